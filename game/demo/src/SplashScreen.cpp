@@ -76,7 +76,7 @@ SplashScreen::SplashScreen(triglav::desktop::ISurface& surface, triglav::graphic
 
    m_job_graph.add_dependency_to_previous_frame("update_ui"_name, "update_ui"_name);
 
-   triglav::renderer::RenderSurface::add_present_jobs(m_job_graph, "render_status"_name);
+   m_render_surface.add_present_jobs(m_job_graph, "render_status"_name);
 
    m_job_graph.add_dependency("render_status"_name, "update_ui"_name);
 
@@ -96,7 +96,8 @@ void SplashScreen::update()
 
    m_update_ui_job.prepare_frame(m_job_graph, m_frame_index);
 
-   m_job_graph.execute("render_status"_name, m_frame_index, nullptr);
+   m_render_surface.acquire_image(m_job_graph, m_frame_index);
+   m_job_graph.execute("render_status"_name, m_frame_index, m_render_surface.job_fence(m_frame_index));
 
    m_render_surface.present(m_job_graph, m_frame_index);
 
@@ -114,7 +115,7 @@ void SplashScreen::on_close()
 
 void SplashScreen::build_rendering_job(triglav::render_core::BuildContext& ctx)
 {
-   ctx.declare_render_target("core.color_out"_name, GAPI_FORMAT(BGRA, sRGB));
+   m_render_surface.declare_output_target(ctx);
    // ctx.declare_depth_target("ui.depth"_name, GAPI_FORMAT(D, UNorm16));
 
    // ctx.begin_render_pass("splash_screen"_name, "core.color_out"_name, "ui.depth"_name);
@@ -124,8 +125,7 @@ void SplashScreen::build_rendering_job(triglav::render_core::BuildContext& ctx)
 
    ctx.end_render_pass();
 
-   ctx.export_texture("core.color_out"_name, triglav::graphics_api::PipelineStage::Transfer,
-                      triglav::graphics_api::TextureState::TransferSrc, triglav::graphics_api::TextureUsage::TransferSrc);
+   m_render_surface.export_output_target(ctx);
 }
 
 void SplashScreen::on_started_loading_asset(const triglav::ResourceName resource_name)
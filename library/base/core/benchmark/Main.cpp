@@ -0,0 +1,100 @@
+#include "triglav/String.hpp"
+
+#include <array>
+#include <chrono>
+#include <print>
+#include <random>
+#include <string>
+#include <vector>
+
+using triglav::MemorySize;
+using triglav::Rune;
+using triglav::u32;
+
+namespace {
+
+constexpr MemorySize g_text_rune_count = 1024 * 1024;
+constexpr MemorySize g_edited_text_rune_count = 64 * 1024;
+constexpr int g_iteration_count = 50;
+constexpr int g_edit_count = 20000;
+
+// Mostly ASCII with some two byte runes, like text written in a european language.
+std::string make_text(std::mt19937& rng, const MemorySize rune_count)
+{
+   constexpr std::array<Rune, 6> accented_runes{0x105, 0x107, 0x119, 0x142, 0xf3, 0x17c};
+
+   std::string result;
+   for (MemorySize i = 0; i < rune_count; ++i) {
+      const auto roll = std::uniform_int_distribution<int>(0, 9)(rng);
+      const Rune rune = roll == 0 ? accented_runes[rng() % accented_runes.size()] : std::uniform_int_distribution<Rune>(0x20, 0x7e)(rng);
+
+      std::array<char, 4> buffer{};
+      const auto byte_count = triglav::rune_to_byte_count(rune);
+      triglav::encode_rune_to_buffer(rune, buffer.data(), byte_count);
+      result.append(buffer.data(), byte_count);
+   }
+   return result;
+}
+
+template<typename TFunc>
+double measure_ns(const int iterations, TFunc func)
+{
+   const auto start = std::chrono::steady_clock::now();
+   for (int i = 0; i < iterations; ++i) {
+      func();
+   }
+   return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / iterations;
+}
+
+void report_throughput(const std::string_view name, const MemorySize size, const double ns)
+{
+   std::println("{:<20} {:>10.1f} MiB/s", name, static_cast<double>(size) / (ns / 1e9) / (1024.0 * 1024.0));
+}
+
+}// namespace
+
+int main()
+{
+   std::mt19937 rng(2024);
+   const auto text = make_text(rng, g_text_rune_count);
+   const auto* text_end = text.data() + text.size();
+
+   MemorySize sink = 0;
+
+   const auto count_scalar_ns = measure_ns(g_iteration_count, [&] { sink += triglav::calculate_rune_count(text.data(), text.size()); });
+   const auto count_ns = measure_ns(g_iteration_count, [&] { sink += triglav::count_runes(text.data(), text.size()); });
+   const auto find_scalar_ns = measure_ns(g_iteration_count, [&] {
+      const char* ptr = text.data();
+      triglav::skip_runes(ptr, text_end, g_text_rune_count - 1);
+      sink += ptr - text.data();
+   });
+   const auto find_ns = measure_ns(g_iteration_count, [&] {
+      sink += triglav::find_rune(text.data(), text.size(), g_text_rune_count - 1) - text.data();
+   });
+   const auto validate_ns = measure_ns(g_iteration_count, [&] { sink += triglav::is_valid_utf8(text.data(), text.size()) ? 1 : 0; });
+
+   std::println("Text of {} bytes, {} runes", text.size(), g_text_rune_count);
+   report_throughput("count scalar", text.size(), count_scalar_ns);
+   report_throughput("count", text.size(), count_ns);
+   report_throughput("find last scalar", text.size(), find_scalar_ns);
+   report_throughput("find last", text.size(), find_ns);
+   report_throughput("validate", text.size(), validate_ns);
+
+   // Typing and deleting at random places of a long text field.
+   triglav::String edited_text{make_text(rng, g_edited_text_rune_count)};
+   std::vector<u32> positions(g_edit_count);
+   for (auto& position : positions) {
+      position = std::uniform_int_distribution<u32>(0, g_edited_text_rune_count - 1)(rng);
+   }
+
+   const auto edit_ns = measure_ns(1, [&] {
+      for (const auto position : positions) {
+         edited_text.insert_rune_at(position, 'a');
+         sink += edited_text.subview(0, static_cast<triglav::i32>(position)).size();
+         edited_text.remove_rune_at(position);
+      }
+   });
+   std::println("{:<20} {:>10.1f} ns per edit, text of {} runes", "edit", edit_ns / g_edit_count, g_edited_text_rune_count);
+
+   return sink == 0 ? 1 : 0;
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "Int.hpp"
+
+#include <cassert>
+#include <list>
+#include <unordered_map>
+
+namespace triglav {
+
+// Fixed capacity cache, inserting into a full cache drops the least recently used entry.
+template<typename TKey, typename TValue, typename THash = std::hash<TKey>>
+class LruCache
+{
+ public:
+   explicit LruCache(const MemorySize capacity) :
+       m_capacity(capacity)
+   {
+      assert(capacity > 0);
+      m_lookup.reserve(capacity);
+   }
+
+   // Returns nullptr on miss, on hit the entry becomes the most recently used one.
+   [[nodiscard]] const TValue* find(const TKey& key)
+   {
+      const auto it = m_lookup.find(key);
+      if (it == m_lookup.end())
+         return nullptr;
+
+      m_entries.splice(m_entries.begin(), m_entries, it->second);
+      return &it->second->second;
+   }
+
+   void insert(const TKey& key, TValue value)
+   {
+      if (const auto it = m_lookup.find(key); it != m_lookup.end()) {
+         it->second->second = std::move(value);
+         m_entries.splice(m_entries.begin(), m_entries, it->second);
+         return;
+      }
+
+      if (m_entries.size() == m_capacity) {
+         m_lookup.erase(m_entries.back().first);
+         m_entries.pop_back();
+      }
+
+      m_entries.emplace_front(key, std::move(value));
+      m_lookup.emplace(key, m_entries.begin());
+   }
+
+   void clear()
+   {
+      m_entries.clear();
+      m_lookup.clear();
+   }
+
+   [[nodiscard]] MemorySize size() const
+   {
+      return m_entries.size();
+   }
+
+   [[nodiscard]] MemorySize capacity() const
+   {
+      return m_capacity;
+   }
+
+ private:
+   using EntryList = std::list<std::pair<TKey, TValue>>;
+
+   MemorySize m_capacity;
+   EntryList m_entries;
+   std::unordered_map<TKey, typename EntryList::iterator, THash> m_lookup;
+};
+
+}// namespace triglav
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "Int.hpp"
+#include "Macros.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace triglav {
+
+// Zones placed on this track are displayed as the GPU timeline.
+constexpr u32 g_gpu_profile_track = 0xFFFF;
+
+struct ProfileZone
+{
+   // Strings are expected to outlive the capture, use Profiler::intern for temporary strings.
+   std::string_view name;
+   std::string_view category;
+   std::string_view detail;
+   u32 track;
+   i64 begin_ns;
+   i64 end_ns;
+};
+
+// Collects timed zones for a number of frames, captures can be exported in the chrome trace format.
+// Outside of a capture adding zones only costs an atomic load.
+class Profiler
+{
+ public:
+   Profiler();
+
+   static Profiler& the();
+
+   void begin_capture(u32 frame_count);
+   [[nodiscard]] bool is_capturing() const;
+
+   // Returns true if this call has finished the capture.
+   bool end_frame();
+
+   // Nanoseconds since the profiler was created.
+   [[nodiscard]] i64 now_ns() const;
+   [[nodiscard]] i64 to_profile_ns(std::chrono::steady_clock::time_point time_point) const;
+
+   void add_zone(const ProfileZone& zone);
+   void set_thread_name(std::string_view name);
+   [[nodiscard]] static u32 thread_track();
+   [[nodiscard]] std::string_view intern(std::string_view value);
+
+   [[nodiscard]] std::vector<ProfileZone> captured_zones() const;
+   [[nodiscard]] std::string chrome_trace_json() const;
+   void clear();
+
+ private:
+   std::chrono::steady_clock::time_point m_epoch;
+   std::atomic<u32> m_remaining_frames{};
+   i64 m_frame_begin_ns{};
+
+   mutable std::mutex m_mutex;
+   std::vector<ProfileZone> m_zones;
+   std::map<u32, std::string> m_track_names;
+   std::set<std::string, std::less<>> m_interned_strings;
+};
+
+class ProfileScope
+{
+ public:
+   ProfileScope(std::string_view name, std::string_view category, std::string_view detail = {});
+   ~ProfileScope();
+
+   TG_DELETE_ALL(ProfileScope)
+
+ private:
+   std::string_view m_name;
+   std::string_view m_category;
+   std::string_view m_detail;
+   i64 m_begin_ns{};
+   bool m_is_active;
+};
+
+}// namespace triglav
+
+#define TG_PROFILE_SCOPE(name, ...) ::triglav::ProfileScope TG_CONCAT(tg_profile_scope_, __COUNTER__){name, __VA_ARGS__}
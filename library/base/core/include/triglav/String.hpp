@@ -6,6 +6,7 @@
 #include <array>
 #include <cstring>
 #include <format>
+#include <memory>
 #include <string>
 
 namespace triglav {
@@ -83,6 +84,7 @@ class StringView
    [[nodiscard]] MemorySize size() const;
    [[nodiscard]] MemorySize rune_count() const;
    [[nodiscard]] bool is_empty() const;
+   [[nodiscard]] bool is_valid_utf8() const;
 
    [[nodiscard]] Iterator begin() const;
    [[nodiscard]] Iterator end() const;
@@ -118,6 +120,7 @@ class String
    [[nodiscard]] bool operator<(const String& other) const;
 
    [[nodiscard]] const char* data() const;
+   // Drops the rune index, the runes may be changed through the pointer.
    [[nodiscard]] char* data();
    [[nodiscard]] MemorySize size() const;
    [[nodiscard]] MemorySize capacity() const;
@@ -141,11 +144,19 @@ class String
    [[nodiscard]] std::string_view to_std_view() const;
 
  private:
+   struct RuneIndex;
+
+   [[nodiscard]] char* payload();
    void grow_to(MemorySize new_size);
    void resize(MemorySize new_size);
    void ensure_capacity_for_size(MemorySize size);
    void deallocate();
 
+   // Only the modifying methods build and update the index, the const ones can be called from several threads.
+   [[nodiscard]] MemorySize rune_offset(u32 position) const;
+   void index_runes_up_to(u32 position);
+   void update_rune_index(MemorySize edit_offset, MemorySize added_runes, MemorySize removed_runes);
+
    struct LargeStringPayload
    {
       char* data;
@@ -158,6 +169,7 @@ class String
       std::array<char, g_small_string_capacity> m_small_payload{};
       LargeStringPayload m_large_payload;
    };
+   std::unique_ptr<RuneIndex> m_rune_index;
 };
 
 class RuneInserterIterator
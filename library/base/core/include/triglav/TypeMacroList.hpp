@@ -25,7 +25,7 @@ class Typeface;
 }
 
 namespace world {
-class Level;
+class CompactLevel;
 }// namespace world
 
 }// namespace triglav
@@ -46,7 +46,7 @@ TG_RESOURCE_TYPE(name, extension, cpp_type, loading_stage)
    TG_RESOURCE_TYPE(Animation, "anim", ::triglav::asset::Animation, 0)                      \
    TG_RESOURCE_TYPE(Mesh, "mesh", ::triglav::render_objects::Mesh, 0)                       \
    TG_RESOURCE_TYPE(Typeface, "typeface", ::triglav::font::Typeface, 0)                     \
-   TG_RESOURCE_TYPE(Level, "level", ::triglav::world::Level, 0)                             \
+   TG_RESOURCE_TYPE(Level, "level", ::triglav::world::CompactLevel, 0)                      \
    TG_RESOURCE_TYPE(Armature, "arm", ::triglav::render_objects::Armature, 0)                \
    TG_RESOURCE_TYPE(HullShader, "hshader", ::triglav::graphics_api::Shader, 0)              \
    TG_RESOURCE_TYPE(DomainShader, "dshader", ::triglav::graphics_api::Shader, 0)
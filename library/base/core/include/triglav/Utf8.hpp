@@ -113,4 +113,11 @@ constexpr void skip_runes(T& buffer, T end_ptr, u32 rune_count)
    }
 }
 
+// Runtime counterparts of the routines above, they process 16 bytes at a time where SSE2 is available.
+[[nodiscard]] MemorySize count_runes(const char* data, MemorySize size);
+// Pointer to the rune at the given index, or to the end if there are fewer runes.
+[[nodiscard]] const char* find_rune(const char* data, MemorySize size, MemorySize rune_index);
+// Rejects truncated sequences, overlong encodings, surrogates and code points above U+10FFFF.
+[[nodiscard]] bool is_valid_utf8(const char* data, MemorySize size);
+
 }// namespace triglav
@@ -208,6 +208,7 @@ std::map<Name, std::string_view> KnownNames{
    {"shader/bindless_geometry/hi_zbuffer_construct.cshader"_name, "shader/bindless_geometry/hi_zbuffer_construct.cshader"sv},
    {"shader/bindless_geometry/matrix_multiply.cshader"_name, "shader/bindless_geometry/matrix_multiply.cshader"sv},
    {"shader/bindless_geometry/passthrough.cshader"_name, "shader/bindless_geometry/passthrough.cshader"sv},
+   {"shader/bindless_geometry/shadow_culling.cshader"_name, "shader/bindless_geometry/shadow_culling.cshader"sv},
    {"shader/bindless_geometry/shadow_map.fshader"_name, "shader/bindless_geometry/shadow_map.fshader"sv},
    {"shader/bindless_geometry/transform_to_matrix.cshader"_name, "shader/bindless_geometry/transform_to_matrix.cshader"sv},
    {"shader/geometry/ground.fshader"_name, "shader/geometry/ground.fshader"sv},
@@ -0,0 +1,201 @@
+#include "Profiler.hpp"
+
+#include <algorithm>
+#include <format>
+#include <iterator>
+
+namespace triglav {
+
+namespace {
+
+std::atomic<u32> g_next_thread_track{0};
+thread_local u32 g_thread_track{g_next_thread_track.fetch_add(1)};
+
+void write_escaped(std::string& out, const std::string_view value)
+{
+   for (const char ch : value) {
+      switch (ch) {
+      case '"':
+         out += "\\\"";
+         break;
+      case '\\':
+         out += "\\\\";
+         break;
+      case '\n':
+         out += "\\n";
+         break;
+      case '\t':
+         out += "\\t";
+         break;
+      default:
+         if (static_cast<unsigned char>(ch) < 0x20) {
+            std::format_to(std::back_inserter(out), "\\u{:04x}", static_cast<u32>(ch));
+         } else {
+            out += ch;
+         }
+         break;
+      }
+   }
+}
+
+}// namespace
+
+Profiler::Profiler() :
+    m_epoch(std::chrono::steady_clock::now())
+{
+}
+
+Profiler& Profiler::the()
+{
+   static Profiler instance;
+   return instance;
+}
+
+void Profiler::begin_capture(const u32 frame_count)
+{
+   std::unique_lock lk{m_mutex};
+   m_zones.clear();
+   m_frame_begin_ns = this->now_ns();
+   m_remaining_frames.store(frame_count);
+}
+
+bool Profiler::is_capturing() const
+{
+   return m_remaining_frames.load(std::memory_order_relaxed) != 0;
+}
+
+bool Profiler::end_frame()
+{
+   if (not this->is_capturing())
+      return false;
+
+   const auto now = this->now_ns();
+   this->add_zone({"Frame", "frame", {}, thread_track(), m_frame_begin_ns, now});
+   m_frame_begin_ns = now;
+
+   return m_remaining_frames.fetch_sub(1) == 1;
+}
+
+i64 Profiler::now_ns() const
+{
+   return this->to_profile_ns(std::chrono::steady_clock::now());
+}
+
+i64 Profiler::to_profile_ns(const std::chrono::steady_clock::time_point time_point) const
+{
+   return std::chrono::duration_cast<std::chrono::nanoseconds>(time_point - m_epoch).count();
+}
+
+void Profiler::add_zone(const ProfileZone& zone)
+{
+   if (not this->is_capturing())
+      return;
+
+   std::unique_lock lk{m_mutex};
+   m_zones.emplace_back(zone);
+}
+
+void Profiler::set_thread_name(const std::string_view name)
+{
+   std::unique_lock lk{m_mutex};
+   m_track_names[thread_track()] = name;
+}
+
+u32 Profiler::thread_track()
+{
+   return g_thread_track;
+}
+
+std::string_view Profiler::intern(const std::string_view value)
+{
+   std::unique_lock lk{m_mutex};
+   if (const auto it = m_interned_strings.find(value); it != m_interned_strings.end()) {
+      return *it;
+   }
+   return *m_interned_strings.emplace(value).first;
+}
+
+std::vector<ProfileZone> Profiler::captured_zones() const
+{
+   std::unique_lock lk{m_mutex};
+   return m_zones;
+}
+
+std::string Profiler::chrome_trace_json() const
+{
+   std::unique_lock lk{m_mutex};
+
+   std::string result;
+   result.reserve(128 * (m_zones.size() + m_track_names.size() + 1));
+   result += R"({"displayTimeUnit":"ms","traceEvents":[)";
+
+   bool is_first = true;
+   const auto write_separator = [&] {
+      if (not is_first) {
+         result += ',';
+      }
+      is_first = false;
+   };
+
+   const auto write_track_name = [&](const u32 track, const std::string_view name) {
+      write_separator();
+      std::format_to(std::back_inserter(result), R"({{"name":"thread_name","ph":"M","pid":0,"tid":{},"args":{{"name":")", track);
+      write_escaped(result, name);
+      result += R"("}})";
+   };
+
+   write_track_name(g_gpu_profile_track, "GPU");
+   for (const auto& [track, name] : m_track_names) {
+      write_track_name(track, name);
+   }
+
+   for (const auto& zone : m_zones) {
+      write_separator();
+      result += R"({"name":")";
+      write_escaped(result, zone.name);
+      result += R"(","cat":")";
+      write_escaped(result, zone.category);
+      const auto duration_ns = std::max(zone.end_ns - zone.begin_ns, i64{0});
+      std::format_to(std::back_inserter(result), R"(","ph":"X","pid":0,"tid":{},"ts":{:.3f},"dur":{:.3f})", zone.track,
+                     static_cast<double>(zone.begin_ns) / 1000.0, static_cast<double>(duration_ns) / 1000.0);
+      if (not zone.detail.empty()) {
+         result += R"(,"args":{"detail":")";
+         write_escaped(result, zone.detail);
+         result += R"("})";
+      }
+      result += '}';
+   }
+
+   result += "]}";
+   return result;
+}
+
+void Profiler::clear()
+{
+   std::unique_lock lk{m_mutex};
+   m_zones.clear();
+}
+
+ProfileScope::ProfileScope(const std::string_view name, const std::string_view category, const std::string_view detail) :
+    m_name(name),
+    m_category(category),
+    m_detail(detail),
+    m_is_active(Profiler::the().is_capturing())
+{
+   if (m_is_active) {
+      m_begin_ns = Profiler::the().now_ns();
+   }
+}
+
+ProfileScope::~ProfileScope()
+{
+   if (not m_is_active)
+      return;
+
+   auto& profiler = Profiler::the();
+   const auto end_ns = profiler.now_ns();
+   const auto detail = m_detail.empty() ? std::string_view{} : profiler.intern(m_detail);
+   profiler.add_zone({m_name, m_category, detail, Profiler::thread_track(), m_begin_ns, end_ns});
+}
+
+}// namespace triglav
@@ -1,12 +1,18 @@
 #include "String.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <utility>
+#include <vector>
 
 namespace triglav {
 
 namespace {
 
+// Shorter strings are scanned from the start, that takes no longer than a few cache lines.
+constexpr MemorySize g_rune_index_min_size = 256;
+constexpr MemorySize g_rune_index_stride = 64;
+
 MemorySize capacity_to_fit_size(const MemorySize size)
 {
    auto cap = g_small_string_capacity;
@@ -18,6 +24,13 @@ MemorySize capacity_to_fit_size(const MemorySize size)
 
 }// namespace
 
+struct String::RuneIndex
+{
+   // Byte offsets of every g_rune_index_stride-th rune, starting with the first one.
+   std::vector<MemorySize> checkpoints{0};
+   MemorySize rune_count{};
+};
+
 StringView::Iterator::Iterator(const char* beg, const char* end, const bool is_end) :
     m_iterator(beg),
     m_end(end),
@@ -77,7 +90,7 @@ MemorySize StringView::size() const
 
 MemorySize StringView::rune_count() const
 {
-   return calculate_rune_count(m_data, m_size);
+   return count_runes(m_data, m_size);
 }
 
 bool StringView::is_empty() const
@@ -85,6 +98,11 @@ bool StringView::is_empty() const
    return m_size == 0;
 }
 
+bool StringView::is_valid_utf8() const
+{
+   return triglav::is_valid_utf8(m_data, m_size);
+}
+
 StringView::Iterator StringView::begin() const
 {
    Iterator it{m_data, m_data + m_size, false};
@@ -122,7 +140,7 @@ String::String(const StringView string) :
 String::String(const char* string, const MemorySize data_size)
 {
    this->ensure_capacity_for_size(data_size);
-   std::memcpy(this->data(), string, data_size);
+   std::memcpy(this->payload(), string, data_size);
 }
 
 String::String(const Rune single_rune, const MemorySize num_runes)
@@ -130,12 +148,12 @@ String::String(const Rune single_rune, const MemorySize num_runes)
    const auto rune_byte_count = rune_to_byte_count(single_rune);
    this->ensure_capacity_for_size(num_runes * rune_byte_count);
    if (rune_byte_count == 1) {
-      std::memset(this->data(), static_cast<int>(single_rune), num_runes);
+      std::memset(this->payload(), static_cast<int>(single_rune), num_runes);
    } else {
       std::array<char, 8> rune_chars{};
       encode_rune_to_buffer(single_rune, rune_chars.data(), rune_byte_count);
       for (MemorySize i = 0; i < num_runes; ++i) {
-         std::memcpy(this->data() + i * rune_byte_count, rune_chars.data(), rune_byte_count);
+         std::memcpy(this->payload() + i * rune_byte_count, rune_chars.data(), rune_byte_count);
       }
    }
 }
@@ -148,18 +166,19 @@ String::~String()
 String::String(const String& other)
 {
    this->ensure_capacity_for_size(other.m_size);
-   std::memcpy(this->data(), other.data(), m_size);
+   std::memcpy(this->payload(), other.data(), m_size);
 }
 
 String& String::operator=(const String& other)
 {
    this->ensure_capacity_for_size(other.m_size);
-   std::memcpy(this->data(), other.data(), other.m_size);
+   std::memcpy(this->payload(), other.data(), other.m_size);
    return *this;
 }
 
 String::String(String&& other) noexcept :
-    m_size(std::exchange(other.m_size, 0))
+    m_size(std::exchange(other.m_size, 0)),
+    m_rune_index(std::move(other.m_rune_index))
 {
    if (m_size <= g_small_string_capacity) {
       std::memcpy(m_small_payload.data(), other.m_small_payload.data(), m_size);
@@ -178,6 +197,7 @@ String& String::operator=(String&& other) noexcept
    } else {
       m_large_payload = other.m_large_payload;
    }
+   m_rune_index = std::move(other.m_rune_index);
 
    return *this;
 }
@@ -216,10 +236,8 @@ const char* String::data() const
 
 char* String::data()
 {
-   if (m_size <= g_small_string_capacity) {
-      return m_small_payload.data();
-   }
-   return m_large_payload.data;
+   m_rune_index.reset();
+   return this->payload();
 }
 
 MemorySize String::size() const
@@ -237,7 +255,10 @@ MemorySize String::capacity() const
 
 MemorySize String::rune_count() const
 {
-   return calculate_rune_count(this->data(), m_size);
+   if (m_rune_index != nullptr) {
+      return m_rune_index->rune_count;
+   }
+   return count_runes(this->data(), m_size);
 }
 
 StringView String::view() const
@@ -252,32 +273,31 @@ bool String::is_empty() const
 
 StringView String::subview(i32 initial_rune, i32 last_rune) const
 {
-   const auto rune_count = static_cast<i32>(this->rune_count());
-   while (initial_rune < 0) {
-      initial_rune += rune_count;
-   }
-   while (last_rune < 0) {
-      last_rune += rune_count;
+   if (initial_rune < 0 || last_rune < 0) {
+      const auto rune_count = static_cast<i32>(this->rune_count());
+      while (initial_rune < 0) {
+         initial_rune += rune_count;
+      }
+      while (last_rune < 0) {
+         last_rune += rune_count;
+      }
    }
 
-   assert(initial_rune < rune_count);
-   assert(last_rune <= rune_count);
    assert(initial_rune <= last_rune);
+   assert(static_cast<MemorySize>(last_rune) <= this->rune_count());
 
-   auto start_ptr = this->data();
-   skip_runes(start_ptr, this->data() + m_size, initial_rune);
-
-   auto end_ptr = start_ptr;
-   skip_runes(end_ptr, this->data() + m_size, last_rune - initial_rune);
+   const auto start_offset = this->rune_offset(initial_rune);
+   const auto end_offset = this->rune_offset(last_rune);
 
-   return {start_ptr, static_cast<MemorySize>(end_ptr - start_ptr)};
+   return {this->data() + start_offset, end_offset - start_offset};
 }
 
 void String::append(const StringView other)
 {
    const auto old_size = m_size;
    this->grow_to(m_size + other.size());
-   std::memcpy(this->data() + old_size, other.data(), other.size());
+   std::memcpy(this->payload() + old_size, other.data(), other.size());
+   this->update_rune_index(old_size, count_runes(other.data(), other.size()), 0);
 }
 
 void String::append_rune(const Rune rune)
@@ -285,22 +305,24 @@ void String::append_rune(const Rune rune)
    const auto count = rune_to_byte_count(rune);
    const auto old_size = m_size;
    this->grow_to(m_size + count);
-   encode_rune_to_buffer(rune, this->data() + old_size, count);
+   encode_rune_to_buffer(rune, this->payload() + old_size, count);
+   this->update_rune_index(old_size, 1, 0);
 }
 
 void String::insert_rune_at(const u32 position, const Rune rune)
 {
+   this->index_runes_up_to(position);
+   const auto offset = this->rune_offset(position);
+
    const auto count = rune_to_byte_count(rune);
    const auto old_size = m_size;
    this->grow_to(m_size + count);
 
-   auto* ptr = this->data();
-   skip_runes(ptr, ptr + old_size, position);
-
-   const auto offset = ptr - this->data();
+   auto* ptr = this->payload() + offset;
    std::memmove(ptr + count, ptr, old_size - offset);
 
    encode_rune_to_buffer(rune, ptr, count);
+   this->update_rune_index(offset, 1, 0);
 }
 
 void String::remove_rune_at(const u32 position)
@@ -310,26 +332,28 @@ void String::remove_rune_at(const u32 position)
 
 void String::remove_range(const u32 first_rune, const u32 last_rune)
 {
-   auto* start = this->data();
-   skip_runes(start, start + m_size, first_rune);
+   this->index_runes_up_to(first_rune);
+   const auto start_offset = this->rune_offset(first_rune);
 
-   auto* end = start;
-   skip_runes(end, this->data() + m_size, last_rune - first_rune);
+   auto* start = this->payload() + start_offset;
+   const auto* end = find_rune(start, m_size - start_offset, last_rune - first_rune);
 
    const auto data_size = end - start;
-   const auto remaining_size = (this->data() + m_size) - end;
+   const auto removed_runes = count_runes(start, data_size);
+   const auto remaining_size = (this->payload() + m_size) - end;
    std::memmove(start, end, remaining_size);
 
    const auto old_size = m_size;
    const auto new_size = m_size - data_size;
 
    if (old_size > g_small_string_capacity && new_size <= g_small_string_capacity) {
-      const auto* ptr = this->data();
+      const auto* ptr = this->payload();
       std::memcpy(m_small_payload.data(), ptr, new_size);
       delete[] ptr;
    }
 
    m_size = new_size;
+   this->update_rune_index(start_offset, 0, removed_runes);
 }
 
 void String::shrink_by(const MemorySize rune_count)
@@ -343,7 +367,7 @@ void String::shrink_by(const MemorySize rune_count)
          --new_size;
          if (new_size == 0)
             break;
-      } while (!is_rune_initial_byte(this->data()[new_size]));
+      } while (!is_rune_initial_byte(this->payload()[new_size]));
 
       if (new_size == 0)
          break;
@@ -383,7 +407,7 @@ void String::grow_to(const MemorySize new_size)
 
    const auto new_cap = capacity_to_fit_size(new_size);
    auto* new_data = new char[new_cap];
-   std::memcpy(new_data, this->data(), m_size);
+   std::memcpy(new_data, this->payload(), m_size);
 
    this->deallocate();
    m_large_payload.capacity = new_cap;
@@ -396,21 +420,26 @@ void String::resize(const MemorySize new_size)
    if (new_size == m_size)
       return;
    if (new_size < m_size) {
+      const auto removed_runes = count_runes(this->payload() + new_size, m_size - new_size);
       if (new_size <= g_small_string_capacity && m_size > g_small_string_capacity) {
          const auto* data = m_large_payload.data;
          std::memcpy(m_small_payload.data(), data, new_size);
          delete[] data;
       }
       m_size = new_size;
+      this->update_rune_index(new_size, 0, removed_runes);
    } else {
       const auto old_size = m_size;
       this->grow_to(new_size);
-      std::memset(this->data() + old_size, ' ', m_size - old_size);
+      std::memset(this->payload() + old_size, ' ', m_size - old_size);
+      this->update_rune_index(old_size, new_size - old_size, 0);
    }
 }
 
 void String::ensure_capacity_for_size(const MemorySize size)
 {
+   m_rune_index.reset();
+
    if (size <= this->capacity()) {
       if (m_size > g_small_string_capacity && size <= g_small_string_capacity) {
          delete[] m_large_payload.data;
@@ -426,6 +455,14 @@ void String::ensure_capacity_for_size(const MemorySize size)
    m_size = size;
 }
 
+char* String::payload()
+{
+   if (m_size <= g_small_string_capacity) {
+      return m_small_payload.data();
+   }
+   return m_large_payload.data;
+}
+
 void String::deallocate()
 {
    if (m_size <= g_small_string_capacity) {
@@ -436,6 +473,55 @@ void String::deallocate()
    m_size = 0;
 }
 
+MemorySize String::rune_offset(const u32 position) const
+{
+   MemorySize base_rune{};
+   MemorySize base_offset{};
+   if (m_rune_index != nullptr) {
+      const auto& checkpoints = m_rune_index->checkpoints;
+      const auto checkpoint = std::min<MemorySize>(position / g_rune_index_stride, checkpoints.size() - 1);
+      base_rune = checkpoint * g_rune_index_stride;
+      base_offset = checkpoints[checkpoint];
+   }
+
+   const auto* text = this->data();
+   return find_rune(text + base_offset, m_size - base_offset, position - base_rune) - text;
+}
+
+void String::index_runes_up_to(const u32 position)
+{
+   if (m_size < g_rune_index_min_size)
+      return;
+
+   const auto* text = this->payload();
+   if (m_rune_index == nullptr) {
+      m_rune_index = std::make_unique<RuneIndex>();
+      m_rune_index->rune_count = count_runes(text, m_size);
+   }
+
+   auto& checkpoints = m_rune_index->checkpoints;
+   while (checkpoints.size() <= position / g_rune_index_stride) {
+      const auto last = checkpoints.back();
+      const auto* next = find_rune(text + last, m_size - last, g_rune_index_stride);
+      if (next == text + m_size)
+         break;
+      checkpoints.push_back(next - text);
+   }
+}
+
+void String::update_rune_index(const MemorySize edit_offset, const MemorySize added_runes, const MemorySize removed_runes)
+{
+   if (m_rune_index == nullptr)
+      return;
+
+   // Runes before the edit keep their offsets.
+   auto& checkpoints = m_rune_index->checkpoints;
+   while (checkpoints.back() > edit_offset) {
+      checkpoints.pop_back();
+   }
+   m_rune_index->rune_count = m_rune_index->rune_count + added_runes - removed_runes;
+}
+
 RuneInserterIterator::RuneInserterIterator(String& string_instance) :
     m_string_instance(string_instance)
 {
@@ -0,0 +1,167 @@
+#include "Utf8.hpp"
+
+#include <algorithm>
+#include <bit>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#define TG_UTF8_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace triglav {
+
+namespace {
+
+constexpr MemorySize g_chunk_size = 16;
+
+[[nodiscard]] constexpr bool is_continuation_byte(const u8 byte)
+{
+   return (byte & 0xc0) == 0x80;
+}
+
+#if TG_UTF8_SSE2
+
+// Bit mask of the runes starting in the 16 bytes at the pointer.
+[[nodiscard]] u32 initial_byte_mask(const char* data)
+{
+   const auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+   // Continuation bytes 0x80-0xbf are the only ones below -64 as signed values.
+   const auto continuation = _mm_cmplt_epi8(chunk, _mm_set1_epi8(-64));
+   return ~static_cast<u32>(_mm_movemask_epi8(continuation)) & 0xffff;
+}
+
+[[nodiscard]] bool is_ascii_chunk(const char* data)
+{
+   return _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data))) == 0;
+}
+
+#else
+
+[[nodiscard]] u32 initial_byte_mask(const char* data)
+{
+   u32 mask = 0;
+   for (MemorySize i = 0; i < g_chunk_size; ++i) {
+      if (not is_continuation_byte(static_cast<u8>(data[i]))) {
+         mask |= 1u << i;
+      }
+   }
+   return mask;
+}
+
+[[nodiscard]] bool is_ascii_chunk(const char* data)
+{
+   for (MemorySize i = 0; i < g_chunk_size; ++i) {
+      if ((static_cast<u8>(data[i]) & 0x80) != 0)
+         return false;
+   }
+   return true;
+}
+
+#endif
+
+// Length of the valid sequence at the pointer, zero if the sequence is invalid.
+[[nodiscard]] MemorySize valid_sequence_length(const u8* data, const MemorySize size)
+{
+   const auto lead = data[0];
+   if (lead < 0x80)
+      return 1;
+
+   MemorySize length;
+   u8 min_second = 0x80;
+   u8 max_second = 0xbf;
+   if (lead >= 0xc2 && lead <= 0xdf) {
+      length = 2;
+   } else if (lead >= 0xe0 && lead <= 0xef) {
+      length = 3;
+      if (lead == 0xe0) {
+         min_second = 0xa0;
+      } else if (lead == 0xed) {
+         max_second = 0x9f;
+      }
+   } else if (lead >= 0xf0 && lead <= 0xf4) {
+      length = 4;
+      if (lead == 0xf0) {
+         min_second = 0x90;
+      } else if (lead == 0xf4) {
+         max_second = 0x8f;
+      }
+   } else {
+      return 0;
+   }
+
+   if (size < length)
+      return 0;
+   if (data[1] < min_second || data[1] > max_second)
+      return 0;
+   for (MemorySize i = 2; i < length; ++i) {
+      if (not is_continuation_byte(data[i]))
+         return 0;
+   }
+   return length;
+}
+
+}// namespace
+
+MemorySize count_runes(const char* data, const MemorySize size)
+{
+   MemorySize count{};
+   MemorySize offset{};
+   for (; offset + g_chunk_size <= size; offset += g_chunk_size) {
+      count += std::popcount(initial_byte_mask(data + offset));
+   }
+   return count + calculate_rune_count(data + offset, size - offset);
+}
+
+const char* find_rune(const char* data, const MemorySize size, MemorySize rune_index)
+{
+   const char* end = data + size;
+   while (data + g_chunk_size <= end) {
+      auto mask = initial_byte_mask(data);
+      const auto count = static_cast<MemorySize>(std::popcount(mask));
+      if (count > rune_index) {
+         // Drop the lower runes, the lowest remaining bit is the requested one.
+         for (MemorySize i = 0; i < rune_index; ++i) {
+            mask &= mask - 1;
+         }
+         return data + std::countr_zero(mask);
+      }
+      rune_index -= count;
+      data += g_chunk_size;
+   }
+
+   for (; data != end; ++data) {
+      if (is_rune_initial_byte(*data)) {
+         if (rune_index == 0)
+            return data;
+         --rune_index;
+      }
+   }
+   return end;
+}
+
+bool is_valid_utf8(const char* data, const MemorySize size)
+{
+   MemorySize offset{};
+   while (offset < size) {
+      if (offset + g_chunk_size <= size && is_ascii_chunk(data + offset)) {
+         offset += g_chunk_size;
+         continue;
+      }
+
+      // Validate the rest of the chunk one sequence at a time.
+      const auto chunk_end = std::min(offset + g_chunk_size, size);
+      while (offset < chunk_end) {
+         if (static_cast<u8>(data[offset]) < 0x80) {
+            ++offset;
+            continue;
+         }
+         const auto length = valid_sequence_length(reinterpret_cast<const u8*>(data + offset), size - offset);
+         if (length == 0)
+            return false;
+         offset += length;
+      }
+   }
+   return true;
+}
+
+}// namespace triglav
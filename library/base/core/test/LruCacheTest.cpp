@@ -0,0 +1,54 @@
+#include "triglav/LruCache.hpp"
+#include "triglav/testing_core/GTest.hpp"
+
+#include <string>
+
+using triglav::LruCache;
+
+TEST(LruCacheTest, FindsInsertedValues)
+{
+   LruCache<int, std::string> cache(4);
+   cache.insert(1, "foo");
+   cache.insert(2, "bar");
+
+   ASSERT_NE(cache.find(1), nullptr);
+   EXPECT_EQ(*cache.find(1), "foo");
+   ASSERT_NE(cache.find(2), nullptr);
+   EXPECT_EQ(*cache.find(2), "bar");
+   EXPECT_EQ(cache.find(3), nullptr);
+   EXPECT_EQ(cache.size(), 2u);
+}
+
+TEST(LruCacheTest, EvictsLeastRecentlyUsed)
+{
+   LruCache<int, int> cache(3);
+   cache.insert(1, 10);
+   cache.insert(2, 20);
+   cache.insert(3, 30);
+
+   // Touch the oldest entry so that 2 becomes the least recently used.
+   ASSERT_NE(cache.find(1), nullptr);
+
+   cache.insert(4, 40);
+
+   EXPECT_EQ(cache.size(), 3u);
+   EXPECT_EQ(cache.find(2), nullptr);
+   ASSERT_NE(cache.find(1), nullptr);
+   EXPECT_EQ(*cache.find(1), 10);
+   ASSERT_NE(cache.find(3), nullptr);
+   ASSERT_NE(cache.find(4), nullptr);
+}
+
+TEST(LruCacheTest, InsertOverridesExisting)
+{
+   LruCache<int, int> cache(2);
+   cache.insert(1, 10);
+   cache.insert(2, 20);
+   cache.insert(1, 11);
+   cache.insert(3, 30);
+
+   EXPECT_EQ(cache.size(), 2u);
+   ASSERT_NE(cache.find(1), nullptr);
+   EXPECT_EQ(*cache.find(1), 11);
+   EXPECT_EQ(cache.find(2), nullptr);
+}
@@ -0,0 +1,74 @@
+#include "triglav/Profiler.hpp"
+#include "triglav/testing_core/GTest.hpp"
+
+#include <thread>
+
+using triglav::Profiler;
+using triglav::ProfileScope;
+using triglav::u32;
+
+TEST(ProfilerTest, RecordsZonesOnlyDuringCapture)
+{
+   Profiler profiler;
+   profiler.add_zone({"before", "test", {}, 0, 0, 10});
+
+   profiler.begin_capture(2);
+   profiler.add_zone({"first", "test", {}, 0, 10, 20});
+   EXPECT_FALSE(profiler.end_frame());
+   profiler.add_zone({"second", "test", {}, 0, 20, 30});
+   EXPECT_TRUE(profiler.end_frame());
+   EXPECT_FALSE(profiler.is_capturing());
+
+   profiler.add_zone({"after", "test", {}, 0, 30, 40});
+
+   const auto zones = profiler.captured_zones();
+   std::vector<std::string_view> names;
+   for (const auto& zone : zones) {
+      names.emplace_back(zone.name);
+   }
+
+   EXPECT_EQ(names, (std::vector<std::string_view>{"first", "Frame", "second", "Frame"}));
+}
+
+TEST(ProfilerTest, ScopeRecordsThreadTrack)
+{
+   auto& profiler = Profiler::the();
+   profiler.begin_capture(1);
+
+   u32 worker_track{};
+   std::thread worker([&] {
+      worker_track = Profiler::thread_track();
+      profiler.set_thread_name("Worker");
+      ProfileScope scope("worker_job", "test", "detail");
+   });
+   worker.join();
+
+   {
+      ProfileScope scope("main_job", "test");
+   }
+   profiler.end_frame();
+
+   const auto zones = profiler.captured_zones();
+   ASSERT_EQ(zones.size(), 3u);
+   EXPECT_EQ(zones[0].name, "worker_job");
+   EXPECT_EQ(zones[0].track, worker_track);
+   EXPECT_EQ(zones[0].detail, "detail");
+   EXPECT_LE(zones[0].begin_ns, zones[0].end_ns);
+   EXPECT_EQ(zones[1].name, "main_job");
+   EXPECT_EQ(zones[1].track, Profiler::thread_track());
+   EXPECT_NE(worker_track, Profiler::thread_track());
+}
+
+TEST(ProfilerTest, ExportsChromeTrace)
+{
+   Profiler profiler;
+   profiler.begin_capture(1);
+   profiler.add_zone({"pass \"gbuffer\"", "gpu", {}, triglav::g_gpu_profile_track, 1500, 4000});
+
+   const auto json = profiler.chrome_trace_json();
+   EXPECT_TRUE(json.starts_with(R"({"displayTimeUnit":"ms","traceEvents":[)"));
+   EXPECT_TRUE(json.ends_with("]}"));
+   EXPECT_NE(json.find(R"({"name":"thread_name","ph":"M","pid":0,"tid":65535,"args":{"name":"GPU"}})"), std::string::npos);
+   EXPECT_NE(json.find(R"({"name":"pass \"gbuffer\"","cat":"gpu","ph":"X","pid":0,"tid":65535,"ts":1.500,"dur":2.500})"),
+             std::string::npos);
+}
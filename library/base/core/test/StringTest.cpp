@@ -2,8 +2,57 @@
 #include "triglav/Format.hpp"
 #include "triglav/testing_core/GTest.hpp"
 
+#include <random>
+#include <string>
+#include <vector>
+
+using triglav::MemorySize;
+using triglav::Rune;
+
 using namespace triglav::string_literals;
 
+namespace {
+
+constexpr int g_fuzz_iteration_count = 200;
+
+Rune random_rune(std::mt19937& rng)
+{
+   // Mostly ASCII with every UTF-8 length represented, like editor text.
+   switch (std::uniform_int_distribution<int>(0, 7)(rng)) {
+   case 0:
+      return std::uniform_int_distribution<Rune>(0x80, 0x7ff)(rng);
+   case 1:
+      return std::uniform_int_distribution<Rune>(0x800, 0xd7ff)(rng);
+   case 2:
+      return std::uniform_int_distribution<Rune>(0x10000, 0x10ffff)(rng);
+   default:
+      return std::uniform_int_distribution<Rune>(0x20, 0x7e)(rng);
+   }
+}
+
+std::vector<Rune> random_runes(std::mt19937& rng, const MemorySize count)
+{
+   std::vector<Rune> runes(count);
+   for (auto& rune : runes) {
+      rune = random_rune(rng);
+   }
+   return runes;
+}
+
+std::string encode_runes(const std::vector<Rune>& runes)
+{
+   std::string result;
+   for (const auto rune : runes) {
+      std::array<char, 4> buffer{};
+      const auto byte_count = triglav::rune_to_byte_count(rune);
+      triglav::encode_rune_to_buffer(rune, buffer.data(), byte_count);
+      result.append(buffer.data(), byte_count);
+   }
+   return result;
+}
+
+}// namespace
+
 TEST(StringTest, BasicASCII)
 {
    triglav::String example{"Hello World"};
@@ -225,3 +274,125 @@ TEST(StringTest, RemoveRune)
       ASSERT_EQ(msg, "dbło łąk");
    }
 }
+
+TEST(StringTest, Utf8RoutinesMatchScalar)
+{
+   std::mt19937 rng(4312);
+
+   for (int iteration = 0; iteration < g_fuzz_iteration_count; ++iteration) {
+      const auto runes = random_runes(rng, std::uniform_int_distribution<MemorySize>(0, 300)(rng));
+      const auto text = encode_runes(runes);
+
+      ASSERT_EQ(triglav::count_runes(text.data(), text.size()), runes.size());
+      ASSERT_EQ(triglav::calculate_rune_count(text.data(), text.size()), runes.size());
+      ASSERT_TRUE(triglav::is_valid_utf8(text.data(), text.size()));
+
+      for (MemorySize index = 0; index <= runes.size(); ++index) {
+         const char* expected = text.data();
+         triglav::skip_runes(expected, text.data() + text.size(), static_cast<triglav::u32>(index));
+         ASSERT_EQ(triglav::find_rune(text.data(), text.size(), index), expected);
+      }
+   }
+}
+
+TEST(StringTest, InvalidUtf8IsRejected)
+{
+   // Lone continuation, overlong encodings, surrogate, above U+10FFFF and bytes that never occur.
+   const std::vector<std::string> invalid_sequences{
+      "\x80", "\xc0\x80", "\xc1\xbf", "\xe0\x80\x80", "\xed\xa0\x80", "\xf0\x80\x80\x80", "\xf4\x90\x80\x80", "\xf5\x80\x80\x80", "\xff",
+   };
+
+   std::mt19937 rng(1291);
+
+   for (int iteration = 0; iteration < g_fuzz_iteration_count; ++iteration) {
+      auto text = encode_runes(random_runes(rng, std::uniform_int_distribution<MemorySize>(0, 100)(rng)));
+      const auto rune_index = std::uniform_int_distribution<MemorySize>(0, 100)(rng);
+      const auto position = triglav::find_rune(text.data(), text.size(), rune_index) - text.data();
+
+      for (const auto& sequence : invalid_sequences) {
+         auto invalid_text = text;
+         invalid_text.insert(position, sequence);
+         ASSERT_FALSE(triglav::is_valid_utf8(invalid_text.data(), invalid_text.size()));
+      }
+
+      // Cut inside the last multibyte rune.
+      if (text.empty())
+         continue;
+      const auto* last_rune = triglav::find_rune(text.data(), text.size(), triglav::count_runes(text.data(), text.size()) - 1);
+      if (text.data() + text.size() - last_rune > 1) {
+         ASSERT_FALSE(triglav::is_valid_utf8(text.data(), text.size() - 1));
+      }
+   }
+}
+
+TEST(StringTest, EditingLongStringMatchesReference)
+{
+   std::mt19937 rng(7707);
+
+   auto runes = random_runes(rng, 600);
+   triglav::String text{encode_runes(runes)};
+
+   const auto random_position = [&](const MemorySize count) {
+      return static_cast<triglav::u32>(std::uniform_int_distribution<MemorySize>(0, count)(rng));
+   };
+
+   for (int iteration = 0; iteration < 20 * g_fuzz_iteration_count; ++iteration) {
+      switch (std::uniform_int_distribution<int>(0, 5)(rng)) {
+      case 0:
+      case 1: {
+         const auto position = random_position(runes.size());
+         const auto rune = random_rune(rng);
+         runes.insert(runes.begin() + position, rune);
+         text.insert_rune_at(position, rune);
+         break;
+      }
+      case 2: {
+         if (runes.empty())
+            break;
+         const auto position = random_position(runes.size() - 1);
+         runes.erase(runes.begin() + position);
+         text.remove_rune_at(position);
+         break;
+      }
+      case 3: {
+         const auto first = random_position(runes.size());
+         const auto last = first + random_position(std::min<MemorySize>(runes.size() - first, 40));
+         runes.erase(runes.begin() + first, runes.begin() + last);
+         text.remove_range(first, last);
+         break;
+      }
+      case 4: {
+         const auto appended = random_runes(rng, random_position(40));
+         runes.insert(runes.end(), appended.begin(), appended.end());
+         text.append(triglav::StringView{encode_runes(appended)});
+         break;
+      }
+      case 5: {
+         const auto count = std::min<MemorySize>(runes.size(), random_position(20));
+         runes.resize(runes.size() - count);
+         text.shrink_by(count);
+         break;
+      }
+      default:
+         break;
+      }
+
+      ASSERT_EQ(text.rune_count(), runes.size());
+      ASSERT_EQ(text.to_std(), encode_runes(runes));
+
+      const auto first = random_position(runes.size());
+      const auto last = first + random_position(runes.size() - first);
+      const std::vector<Rune> expected(runes.begin() + first, runes.begin() + last);
+      ASSERT_EQ(text.subview(static_cast<triglav::i32>(first), static_cast<triglav::i32>(last)).to_std(), encode_runes(expected));
+   }
+
+   // Copies and moves keep the contents consistent with the index.
+   triglav::String copy{text};
+   copy.insert_rune_at(0, "x"_rune);
+   runes.insert(runes.begin(), "x"_rune);
+   triglav::String moved{std::move(copy)};
+   moved.insert_rune_at(static_cast<triglav::u32>(runes.size() / 2), "y"_rune);
+   runes.insert(runes.begin() + static_cast<std::ptrdiff_t>(runes.size() / 2), "y"_rune);
+   ASSERT_EQ(moved.to_std(), encode_runes(runes));
+   ASSERT_EQ(moved.rune_count(), runes.size());
+}
@@ -0,0 +1,140 @@
+#include "triglav/io/AsyncFileReader.hpp"
+#include "triglav/io/CommandLine.hpp"
+#include "triglav/io/File.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <print>
+#include <string>
+#include <vector>
+
+using triglav::MemorySize;
+using triglav::u32;
+using triglav::u8;
+using triglav::io::CommandLine;
+using triglav::io::FileContents;
+using triglav::io::IAsyncFileReader;
+using triglav::io::Path;
+using triglav::io::Result;
+
+using namespace triglav::name_literals;
+
+namespace {
+
+constexpr int g_default_small_file_count = 2000;
+constexpr int g_default_small_file_size = 4 * 1024;
+constexpr int g_default_large_file_count = 16;
+constexpr int g_default_large_file_size = 8 * 1024 * 1024;
+constexpr int g_default_iteration_count = 5;
+constexpr u32 g_threaded_reader_thread_count = 4;
+
+struct FileSet
+{
+   std::vector<Path> paths;
+   MemorySize total_size{};
+};
+
+FileSet write_files(const std::filesystem::path& directory, const std::string& prefix, const int count, const int size)
+{
+   FileSet result;
+   std::filesystem::create_directories(directory);
+
+   FileContents contents(static_cast<MemorySize>(size));
+   for (int i = 0; i < count; ++i) {
+      std::ranges::fill(contents, static_cast<u8>(i));
+      const Path path{(directory / (prefix + std::to_string(i) + ".bin")).string()};
+      auto file = triglav::io::open_file(path, triglav::io::FileMode::Write | triglav::io::FileMode::Create);
+      if (!file.has_value() || (*file)->write(contents) != contents.size()) {
+         std::println(stderr, "failed to write {}", path.string());
+         std::exit(EXIT_FAILURE);
+      }
+      result.paths.emplace_back(path);
+      result.total_size += contents.size();
+   }
+   return result;
+}
+
+template<typename TFunc>
+double measure_seconds(const int iterations, TFunc func)
+{
+   // The first pass warms up the page cache so that every variant reads the same cached files.
+   func();
+
+   const auto start = std::chrono::steady_clock::now();
+   for (int i = 0; i < iterations; ++i) {
+      func();
+   }
+   return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / iterations;
+}
+
+MemorySize read_blocking(const FileSet& files)
+{
+   MemorySize bytes_read{};
+   for (const auto& path : files.paths) {
+      bytes_read += triglav::io::read_whole_file(path).size();
+   }
+   return bytes_read;
+}
+
+MemorySize read_async(IAsyncFileReader& reader, const FileSet& files)
+{
+   std::atomic<MemorySize> bytes_read{};
+   for (const auto& path : files.paths) {
+      reader.read_file(path, [&](Result<FileContents>&& contents) {
+         if (contents.has_value()) {
+            bytes_read.fetch_add(contents->size(), std::memory_order_relaxed);
+         }
+      });
+   }
+   reader.wait_idle();
+   return bytes_read.load();
+}
+
+void run_benchmark(const std::string_view name, const FileSet& files, const int iterations)
+{
+   const auto async_reader = triglav::io::create_async_file_reader();
+   const auto threaded_reader = triglav::io::create_threaded_file_reader(g_threaded_reader_thread_count);
+
+   MemorySize bytes_read{};
+   const auto blocking_seconds = measure_seconds(iterations, [&] { bytes_read = read_blocking(files); });
+   const auto async_seconds = measure_seconds(iterations, [&] { bytes_read = read_async(*async_reader, files); });
+   const auto threaded_seconds = measure_seconds(iterations, [&] { bytes_read = read_async(*threaded_reader, files); });
+
+   const auto mib = static_cast<double>(files.total_size) / (1024.0 * 1024.0);
+   const auto file_count = static_cast<double>(files.paths.size());
+   std::println("{} files, {} files, {:.1f} MiB", name, files.paths.size(), mib);
+   std::println("{:<16} {:>10.1f} MiB/s {:>12.0f} files/s", "blocking", mib / blocking_seconds, file_count / blocking_seconds);
+   std::println("{:<16} {:>10.1f} MiB/s {:>12.0f} files/s", "async", mib / async_seconds, file_count / async_seconds);
+   std::println("{:<16} {:>10.1f} MiB/s {:>12.0f} files/s", "threaded", mib / threaded_seconds, file_count / threaded_seconds);
+
+   if (bytes_read != files.total_size) {
+      std::println(stderr, "read {} bytes, expected {}", bytes_read, files.total_size);
+      std::exit(EXIT_FAILURE);
+   }
+}
+
+}// namespace
+
+int main(const int argc, const char** argv)
+{
+   CommandLine::the().parse(argc, argv);
+
+   const auto small_count = CommandLine::the().arg_int("smallCount"_name).value_or(g_default_small_file_count);
+   const auto small_size = CommandLine::the().arg_int("smallSize"_name).value_or(g_default_small_file_size);
+   const auto large_count = CommandLine::the().arg_int("largeCount"_name).value_or(g_default_large_file_count);
+   const auto large_size = CommandLine::the().arg_int("largeSize"_name).value_or(g_default_large_file_size);
+   const auto iterations = CommandLine::the().arg_int("iterations"_name).value_or(g_default_iteration_count);
+
+   const auto directory = std::filesystem::temp_directory_path() / "triglav_io_benchmark";
+   const auto small_files = write_files(directory / "small", "small_", small_count, small_size);
+   const auto large_files = write_files(directory / "large", "large_", large_count, large_size);
+
+   run_benchmark("Small", small_files, iterations);
+   run_benchmark("Large", large_files, iterations);
+
+   std::filesystem::remove_all(directory);
+   return EXIT_SUCCESS;
+}
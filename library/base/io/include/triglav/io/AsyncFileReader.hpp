@@ -0,0 +1,36 @@
+#pragma once
+
+#include "Path.hpp"
+#include "Result.hpp"
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace triglav::io {
+
+using FileContents = std::vector<u8>;
+using ReadFileCallback = std::function<void(Result<FileContents>&& contents)>;
+
+// Reads whole files in the background with many reads in flight at once.
+// Callbacks run on the reader's own thread and should only hand the contents over.
+class IAsyncFileReader
+{
+ public:
+   virtual ~IAsyncFileReader() = default;
+
+   virtual void read_file(const Path& path, ReadFileCallback callback) = 0;
+   // Blocks until every queued read has completed and its callback returned.
+   virtual void wait_idle() = 0;
+};
+
+using IAsyncFileReaderUPtr = std::unique_ptr<IAsyncFileReader>;
+
+// Reads the whole file with blocking calls.
+[[nodiscard]] Result<FileContents> read_file_contents(const Path& path);
+
+// Uses io_uring where the kernel supports it and falls back to blocking reads on a few threads.
+IAsyncFileReaderUPtr create_async_file_reader();
+IAsyncFileReaderUPtr create_threaded_file_reader(u32 thread_count);
+
+}// namespace triglav::io
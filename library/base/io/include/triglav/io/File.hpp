@@ -20,6 +20,10 @@ class IFile : public ISeekableStream
 {
  public:
    [[nodiscard]] virtual Result<MemorySize> file_size() = 0;
+
+   // Reads from an absolute offset without moving the stream position.
+   // Safe to call concurrently from multiple threads.
+   [[nodiscard]] virtual Result<MemorySize> read_at(std::span<u8> buffer, MemoryOffset offset) const = 0;
 };
 
 using IFileUPtr = std::unique_ptr<IFile>;
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "Stream.hpp"
+
+namespace triglav::io {
+
+// Read-only seekable stream over a memory region.
+class MemoryStream final : public ISeekableStream
+{
+ public:
+   explicit MemoryStream(std::span<const u8> data);
+
+   [[nodiscard]] Result<MemorySize> read(std::span<u8> buffer) override;
+   [[nodiscard]] Result<MemorySize> write(std::span<const u8> buffer) override;
+   [[nodiscard]] Status seek(SeekPosition position, MemoryOffset offset) override;
+   [[nodiscard]] MemorySize position() const override;
+
+ private:
+   std::span<const u8> m_data;
+   MemorySize m_position{};
+};
+
+}// namespace triglav::io
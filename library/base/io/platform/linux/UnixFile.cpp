@@ -130,6 +130,21 @@ Result<MemorySize> UnixFile::file_size()
    return file_stat.st_size;
 }
 
+Result<MemorySize> UnixFile::read_at(const std::span<u8> buffer, const MemoryOffset offset) const
+{
+   MemorySize total_read = 0;
+   while (total_read < buffer.size()) {
+      const auto result = ::pread(m_file_descriptor, buffer.data() + total_read, buffer.size() - total_read,
+                                  static_cast<off_t>(offset + static_cast<MemoryOffset>(total_read)));
+      if (result < 0)
+         return std::unexpected(Status::BrokenPipe);
+      if (result == 0)
+         break;
+      total_read += static_cast<MemorySize>(result);
+   }
+   return total_read;
+}
+
 MemorySize UnixFile::position() const
 {
    const auto res = ::lseek(m_file_descriptor, 0, SEEK_CUR);
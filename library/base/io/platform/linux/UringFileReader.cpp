@@ -0,0 +1,414 @@
+#include "UringFileReader.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+#include <utility>
+
+extern "C"
+{
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+}
+
+namespace triglav::io {
+
+namespace {
+
+constexpr u32 g_default_queue_depth = 64;
+constexpr u32 g_fallback_thread_count = 4;
+// Marks the request used to wake up the completion thread.
+constexpr u64 g_wake_up_user_data = 0;
+
+int io_uring_setup(const u32 entries, io_uring_params* params)
+{
+   return static_cast<int>(::syscall(__NR_io_uring_setup, entries, params));
+}
+
+int io_uring_enter(const int ring_fd, const u32 to_submit, const u32 min_complete, const u32 flags)
+{
+   return static_cast<int>(::syscall(__NR_io_uring_enter, ring_fd, to_submit, min_complete, flags, nullptr, 0));
+}
+
+int io_uring_register(const int ring_fd, const u32 opcode, void* arg, const u32 arg_count)
+{
+   return static_cast<int>(::syscall(__NR_io_uring_register, ring_fd, opcode, arg, arg_count));
+}
+
+template<typename T>
+T* ring_field(void* ring, const u32 offset)
+{
+   return reinterpret_cast<T*>(static_cast<char*>(ring) + offset);
+}
+
+bool supports_required_operations(const int ring_fd)
+{
+   constexpr u32 op_count = 256;
+   std::vector<u8> probe_memory(sizeof(io_uring_probe) + op_count * sizeof(io_uring_probe_op));
+   auto* probe = reinterpret_cast<io_uring_probe*>(probe_memory.data());
+   if (io_uring_register(ring_fd, IORING_REGISTER_PROBE, probe, op_count) < 0)
+      return false;
+
+   for (const auto op : {IORING_OP_NOP, IORING_OP_OPENAT, IORING_OP_STATX, IORING_OP_READ}) {
+      if (op > probe->last_op || !(probe->ops[op].flags & IO_URING_OP_SUPPORTED))
+         return false;
+   }
+   return true;
+}
+
+}// namespace
+
+struct UringFileReader::Request
+{
+   enum class Stage
+   {
+      Open,
+      Stat,
+      Read,
+   };
+
+   std::string path;
+   ReadFileCallback callback;
+   Stage stage{Stage::Open};
+   int file_descriptor{-1};
+   struct ::statx stat{};
+   FileContents contents;
+   MemorySize bytes_read{};
+};
+
+UringFileReader::~UringFileReader()
+{
+   if (m_completion_thread.joinable()) {
+      this->wait_idle();
+      {
+         std::unique_lock lk{m_mutex};
+         m_is_quitting = true;
+         // The completion thread has already exited if the ring failed.
+         if (!m_is_broken) {
+            io_uring_sqe sqe{};
+            sqe.opcode = IORING_OP_NOP;
+            sqe.user_data = g_wake_up_user_data;
+            [[maybe_unused]] const bool pushed = this->push_sqe(sqe);
+            assert(pushed);
+            this->flush_submissions();
+         }
+      }
+      m_completion_thread.join();
+   }
+   m_fallback_reader.reset();
+
+   if (m_sqes != nullptr)
+      ::munmap(m_sqes, m_sqes_size);
+   if (m_cq_ring != nullptr && m_cq_ring != m_sq_ring)
+      ::munmap(m_cq_ring, m_cq_ring_size);
+   if (m_sq_ring != nullptr)
+      ::munmap(m_sq_ring, m_sq_ring_size);
+   if (m_ring_fd >= 0)
+      ::close(m_ring_fd);
+
+   for (auto* request : m_abandoned) {
+      if (request->file_descriptor >= 0) {
+         ::close(request->file_descriptor);
+      }
+      delete request;
+   }
+}
+
+std::unique_ptr<UringFileReader> UringFileReader::create(const u32 queue_depth)
+{
+   std::unique_ptr<UringFileReader> result{new UringFileReader()};
+   if (!result->initialize(queue_depth))
+      return nullptr;
+
+   result->m_completion_thread = std::thread(&UringFileReader::thread_routine, result.get());
+   return result;
+}
+
+bool UringFileReader::initialize(const u32 queue_depth)
+{
+   // Completions are only reaped by the completion thread, so it doesn't need to be interrupted to run completion work.
+   io_uring_params params{.flags = IORING_SETUP_COOP_TASKRUN};
+   m_ring_fd = io_uring_setup(queue_depth, &params);
+   if (m_ring_fd < 0 && errno == EINVAL) {
+      params = {};
+      m_ring_fd = io_uring_setup(queue_depth, &params);
+   }
+   if (m_ring_fd < 0 || !supports_required_operations(m_ring_fd))
+      return false;
+
+   m_queue_depth = params.sq_entries;
+   m_sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(u32);
+   m_cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+   if (params.features & IORING_FEAT_SINGLE_MMAP) {
+      m_sq_ring_size = std::max(m_sq_ring_size, m_cq_ring_size);
+      m_cq_ring_size = m_sq_ring_size;
+   }
+
+   m_sq_ring = ::mmap(nullptr, m_sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ring_fd, IORING_OFF_SQ_RING);
+   if (m_sq_ring == MAP_FAILED) {
+      m_sq_ring = nullptr;
+      return false;
+   }
+
+   if (params.features & IORING_FEAT_SINGLE_MMAP) {
+      m_cq_ring = m_sq_ring;
+   } else {
+      m_cq_ring = ::mmap(nullptr, m_cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ring_fd, IORING_OFF_CQ_RING);
+      if (m_cq_ring == MAP_FAILED) {
+         m_cq_ring = nullptr;
+         return false;
+      }
+   }
+
+   m_sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+   auto* sqes = ::mmap(nullptr, m_sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ring_fd, IORING_OFF_SQES);
+   if (sqes == MAP_FAILED)
+      return false;
+   m_sqes = static_cast<io_uring_sqe*>(sqes);
+
+   m_sq_head = ring_field<u32>(m_sq_ring, params.sq_off.head);
+   m_sq_tail = ring_field<u32>(m_sq_ring, params.sq_off.tail);
+   m_sq_mask = ring_field<u32>(m_sq_ring, params.sq_off.ring_mask);
+   m_sq_array = ring_field<u32>(m_sq_ring, params.sq_off.array);
+   m_cq_head = ring_field<u32>(m_cq_ring, params.cq_off.head);
+   m_cq_tail = ring_field<u32>(m_cq_ring, params.cq_off.tail);
+   m_cq_mask = ring_field<u32>(m_cq_ring, params.cq_off.ring_mask);
+   m_cqes = ring_field<io_uring_cqe>(m_cq_ring, params.cq_off.cqes);
+
+   return true;
+}
+
+void UringFileReader::read_file(const Path& path, ReadFileCallback callback)
+{
+   std::unique_lock lk{m_mutex};
+   if (m_is_broken) {
+      if (m_fallback_reader == nullptr) {
+         m_fallback_reader = create_threaded_file_reader(g_fallback_thread_count);
+      }
+      m_fallback_reader->read_file(path, std::move(callback));
+      return;
+   }
+
+   auto* request = new Request{
+      .path = std::string{path.string()},
+      .callback = std::move(callback),
+   };
+
+   ++m_request_count;
+   this->submit(request);
+   this->flush_submissions();
+}
+
+void UringFileReader::wait_idle()
+{
+   std::unique_lock lk{m_mutex};
+   m_idle_cv.wait(lk, [this] { return m_request_count == 0; });
+
+   if (m_fallback_reader != nullptr) {
+      auto& fallback_reader = *m_fallback_reader;
+      lk.unlock();
+      fallback_reader.wait_idle();
+   }
+}
+
+void UringFileReader::submit(Request* request)
+{
+   // One wake up slot is kept free for the destructor.
+   if (m_in_flight.size() + 1 >= m_queue_depth) {
+      m_pending.emplace_back(request);
+      return;
+   }
+
+   io_uring_sqe sqe{};
+   sqe.user_data = reinterpret_cast<u64>(request);
+
+   switch (request->stage) {
+   case Request::Stage::Open:
+      sqe.opcode = IORING_OP_OPENAT;
+      sqe.fd = AT_FDCWD;
+      sqe.addr = reinterpret_cast<u64>(request->path.c_str());
+      sqe.open_flags = O_RDONLY | O_CLOEXEC;
+      break;
+   case Request::Stage::Stat:
+      sqe.opcode = IORING_OP_STATX;
+      sqe.fd = request->file_descriptor;
+      sqe.addr = reinterpret_cast<u64>("");
+      sqe.len = STATX_SIZE;
+      sqe.off = reinterpret_cast<u64>(&request->stat);
+      sqe.statx_flags = AT_EMPTY_PATH;
+      break;
+   case Request::Stage::Read:
+      sqe.opcode = IORING_OP_READ;
+      sqe.fd = request->file_descriptor;
+      sqe.addr = reinterpret_cast<u64>(request->contents.data() + request->bytes_read);
+      sqe.len = static_cast<u32>(std::min<MemorySize>(request->contents.size() - request->bytes_read, 1u << 30));
+      sqe.off = request->bytes_read;
+      break;
+   }
+
+   [[maybe_unused]] const bool pushed = this->push_sqe(sqe);
+   assert(pushed);
+   m_in_flight.insert(request);
+}
+
+void UringFileReader::submit_pending()
+{
+   while (!m_pending.empty() && m_in_flight.size() + 1 < m_queue_depth) {
+      auto* request = m_pending.front();
+      m_pending.pop_front();
+      this->submit(request);
+   }
+}
+
+bool UringFileReader::push_sqe(const io_uring_sqe& sqe)
+{
+   const auto tail = *m_sq_tail;
+   const auto head = std::atomic_ref{*m_sq_head}.load(std::memory_order_acquire);
+   if (tail - head >= m_queue_depth)
+      return false;
+
+   const auto index = tail & *m_sq_mask;
+   m_sqes[index] = sqe;
+   m_sq_array[index] = index;
+   std::atomic_ref{*m_sq_tail}.store(tail + 1, std::memory_order_release);
+   ++m_unsubmitted_count;
+   return true;
+}
+
+void UringFileReader::flush_submissions()
+{
+   if (m_unsubmitted_count == 0)
+      return;
+
+   // The kernel only consumes entries that are in the ring, so asking for more after an interrupted call is harmless.
+   if (io_uring_enter(m_ring_fd, m_unsubmitted_count, 0, 0) >= 0) {
+      m_unsubmitted_count = 0;
+   }
+}
+
+void UringFileReader::on_completion(Request* request, const i32 result)
+{
+   m_in_flight.erase(request);
+
+   if (result < 0) {
+      this->finish(request, std::unexpected{request->stage == Request::Stage::Read ? Status::BrokenPipe : Status::InvalidFile});
+      return;
+   }
+
+   switch (request->stage) {
+   case Request::Stage::Open:
+      request->file_descriptor = result;
+      request->stage = Request::Stage::Stat;
+      break;
+   case Request::Stage::Stat:
+      if (request->stat.stx_size == 0) {
+         this->finish(request, FileContents{});
+         return;
+      }
+      request->contents.resize(request->stat.stx_size);
+      request->stage = Request::Stage::Read;
+      break;
+   case Request::Stage::Read:
+      request->bytes_read += static_cast<MemorySize>(result);
+      if (result == 0 || request->bytes_read == request->contents.size()) {
+         request->contents.resize(request->bytes_read);
+         this->finish(request, std::move(request->contents));
+         return;
+      }
+      break;
+   }
+
+   this->submit(request);
+}
+
+void UringFileReader::finish(Request* request, Result<FileContents>&& result)
+{
+   if (request->file_descriptor >= 0) {
+      ::close(request->file_descriptor);
+   }
+
+   const std::unique_ptr<Request> owned_request{request};
+   m_mutex.unlock();
+   owned_request->callback(std::move(result));
+   m_mutex.lock();
+
+   if (--m_request_count == 0) {
+      m_idle_cv.notify_all();
+   }
+}
+
+void UringFileReader::fail_requests()
+{
+   std::unique_lock lk{m_mutex};
+   m_is_broken = true;
+
+   std::vector<ReadFileCallback> callbacks;
+   for (auto* request : m_in_flight) {
+      callbacks.emplace_back(std::move(request->callback));
+      m_abandoned.emplace_back(request);
+   }
+   m_in_flight.clear();
+
+   for (auto* request : m_pending) {
+      callbacks.emplace_back(std::move(request->callback));
+      delete request;
+   }
+   m_pending.clear();
+
+   lk.unlock();
+   for (auto& callback : callbacks) {
+      callback(std::unexpected{Status::BrokenPipe});
+   }
+   lk.lock();
+
+   m_request_count -= static_cast<u32>(callbacks.size());
+   m_idle_cv.notify_all();
+}
+
+void UringFileReader::thread_routine()
+{
+   // Entries queued while processing completions are submitted with the same call that waits for the next ones.
+   u32 to_submit = 0;
+   while (true) {
+      if (io_uring_enter(m_ring_fd, to_submit, 1, IORING_ENTER_GETEVENTS) >= 0) {
+         to_submit = 0;
+      } else if (errno != EINTR) {
+         this->fail_requests();
+         return;
+      }
+
+      std::unique_lock lk{m_mutex};
+
+      auto head = *m_cq_head;
+      while (head != std::atomic_ref{*m_cq_tail}.load(std::memory_order_acquire)) {
+         const auto cqe = m_cqes[head & *m_cq_mask];
+         ++head;
+         std::atomic_ref{*m_cq_head}.store(head, std::memory_order_release);
+
+         if (cqe.user_data == g_wake_up_user_data)
+            continue;
+
+         this->on_completion(reinterpret_cast<Request*>(cqe.user_data), cqe.res);
+      }
+
+      this->submit_pending();
+      to_submit += std::exchange(m_unsubmitted_count, 0);
+
+      if (m_is_quitting && m_request_count == 0)
+         return;
+   }
+}
+
+IAsyncFileReaderUPtr create_async_file_reader()
+{
+   if (auto reader = UringFileReader::create(g_default_queue_depth); reader != nullptr) {
+      return reader;
+   }
+   return create_threaded_file_reader(g_fallback_thread_count);
+}
+
+}// namespace triglav::io
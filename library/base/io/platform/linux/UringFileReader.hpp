@@ -0,0 +1,84 @@
+#pragma once
+
+#include "AsyncFileReader.hpp"
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+extern "C"
+{
+#include <linux/io_uring.h>
+#include <linux/stat.h>
+}
+
+namespace triglav::io {
+
+// Opens, stats and reads files through io_uring, so all reads of a batch wait on the disk at the same time.
+// Submissions may come from any thread, completions are processed on a single thread which runs the callbacks.
+// If the ring fails, outstanding reads fail with an error and new reads go through the threaded reader.
+class UringFileReader final : public IAsyncFileReader
+{
+ public:
+   struct Request;
+
+   ~UringFileReader() override;
+
+   // Returns nullptr if io_uring isn't available or lacks the required operations.
+   [[nodiscard]] static std::unique_ptr<UringFileReader> create(u32 queue_depth);
+
+   void read_file(const Path& path, ReadFileCallback callback) override;
+   void wait_idle() override;
+
+ private:
+   UringFileReader() = default;
+
+   [[nodiscard]] bool initialize(u32 queue_depth);
+   void submit(Request* request);
+   void submit_pending();
+   [[nodiscard]] bool push_sqe(const io_uring_sqe& sqe);
+   void flush_submissions();
+   void on_completion(Request* request, i32 result);
+   void finish(Request* request, Result<FileContents>&& result);
+   void fail_requests();
+   void thread_routine();
+
+   int m_ring_fd{-1};
+   u32 m_queue_depth{};
+   void* m_sq_ring{};
+   MemorySize m_sq_ring_size{};
+   void* m_cq_ring{};
+   MemorySize m_cq_ring_size{};
+   io_uring_sqe* m_sqes{};
+   MemorySize m_sqes_size{};
+
+   u32* m_sq_head{};
+   u32* m_sq_tail{};
+   u32* m_sq_mask{};
+   u32* m_sq_array{};
+   u32* m_cq_head{};
+   u32* m_cq_tail{};
+   u32* m_cq_mask{};
+   io_uring_cqe* m_cqes{};
+
+   std::mutex m_mutex;
+   std::condition_variable m_idle_cv;
+   // Requests waiting for a free submission slot, the ring never holds more than queue depth operations.
+   std::deque<Request*> m_pending;
+   std::unordered_set<Request*> m_in_flight;
+   // Requests that were in the ring when it failed, the kernel may still write to them until the ring is closed.
+   std::vector<Request*> m_abandoned;
+   IAsyncFileReaderUPtr m_fallback_reader;
+   u32 m_unsubmitted_count{};
+   u32 m_request_count{};
+   bool m_is_quitting{};
+   bool m_is_broken{};
+   std::thread m_completion_thread;
+};
+
+}// namespace triglav::io
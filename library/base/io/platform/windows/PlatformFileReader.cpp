@@ -0,0 +1,16 @@
+#include "AsyncFileReader.hpp"
+
+namespace triglav::io {
+
+namespace {
+
+constexpr u32 g_reader_thread_count = 4;
+
+}
+
+IAsyncFileReaderUPtr create_async_file_reader()
+{
+   return create_threaded_file_reader(g_reader_thread_count);
+}
+
+}// namespace triglav::io
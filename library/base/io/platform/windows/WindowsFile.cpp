@@ -158,6 +158,20 @@ Result<MemorySize> WindowsFile::file_size()
    return static_cast<MemorySize>(file_size_high) << 32 | static_cast<MemorySize>(res);
 }
 
+Result<MemorySize> WindowsFile::read_at(const std::span<u8> buffer, const MemoryOffset offset) const
+{
+   OVERLAPPED overlapped{};
+   overlapped.Offset = static_cast<DWORD>(static_cast<u64>(offset) & 0xFFFFFFFF);
+   overlapped.OffsetHigh = static_cast<DWORD>(static_cast<u64>(offset) >> 32);
+
+   DWORD bytes_read{};
+   const auto res = ReadFile(hfile_to_handle(m_file), buffer.data(), static_cast<DWORD>(buffer.size()), &bytes_read, &overlapped);
+   if (not res && GetLastError() != ERROR_HANDLE_EOF) {
+      return std::unexpected(Status::BrokenPipe);
+   }
+   return static_cast<MemorySize>(bytes_read);
+}
+
 MemorySize WindowsFile::position() const
 {
    const auto res = SetFilePointer(hfile_to_handle(m_file), 0, nullptr, FILE_CURRENT);
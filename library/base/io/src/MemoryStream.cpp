@@ -0,0 +1,59 @@
+#include "MemoryStream.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace triglav::io {
+
+MemoryStream::MemoryStream(const std::span<const u8> data) :
+    m_data(data)
+{
+}
+
+Result<MemorySize> MemoryStream::read(const std::span<u8> buffer)
+{
+   const auto read_size = std::min(buffer.size(), m_data.size() - m_position);
+   if (read_size == 0) {
+      return 0;
+   }
+
+   std::memcpy(buffer.data(), m_data.data() + m_position, read_size);
+   m_position += read_size;
+   return read_size;
+}
+
+Result<MemorySize> MemoryStream::write(const std::span<const u8> /*buffer*/)
+{
+   return std::unexpected(Status::BrokenPipe);
+}
+
+Status MemoryStream::seek(const SeekPosition position, const MemoryOffset offset)
+{
+   MemoryOffset base{};
+   switch (position) {
+   case SeekPosition::Begin:
+      base = 0;
+      break;
+   case SeekPosition::Current:
+      base = static_cast<MemoryOffset>(m_position);
+      break;
+   case SeekPosition::End:
+      base = static_cast<MemoryOffset>(m_data.size());
+      break;
+   }
+
+   const auto new_position = base + offset;
+   if (new_position < 0) {
+      return Status::BrokenPipe;
+   }
+
+   m_position = std::min(static_cast<MemorySize>(new_position), m_data.size());
+   return Status::Success;
+}
+
+MemorySize MemoryStream::position() const
+{
+   return m_position;
+}
+
+}// namespace triglav::io
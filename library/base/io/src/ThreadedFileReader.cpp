@@ -0,0 +1,89 @@
+#include "ThreadedFileReader.hpp"
+
+#include "File.hpp"
+
+namespace triglav::io {
+
+Result<FileContents> read_file_contents(const Path& path)
+{
+   const auto file = open_file(path, FileMode::Read);
+   if (!file.has_value())
+      return std::unexpected{file.error()};
+
+   const auto file_size = (*file)->file_size();
+   if (!file_size.has_value())
+      return std::unexpected{file_size.error()};
+
+   FileContents result(*file_size);
+   const auto bytes_read = (*file)->read_at(result, 0);
+   if (!bytes_read.has_value())
+      return std::unexpected{bytes_read.error()};
+
+   result.resize(*bytes_read);
+   return result;
+}
+
+ThreadedFileReader::ThreadedFileReader(const u32 thread_count)
+{
+   m_threads.reserve(thread_count);
+   for (u32 i = 0; i < thread_count; ++i) {
+      m_threads.emplace_back(&ThreadedFileReader::thread_routine, this);
+   }
+}
+
+ThreadedFileReader::~ThreadedFileReader()
+{
+   {
+      std::unique_lock lk{m_mutex};
+      m_is_quitting = true;
+   }
+   m_queue_cv.notify_all();
+
+   for (auto& thread : m_threads) {
+      thread.join();
+   }
+}
+
+void ThreadedFileReader::read_file(const Path& path, ReadFileCallback callback)
+{
+   {
+      std::unique_lock lk{m_mutex};
+      m_queue.emplace_back(path, std::move(callback));
+      ++m_pending_count;
+   }
+   m_queue_cv.notify_one();
+}
+
+void ThreadedFileReader::wait_idle()
+{
+   std::unique_lock lk{m_mutex};
+   m_idle_cv.wait(lk, [this] { return m_pending_count == 0; });
+}
+
+void ThreadedFileReader::thread_routine()
+{
+   std::unique_lock lk{m_mutex};
+   while (true) {
+      m_queue_cv.wait(lk, [this] { return m_is_quitting || !m_queue.empty(); });
+      if (m_queue.empty())
+         return;
+
+      auto [path, callback] = std::move(m_queue.front());
+      m_queue.pop_front();
+      lk.unlock();
+
+      callback(read_file_contents(path));
+
+      lk.lock();
+      if (--m_pending_count == 0) {
+         m_idle_cv.notify_all();
+      }
+   }
+}
+
+IAsyncFileReaderUPtr create_threaded_file_reader(const u32 thread_count)
+{
+   return std::make_unique<ThreadedFileReader>(thread_count);
+}
+
+}// namespace triglav::io
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "AsyncFileReader.hpp"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace triglav::io {
+
+// Reads files with blocking calls on dedicated threads, so workers decoding the files aren't held up by the disk.
+class ThreadedFileReader final : public IAsyncFileReader
+{
+ public:
+   explicit ThreadedFileReader(u32 thread_count);
+   ~ThreadedFileReader() override;
+
+   void read_file(const Path& path, ReadFileCallback callback) override;
+   void wait_idle() override;
+
+ private:
+   void thread_routine();
+
+   std::vector<std::thread> m_threads;
+   std::deque<std::pair<Path, ReadFileCallback>> m_queue;
+   std::mutex m_mutex;
+   std::condition_variable m_queue_cv;
+   std::condition_variable m_idle_cv;
+   u32 m_pending_count{};
+   bool m_is_quitting{};
+};
+
+}// namespace triglav::io
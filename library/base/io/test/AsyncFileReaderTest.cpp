@@ -0,0 +1,150 @@
+#include "triglav/io/AsyncFileReader.hpp"
+#include "triglav/io/File.hpp"
+#include "triglav/testing_core/GTest.hpp"
+
+#include <atomic>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using triglav::MemorySize;
+using triglav::u32;
+using triglav::u8;
+using triglav::io::FileContents;
+using triglav::io::FileMode;
+using triglav::io::IAsyncFileReaderUPtr;
+using triglav::io::Path;
+using triglav::io::Result;
+
+namespace {
+
+using ReaderFactory = IAsyncFileReaderUPtr (*)();
+
+IAsyncFileReaderUPtr create_threaded_reader()
+{
+   return triglav::io::create_threaded_file_reader(2);
+}
+
+FileContents make_contents(const MemorySize size, const u32 seed)
+{
+   FileContents result(size);
+   for (MemorySize i = 0; i < size; ++i) {
+      result[i] = static_cast<u8>((i * 31 + seed * 17) % 251);
+   }
+   return result;
+}
+
+class AsyncFileReaderTest : public testing::TestWithParam<ReaderFactory>
+{
+ protected:
+   void SetUp() override
+   {
+      m_directory = std::filesystem::temp_directory_path() / "triglav_async_reader_test";
+      std::filesystem::create_directories(m_directory);
+   }
+
+   void TearDown() override
+   {
+      std::filesystem::remove_all(m_directory);
+   }
+
+   Path write_file(const std::string& name, const FileContents& contents) const
+   {
+      const Path path{(m_directory / name).string()};
+      auto file = triglav::io::open_file(path, FileMode::Write | FileMode::Create);
+      EXPECT_TRUE(file.has_value());
+      EXPECT_EQ((*file)->write(contents), contents.size());
+      return path;
+   }
+
+   std::filesystem::path m_directory;
+};
+
+}// namespace
+
+TEST_P(AsyncFileReaderTest, ReadsFileContents)
+{
+   const auto contents = make_contents(100'000, 1);
+   const auto path = this->write_file("file.bin", contents);
+
+   Result<FileContents> result;
+   const auto reader = GetParam()();
+   reader->read_file(path, [&](Result<FileContents>&& read_contents) { result = std::move(read_contents); });
+   reader->wait_idle();
+
+   ASSERT_TRUE(result.has_value());
+   ASSERT_EQ(*result, contents);
+}
+
+TEST_P(AsyncFileReaderTest, ReadsEmptyFile)
+{
+   const auto path = this->write_file("empty.bin", {});
+
+   Result<FileContents> result = std::unexpected{triglav::io::Status::BrokenPipe};
+   const auto reader = GetParam()();
+   reader->read_file(path, [&](Result<FileContents>&& read_contents) { result = std::move(read_contents); });
+   reader->wait_idle();
+
+   ASSERT_TRUE(result.has_value());
+   ASSERT_TRUE(result->empty());
+}
+
+TEST_P(AsyncFileReaderTest, MissingFileFails)
+{
+   Result<FileContents> result;
+   const auto reader = GetParam()();
+   reader->read_file(Path{(m_directory / "missing.bin").string()},
+                     [&](Result<FileContents>&& read_contents) { result = std::move(read_contents); });
+   reader->wait_idle();
+
+   ASSERT_FALSE(result.has_value());
+}
+
+TEST_P(AsyncFileReaderTest, ReadsManyFilesAtOnce)
+{
+   // More files than the io_uring queue holds, so some reads wait for a free slot.
+   constexpr u32 file_count = 300;
+
+   std::vector<FileContents> expected;
+   std::vector<Path> paths;
+   for (u32 i = 0; i < file_count; ++i) {
+      expected.emplace_back(make_contents(1 + (i * 997) % 20'000, i));
+      paths.emplace_back(this->write_file("file_" + std::to_string(i) + ".bin", expected.back()));
+   }
+
+   std::vector<FileContents> actual(file_count);
+   std::atomic<u32> success_count{};
+   const auto reader = GetParam()();
+   for (u32 i = 0; i < file_count; ++i) {
+      reader->read_file(paths[i], [&, i](Result<FileContents>&& read_contents) {
+         if (read_contents.has_value()) {
+            actual[i] = std::move(*read_contents);
+            success_count.fetch_add(1, std::memory_order_relaxed);
+         }
+      });
+   }
+   reader->wait_idle();
+
+   ASSERT_EQ(success_count.load(), file_count);
+   ASSERT_EQ(actual, expected);
+}
+
+TEST_P(AsyncFileReaderTest, CallbackCanQueueReads)
+{
+   const auto first_path = this->write_file("first.bin", make_contents(10, 1));
+   const auto second_contents = make_contents(20, 2);
+   const auto second_path = this->write_file("second.bin", second_contents);
+
+   Result<FileContents> result;
+   const auto reader = GetParam()();
+   reader->read_file(first_path, [&](Result<FileContents>&&) {
+      reader->read_file(second_path, [&](Result<FileContents>&& read_contents) { result = std::move(read_contents); });
+   });
+   reader->wait_idle();
+
+   ASSERT_TRUE(result.has_value());
+   ASSERT_EQ(*result, second_contents);
+}
+
+INSTANTIATE_TEST_SUITE_P(IO, AsyncFileReaderTest, testing::Values(&triglav::io::create_async_file_reader, &create_threaded_reader));
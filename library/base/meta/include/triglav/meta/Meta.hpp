@@ -132,6 +132,8 @@ struct TypeRegisterer
 };
 
 class ClassRef;
+class MemberTable;
+class RegisteredType;
 class ArrayRef;
 class MapRef;
 class OptionalRef;
@@ -240,6 +242,8 @@ class PropertyRef
    [[nodiscard]] bool is_lvalue_ref() const;
 
    [[nodiscard]] Ref to_ref() const;
+   // Address of the value, unavailable for indirect properties that aren't references.
+   [[nodiscard]] void* value_handle() const;
    [[nodiscard]] ClassRef to_class_ref() const;
    [[nodiscard]] ArrayRef to_array_ref() const;
    [[nodiscard]] MapRef to_map_ref() const;
@@ -331,6 +335,7 @@ class EnumRef : public PropertyRef
 {
  public:
    EnumRef(void* handle, const Member* member);
+   EnumRef(void* handle, const Member* member, std::span<Member> members);
 
    [[nodiscard]] std::string_view string() const;
    [[nodiscard]] int value() const;
@@ -406,6 +411,7 @@ class ClassRef : public Ref
  public:
    ClassRef(void* handle, Name name, std::span<Member> members);
    ClassRef(void* handle, Name name);
+   ClassRef(void* handle, const RegisteredType& type);
 
    [[nodiscard]] const Member* find_member(Name name) const;
 
@@ -457,6 +463,7 @@ class ClassRef : public Ref
 
  protected:
    std::span<Member> m_members;
+   const MemberTable* m_member_table;
 };
 
 class Box : public ClassRef
@@ -2,11 +2,71 @@
 
 #include "Meta.hpp"
 
-#include <map>
+#include <mutex>
+#include <span>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace triglav::meta {
 
+class RegisteredType;
+
+// Finds members by name with a hash of the name that is collision-free within the type.
+class MemberTable
+{
+ public:
+   MemberTable() = default;
+   explicit MemberTable(std::span<const Member> members);
+
+   [[nodiscard]] const Member* find(Name name) const;
+
+ private:
+   std::span<const Member> m_members;
+   std::vector<const Member*> m_slots;
+   u32 m_shift{};
+};
+
+// Property of a class resolved up front, so traversing instances requires no lookups.
+struct PropertyPlan
+{
+   const Member* member;
+   RefKind kind;
+   // Type of the property, or of the contained values for arrays, maps and optionals.
+   const RegisteredType* type;
+   // Only set for maps.
+   const RegisteredType* key_type;
+};
+
+class RegisteredType
+{
+ public:
+   explicit RegisteredType(Type type);
+
+   [[nodiscard]] const Type& info() const;
+   [[nodiscard]] Name name() const;
+   [[nodiscard]] RefKind kind() const;
+   [[nodiscard]] const Member* find_member(Name name) const;
+   [[nodiscard]] const Member* self_member() const;
+   [[nodiscard]] const MemberTable& member_table() const;
+
+   // Plan of the value as a whole, through the self member.
+   [[nodiscard]] PropertyPlan self_plan() const;
+   // Properties of the class in declaration order excluding self, resolved on first use.
+   [[nodiscard]] std::span<const PropertyPlan> property_plan() const;
+   [[nodiscard]] const PropertyPlan* find_property_plan(Name name) const;
+
+ private:
+   Type m_type;
+   Name m_name;
+   MemberTable m_member_table;
+   const Member* m_self_member;
+   mutable std::once_flag m_property_plan_flag;
+   mutable std::vector<PropertyPlan> m_property_plan;
+   // Index into the plan for each member.
+   mutable std::vector<u32> m_property_plan_index;
+};
+
 class TypeRegistry
 {
  public:
@@ -15,9 +75,12 @@ class TypeRegistry
 
    static TypeRegistry& the();
    [[nodiscard]] const Type& type_info(Name type_name) const;
+   [[nodiscard]] const RegisteredType& registered_type(Name type_name) const;
+   [[nodiscard]] const RegisteredType* find_type(Name type_name) const;
 
  private:
-   std::map<Name, Type> m_types;
+   // Entries keep their address, refs and plans point to them.
+   std::unordered_map<Name, RegisteredType> m_types;
 };
 
-}// namespace triglav::meta
\ No newline at end of file
+}// namespace triglav::meta
@@ -23,6 +23,7 @@ Box& Box::operator=(const Box& other)
 {
    dynamic_cast<Ref&>(*this) = Ref{other.checked_call<void*>("copy"_name, other.raw_handle()), other.type()};
    m_members = other.m_members;
+   m_member_table = other.m_member_table;
    return *this;
 }
 
@@ -40,18 +40,16 @@ ClassRef Ref::to_class_ref() const
 
 PropertyRef Ref::to_property_ref() const
 {
-   const auto& info = TypeRegistry::the().type_info(m_type);
-   const auto it = std::ranges::find_if(info.members, [](const Member& member) { return member.name == "self"_name; });
-   assert(it != info.members.end());
-   return {m_handle, &(*it)};
+   const auto* self = TypeRegistry::the().registered_type(m_type).self_member();
+   assert(self != nullptr);
+   return {m_handle, self};
 }
 
 EnumRef Ref::to_enum_ref() const
 {
-   const auto& info = TypeRegistry::the().type_info(m_type);
-   const auto it = std::ranges::find_if(info.members, [](const Member& member) { return member.name == "self"_name; });
-   assert(it != info.members.end());
-   return {m_handle, &(*it)};
+   const auto& type = TypeRegistry::the().registered_type(m_type);
+   assert(type.self_member() != nullptr);
+   return {m_handle, type.self_member(), type.info().members};
 }
 
 PropertyRef::PropertyRef(void* handle, const Member* member) :
@@ -100,16 +98,14 @@ Ref PropertyRef::to_ref() const
    return {m_handle, m_member->property.type_name};
 }
 
-ClassRef PropertyRef::to_class_ref() const
+void* PropertyRef::value_handle() const
 {
    if (!(m_member->role_flags & MemberRole::Indirect)) {
-      return {static_cast<char*>(m_handle) + m_member->property.offset.offset, m_member->property.type_name,
-              TypeRegistry::the().type_info(m_member->property.type_name).members};
+      return static_cast<char*>(m_handle) + m_member->property.offset.offset;
    }
 
    if (m_member->role_flags & MemberRole::Reference) {
-      return {const_cast<void*>(reinterpret_cast<const void* (*)(void*)>(m_member->property.indirect.get)(m_handle)),
-              m_member->property.type_name, TypeRegistry::the().type_info(m_member->property.type_name).members};
+      return const_cast<void*>(reinterpret_cast<const void* (*)(void*)>(m_member->property.indirect.get)(m_handle));
    }
 
    // unsupported
@@ -117,6 +113,11 @@ ClassRef PropertyRef::to_class_ref() const
    std::unreachable();
 }
 
+ClassRef PropertyRef::to_class_ref() const
+{
+   return {this->value_handle(), m_member->property.type_name};
+}
+
 ArrayRef PropertyRef::to_array_ref() const
 {
    return ArrayRef{m_handle, m_member->property.type_name, m_member->property.array};
@@ -189,6 +190,12 @@ EnumRef::EnumRef(void* handle, const Member* member) :
 {
 }
 
+EnumRef::EnumRef(void* handle, const Member* member, const std::span<Member> members) :
+    PropertyRef(handle, member),
+    m_members(members)
+{
+}
+
 std::string_view EnumRef::string() const
 {
    int enum_value = this->value();
@@ -278,17 +285,32 @@ std::optional<PropertyRef> PropertyIterator::next()
 
 ClassRef::ClassRef(void* handle, const Name type, const std::span<Member> members) :
     Ref(handle, type),
-    m_members(members)
+    m_members(members),
+    m_member_table(nullptr)
 {
+   if (const auto* registered_type = TypeRegistry::the().find_type(type); registered_type != nullptr) {
+      m_member_table = &registered_type->member_table();
+   }
 }
 
 ClassRef::ClassRef(void* handle, const Name name) :
-    ClassRef(handle, name, TypeRegistry::the().type_info(name).members)
+    ClassRef(handle, TypeRegistry::the().registered_type(name))
+{
+}
+
+ClassRef::ClassRef(void* handle, const RegisteredType& type) :
+    Ref(handle, type.name()),
+    m_members(type.info().members),
+    m_member_table(&type.member_table())
 {
 }
 
 const Member* ClassRef::find_member(const Name name) const
 {
+   if (m_member_table != nullptr) {
+      return m_member_table->find(name);
+   }
+
    const auto it = std::ranges::find_if(m_members, [name](const Member& member) { return member.name == name; });
    if (it == m_members.end())
       return nullptr;
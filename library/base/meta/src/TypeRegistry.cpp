@@ -1,18 +1,170 @@
 #include "TypeRegistry.hpp"
 
+#include <algorithm>
+#include <bit>
+#include <cassert>
+
 namespace triglav::meta {
 
 using namespace name_literals;
 
+namespace {
+
+// Larger tables give up on the hash and fall back to a linear search.
+constexpr MemorySize g_max_member_table_scale = 64;
+constexpr u32 g_no_property_plan = ~0u;
+
+u64 member_slot(const Name name, const u32 shift, const MemorySize slot_count)
+{
+   return (name >> shift) & (slot_count - 1);
+}
+
+}// namespace
+
+MemberTable::MemberTable(const std::span<const Member> members) :
+    m_members(members)
+{
+   std::vector<const Member*> unique_members;
+   for (const auto& member : members) {
+      // Like the linear search, the first member with a given name wins.
+      if (std::ranges::none_of(unique_members, [&](const Member* other) { return other->name == member.name; })) {
+         unique_members.emplace_back(&member);
+      }
+   }
+
+   const auto min_slot_count = std::bit_ceil(std::max<MemorySize>(unique_members.size(), 1));
+   for (auto slot_count = min_slot_count; slot_count <= min_slot_count * g_max_member_table_scale; slot_count *= 2) {
+      const auto slot_bits = static_cast<u32>(std::countr_zero(slot_count));
+      for (u32 shift = 0; shift < 64 && shift + slot_bits <= 64; ++shift) {
+         std::vector<const Member*> slots(slot_count);
+         const bool has_collision = std::ranges::any_of(unique_members, [&](const Member* member) {
+            auto& slot = slots[member_slot(member->name, shift, slot_count)];
+            if (slot != nullptr)
+               return true;
+            slot = member;
+            return false;
+         });
+         if (!has_collision) {
+            m_slots = std::move(slots);
+            m_shift = shift;
+            return;
+         }
+      }
+   }
+}
+
+const Member* MemberTable::find(const Name name) const
+{
+   if (m_slots.empty()) {
+      const auto it = std::ranges::find_if(m_members, [name](const Member& member) { return member.name == name; });
+      return it != m_members.end() ? &(*it) : nullptr;
+   }
+
+   const auto* member = m_slots[member_slot(name, m_shift, m_slots.size())];
+   return member != nullptr && member->name == name ? member : nullptr;
+}
+
+RegisteredType::RegisteredType(Type type) :
+    m_type(std::move(type)),
+    m_name(make_name_id(m_type.name)),
+    m_member_table(m_type.members),
+    m_self_member(m_member_table.find("self"_name))
+{
+}
+
+const Type& RegisteredType::info() const
+{
+   return m_type;
+}
+
+Name RegisteredType::name() const
+{
+   return m_name;
+}
+
+RefKind RegisteredType::kind() const
+{
+   switch (m_type.variant) {
+   case TypeVariant::Primitive:
+      return RefKind::Primitive;
+   case TypeVariant::Class:
+      return RefKind::Class;
+   case TypeVariant::Enum:
+      return RefKind::Enum;
+   }
+   std::unreachable();
+}
+
+const Member* RegisteredType::find_member(const Name name) const
+{
+   return m_member_table.find(name);
+}
+
+const Member* RegisteredType::self_member() const
+{
+   return m_self_member;
+}
+
+const MemberTable& RegisteredType::member_table() const
+{
+   return m_member_table;
+}
+
+PropertyPlan RegisteredType::self_plan() const
+{
+   return {m_self_member, this->kind(), this, nullptr};
+}
+
+std::span<const PropertyPlan> RegisteredType::property_plan() const
+{
+   // Other types may not be registered yet when this one is, so the plan is resolved lazily.
+   std::call_once(m_property_plan_flag, [this] {
+      const auto& registry = TypeRegistry::the();
+      m_property_plan_index.resize(m_type.members.size(), g_no_property_plan);
+      for (const auto& member : m_type.members) {
+         if (!(member.role_flags & MemberRole::Property) || &member == m_self_member)
+            continue;
+
+         m_property_plan_index[&member - m_type.members.data()] = static_cast<u32>(m_property_plan.size());
+
+         const auto* type = registry.find_type(member.property.type_name);
+         PropertyPlan plan{&member, RefKind::Primitive, type, nullptr};
+         if (member.role_flags & MemberRole::Array) {
+            plan.kind = RefKind::Array;
+         } else if (member.role_flags & MemberRole::Map) {
+            plan.kind = RefKind::Map;
+            plan.key_type = registry.find_type(member.property.map.key_type);
+         } else if (member.role_flags & MemberRole::Optional) {
+            plan.kind = RefKind::Optional;
+         } else if (type != nullptr) {
+            plan.kind = type->kind();
+         }
+         m_property_plan.emplace_back(plan);
+      }
+   });
+   return m_property_plan;
+}
+
+const PropertyPlan* RegisteredType::find_property_plan(const Name name) const
+{
+   const auto plan = this->property_plan();
+   const auto* member = m_member_table.find(name);
+   if (member == nullptr)
+      return nullptr;
+
+   const auto index = m_property_plan_index[member - m_type.members.data()];
+   return index != g_no_property_plan ? &plan[index] : nullptr;
+}
 
 void TypeRegistry::register_type(Type tp)
 {
-   m_types.emplace(make_name_id(tp.name), std::move(tp));
+   const auto name = make_name_id(tp.name);
+   m_types.try_emplace(name, std::move(tp));
 }
 
 Box TypeRegistry::create_box(const Name type) const
 {
-   const auto& ty = m_types.at(type);
+   const auto& ty = this->type_info(type);
    return {ty.factory(), type, ty.members};
 }
 
@@ -26,8 +178,19 @@ TypeRegistry& TypeRegistry::the()
 }
 
 const Type& TypeRegistry::type_info(const Name type_name) const
+{
+   return this->registered_type(type_name).info();
+}
+
+const RegisteredType& TypeRegistry::registered_type(const Name type_name) const
 {
    return m_types.at(type_name);
 }
 
+const RegisteredType* TypeRegistry::find_type(const Name type_name) const
+{
+   const auto it = m_types.find(type_name);
+   return it != m_types.end() ? &it->second : nullptr;
+}
+
 }// namespace triglav::meta
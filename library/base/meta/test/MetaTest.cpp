@@ -215,3 +215,42 @@ TEST(MetaTest, BasicType)
    }
    ASSERT_EQ(example_namespace::ExampleClass::instance_count, 0);
 }
+
+TEST(MetaTest, MemberTableFindsEveryMember)
+{
+   const auto& type = triglav::meta::TypeRegistry::the().registered_type("example_namespace::ExampleClass"_name);
+   for (const auto& member : type.info().members) {
+      ASSERT_EQ(type.find_member(member.name), &member);
+   }
+   ASSERT_EQ(type.find_member("missing_member"_name), nullptr);
+
+   example_namespace::ExampleClass example;
+   example.m_value = 7;
+   ASSERT_EQ(example.to_meta_ref().property<int>("m_value"_name), 7);
+}
+
+TEST(MetaTest, PropertyPlanMatchesProperties)
+{
+   example_namespace::ExampleClass example;
+   const auto obj_ref = example.to_meta_ref();
+   const auto& type = triglav::meta::TypeRegistry::the().registered_type("example_namespace::ExampleClass"_name);
+   const auto plan = type.property_plan();
+
+   std::size_t index = 0;
+   for (const auto property : obj_ref.properties()) {
+      ASSERT_LT(index, plan.size());
+      ASSERT_EQ(plan[index].member->name, property.name());
+      ASSERT_EQ(plan[index].kind, property.ref_kind());
+      ++index;
+   }
+   ASSERT_EQ(index, plan.size());
+
+   const auto& data_plan = plan[1];
+   ASSERT_EQ(data_plan.kind, triglav::meta::RefKind::Class);
+   ASSERT_EQ(data_plan.type->name(), "example_namespace::ExampleStruct"_name);
+
+   const auto& map_plan = plan[6];
+   ASSERT_EQ(map_plan.kind, triglav::meta::RefKind::Map);
+   ASSERT_EQ(map_plan.type->name(), "int"_name);
+   ASSERT_EQ(map_plan.key_type->name(), "std::string"_name);
+}
@@ -30,6 +30,9 @@ class ThreadPool
 
    void initialize(u32 count);
    void issue_job(Job&& job);
+   // Calls func for each index in [0, count) on the pool and the calling thread, returns once all calls finish.
+   // Runs serially if the pool has no threads.
+   void parallel_for(u32 count, const std::function<void(u32)>& func);
    void thread_routine();
    void thread_entrypoint(ThreadID thread_id);
    void quit();
@@ -2,7 +2,11 @@
 
 #include "SafeAccess.hpp"
 
+#include "triglav/Profiler.hpp"
+
 #include <algorithm>
+#include <format>
+#include <memory>
 
 namespace triglav::threading {
 
@@ -19,6 +23,45 @@ void ThreadPool::issue_job(Job&& job)
    m_job_is_ready_cv.notify_one();
 }
 
+void ThreadPool::parallel_for(const u32 count, const std::function<void(u32)>& func)
+{
+   const auto helper_count = std::min(this->thread_count(), count > 0 ? count - 1 : 0);
+   if (helper_count == 0 || m_state.load() == State::Quitting) {
+      for (u32 index = 0; index < count; ++index) {
+         func(index);
+      }
+      return;
+   }
+
+   // Helpers may start after all indices are claimed, so the state outlives the call.
+   struct ParallelForState
+   {
+      const std::function<void(u32)>* func;
+      u32 count;
+      std::atomic<u32> next_index{};
+      std::atomic<u32> done_count{};
+   };
+   const auto state = std::make_shared<ParallelForState>(&func, count);
+
+   const auto run = [](ParallelForState& st) {
+      for (auto index = st.next_index.fetch_add(1); index < st.count; index = st.next_index.fetch_add(1)) {
+         (*st.func)(index);
+         if (st.done_count.fetch_add(1) + 1 == st.count) {
+            st.done_count.notify_all();
+         }
+      }
+   };
+
+   for (u32 helper = 0; helper < helper_count; ++helper) {
+      this->issue_job([state, run] { run(*state); });
+   }
+   run(*state);
+
+   for (auto done_count = state->done_count.load(); done_count != count; done_count = state->done_count.load()) {
+      state->done_count.wait(done_count);
+   }
+}
+
 void ThreadPool::thread_routine()
 {
    std::unique_lock lk{m_job_is_ready_mutex};
@@ -34,12 +77,14 @@ void ThreadPool::thread_routine()
 
    lk.unlock();
 
+   TG_PROFILE_SCOPE("Job", "thread_pool");
    (*object)();
 }
 
 void ThreadPool::thread_entrypoint(const ThreadID thread_id)
 {
    set_thread_id(thread_id);
+   Profiler::the().set_thread_name(std::format("Worker {}", thread_id));
 
    try {
       while (m_state.load() != State::Quitting) {
@@ -2,9 +2,11 @@
 
 #include "triglav/threading/ThreadPool.hpp"
 
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <iostream>
+#include <vector>
 
 using triglav::threading::ThreadPool;
 
@@ -116,3 +118,28 @@ TEST(ThreadPool, CanBeIdle)
 
    pool.quit();
 }
+
+TEST(ThreadPool, ParallelForVisitsEachIndexOnce)
+{
+   ThreadPool pool;
+   pool.initialize(4);
+
+   std::array<std::atomic<int>, 100> visits{};
+   pool.parallel_for(static_cast<triglav::u32>(visits.size()), [&](const triglav::u32 index) { visits[index].fetch_add(1); });
+
+   for (const auto& visit_count : visits) {
+      ASSERT_EQ(visit_count.load(), 1);
+   }
+
+   pool.quit();
+}
+
+TEST(ThreadPool, ParallelForRunsSeriallyWithoutThreads)
+{
+   ThreadPool pool;
+
+   std::vector<triglav::u32> indices;
+   pool.parallel_for(5, [&](const triglav::u32 index) { indices.push_back(index); });
+
+   ASSERT_EQ(indices, (std::vector<triglav::u32>{0, 1, 2, 3, 4}));
+}
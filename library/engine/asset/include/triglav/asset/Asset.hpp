@@ -168,6 +168,8 @@ std::optional<geometry::MeshData> decode_mesh(io::IReader& reader, u32 version);
 
 bool encode_texture(io::IWriter& writer, TexturePurpose purpose, const ktx::Texture& tex, const SamplerProperties& sampler);
 std::optional<DecodedTexture> decode_texture(io::IFile& stream);
+// The stream is expected to be positioned after the asset header, size is the size of the whole asset.
+std::optional<DecodedTexture> decode_texture(io::ISeekableStream& stream, MemorySize size);
 
 bool encode_animation(io::IWriter& writer, Animation& animation);
 std::optional<Animation> decode_animation(io::IReader& reader);
@@ -319,6 +319,15 @@ bool encode_texture(io::IWriter& writer, const TexturePurpose purpose, const ktx
 }
 
 std::optional<DecodedTexture> decode_texture(io::IFile& stream)
+{
+   const auto file_size = stream.file_size();
+   if (!file_size.has_value()) {
+      return std::nullopt;
+   }
+   return decode_texture(stream, *file_size);
+}
+
+std::optional<DecodedTexture> decode_texture(io::ISeekableStream& stream, const MemorySize size)
 {
    TextureHeader tex_header{};
    if (!stream.read({reinterpret_cast<u8*>(&tex_header), sizeof(TextureHeader)}).has_value()) {
@@ -326,7 +335,7 @@ std::optional<DecodedTexture> decode_texture(io::IFile& stream)
    }
 
    static constexpr auto offset = sizeof(AssetHeader) + sizeof(TextureHeader);
-   io::DisplacedStream displaced_stream{stream, offset, *stream.file_size() - offset};
+   io::DisplacedStream displaced_stream{stream, offset, size - offset};
 
    auto tex_result = ktx::Texture::from_stream(displaced_stream);
    if (!tex_result.has_value()) {
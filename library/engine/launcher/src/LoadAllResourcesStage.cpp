@@ -2,6 +2,7 @@
 
 #include "Application.hpp"
 
+#include "triglav/io/CommandLine.hpp"
 #include "triglav/project/PathManager.hpp"
 #include "triglav/project/ProjectManager.hpp"
 
@@ -11,10 +12,22 @@ using namespace name_literals;
 LoadAllResourcesStage::LoadAllResourcesStage(Application& app) :
     IStage(app)
 {
+   const auto budget_mb = io::CommandLine::the().arg_int("resourceBudgetMb"_name);
+   if (budget_mb.has_value()) {
+      app.m_resource_manager->set_memory_budget(static_cast<MemorySize>(*budget_mb) * 1024 * 1024);
+   }
+
    TG_CONNECT_OPT(*app.m_resource_manager, OnLoadedAssets, on_loaded_assets);
    const auto index_path = project::this_project() == "triglav_editor"_name ? "editor/index.yaml"_rc : "index.yaml"_rc;
    const auto proj_path = project::PathManager::the().translate_path(index_path);
-   app.m_resource_manager->load_asset_list(proj_path);
+
+   const auto* metadata = project::ProjectManager::the().project_metadata(project::this_project());
+   if (metadata != nullptr && !metadata->initial_level.empty()) {
+      const LevelName initial_level = name_from_path(StringView{metadata->initial_level.data(), metadata->initial_level.size()});
+      app.m_resource_manager->load_level_assets(proj_path, initial_level);
+   } else {
+      app.m_resource_manager->load_asset_list(proj_path);
+   }
 }
 
 void LoadAllResourcesStage::tick()
@@ -2,6 +2,7 @@
 
 #include "Application.hpp"
 
+#include "triglav/io/CommandLine.hpp"
 #include "triglav/project/PathManager.hpp"
 #include "triglav/render_core/GlyphCache.hpp"
 
@@ -13,7 +14,8 @@ LoadInitialResourcesStage::LoadInitialResourcesStage(Application& app) :
     IStage(app)
 {
    app.m_resource_manager = std::make_unique<resource::ResourceManager>(*app.m_gfx_device, app.m_font_manager);
-   app.m_glyph_cache = std::make_unique<render_core::GlyphCache>(*app.m_gfx_device, *app.m_resource_manager);
+   const auto sdf_min_font_size = io::CommandLine::the().arg_int("sdfMinFontSize"_name).value_or(render_core::g_default_sdf_min_font_size);
+   app.m_glyph_cache = std::make_unique<render_core::GlyphCache>(*app.m_gfx_device, *app.m_resource_manager, sdf_min_font_size);
 
    TG_CONNECT_OPT(*app.m_resource_manager, OnLoadedAssets, on_loaded_assets);
    const auto proj_path = project::PathManager::the().translate_path("engine/index.yaml"_rc);
@@ -0,0 +1,32 @@
+#include "triglav/launcher/Application.hpp"
+#include "triglav/testing_core/GTest.hpp"
+
+using namespace triglav::name_literals;
+
+extern triglav::launcher::Application* g_application;
+
+TEST(LoadAllResourcesStageTest, InitialLevelGetsLoaded)
+{
+   const auto& resource_manager = g_application->resource_manager();
+
+   ASSERT_TRUE(resource_manager.is_name_registered("level/demo.level"_rc));
+   ASSERT_TRUE(resource_manager.is_name_registered("mesh/hall.mesh"_rc));
+}
+
+TEST(LoadAllResourcesStageTest, LevelIndependentAssetsGetLoaded)
+{
+   const auto& resource_manager = g_application->resource_manager();
+
+   // Not referenced by any level, games fetch them by name.
+   ASSERT_TRUE(resource_manager.is_name_registered("mesh/teapot.mesh"_rc));
+   ASSERT_TRUE(resource_manager.is_name_registered("material/stone.mat"_rc));
+   ASSERT_TRUE(resource_manager.is_name_registered("texture/board.tex"_rc));
+}
+
+TEST(LoadAllResourcesStageTest, OtherLevelsAreSkipped)
+{
+   const auto& resource_manager = g_application->resource_manager();
+
+   ASSERT_FALSE(resource_manager.is_name_registered("level/simple_animated_human.level"_rc));
+   ASSERT_FALSE(resource_manager.is_name_registered("mesh/simple_human_anim_floor.mesh"_rc));
+}
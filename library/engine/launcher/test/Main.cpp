@@ -0,0 +1,26 @@
+#include "triglav/desktop/Entrypoint.hpp"
+#include "triglav/desktop/IDisplay.hpp"
+#include "triglav/io/Logging.hpp"
+#include "triglav/launcher/Application.hpp"
+#include "triglav/project/Name.hpp"
+#include "triglav/testing_core/GTest.hpp"
+
+TG_PROJECT_NAME(triglav_launcher_test)
+
+using triglav::desktop::IDisplay;
+using triglav::desktop::InputArgs;
+
+triglav::launcher::Application* g_application{};
+
+int triglav_main(InputArgs& args, IDisplay& display)
+{
+   triglav::LogManager::the().register_listener<triglav::io::StreamLogger>(triglav::io::stdout_writer());
+
+   // Runs all launch stages, the project's initial level gets loaded with the asset list.
+   triglav::launcher::Application app(args, display);
+   app.initialise();
+   g_application = &app;
+
+   testing::InitGoogleTest(&args.arg_count, const_cast<char**>(args.args));
+   return RUN_ALL_TESTS();
+}
@@ -46,6 +46,8 @@ struct ProjectMetadata
    std::string engine;
    std::vector<ResourcePathMapping> resource_mapping;
    ImportSettings import_settings;
+   // Only assets of this level are loaded on startup, all other levels are loaded on demand.
+   std::string initial_level;
 
    [[nodiscard]] std::string default_import_path(ResourceType res_type, std::string_view basename) const;
 };
@@ -80,6 +80,7 @@ TG_META_PROPERTY(type, triglav::project::ProjectType)
 TG_META_PROPERTY(engine, std::string)
 TG_META_ARRAY_PROPERTY(resource_mapping, triglav::project::ResourcePathMapping)
 TG_META_PROPERTY(import_settings, triglav::project::ImportSettings)
+TG_META_PROPERTY(initial_level, std::string)
 TG_META_CLASS_END
 #undef TG_TYPE
 
@@ -10,8 +10,9 @@ template<>
 struct Loader<ResourceType::Animation>
 {
    constexpr static ResourceLoadType type{ResourceLoadType::Static};
+   constexpr static bool loads_from_contents{true};
 
-   static asset::Animation load(const io::Path& path);
+   static asset::Animation load(std::span<const u8> contents);
    static void collect_dependencies(std::set<ResourceName>& out_dependencies, const io::Path& path);
 };
 
@@ -5,20 +5,47 @@
 #include "triglav/ResourcePathMap.hpp"
 #include "triglav/threading/SharedMutex.hpp"
 
+#include <atomic>
 #include <map>
 #include <mutex>
+#include <optional>
 #include <ranges>
 #include <shared_mutex>
+#include <tuple>
 #include <utility>
+#include <vector>
 
 namespace triglav::resource {
 
+namespace detail {
+
+// Shared by all containers so the last use of resources of different types can be compared.
+inline std::atomic<u64> g_resource_use_clock{};
+
+}// namespace detail
+
+struct EvictionCandidate
+{
+   ResourceName name;
+   u64 last_use;
+   MemorySize memory_size;
+};
+
 class IContainer
 {
  public:
    virtual ~IContainer() = default;
 
    [[nodiscard]] virtual bool is_name_registered(ResourceName name) const = 0;
+
+   // Return the updated reference count or nullopt if the resource isn't loaded.
+   virtual std::optional<u32> add_ref(ResourceName name) = 0;
+   virtual std::optional<u32> release(ResourceName name) = 0;
+
+   // Removes the resource if nothing references it.
+   virtual bool unload(ResourceName name) = 0;
+   virtual void collect_unreferenced(std::vector<EvictionCandidate>& out_candidates) const = 0;
+   [[nodiscard]] virtual MemorySize memory_usage() const = 0;
 };
 
 template<ResourceType CResourceType>
@@ -29,28 +56,44 @@ class Container final : public IContainer
    using ResName = TypedName<CResourceType>;
    using ValueType = typename EnumToCppResourceType<CResourceType>::ResourceType;
 
-   ValueType& get(const ResName name)
+   // Resources accessed while nothing references them get pinned with a reference that is never released,
+   // out_is_pinned is set if this call pinned the resource.
+   ValueType& get(const ResName name, bool& out_is_pinned)
    {
       std::shared_lock lk{m_mutex};
-      if (!m_map.contains(name)) {
+      const auto it = m_map.find(name);
+      if (it == m_map.end()) {
          log_error("Resource not found: {}", ResourcePathMap::the().resolve(name));
          flush_logs();
          assert(false);
       }
-      return m_map.at(name);
+
+      auto& entry = it->second;
+      entry.last_use.store(detail::g_resource_use_clock.fetch_add(1, std::memory_order_relaxed), std::memory_order_relaxed);
+
+      out_is_pinned = false;
+      if (entry.ref_count.load(std::memory_order_relaxed) == 0 && not entry.is_pinned.exchange(true, std::memory_order_relaxed)) {
+         entry.ref_count.fetch_add(1, std::memory_order_relaxed);
+         out_is_pinned = true;
+      }
+      return entry.value;
    }
 
    template<typename... TArgs>
    void register_emplace(const ResName name, TArgs... args)
    {
       std::unique_lock lk{m_mutex};
-      m_map.emplace(name, std::forward<TArgs>(args)...);
+      m_map.emplace(std::piecewise_construct, std::forward_as_tuple(name), std::forward_as_tuple(0, std::forward<TArgs>(args)...));
    }
 
-   void register_resource(const ResName name, ValueType&& resource)
+   void register_resource(const ResName name, ValueType&& resource, const MemorySize memory_size = 0)
    {
       std::unique_lock lk{m_mutex};
-      m_map.emplace(name, std::move(resource));
+      const auto [it, inserted] =
+         m_map.emplace(std::piecewise_construct, std::forward_as_tuple(name), std::forward_as_tuple(memory_size, std::move(resource)));
+      if (inserted) {
+         m_memory_usage += memory_size;
+      }
    }
 
    [[nodiscard]] bool is_name_registered(const ResourceName name) const override
@@ -62,17 +105,87 @@ class Container final : public IContainer
       return m_map.contains(ResName{name});
    }
 
+   std::optional<u32> add_ref(const ResourceName name) override
+   {
+      std::shared_lock lk{m_mutex};
+      const auto it = m_map.find(ResName{name});
+      if (it == m_map.end())
+         return std::nullopt;
+      return it->second.ref_count.fetch_add(1, std::memory_order_relaxed) + 1;
+   }
+
+   std::optional<u32> release(const ResourceName name) override
+   {
+      std::shared_lock lk{m_mutex};
+      const auto it = m_map.find(ResName{name});
+      if (it == m_map.end())
+         return std::nullopt;
+
+      auto count = it->second.ref_count.load(std::memory_order_relaxed);
+      do {
+         if (count == 0)
+            return std::nullopt;
+      } while (!it->second.ref_count.compare_exchange_weak(count, count - 1, std::memory_order_relaxed));
+
+      return count - 1;
+   }
+
+   bool unload(const ResourceName name) override
+   {
+      std::unique_lock lk{m_mutex};
+      const auto it = m_map.find(ResName{name});
+      if (it == m_map.end() || it->second.ref_count.load(std::memory_order_relaxed) != 0)
+         return false;
+
+      m_memory_usage -= it->second.memory_size;
+      m_map.erase(it);
+      return true;
+   }
+
+   void collect_unreferenced(std::vector<EvictionCandidate>& out_candidates) const override
+   {
+      std::shared_lock lk{m_mutex};
+      for (const auto& [name, entry] : m_map) {
+         if (entry.ref_count.load(std::memory_order_relaxed) == 0) {
+            out_candidates.emplace_back(name, entry.last_use.load(std::memory_order_relaxed), entry.memory_size);
+         }
+      }
+   }
+
+   [[nodiscard]] MemorySize memory_usage() const override
+   {
+      std::shared_lock lk{m_mutex};
+      return m_memory_usage;
+   }
+
    template<typename TFunc>
    void iterate_resources(TFunc func)
    {
-      for (const auto& [name, value] : m_map) {
-         func(name, value);
+      for (const auto& [name, entry] : m_map) {
+         func(name, entry.value);
       }
    }
 
  private:
-   std::map<ResName, ValueType> m_map{};
+   struct Entry
+   {
+      template<typename... TArgs>
+      explicit Entry(const MemorySize memory_size, TArgs&&... args) :
+          value(std::forward<TArgs>(args)...),
+          memory_size(memory_size)
+      {
+      }
+
+      ValueType value;
+      MemorySize memory_size;
+      std::atomic<u32> ref_count{};
+      std::atomic<u64> last_use{};
+      std::atomic<bool> is_pinned{};
+   };
+
+   std::map<ResName, Entry> m_map{};
+   MemorySize m_memory_usage{};
    mutable threading::SharedMutex m_mutex;
 };
 
-}// namespace triglav::resource
\ No newline at end of file
+}// namespace triglav::resource
@@ -4,7 +4,7 @@
 
 #include "triglav/Name.hpp"
 #include "triglav/io/Path.hpp"
-#include "triglav/world/Level.hpp"
+#include "triglav/world/LevelBinary.hpp"
 
 #include <set>
 #include <string_view>
@@ -16,7 +16,7 @@ struct Loader<ResourceType::Level>
 {
    constexpr static ResourceLoadType type{ResourceLoadType::Static};
 
-   static world::Level load(const io::Path& path);
+   static world::CompactLevel load(const io::Path& path);
    static void collect_dependencies(std::set<ResourceName>& out_dependencies, const io::Path& path);
 };
 
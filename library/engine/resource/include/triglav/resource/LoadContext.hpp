@@ -6,12 +6,16 @@
 #include "triglav/io/Path.hpp"
 #include "triglav/threading/SharedMutex.hpp"
 
+#include <map>
 #include <memory>
 #include <set>
 #include <vector>
 
 namespace triglav::resource {
 
+// Direct dependencies of each resource.
+using DependencyGraph = std::map<ResourceName, std::set<ResourceName>>;
+
 struct ResourceStage
 {
    std::vector<std::pair<ResourceName, io::Path>> resource_list;
@@ -27,7 +31,7 @@ enum class FinishLoadingAssetResult
 class LoadContext
 {
  public:
-   explicit LoadContext(std::vector<ResourceStage>&& loading_stages);
+   LoadContext(std::vector<ResourceStage>&& loading_stages, DependencyGraph&& dependency_graph);
 
    const ResourceStage& next_stage();
    FinishLoadingAssetResult finish_loading_asset();
@@ -35,19 +39,22 @@ class LoadContext
    [[nodiscard]] u32 total_assets() const;
    [[nodiscard]] u32 total_loaded_assets() const;
    [[nodiscard]] u32 current_stage_id() const;
+   [[nodiscard]] const DependencyGraph& dependency_graph() const;
 
    static std::unique_ptr<LoadContext> from_asset_list(const io::Path& path);
    static std::unique_ptr<LoadContext> from_target_asset(ResourceName res_name);
+   // Skips other levels and content referenced only by them, the given level and the rest of the asset list get loaded.
+   static std::unique_ptr<LoadContext> from_level_assets(const io::Path& asset_list_path, LevelName level);
 
  private:
-   static std::unique_ptr<LoadContext> build_load_context(const std::set<ResourceName>& resources);
-
+   static std::unique_ptr<LoadContext> build_load_context(const std::set<ResourceName>& resources, DependencyGraph&& dependency_graph);
 
    u32 m_assets_loaded_in_stage{};
    u32 m_total_assets{};
    u32 m_total_loaded_assets{};
    u32 m_current_stage_id{};
    std::vector<ResourceStage> m_loading_stages{};
+   DependencyGraph m_dependency_graph;
    mutable threading::SharedMutex m_mutex;
 };
 
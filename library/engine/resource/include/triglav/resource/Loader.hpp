@@ -1,10 +1,12 @@
 #pragma once
 
+#include "triglav/Int.hpp"
 #include "triglav/Name.hpp"
 #include "triglav/ResourceType.hpp"
 #include "triglav/io/Path.hpp"
 
 #include <set>
+#include <span>
 
 namespace triglav::resource {
 
@@ -23,6 +25,16 @@ concept CollectsDependencies = requires(std::set<ResourceName>& out_deps, const
    { TLoader::collect_dependencies(out_deps, path) } -> std::same_as<void>;
 };
 
+// Used to keep the loaded resources within the memory budget.
+template<typename TLoader, typename TValue>
+concept EstimatesMemorySize = requires(const TValue& value) {
+   { TLoader::memory_size(value) } -> std::same_as<MemorySize>;
+};
+
+// Loaders which only decode the file contents, these files are read asynchronously before the decoding job is issued.
+template<typename TLoader>
+concept LoadsFromContents = requires { requires TLoader::loads_from_contents; };
+
 template<ResourceType CResourceType>
 struct Loader
 {
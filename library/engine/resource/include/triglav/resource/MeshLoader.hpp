@@ -16,9 +16,11 @@ template<>
 struct Loader<ResourceType::Mesh>
 {
    constexpr static ResourceLoadType type{ResourceLoadType::Graphics};
+   constexpr static bool loads_from_contents{true};
 
-   static render_objects::Mesh load_gpu(graphics_api::Device& device, MeshName name, const io::Path& path);
+   static render_objects::Mesh load_gpu(graphics_api::Device& device, MeshName name, std::span<const u8> contents);
    static void collect_dependencies(std::set<ResourceName>& out_dependencies, const io::Path& path);
+   static MemorySize memory_size(const render_objects::Mesh& mesh);
 };
 
 }// namespace triglav::resource
@@ -15,10 +15,14 @@
 #include "triglav/ResourcePathMap.hpp"
 #include "triglav/event/Delegate.hpp"
 #include "triglav/font/FontManager.hpp"
+#include "triglav/io/AsyncFileReader.hpp"
 #include "triglav/io/Path.hpp"
+#include "triglav/threading/SharedMutex.hpp"
 
+#include <limits>
 #include <map>
 #include <memory>
+#include <span>
 #include <string>
 
 namespace triglav::graphics_api {
@@ -27,6 +31,15 @@ class Device;
 
 namespace triglav::resource {
 
+template<ResourceType CResourceType>
+class ResourceRef;
+
+// Only these resources are unloaded when nothing references them.
+[[nodiscard]] constexpr bool is_ref_counted(const ResourceType type)
+{
+   return type == ResourceType::Mesh || type == ResourceType::Texture || type == ResourceType::Material || type == ResourceType::Typeface;
+}
+
 class ResourceManager
 {
    TG_DEFINE_LOG_CATEGORY(ResourceManager)
@@ -39,28 +52,70 @@ class ResourceManager
 
    void load_asset_list(const io::Path& path);
    void load_asset(ResourceName resource_name);
+   void load_level_assets(const io::Path& asset_list_path, LevelName level);
 
    [[nodiscard]] bool is_name_registered(ResourceName asset_name) const;
 
+   // Resources accessed without a reference can't be tracked, so they get pinned and are never evicted.
    template<ResourceType CResourceType>
    auto& get(const TypedName<CResourceType> name)
    {
-      return container<CResourceType>().get(name);
+      bool is_pinned{};
+      auto& value = container<CResourceType>().get(name, is_pinned);
+      if (is_pinned) {
+         this->add_dependency_refs(name);
+      }
+      return value;
    }
 
+   // Keeps the resource and its dependencies loaded for the lifetime of the reference.
+   template<ResourceType CResourceType>
+   ResourceRef<CResourceType> acquire(const TypedName<CResourceType> name)
+   {
+      this->add_ref(name);
+      return ResourceRef<CResourceType>(*this, name);
+   }
+
+   void add_ref(ResourceName name);
+   void release(ResourceName name);
+
+   // Unloading must happen when the GPU no longer uses the resources, for example between levels.
+   u32 unload_unreferenced();
+   // Unloads the least recently used unreferenced resources until the memory usage fits in the budget.
+   u32 evict_to_budget();
+
+   void set_memory_budget(MemorySize budget);
+   [[nodiscard]] MemorySize memory_budget() const;
+   [[nodiscard]] MemorySize memory_usage() const;
+
    template<ResourceType CResourceType>
    void load_resource(TypedName<CResourceType> name, const io::Path& path)
    {
-      if constexpr (Loader<CResourceType>::type == ResourceLoadType::Graphics) {
-         container<CResourceType>().register_resource(name, Loader<CResourceType>::load_gpu(m_device, name, path));
+      if constexpr (LoadsFromContents<Loader<CResourceType>>) {
+         const auto contents = io::read_file_contents(path);
+         assert(contents.has_value());
+         this->load_resource_from_contents(name, *contents);
+      } else if constexpr (Loader<CResourceType>::type == ResourceLoadType::Graphics) {
+         this->register_resource(name, Loader<CResourceType>::load_gpu(m_device, name, path));
       } else if constexpr (Loader<CResourceType>::type == ResourceLoadType::GraphicsDependent) {
-         container<CResourceType>().register_resource(name, Loader<CResourceType>::load_gpu(*this, m_device, path));
+         this->register_resource(name, Loader<CResourceType>::load_gpu(*this, m_device, path));
       } else if constexpr (Loader<CResourceType>::type == ResourceLoadType::Font) {
-         container<CResourceType>().register_resource(name, Loader<CResourceType>::load_font(m_font_manager, path));
+         this->register_resource(name, Loader<CResourceType>::load_font(m_font_manager, path));
       } else if constexpr (Loader<CResourceType>::type == ResourceLoadType::StaticDependent) {
-         container<CResourceType>().register_resource(name, Loader<CResourceType>::load(*this, path));
+         this->register_resource(name, Loader<CResourceType>::load(*this, path));
       } else if constexpr (Loader<CResourceType>::type == ResourceLoadType::Static) {
-         container<CResourceType>().register_resource(name, Loader<CResourceType>::load(path));
+         this->register_resource(name, Loader<CResourceType>::load(path));
+      }
+   }
+
+   template<ResourceType CResourceType>
+      requires LoadsFromContents<Loader<CResourceType>>
+   void load_resource_from_contents(TypedName<CResourceType> name, const std::span<const u8> contents)
+   {
+      if constexpr (Loader<CResourceType>::type == ResourceLoadType::Graphics) {
+         this->register_resource(name, Loader<CResourceType>::load_gpu(m_device, name, contents));
+      } else if constexpr (Loader<CResourceType>::type == ResourceLoadType::Static) {
+         this->register_resource(name, Loader<CResourceType>::load(contents));
       }
    }
 
@@ -83,8 +138,20 @@ class ResourceManager
    const NameRegistry& name_registry() const;
 
  private:
-   void load_asset_internal(ResourceName asset_name, const io::Path& path);
+   // Contents are only passed for assets whose loader decodes from memory, others are loaded from the path.
+   void load_asset_internal(ResourceName asset_name, const io::Path& path, const io::FileContents* contents = nullptr);
    void load_next_stage();
+   void add_dependency_refs(ResourceName name);
+
+   template<ResourceType CResourceType, typename TValue>
+   void register_resource(const TypedName<CResourceType> name, TValue&& value)
+   {
+      MemorySize memory_size{};
+      if constexpr (EstimatesMemorySize<Loader<CResourceType>, TValue>) {
+         memory_size = Loader<CResourceType>::memory_size(value);
+      }
+      container<CResourceType>().register_resource(name, std::forward<TValue>(value), memory_size);
+   }
 
    template<ResourceType CResourceType>
    Container<CResourceType>& container()
@@ -97,8 +164,101 @@ class ResourceManager
    NameRegistry m_name_registry;
    graphics_api::Device& m_device;
    font::FontManger& m_font_manager;
+   DependencyGraph m_dependency_graph;
+   mutable threading::SharedMutex m_dependency_mutex;
+   MemorySize m_memory_budget{std::numeric_limits<MemorySize>::max()};
+   // Destroyed first, the reader waits for pending callbacks which register resources in the containers.
+   io::IAsyncFileReaderUPtr m_file_reader;
+};
+
+template<ResourceType CResourceType>
+class ResourceRef
+{
+ public:
+   using ValueType = typename EnumToCppResourceType<CResourceType>::ResourceType;
+
+   ResourceRef() = default;
+
+   // Expects the reference to be already added.
+   ResourceRef(ResourceManager& manager, const TypedName<CResourceType> name) :
+       m_manager(&manager),
+       m_name(name)
+   {
+   }
+
+   ~ResourceRef()
+   {
+      this->reset();
+   }
+
+   ResourceRef(const ResourceRef& other) :
+       m_manager(other.m_manager),
+       m_name(other.m_name)
+   {
+      if (m_manager != nullptr) {
+         m_manager->add_ref(m_name);
+      }
+   }
+
+   ResourceRef& operator=(const ResourceRef& other)
+   {
+      if (this == &other)
+         return *this;
+
+      this->reset();
+      m_manager = other.m_manager;
+      m_name = other.m_name;
+      if (m_manager != nullptr) {
+         m_manager->add_ref(m_name);
+      }
+      return *this;
+   }
+
+   ResourceRef(ResourceRef&& other) noexcept :
+       m_manager(std::exchange(other.m_manager, nullptr)),
+       m_name(other.m_name)
+   {
+   }
+
+   ResourceRef& operator=(ResourceRef&& other) noexcept
+   {
+      if (this == &other)
+         return *this;
+
+      this->reset();
+      m_manager = std::exchange(other.m_manager, nullptr);
+      m_name = other.m_name;
+      return *this;
+   }
+
+   void reset()
+   {
+      if (m_manager != nullptr) {
+         std::exchange(m_manager, nullptr)->release(m_name);
+      }
+   }
+
+   [[nodiscard]] ValueType& get() const
+   {
+      assert(m_manager != nullptr);
+      return m_manager->get(m_name);
+   }
+
+   [[nodiscard]] TypedName<CResourceType> name() const
+   {
+      return m_name;
+   }
+
+   [[nodiscard]] bool has_value() const
+   {
+      return m_manager != nullptr;
+   }
+
+ private:
+   ResourceManager* m_manager{};
+   TypedName<CResourceType> m_name{};
 };
 
-void resolve_dependencies(std::set<ResourceName>& resource_list);
+void resolve_dependencies(std::set<ResourceName>& resource_list, DependencyGraph& out_dependency_graph);
 
 }// namespace triglav::resource
\ No newline at end of file
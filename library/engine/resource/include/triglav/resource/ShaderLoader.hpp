@@ -16,64 +16,72 @@ template<>
 struct Loader<ResourceType::FragmentShader>
 {
    constexpr static ResourceLoadType type{ResourceLoadType::Graphics};
+   constexpr static bool loads_from_contents{true};
 
-   static graphics_api::Shader load_gpu(graphics_api::Device& device, FragmentShaderName name, const io::Path& path);
+   static graphics_api::Shader load_gpu(graphics_api::Device& device, FragmentShaderName name, std::span<const u8> contents);
 };
 
 template<>
 struct Loader<ResourceType::VertexShader>
 {
    constexpr static ResourceLoadType type{ResourceLoadType::Graphics};
+   constexpr static bool loads_from_contents{true};
 
-   static graphics_api::Shader load_gpu(graphics_api::Device& device, VertexShaderName name, const io::Path& path);
+   static graphics_api::Shader load_gpu(graphics_api::Device& device, VertexShaderName name, std::span<const u8> contents);
 };
 
 template<>
 struct Loader<ResourceType::HullShader>
 {
    constexpr static ResourceLoadType type{ResourceLoadType::Graphics};
+   constexpr static bool loads_from_contents{true};
 
-   static graphics_api::Shader load_gpu(graphics_api::Device& device, HullShaderName name, const io::Path& path);
+   static graphics_api::Shader load_gpu(graphics_api::Device& device, HullShaderName name, std::span<const u8> contents);
 };
 
 template<>
 struct Loader<ResourceType::DomainShader>
 {
    constexpr static ResourceLoadType type{ResourceLoadType::Graphics};
+   constexpr static bool loads_from_contents{true};
 
-   static graphics_api::Shader load_gpu(graphics_api::Device& device, DomainShaderName name, const io::Path& path);
+   static graphics_api::Shader load_gpu(graphics_api::Device& device, DomainShaderName name, std::span<const u8> contents);
 };
 
 template<>
 struct Loader<ResourceType::ComputeShader>
 {
    constexpr static ResourceLoadType type{ResourceLoadType::Graphics};
+   constexpr static bool loads_from_contents{true};
 
-   static graphics_api::Shader load_gpu(graphics_api::Device& device, ComputeShaderName name, const io::Path& path);
+   static graphics_api::Shader load_gpu(graphics_api::Device& device, ComputeShaderName name, std::span<const u8> contents);
 };
 
 template<>
 struct Loader<ResourceType::RayGenShader>
 {
    constexpr static ResourceLoadType type{ResourceLoadType::Graphics};
+   constexpr static bool loads_from_contents{true};
 
-   static graphics_api::Shader load_gpu(graphics_api::Device& device, RayGenShaderName name, const io::Path& path);
+   static graphics_api::Shader load_gpu(graphics_api::Device& device, RayGenShaderName name, std::span<const u8> contents);
 };
 
 template<>
 struct Loader<ResourceType::RayClosestHitShader>
 {
    constexpr static ResourceLoadType type{ResourceLoadType::Graphics};
+   constexpr static bool loads_from_contents{true};
 
-   static graphics_api::Shader load_gpu(graphics_api::Device& device, RayClosestHitShaderName name, const io::Path& path);
+   static graphics_api::Shader load_gpu(graphics_api::Device& device, RayClosestHitShaderName name, std::span<const u8> contents);
 };
 
 template<>
 struct Loader<ResourceType::RayMissShader>
 {
    constexpr static ResourceLoadType type{ResourceLoadType::Graphics};
+   constexpr static bool loads_from_contents{true};
 
-   static graphics_api::Shader load_gpu(graphics_api::Device& device, RayMissShaderName name, const io::Path& path);
+   static graphics_api::Shader load_gpu(graphics_api::Device& device, RayMissShaderName name, std::span<const u8> contents);
 };
 
 }// namespace triglav::resource
@@ -16,8 +16,10 @@ template<>
 struct Loader<ResourceType::Texture>
 {
    constexpr static ResourceLoadType type{ResourceLoadType::Graphics};
+   constexpr static bool loads_from_contents{true};
 
-   static graphics_api::Texture load_gpu(graphics_api::Device& device, TextureName name, const io::Path& path);
+   static graphics_api::Texture load_gpu(graphics_api::Device& device, TextureName name, std::span<const u8> contents);
+   static MemorySize memory_size(const graphics_api::Texture& texture);
 };
 
 }// namespace triglav::resource
\ No newline at end of file
@@ -1,18 +1,14 @@
 #include "AnimationLoader.hpp"
 
 #include "triglav/asset/Asset.hpp"
+#include "triglav/io/MemoryStream.hpp"
 
 namespace triglav::resource {
 
-asset::Animation Loader<ResourceType::Animation>::load(const io::Path& path)
+asset::Animation Loader<ResourceType::Animation>::load(const std::span<const u8> contents)
 {
-   const auto file = io::open_file(path, io::FileMode::Read);
-   if (!file.has_value()) {
-      assert(false);
-      return {};
-   }
-
-   auto animation = asset::decode_animation(**file);
+   io::MemoryStream stream{contents};
+   auto animation = asset::decode_animation(stream);
    assert(animation.has_value());
    return std::move(*animation);
 }
@@ -8,12 +8,51 @@
 #include <ryml.hpp>
 
 #include <mutex>
+#include <optional>
 #include <shared_mutex>
 
 namespace triglav::resource {
 
-LoadContext::LoadContext(std::vector<ResourceStage>&& loading_stages) :
-    m_loading_stages(std::move(loading_stages))
+namespace {
+
+std::optional<std::set<ResourceName>> read_asset_list(const io::Path& path)
+{
+   auto file = io::read_whole_file(path);
+   if (file.empty()) {
+      return std::nullopt;
+   }
+
+   auto tree =
+      ryml::parse_in_place(c4::substr{const_cast<char*>(path.string().data()), path.string().size()}, c4::substr{file.data(), file.size()});
+   auto resources_node = tree["resources"];
+
+   std::set<ResourceName> resources;
+   for (const auto node : resources_node) {
+      auto rc_path = node.val();
+      resources.insert(name_from_path(StringView{rc_path.data(), rc_path.size()}));
+   }
+   return resources;
+}
+
+bool is_level_content(const ResourceType type)
+{
+   switch (type) {
+   case ResourceType::Level:
+   case ResourceType::Mesh:
+   case ResourceType::Material:
+   case ResourceType::Armature:
+   case ResourceType::Animation:
+      return true;
+   default:
+      return false;
+   }
+}
+
+}// namespace
+
+LoadContext::LoadContext(std::vector<ResourceStage>&& loading_stages, DependencyGraph&& dependency_graph) :
+    m_loading_stages(std::move(loading_stages)),
+    m_dependency_graph(std::move(dependency_graph))
 {
    for (const auto& stage : m_loading_stages) {
       m_total_assets += static_cast<u32>(stage.resource_list.size());
@@ -62,36 +101,62 @@ u32 LoadContext::current_stage_id() const
    return m_current_stage_id;
 }
 
+const DependencyGraph& LoadContext::dependency_graph() const
+{
+   return m_dependency_graph;
+}
+
 std::unique_ptr<LoadContext> LoadContext::from_asset_list(const io::Path& path)
 {
-   auto file = io::read_whole_file(path);
-   if (file.empty()) {
+   auto resources = read_asset_list(path);
+   if (!resources.has_value()) {
       return {};
    }
 
-   auto tree =
-      ryml::parse_in_place(c4::substr{const_cast<char*>(path.string().data()), path.string().size()}, c4::substr{file.data(), file.size()});
-   auto resources_node = tree["resources"];
-
-   std::set<ResourceName> resources;
-   for (const auto node : resources_node) {
-      auto rc_path = node.val();
-      resources.insert(name_from_path(StringView{rc_path.data(), rc_path.size()}));
-   }
-   resolve_dependencies(resources);
+   DependencyGraph dependency_graph;
+   resolve_dependencies(*resources, dependency_graph);
 
-   return build_load_context(resources);
+   return build_load_context(*resources, std::move(dependency_graph));
 }
 
 std::unique_ptr<LoadContext> LoadContext::from_target_asset(const ResourceName res_name)
 {
    std::set<ResourceName> resources;
    resources.insert(res_name);
-   resolve_dependencies(resources);
-   return build_load_context(resources);
+
+   DependencyGraph dependency_graph;
+   resolve_dependencies(resources, dependency_graph);
+
+   return build_load_context(resources, std::move(dependency_graph));
+}
+
+std::unique_ptr<LoadContext> LoadContext::from_level_assets(const io::Path& asset_list_path, const LevelName level)
+{
+   auto resources = read_asset_list(asset_list_path);
+   if (!resources.has_value()) {
+      return {};
+   }
+
+   std::set<ResourceName> other_level_content;
+   for (const auto rc : *resources) {
+      if (rc.type() == ResourceType::Level && rc != level) {
+         other_level_content.insert(rc);
+      }
+   }
+   DependencyGraph other_level_graph;
+   resolve_dependencies(other_level_content, other_level_graph);
+
+   // Content of other levels is skipped, unless it's also needed by the level or by the rest of the asset list.
+   std::erase_if(*resources, [&](const ResourceName rc) { return is_level_content(rc.type()) && other_level_content.contains(rc); });
+   resources->insert(level);
+
+   DependencyGraph dependency_graph;
+   resolve_dependencies(*resources, dependency_graph);
+
+   return build_load_context(*resources, std::move(dependency_graph));
 }
 
-std::unique_ptr<LoadContext> LoadContext::build_load_context(const std::set<ResourceName>& resources)
+std::unique_ptr<LoadContext> LoadContext::build_load_context(const std::set<ResourceName>& resources, DependencyGraph&& dependency_graph)
 {
    std::vector<ResourceStage> result{};
    result.resize(loading_stage_count());
@@ -103,7 +168,7 @@ std::unique_ptr<LoadContext> LoadContext::build_load_context(const std::set<Reso
    result.erase(std::ranges::remove_if(result, [](const ResourceStage& stage) { return stage.resource_list.empty(); }).begin(),
                 result.end());
 
-   return std::make_unique<LoadContext>(std::move(result));
+   return std::make_unique<LoadContext>(std::move(result), std::move(dependency_graph));
 }
 
 }// namespace triglav::resource
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include "triglav/asset/Asset.hpp"
 #include "triglav/geometry/Mesh.hpp"
 #include "triglav/io/File.hpp"
+#include "triglav/io/MemoryStream.hpp"
 
 #include <format>
 
@@ -10,26 +11,25 @@ namespace triglav::resource {
 
 namespace {
 
-geometry::MeshData load_mesh_data(const io::Path& path)
+geometry::MeshData load_mesh_data(io::IReader& reader)
 {
-   const auto mesh_file_handle = io::open_file(path, io::FileMode::Read);
-   assert(mesh_file_handle.has_value());
-
    [[maybe_unused]]
-   const auto asset_header = asset::decode_header(**mesh_file_handle);
+   const auto asset_header = asset::decode_header(reader);
    assert(asset_header.has_value());
    assert(asset_header->type == ResourceType::Mesh);
 
-   const auto mesh = asset::decode_mesh(**mesh_file_handle, asset_header->version);
+   const auto mesh = asset::decode_mesh(reader, asset_header->version);
    assert(mesh.has_value());
    return *mesh;
 }
 
 }// namespace
 
-render_objects::Mesh Loader<ResourceType::Mesh>::load_gpu(graphics_api::Device& device, MeshName /*name*/, const io::Path& path)
+render_objects::Mesh Loader<ResourceType::Mesh>::load_gpu(graphics_api::Device& device, MeshName /*name*/,
+                                                          const std::span<const u8> contents)
 {
-   const auto mesh = load_mesh_data(path);
+   io::MemoryStream stream{contents};
+   const auto mesh = load_mesh_data(stream);
 
    graphics_api::BufferUsageFlags additional_usage_flags{graphics_api::BufferUsage::TransferSrc};
    if (device.enabled_features() & graphics_api::DeviceFeature::RayTracing) {
@@ -49,10 +49,18 @@ render_objects::Mesh Loader<ResourceType::Mesh>::load_gpu(graphics_api::Device&
 
 void Loader<ResourceType::Mesh>::collect_dependencies(std::set<ResourceName>& out_dependencies, const io::Path& path)
 {
-   const auto mesh_data = load_mesh_data(path);
+   const auto mesh_file_handle = io::open_file(path, io::FileMode::Read);
+   assert(mesh_file_handle.has_value());
+
+   const auto mesh_data = load_mesh_data(**mesh_file_handle);
    for (const auto& range : mesh_data.vertex_data.vertex_buffer.vertex_groups()) {
       out_dependencies.insert(range.material_name);
    }
 }
 
+MemorySize Loader<ResourceType::Mesh>::memory_size(const render_objects::Mesh& mesh)
+{
+   return mesh.device_mesh.vertex_buffer.size() + mesh.device_mesh.index_buffer.buffer().size();
+}
+
 }// namespace triglav::resource
\ No newline at end of file
@@ -9,6 +9,7 @@
 #include "TextureLoader.hpp"
 #include "TypefaceLoader.hpp"
 
+#include "triglav/Profiler.hpp"
 #include "triglav/TypeMacroList.hpp"
 #include "triglav/asset/Asset.hpp"
 #include "triglav/project/PathManager.hpp"
@@ -16,16 +17,39 @@
 
 #include <ryml.hpp>
 
+#include <algorithm>
 #include <map>
+#include <mutex>
+#include <ranges>
+#include <shared_mutex>
 #include <string>
 
 namespace triglav::resource {
 
 using namespace name_literals;
 
+namespace {
+
+[[nodiscard]] bool loads_from_contents(const ResourceType type)
+{
+   switch (type) {
+#define TG_RESOURCE_TYPE(name, extension, cpp_type, stage) \
+   case ResourceType::name:                                \
+      return LoadsFromContents<Loader<ResourceType::name>>;
+      TG_RESOURCE_TYPE_LIST
+#undef TG_RESOURCE_TYPE
+   case ResourceType::Unknown:
+      break;
+   }
+   return false;
+}
+
+}// namespace
+
 ResourceManager::ResourceManager(graphics_api::Device& device, font::FontManger& font_manager) :
     m_device(device),
-    m_font_manager(font_manager)
+    m_font_manager(font_manager),
+    m_file_reader(io::create_async_file_reader())
 {
 #define TG_RESOURCE_TYPE(name, extension, cpp_type, stage) \
    m_containers.emplace(ResourceType::name, std::make_unique<Container<ResourceType::name>>());
@@ -65,6 +89,22 @@ void ResourceManager::load_asset(const ResourceName resource_name)
    this->load_next_stage();
 }
 
+void ResourceManager::load_level_assets(const io::Path& asset_list_path, const LevelName level)
+{
+   if (m_load_context != nullptr) {
+      log_error("Loading assets already in progress");
+      return;
+   }
+   m_load_context = LoadContext::from_level_assets(asset_list_path, level);
+   if (m_load_context == nullptr) {
+      log_error("Failed to open asset file list");
+      return;
+   }
+
+   log_info("Loading {} assets for level {}", m_load_context->total_assets(), ResourcePathMap::the().resolve(level));
+   this->load_next_stage();
+}
+
 void ResourceManager::load_next_stage()
 {
    if (m_load_context == nullptr) {
@@ -84,16 +124,35 @@ void ResourceManager::load_next_stage()
       }
 
       m_name_registry.register_resource(rc_name, rc_path.string());
-      threading::ThreadPool::the().issue_job([&] { this->load_asset_internal(rc_name, rc_path); });
+
+      if (!loads_from_contents(rc_name.type())) {
+         threading::ThreadPool::the().issue_job([&] { this->load_asset_internal(rc_name, rc_path); });
+         continue;
+      }
+
+      // The reads of the whole stage are in flight at once, workers only pick up files which are already in memory.
+      m_file_reader->read_file(rc_path, [this, &rc_name, &rc_path](io::Result<io::FileContents>&& contents) {
+         if (!contents.has_value()) {
+            log_error("failed to read resource: {}", rc_path.string());
+            // Skip the resource, otherwise the stage never finishes loading.
+            threading::ThreadPool::the().issue_job([this, &rc_name] { this->on_finished_loading_resource(rc_name, true); });
+            return;
+         }
+         threading::ThreadPool::the().issue_job([this, &rc_name, &rc_path, file_contents = std::move(*contents)] {
+            this->load_asset_internal(rc_name, rc_path, &file_contents);
+         });
+      });
    }
 
    flush_logs();
 }
 
-void ResourceManager::load_asset_internal(const ResourceName asset_name, const io::Path& path)
+void ResourceManager::load_asset_internal(const ResourceName asset_name, const io::Path& path, const io::FileContents* contents)
 {
-   log_info("[THREAD: {}] Loading asset {}", threading::this_thread_id(),
-            m_name_registry.lookup_resource_name(asset_name).value_or("UNKNOWN"));
+   const auto resource_name = m_name_registry.lookup_resource_name(asset_name).value_or("UNKNOWN");
+   TG_PROFILE_SCOPE("Load Asset", "resource", resource_name);
+
+   log_info("[THREAD: {}] Loading asset {}", threading::this_thread_id(), resource_name);
 
    this->event_OnStartedLoadingAsset.publish(asset_name);
 
@@ -102,16 +161,15 @@ void ResourceManager::load_asset_internal(const ResourceName asset_name, const i
       return;
    }
 
-   switch (asset_name.type()) {
-#define TG_RESOURCE_TYPE(name, extension, cpp_type, stage)       \
-   case ResourceType::name:                                      \
-      this->load_resource<ResourceType::name>(asset_name, path); \
-      break;
-      TG_RESOURCE_TYPE_LIST
-#undef TG_RESOURCE_TYPE
-   case ResourceType::Unknown:
-      break;
-   }
+   asset_name.match([&]<typename TName>(const TName typed_name) {
+      if constexpr (LoadsFromContents<Loader<TName::resource_type>>) {
+         if (contents != nullptr) {
+            this->load_resource_from_contents(typed_name, *contents);
+            return;
+         }
+      }
+      this->load_resource(typed_name, path);
+   });
 
    this->on_finished_loading_resource(asset_name);
 }
@@ -147,11 +205,17 @@ void ResourceManager::on_finished_loading_resource(ResourceName resource_name, c
       log_info("Loading stage {} DONE", m_load_context->current_stage_id());
       this->load_next_stage();
       break;
-   case FinishLoadingAssetResult::FinishedLoadingAssets:
+   case FinishLoadingAssetResult::FinishedLoadingAssets: {
       log_info("Loading assets DONE");
+      std::unique_lock lk{m_dependency_mutex};
+      for (const auto& [rc_name, dependencies] : m_load_context->dependency_graph()) {
+         m_dependency_graph.insert_or_assign(rc_name, dependencies);
+      }
+      lk.unlock();
       m_load_context.reset();
       this->event_OnLoadedAssets.publish();
       break;
+   }
    case FinishLoadingAssetResult::None:
       break;
    }
@@ -167,21 +231,144 @@ const NameRegistry& ResourceManager::name_registry() const
    return m_name_registry;
 }
 
-void resolve_dependencies(std::set<ResourceName>& resource_list)
+void ResourceManager::add_ref(const ResourceName name)
+{
+   if (not m_containers.contains(name.type()))
+      return;
+
+   // Dependencies are referenced once by each referenced resource.
+   if (m_containers.at(name.type())->add_ref(name) != 1u)
+      return;
+
+   this->add_dependency_refs(name);
+}
+
+void ResourceManager::add_dependency_refs(const ResourceName name)
+{
+   std::shared_lock lk{m_dependency_mutex};
+   const auto it = m_dependency_graph.find(name);
+   if (it == m_dependency_graph.end())
+      return;
+   const auto dependencies = it->second;
+   lk.unlock();
+
+   for (const auto dependency : dependencies) {
+      this->add_ref(dependency);
+   }
+}
+
+void ResourceManager::release(const ResourceName name)
+{
+   if (not m_containers.contains(name.type()))
+      return;
+
+   if (m_containers.at(name.type())->release(name) != 0u)
+      return;
+
+   std::shared_lock lk{m_dependency_mutex};
+   const auto it = m_dependency_graph.find(name);
+   if (it == m_dependency_graph.end())
+      return;
+   const auto dependencies = it->second;
+   lk.unlock();
+
+   for (const auto dependency : dependencies) {
+      this->release(dependency);
+   }
+}
+
+u32 ResourceManager::unload_unreferenced()
+{
+   std::vector<EvictionCandidate> candidates;
+   for (const auto& [type, container] : m_containers) {
+      if (is_ref_counted(type)) {
+         container->collect_unreferenced(candidates);
+      }
+   }
+
+   u32 unloaded_count = 0;
+   for (const auto& candidate : candidates) {
+      if (m_containers.at(candidate.name.type())->unload(candidate.name)) {
+         ++unloaded_count;
+      }
+   }
+
+   log_info("Unloaded {} unreferenced resources", unloaded_count);
+   return unloaded_count;
+}
+
+u32 ResourceManager::evict_to_budget()
+{
+   auto usage = this->memory_usage();
+   if (usage <= m_memory_budget)
+      return 0;
+
+   std::vector<EvictionCandidate> candidates;
+   for (const auto& [type, container] : m_containers) {
+      if (is_ref_counted(type)) {
+         container->collect_unreferenced(candidates);
+      }
+   }
+   std::ranges::sort(candidates, std::less{}, &EvictionCandidate::last_use);
+
+   u32 evicted_count = 0;
+   for (const auto& candidate : candidates) {
+      if (usage <= m_memory_budget)
+         break;
+      if (m_containers.at(candidate.name.type())->unload(candidate.name)) {
+         usage -= candidate.memory_size;
+         ++evicted_count;
+      }
+   }
+
+   if (usage > m_memory_budget) {
+      log_info("Referenced resources exceed the memory budget: {} > {}", usage, m_memory_budget);
+   }
+   log_info("Evicted {} resources, memory usage: {}", evicted_count, usage);
+   return evicted_count;
+}
+
+void ResourceManager::set_memory_budget(const MemorySize budget)
+{
+   m_memory_budget = budget;
+}
+
+MemorySize ResourceManager::memory_budget() const
+{
+   return m_memory_budget;
+}
+
+MemorySize ResourceManager::memory_usage() const
+{
+   MemorySize result{};
+   for (const auto& container : m_containers | std::views::values) {
+      result += container->memory_usage();
+   }
+   return result;
+}
+
+void resolve_dependencies(std::set<ResourceName>& resource_list, DependencyGraph& out_dependency_graph)
 {
    std::set<ResourceName> child_deps;
    for (const auto rc : resource_list) {
+      // Resources shared between multiple parents are resolved once.
+      if (out_dependency_graph.contains(rc))
+         continue;
+
       const auto path = project::PathManager::the().translate_path(rc);
+      auto& dependencies = out_dependency_graph[rc];
 
       rc.match([&]<typename TName>(TName /*typed_rc*/) {
          if constexpr (CollectsDependencies<Loader<TName::resource_type>>) {
-            Loader<TName::resource_type>::collect_dependencies(child_deps, path);
+            Loader<TName::resource_type>::collect_dependencies(dependencies, path);
          }
       });
+
+      child_deps.insert_range(dependencies);
    }
 
    if (!child_deps.empty()) {
-      resolve_dependencies(child_deps);
+      resolve_dependencies(child_deps, out_dependency_graph);
       resource_list.insert_range(child_deps);
    }
 }
@@ -2,60 +2,72 @@
 
 #include "triglav/NameResolution.hpp"
 #include "triglav/graphics_api/Device.hpp"
-#include "triglav/io/File.hpp"
 
 namespace triglav::resource {
 
+namespace {
+
+std::span<const char> shader_code(const std::span<const u8> contents)
+{
+   return {reinterpret_cast<const char*>(contents.data()), contents.size()};
+}
+
+}// namespace
+
 graphics_api::Shader Loader<ResourceType::FragmentShader>::load_gpu(graphics_api::Device& device, const FragmentShaderName /*name*/,
-                                                                    const io::Path& path)
+                                                                    const std::span<const u8> contents)
 {
-   return GAPI_CHECK(device.create_shader(graphics_api::PipelineStage::FragmentShader, "main", io::read_whole_file(path)));
+   return GAPI_CHECK(device.create_shader(graphics_api::PipelineStage::FragmentShader, "main", shader_code(contents)));
 }
 
 graphics_api::Shader Loader<ResourceType::VertexShader>::load_gpu(graphics_api::Device& device,
-                                                                  [[maybe_unused]] const VertexShaderName name, const io::Path& path)
+                                                                  [[maybe_unused]] const VertexShaderName name,
+                                                                  const std::span<const u8> contents)
 {
-   auto shader = GAPI_CHECK(device.create_shader(graphics_api::PipelineStage::VertexShader, "main", io::read_whole_file(path)));
+   auto shader = GAPI_CHECK(device.create_shader(graphics_api::PipelineStage::VertexShader, "main", shader_code(contents)));
    TG_SET_DEBUG_NAME(shader, resolve_name(name.name()));
    return shader;
 }
 
-graphics_api::Shader Loader<ResourceType::HullShader>::load_gpu(graphics_api::Device& device, HullShaderName name, const io::Path& path)
+graphics_api::Shader Loader<ResourceType::HullShader>::load_gpu(graphics_api::Device& device, HullShaderName name,
+                                                                const std::span<const u8> contents)
 {
-   auto shader = GAPI_CHECK(device.create_shader(graphics_api::PipelineStage::HullShader, "main", io::read_whole_file(path)));
+   auto shader = GAPI_CHECK(device.create_shader(graphics_api::PipelineStage::HullShader, "main", shader_code(contents)));
    TG_SET_DEBUG_NAME(shader, resolve_name(name.name()));
    return shader;
 }
 
-graphics_api::Shader Loader<ResourceType::DomainShader>::load_gpu(graphics_api::Device& device, DomainShaderName name, const io::Path& path)
+graphics_api::Shader Loader<ResourceType::DomainShader>::load_gpu(graphics_api::Device& device, DomainShaderName name,
+                                                                  const std::span<const u8> contents)
 {
-   auto shader = GAPI_CHECK(device.create_shader(graphics_api::PipelineStage::DomainShader, "main", io::read_whole_file(path)));
+   auto shader = GAPI_CHECK(device.create_shader(graphics_api::PipelineStage::DomainShader, "main", shader_code(contents)));
    TG_SET_DEBUG_NAME(shader, resolve_name(name.name()));
    return shader;
 }
 
 graphics_api::Shader Loader<ResourceType::ComputeShader>::load_gpu(graphics_api::Device& device, const ComputeShaderName /*name*/,
-                                                                   const io::Path& path)
+                                                                   const std::span<const u8> contents)
 {
-   return GAPI_CHECK(device.create_shader(graphics_api::PipelineStage::ComputeShader, "main", io::read_whole_file(path)));
+   return GAPI_CHECK(device.create_shader(graphics_api::PipelineStage::ComputeShader, "main", shader_code(contents)));
 }
 
 graphics_api::Shader Loader<ResourceType::RayGenShader>::load_gpu(graphics_api::Device& device, const RayGenShaderName /*name*/,
-                                                                  const io::Path& path)
+                                                                  const std::span<const u8> contents)
 {
-   return GAPI_CHECK(device.create_shader(graphics_api::PipelineStage::RayGenerationShader, "main", io::read_whole_file(path)));
+   return GAPI_CHECK(device.create_shader(graphics_api::PipelineStage::RayGenerationShader, "main", shader_code(contents)));
 }
 
 graphics_api::Shader Loader<ResourceType::RayClosestHitShader>::load_gpu(graphics_api::Device& device,
-                                                                         const RayClosestHitShaderName /*name*/, const io::Path& path)
+                                                                         const RayClosestHitShaderName /*name*/,
+                                                                         const std::span<const u8> contents)
 {
-   return GAPI_CHECK(device.create_shader(graphics_api::PipelineStage::ClosestHitShader, "main", io::read_whole_file(path)));
+   return GAPI_CHECK(device.create_shader(graphics_api::PipelineStage::ClosestHitShader, "main", shader_code(contents)));
 }
 
 graphics_api::Shader Loader<ResourceType::RayMissShader>::load_gpu(graphics_api::Device& device, const RayMissShaderName /*name*/,
-                                                                   const io::Path& path)
+                                                                   const std::span<const u8> contents)
 {
-   return GAPI_CHECK(device.create_shader(graphics_api::PipelineStage::MissShader, "main", io::read_whole_file(path)));
+   return GAPI_CHECK(device.create_shader(graphics_api::PipelineStage::MissShader, "main", shader_code(contents)));
 }
 
 }// namespace triglav::resource
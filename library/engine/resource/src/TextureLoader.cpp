@@ -3,7 +3,9 @@
 #include "triglav/asset/Asset.hpp"
 #include "triglav/graphics_api/Device.hpp"
 #include "triglav/graphics_api/Texture.hpp"
-#include "triglav/io/File.hpp"
+#include "triglav/io/MemoryStream.hpp"
+
+#include <algorithm>
 
 namespace triglav::resource {
 
@@ -14,17 +16,16 @@ using graphics_api::TextureUsage;
 using namespace name_literals;
 
 graphics_api::Texture Loader<ResourceType::Texture>::load_gpu(graphics_api::Device& device, [[maybe_unused]] const TextureName name,
-                                                              const io::Path& path)
+                                                              const std::span<const u8> contents)
 {
-   auto file = io::open_file(path, io::FileMode::Read);
-   assert(file.has_value());
+   io::MemoryStream stream{contents};
 
    [[maybe_unused]]
-   const auto header = asset::decode_header(**file);
+   const auto header = asset::decode_header(stream);
    assert(header.has_value());
    assert(header->type == ResourceType::Texture);
 
-   const auto decoded_tex = asset::decode_texture(**file);
+   const auto decoded_tex = asset::decode_texture(stream, contents.size());
    assert(decoded_tex.has_value());
 
    auto texture = GAPI_CHECK(device.create_texture_from_ktx(
@@ -44,4 +45,16 @@ graphics_api::Texture Loader<ResourceType::Texture>::load_gpu(graphics_api::Devi
    return texture;
 }
 
+MemorySize Loader<ResourceType::Texture>::memory_size(const graphics_api::Texture& texture)
+{
+   // Estimated from the uncompressed pixel size, each mip is a quarter of the previous one.
+   MemorySize result{};
+   MemorySize mip_size = static_cast<MemorySize>(texture.width()) * texture.height() * texture.format().pixel_size();
+   for (u32 mip = 0; mip < texture.mip_count(); ++mip) {
+      result += mip_size;
+      mip_size = std::max<MemorySize>(mip_size / 4, 1);
+   }
+   return result;
+}
+
 }// namespace triglav::resource
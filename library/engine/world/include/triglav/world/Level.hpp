@@ -3,6 +3,7 @@
 #include "LevelNode.hpp"
 
 #include <map>
+#include <optional>
 
 namespace triglav::io {
 class Path;
@@ -10,6 +11,12 @@ class Path;
 
 namespace triglav::world {
 
+enum class LevelFormat
+{
+   Yaml,
+   Binary,
+};
+
 class Level
 {
  public:
@@ -17,9 +24,13 @@ class Level
 
    LevelNode& at(Name id);
    LevelNode& root();
+   [[nodiscard]] const std::map<Name, LevelNode>& nodes() const;
 
    void serialize_yaml(c4::yml::NodeRef& node) const;
-   [[nodiscard]] bool save_to_file(const io::Path& path) const;
+   void deserialize_yaml(const c4::yml::ConstNodeRef& node);
+   [[nodiscard]] bool save_to_file(const io::Path& path, LevelFormat format = LevelFormat::Yaml) const;
+   // Detects the format from the file's content.
+   [[nodiscard]] static std::optional<Level> load_from_file(const io::Path& path);
 
  private:
    std::map<Name, LevelNode> m_nodes;
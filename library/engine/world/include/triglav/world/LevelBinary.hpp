@@ -0,0 +1,85 @@
+#pragma once
+
+#include "Level.hpp"
+
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace triglav::io {
+class IReader;
+class IWriter;
+class Path;
+}// namespace triglav::io
+
+namespace triglav::world {
+
+// Binary levels start with this value, YAML levels never do.
+constexpr u32 g_binary_level_magic = 0x4C564754;
+
+// Level stored the same way as its binary encoding, strings are kept in a single table
+// and static mesh transforms are stored as separate arrays of translations, rotations and scales.
+// Loading it takes a few bulk reads and no allocation per node or static mesh.
+class CompactLevel
+{
+ public:
+   struct StringRef
+   {
+      u32 offset;
+      u32 size;
+   };
+
+   struct ResourceRecord
+   {
+      Name name;
+      StringRef path;
+   };
+
+   struct NodeRecord
+   {
+      StringRef name;
+      u32 first_mesh;
+      u32 mesh_count;
+   };
+
+   struct MeshRecord
+   {
+      StringRef name;
+      u32 mesh_resource;
+      u32 armature_resource;
+   };
+
+   [[nodiscard]] static CompactLevel from_level(const Level& level);
+   // Returns std::nullopt if the data is truncated or any record points outside of its array.
+   [[nodiscard]] static std::optional<CompactLevel> decode(io::IReader& reader);
+   // Detects the format from the file's content, YAML levels get converted.
+   [[nodiscard]] static std::optional<CompactLevel> load_from_file(const io::Path& path);
+
+   [[nodiscard]] bool encode(io::IWriter& writer) const;
+   [[nodiscard]] Level to_level() const;
+
+   [[nodiscard]] std::string_view string(StringRef ref) const;
+   [[nodiscard]] std::span<const NodeRecord> nodes() const;
+   [[nodiscard]] const NodeRecord* find_node(std::string_view name) const;
+
+   [[nodiscard]] std::string_view static_mesh_name(u32 index) const;
+   [[nodiscard]] MeshName static_mesh_resource(u32 index) const;
+   [[nodiscard]] std::optional<ArmatureName> static_mesh_armature(u32 index) const;
+   [[nodiscard]] Transform3D static_mesh_transform(u32 index) const;
+
+ private:
+   std::string m_strings;
+   std::vector<ResourceRecord> m_resources;
+   std::vector<NodeRecord> m_nodes;
+   std::vector<MeshRecord> m_meshes;
+   std::vector<Vector3> m_translations;
+   std::vector<Vector4> m_rotations;
+   std::vector<Vector3> m_scales;
+};
+
+[[nodiscard]] bool encode_level_binary(io::IWriter& writer, const Level& level);
+[[nodiscard]] std::optional<Level> decode_level_binary(io::IReader& reader);
+
+}// namespace triglav::world
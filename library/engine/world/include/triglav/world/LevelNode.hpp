@@ -9,7 +9,8 @@
 
 namespace c4::yml {
 class NodeRef;
-}
+class ConstNodeRef;
+}// namespace c4::yml
 
 namespace triglav::world {
 
@@ -21,6 +22,7 @@ struct StaticMesh
    std::optional<ArmatureName> armature_name{};
 
    void serialize_yaml(c4::yml::NodeRef& node) const;
+   [[nodiscard]] static StaticMesh deserialize_yaml(const c4::yml::ConstNodeRef& node);
 };
 
 class LevelNode
@@ -29,10 +31,13 @@ class LevelNode
    explicit LevelNode(std::string_view name);
 
    void add_static_mesh(StaticMesh&& mesh);
+   void reserve_static_meshes(MemorySize count);
 
-   const std::vector<StaticMesh>& static_meshes();
+   [[nodiscard]] std::string_view name() const;
+   [[nodiscard]] const std::vector<StaticMesh>& static_meshes() const;
 
    void serialize_yaml(c4::yml::NodeRef& node) const;
+   [[nodiscard]] static LevelNode deserialize_yaml(const c4::yml::ConstNodeRef& node);
 
  private:
    std::string m_name;
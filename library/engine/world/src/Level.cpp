@@ -1,5 +1,7 @@
 #include "Level.hpp"
 
+#include "LevelBinary.hpp"
+
 #include "triglav/Ranges.hpp"
 #include "triglav/io/File.hpp"
 
@@ -36,6 +38,11 @@ LevelNode& Level::root()
    return this->at("root"_name);
 }
 
+const std::map<Name, LevelNode>& Level::nodes() const
+{
+   return m_nodes;
+}
+
 void Level::serialize_yaml(c4::yml::NodeRef& node) const
 {
    auto nodes_yaml = node["nodes"];
@@ -47,13 +54,26 @@ void Level::serialize_yaml(c4::yml::NodeRef& node) const
    }
 }
 
-bool Level::save_to_file(const io::Path& path) const
+void Level::deserialize_yaml(const c4::yml::ConstNodeRef& node)
+{
+   for (const auto level_node_yaml : node["nodes"]) {
+      auto level_node = LevelNode::deserialize_yaml(level_node_yaml);
+      const auto id = make_name_id(level_node.name());
+      this->add_node(id, std::move(level_node));
+   }
+}
+
+bool Level::save_to_file(const io::Path& path, const LevelFormat format) const
 {
    const auto file = io::open_file(path, io::FileMode::Write | io::FileMode::Create);
    if (!file.has_value()) {
       return false;
    }
 
+   if (format == LevelFormat::Binary) {
+      return encode_level_binary(**file, *this);
+   }
+
    ryml::Tree tree;
    ryml::NodeRef tree_ref{tree};
    tree_ref |= ryml::MAP;
@@ -63,4 +83,35 @@ bool Level::save_to_file(const io::Path& path) const
    return (*file)->write({reinterpret_cast<const u8*>(str.data()), str.size()}).has_value();
 }
 
+std::optional<Level> Level::load_from_file(const io::Path& path)
+{
+   const auto file = io::open_file(path, io::FileMode::Read);
+   if (!file.has_value()) {
+      return std::nullopt;
+   }
+
+   u32 magic{};
+   if (!(*file)->read_at({reinterpret_cast<u8*>(&magic), sizeof(u32)}, 0).has_value()) {
+      return std::nullopt;
+   }
+   if (magic == g_binary_level_magic) {
+      if ((*file)->seek(io::SeekPosition::Begin, 0) != io::Status::Success) {
+         return std::nullopt;
+      }
+      return decode_level_binary(**file);
+   }
+
+   auto content = io::read_whole_file(path);
+   if (content.empty()) {
+      return std::nullopt;
+   }
+
+   const auto tree = ryml::parse_in_place(c4::substr{const_cast<char*>(path.string().data()), path.string().size()},
+                                          c4::substr{content.data(), content.size()});
+
+   Level result;
+   result.deserialize_yaml(tree.crootref());
+   return result;
+}
+
 }// namespace triglav::world
\ No newline at end of file
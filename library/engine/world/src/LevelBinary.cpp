@@ -0,0 +1,304 @@
+#include "LevelBinary.hpp"
+
+#include "triglav/Ranges.hpp"
+#include "triglav/ResourcePathMap.hpp"
+#include "triglav/io/File.hpp"
+#include "triglav/io/Stream.hpp"
+
+#include <algorithm>
+#include <map>
+
+namespace triglav::world {
+
+constexpr u32 g_binary_level_version = 1;
+constexpr u32 g_no_resource = ~0u;
+
+namespace {
+
+using StringRef = CompactLevel::StringRef;
+using ResourceRecord = CompactLevel::ResourceRecord;
+using NodeRecord = CompactLevel::NodeRecord;
+using MeshRecord = CompactLevel::MeshRecord;
+
+struct BinaryLevelHeader
+{
+   u32 magic;
+   u32 version;
+   u32 string_table_size;
+   u32 resource_count;
+   u32 node_count;
+   u32 mesh_count;
+};
+
+template<typename T>
+bool write_array(io::IWriter& writer, const std::span<const T> values)
+{
+   return writer.write({reinterpret_cast<const u8*>(values.data()), values.size_bytes()}).has_value();
+}
+
+template<typename T>
+bool read_array(io::IReader& reader, const std::span<T> values)
+{
+   const std::span bytes{reinterpret_cast<u8*>(values.data()), values.size_bytes()};
+   MemorySize offset = 0;
+   while (offset < bytes.size()) {
+      const auto bytes_read = reader.read(bytes.subspan(offset));
+      if (!bytes_read.has_value() || *bytes_read == 0) {
+         return false;
+      }
+      offset += *bytes_read;
+   }
+   return true;
+}
+
+class StringTableBuilder
+{
+ public:
+   StringTableBuilder(std::string& data, std::vector<ResourceRecord>& resources) :
+       m_data(data),
+       m_resources(resources)
+   {
+   }
+
+   StringRef add(const std::string_view value)
+   {
+      const StringRef result{static_cast<u32>(m_data.size()), static_cast<u32>(value.size())};
+      m_data.append(value);
+      return result;
+   }
+
+   u32 add_resource(const Name name)
+   {
+      const auto [it, inserted] = m_resource_ids.emplace(name, static_cast<u32>(m_resources.size()));
+      if (inserted) {
+         const auto path = ResourcePathMap::the().resolve(ResourceName{ResourceType::Unknown, name});
+         m_resources.emplace_back(name, this->add({path.data(), path.size()}));
+      }
+      return it->second;
+   }
+
+ private:
+   std::string& m_data;
+   std::vector<ResourceRecord>& m_resources;
+   std::map<Name, u32> m_resource_ids;
+};
+
+bool is_in_table(const StringRef ref, const std::string_view table)
+{
+   return ref.offset <= table.size() && ref.size <= table.size() - ref.offset;
+}
+
+// Registers the path of the resource so the level can be saved back as YAML.
+void register_resource_path(const ResourceRecord& record, const std::string_view string_table)
+{
+   const auto path = string_table.substr(record.path.offset, record.path.size);
+   if (!path.empty() && make_rc_name(path).name() == record.name) {
+      ResourcePathMap::the().store_path({path.data(), path.size()});
+   }
+}
+
+}// namespace
+
+CompactLevel CompactLevel::from_level(const Level& level)
+{
+   CompactLevel result;
+   StringTableBuilder strings(result.m_strings, result.m_resources);
+
+   result.m_nodes.reserve(level.nodes().size());
+   for (const auto& node : Values(level.nodes())) {
+      result.m_nodes.emplace_back(strings.add(node.name()), static_cast<u32>(result.m_meshes.size()),
+                                  static_cast<u32>(node.static_meshes().size()));
+
+      for (const auto& mesh : node.static_meshes()) {
+         const auto armature = mesh.armature_name.has_value() ? strings.add_resource(mesh.armature_name->name()) : g_no_resource;
+         result.m_meshes.emplace_back(strings.add(mesh.name), strings.add_resource(mesh.mesh_name.name()), armature);
+         result.m_translations.emplace_back(mesh.transform.translation);
+         result.m_rotations.emplace_back(mesh.transform.rotation.x, mesh.transform.rotation.y, mesh.transform.rotation.z,
+                                         mesh.transform.rotation.w);
+         result.m_scales.emplace_back(mesh.transform.scale);
+      }
+   }
+
+   return result;
+}
+
+std::optional<CompactLevel> CompactLevel::decode(io::IReader& reader)
+{
+   BinaryLevelHeader header{};
+   if (!read_array(reader, std::span{&header, 1}))
+      return std::nullopt;
+   if (header.magic != g_binary_level_magic || header.version > g_binary_level_version)
+      return std::nullopt;
+
+   CompactLevel result;
+   result.m_strings.resize(header.string_table_size);
+   result.m_resources.resize(header.resource_count);
+   result.m_nodes.resize(header.node_count);
+   result.m_meshes.resize(header.mesh_count);
+   result.m_translations.resize(header.mesh_count);
+   result.m_rotations.resize(header.mesh_count);
+   result.m_scales.resize(header.mesh_count);
+
+   if (!read_array(reader, std::span{result.m_strings}) || !read_array(reader, std::span{result.m_resources}) ||
+       !read_array(reader, std::span{result.m_nodes}) || !read_array(reader, std::span{result.m_meshes}) ||
+       !read_array(reader, std::span{result.m_translations}) || !read_array(reader, std::span{result.m_rotations}) ||
+       !read_array(reader, std::span{result.m_scales})) {
+      return std::nullopt;
+   }
+
+   // Validate all references up front, the accessors don't check them.
+   const std::string_view strings{result.m_strings};
+   for (const auto& resource : result.m_resources) {
+      if (!is_in_table(resource.path, strings))
+         return std::nullopt;
+   }
+   for (const auto& node : result.m_nodes) {
+      if (!is_in_table(node.name, strings) || node.first_mesh > header.mesh_count || node.mesh_count > header.mesh_count - node.first_mesh)
+         return std::nullopt;
+   }
+   for (const auto& mesh : result.m_meshes) {
+      if (!is_in_table(mesh.name, strings) || mesh.mesh_resource >= header.resource_count)
+         return std::nullopt;
+      if (mesh.armature_resource != g_no_resource && mesh.armature_resource >= header.resource_count)
+         return std::nullopt;
+   }
+
+   for (const auto& resource : result.m_resources) {
+      register_resource_path(resource, strings);
+   }
+
+   return result;
+}
+
+std::optional<CompactLevel> CompactLevel::load_from_file(const io::Path& path)
+{
+   const auto file = io::open_file(path, io::FileMode::Read);
+   if (!file.has_value()) {
+      return std::nullopt;
+   }
+
+   u32 magic{};
+   if (!(*file)->read_at({reinterpret_cast<u8*>(&magic), sizeof(u32)}, 0).has_value()) {
+      return std::nullopt;
+   }
+   if (magic == g_binary_level_magic) {
+      if ((*file)->seek(io::SeekPosition::Begin, 0) != io::Status::Success) {
+         return std::nullopt;
+      }
+      return decode(**file);
+   }
+
+   const auto level = Level::load_from_file(path);
+   if (!level.has_value()) {
+      return std::nullopt;
+   }
+   return from_level(*level);
+}
+
+bool CompactLevel::encode(io::IWriter& writer) const
+{
+   const BinaryLevelHeader header{
+      .magic = g_binary_level_magic,
+      .version = g_binary_level_version,
+      .string_table_size = static_cast<u32>(m_strings.size()),
+      .resource_count = static_cast<u32>(m_resources.size()),
+      .node_count = static_cast<u32>(m_nodes.size()),
+      .mesh_count = static_cast<u32>(m_meshes.size()),
+   };
+
+   if (!writer.write({reinterpret_cast<const u8*>(&header), sizeof(BinaryLevelHeader)}).has_value())
+      return false;
+   if (!write_array(writer, std::span{m_strings}))
+      return false;
+   if (!write_array(writer, std::span{m_resources}))
+      return false;
+   if (!write_array(writer, std::span{m_nodes}))
+      return false;
+   if (!write_array(writer, std::span{m_meshes}))
+      return false;
+   if (!write_array(writer, std::span{m_translations}))
+      return false;
+   if (!write_array(writer, std::span{m_rotations}))
+      return false;
+   return write_array(writer, std::span{m_scales});
+}
+
+Level CompactLevel::to_level() const
+{
+   Level result;
+   for (const auto& node_record : m_nodes) {
+      LevelNode node(this->string(node_record.name));
+      node.reserve_static_meshes(node_record.mesh_count);
+
+      for (u32 index = node_record.first_mesh; index < node_record.first_mesh + node_record.mesh_count; ++index) {
+         node.add_static_mesh(StaticMesh{
+            .mesh_name = this->static_mesh_resource(index),
+            .name = std::string{this->static_mesh_name(index)},
+            .transform = this->static_mesh_transform(index),
+            .armature_name = this->static_mesh_armature(index),
+         });
+      }
+
+      result.add_node(make_name_id(node.name()), std::move(node));
+   }
+   return result;
+}
+
+std::string_view CompactLevel::string(const StringRef ref) const
+{
+   return std::string_view{m_strings}.substr(ref.offset, ref.size);
+}
+
+std::span<const CompactLevel::NodeRecord> CompactLevel::nodes() const
+{
+   return m_nodes;
+}
+
+const CompactLevel::NodeRecord* CompactLevel::find_node(const std::string_view name) const
+{
+   const auto it = std::ranges::find_if(m_nodes, [&](const NodeRecord& node) { return this->string(node.name) == name; });
+   return it != m_nodes.end() ? &*it : nullptr;
+}
+
+std::string_view CompactLevel::static_mesh_name(const u32 index) const
+{
+   return this->string(m_meshes[index].name);
+}
+
+MeshName CompactLevel::static_mesh_resource(const u32 index) const
+{
+   return MeshName{m_resources[m_meshes[index].mesh_resource].name};
+}
+
+std::optional<ArmatureName> CompactLevel::static_mesh_armature(const u32 index) const
+{
+   const auto armature = m_meshes[index].armature_resource;
+   if (armature == g_no_resource)
+      return std::nullopt;
+   return ArmatureName{m_resources[armature].name};
+}
+
+Transform3D CompactLevel::static_mesh_transform(const u32 index) const
+{
+   const auto& rotation = m_rotations[index];
+   return Transform3D{
+      .rotation = Quaternion{rotation.w, rotation.x, rotation.y, rotation.z},
+      .scale = m_scales[index],
+      .translation = m_translations[index],
+   };
+}
+
+bool encode_level_binary(io::IWriter& writer, const Level& level)
+{
+   return CompactLevel::from_level(level).encode(writer);
+}
+
+std::optional<Level> decode_level_binary(io::IReader& reader)
+{
+   const auto level = CompactLevel::decode(reader);
+   if (!level.has_value())
+      return std::nullopt;
+   return level->to_level();
+}
+
+}// namespace triglav::world
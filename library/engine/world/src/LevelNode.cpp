@@ -2,7 +2,9 @@
 
 #include "triglav/ResourcePathMap.hpp"
 
+#include <algorithm>
 #include <ryml.hpp>
+#include <string>
 
 namespace triglav::world {
 
@@ -48,6 +50,59 @@ void serialize_transform(ryml::NodeRef& node, const Transform3D& transform)
    serialize_vector3(scale_node, transform.scale);
 }
 
+Vector3 parse_vector3(const ryml::ConstNodeRef node)
+{
+   auto x = node["x"].val();
+   auto y = node["y"].val();
+   auto z = node["z"].val();
+
+   return Vector3{
+      std::stof(std::string{x.data(), x.size()}),
+      std::stof(std::string{y.data(), y.size()}),
+      std::stof(std::string{z.data(), z.size()}),
+   };
+}
+
+Vector4 parse_vector4(const ryml::ConstNodeRef node)
+{
+   auto x = node["x"].val();
+   auto y = node["y"].val();
+   auto z = node["z"].val();
+   auto w = node["w"].val();
+
+   return Vector4{
+      std::stof(std::string{x.data(), x.size()}),
+      std::stof(std::string{y.data(), y.size()}),
+      std::stof(std::string{z.data(), z.size()}),
+      std::stof(std::string{w.data(), w.size()}),
+   };
+}
+
+template<ResourceType CResType>
+TypedName<CResType> to_typed_name(const ryml::csubstr str)
+{
+   if (std::ranges::all_of(str, [](const char c) { return std::isdigit(c); })) {
+      return TypedName<CResType>{std::stoull(std::string{str.data(), str.size()})};
+   }
+
+   return TypedName<CResType>{name_from_path({str.data(), str.size()})};
+}
+
+Transform3D parse_transformation(const ryml::ConstNodeRef node)
+{
+   const auto translation = node["translation"];
+   const auto rotation = node["rotation"];
+   const auto scale = node["scale"];
+
+   const auto rotation_vec4 = parse_vector4(rotation);
+
+   return Transform3D{
+      .rotation = glm::quat{rotation_vec4.w, rotation_vec4.x, rotation_vec4.y, rotation_vec4.z},
+      .scale = parse_vector3(scale),
+      .translation = parse_vector3(translation),
+   };
+}
+
 }// namespace
 
 void StaticMesh::serialize_yaml(ryml::NodeRef& node) const
@@ -65,6 +120,24 @@ void StaticMesh::serialize_yaml(ryml::NodeRef& node) const
    serialize_transform(transform_node, this->transform);
 }
 
+StaticMesh StaticMesh::deserialize_yaml(const ryml::ConstNodeRef& node)
+{
+   const auto mesh_name = node["mesh"].val();
+   const auto name = node["name"].val();
+   std::optional<ArmatureName> armature_name{};
+   if (node.has_child("armature")) {
+      const auto armature = node["armature"].val();
+      armature_name.emplace(name_from_path({armature.data(), armature.size()}));
+   }
+
+   return StaticMesh{
+      .mesh_name = to_typed_name<ResourceType::Mesh>(mesh_name),
+      .name = {name.data(), name.size()},
+      .transform = parse_transformation(node["transform"]),
+      .armature_name = armature_name,
+   };
+}
+
 LevelNode::LevelNode(const std::string_view name) :
     m_name(name)
 {
@@ -72,10 +145,20 @@ LevelNode::LevelNode(const std::string_view name) :
 
 void LevelNode::add_static_mesh(StaticMesh&& mesh)
 {
-   m_static_meshes.emplace_back(mesh);
+   m_static_meshes.emplace_back(std::move(mesh));
+}
+
+void LevelNode::reserve_static_meshes(const MemorySize count)
+{
+   m_static_meshes.reserve(count);
 }
 
-const std::vector<StaticMesh>& LevelNode::static_meshes()
+std::string_view LevelNode::name() const
+{
+   return m_name;
+}
+
+const std::vector<StaticMesh>& LevelNode::static_meshes() const
 {
    return m_static_meshes;
 }
@@ -92,4 +175,20 @@ void LevelNode::serialize_yaml(ryml::NodeRef& node) const
    }
 }
 
+LevelNode LevelNode::deserialize_yaml(const ryml::ConstNodeRef& node)
+{
+   const auto name = node["name"].val();
+   LevelNode result({name.data(), name.size()});
+
+   const auto items = node["items"];
+   result.reserve_static_meshes(items.num_children());
+   for (const auto item : items) {
+      if (item["type"].val() == "static_mesh") {
+         result.add_static_mesh(StaticMesh::deserialize_yaml(item));
+      }
+   }
+
+   return result;
+}
+
 }// namespace triglav::world
\ No newline at end of file
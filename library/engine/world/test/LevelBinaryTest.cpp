@@ -0,0 +1,176 @@
+#include "triglav/io/DynamicWriter.hpp"
+#include "triglav/io/MemoryStream.hpp"
+#include "triglav/testing_core/GTest.hpp"
+#include "triglav/world/LevelBinary.hpp"
+
+#include <cstring>
+#include <vector>
+
+using triglav::ArmatureName;
+using triglav::make_name_id;
+using triglav::make_rc_name;
+using triglav::MeshName;
+using triglav::Quaternion;
+using triglav::Transform3D;
+using triglav::u8;
+using triglav::Vector3;
+using triglav::io::DynamicWriter;
+using triglav::io::MemoryStream;
+using triglav::world::CompactLevel;
+using triglav::world::decode_level_binary;
+using triglav::world::encode_level_binary;
+using triglav::world::Level;
+using triglav::world::LevelNode;
+using triglav::world::StaticMesh;
+
+namespace {
+
+StaticMesh make_mesh(const std::string_view name, const float offset, const bool has_armature)
+{
+   std::optional<ArmatureName> armature_name{};
+   if (has_armature) {
+      armature_name.emplace(make_rc_name("skeleton/player.armature").name());
+   }
+
+   return StaticMesh{
+      .mesh_name = MeshName{make_rc_name("mesh/box.mesh").name()},
+      .name = std::string{name},
+      .transform =
+         Transform3D{
+            .rotation = Quaternion{0.5f, 0.5f, -0.5f, 0.5f},
+            .scale = Vector3{1.0f, 2.0f, 3.0f},
+            .translation = Vector3{offset, -offset, 2 * offset},
+         },
+      .armature_name = armature_name,
+   };
+}
+
+Level make_level()
+{
+   Level level;
+
+   LevelNode root("root");
+   root.add_static_mesh(make_mesh("first", 1.0f, false));
+   root.add_static_mesh(make_mesh("second", 2.0f, true));
+   level.add_node(make_name_id("root"), std::move(root));
+
+   LevelNode empty("empty");
+   level.add_node(make_name_id("empty"), std::move(empty));
+
+   return level;
+}
+
+// Encodes the test level and lets the caller modify the record of its first node.
+template<typename TFunc>
+std::vector<u8> encode_with_modified_node(TFunc&& modify)
+{
+   DynamicWriter writer;
+   EXPECT_TRUE(encode_level_binary(writer, make_level()));
+   std::vector<u8> data(writer.span().begin(), writer.span().end());
+
+   triglav::u32 string_table_size{};
+   triglav::u32 resource_count{};
+   std::memcpy(&string_table_size, data.data() + 2 * sizeof(triglav::u32), sizeof(triglav::u32));
+   std::memcpy(&resource_count, data.data() + 3 * sizeof(triglav::u32), sizeof(triglav::u32));
+
+   const auto node_offset = 6 * sizeof(triglav::u32) + string_table_size + resource_count * sizeof(CompactLevel::ResourceRecord);
+   CompactLevel::NodeRecord node{};
+   std::memcpy(&node, data.data() + node_offset, sizeof(node));
+   modify(node);
+   std::memcpy(data.data() + node_offset, &node, sizeof(node));
+
+   return data;
+}
+
+}// namespace
+
+TEST(LevelBinaryTest, RoundTrip)
+{
+   const auto level = make_level();
+
+   DynamicWriter writer;
+   ASSERT_TRUE(encode_level_binary(writer, level));
+
+   MemoryStream stream(writer.span());
+   auto decoded = decode_level_binary(stream);
+   ASSERT_TRUE(decoded.has_value());
+
+   ASSERT_EQ(decoded->nodes().size(), 2);
+   ASSERT_TRUE(decoded->at(make_name_id("empty")).static_meshes().empty());
+
+   const auto& expected = level.nodes().at(make_name_id("root")).static_meshes();
+   const auto& actual = decoded->root().static_meshes();
+   ASSERT_EQ(actual.size(), expected.size());
+   for (std::size_t i = 0; i < actual.size(); ++i) {
+      ASSERT_EQ(actual[i].name, expected[i].name);
+      ASSERT_EQ(actual[i].mesh_name, expected[i].mesh_name);
+      ASSERT_EQ(actual[i].armature_name, expected[i].armature_name);
+      ASSERT_EQ(actual[i].transform.translation, expected[i].transform.translation);
+      ASSERT_EQ(actual[i].transform.rotation, expected[i].transform.rotation);
+      ASSERT_EQ(actual[i].transform.scale, expected[i].transform.scale);
+   }
+}
+
+TEST(LevelBinaryTest, RejectsTruncatedData)
+{
+   DynamicWriter writer;
+   ASSERT_TRUE(encode_level_binary(writer, make_level()));
+
+   const auto data = writer.span();
+   MemoryStream stream(data.subspan(0, data.size() - 4));
+   ASSERT_FALSE(decode_level_binary(stream).has_value());
+}
+
+TEST(LevelBinaryTest, RejectsYaml)
+{
+   constexpr std::string_view yaml = "nodes:\n  - name: root\n";
+
+   MemoryStream stream({reinterpret_cast<const u8*>(yaml.data()), yaml.size()});
+   ASSERT_FALSE(decode_level_binary(stream).has_value());
+}
+
+TEST(LevelBinaryTest, RejectsStringOutOfBounds)
+{
+   const auto data = encode_with_modified_node([](CompactLevel::NodeRecord& node) { node.name.offset = ~0u - 1; });
+
+   MemoryStream stream(data);
+   ASSERT_FALSE(decode_level_binary(stream).has_value());
+}
+
+TEST(LevelBinaryTest, RejectsOverflowingMeshRange)
+{
+   const auto data = encode_with_modified_node([](CompactLevel::NodeRecord& node) {
+      node.first_mesh = 1;
+      node.mesh_count = ~0u;
+   });
+
+   MemoryStream stream(data);
+   ASSERT_FALSE(decode_level_binary(stream).has_value());
+}
+
+TEST(LevelBinaryTest, CompactLevelKeepsFlatArrays)
+{
+   const auto level = make_level();
+
+   DynamicWriter writer;
+   ASSERT_TRUE(encode_level_binary(writer, level));
+
+   MemoryStream stream(writer.span());
+   const auto compact = CompactLevel::decode(stream);
+   ASSERT_TRUE(compact.has_value());
+   ASSERT_EQ(compact->nodes().size(), 2);
+   ASSERT_EQ(compact->find_node("missing"), nullptr);
+
+   const auto* root = compact->find_node("root");
+   ASSERT_NE(root, nullptr);
+   ASSERT_EQ(root->mesh_count, 2);
+
+   const auto& expected = level.nodes().at(make_name_id("root")).static_meshes();
+   for (triglav::u32 i = 0; i < root->mesh_count; ++i) {
+      const auto index = root->first_mesh + i;
+      ASSERT_EQ(compact->static_mesh_name(index), expected[i].name);
+      ASSERT_EQ(compact->static_mesh_resource(index), expected[i].mesh_name);
+      ASSERT_EQ(compact->static_mesh_armature(index), expected[i].armature_name);
+      ASSERT_EQ(compact->static_mesh_transform(index).translation, expected[i].transform.translation);
+   }
+}
@@ -0,0 +1,150 @@
+#include "triglav/font/Charset.hpp"
+#include "triglav/font/FontManager.hpp"
+#include "triglav/io/CommandLine.hpp"
+
+#include <algorithm>
+#include <array>
+#include <barrier>
+#include <chrono>
+#include <cstring>
+#include <print>
+#include <thread>
+#include <vector>
+
+using triglav::u32;
+using triglav::u8;
+using triglav::font::Charset;
+using triglav::font::FontManger;
+using triglav::font::Typeface;
+using triglav::io::CommandLine;
+
+using namespace triglav::name_literals;
+
+namespace {
+
+constexpr auto g_default_iteration_count = 20;
+constexpr auto g_atlas_sizes = std::array{12, 16, 20, 24, 32, 48, 64, 96};
+constexpr u32 g_atlas_width = 2048;
+
+// Rasterizes the charset and packs the glyphs in rows, the way the glyph atlases are built.
+std::vector<u8> build_atlas(const Typeface& typeface, const int size)
+{
+   std::vector<u8> pixels;
+   u32 x = 0;
+   u32 y = 0;
+   u32 row_height = 0;
+
+   for (const auto rune : Charset::European) {
+      const auto glyph = typeface.render_glyph(size, rune);
+      if (not glyph.has_value())
+         continue;
+
+      if (x + glyph->width > g_atlas_width) {
+         x = 0;
+         y += row_height;
+         row_height = 0;
+      }
+
+      row_height = std::max(row_height, glyph->height);
+      pixels.resize(std::max<size_t>(pixels.size(), static_cast<size_t>(y + row_height) * g_atlas_width));
+      for (u32 row = 0; row < glyph->height; ++row) {
+         std::memcpy(&pixels[(y + row) * g_atlas_width + x], &glyph->data[row * glyph->width], glyph->width);
+      }
+      x += glyph->width;
+   }
+
+   return pixels;
+}
+
+// One thread per atlas that stays alive across the iterations, like the loader threads building the atlases of a typeface.
+class AtlasWorkers
+{
+ public:
+   explicit AtlasWorkers(const Typeface& typeface) :
+       m_typeface(typeface)
+   {
+      for (size_t i = 0; i < g_atlas_sizes.size(); ++i) {
+         m_threads.emplace_back([this, i] {
+            while (true) {
+               m_start.arrive_and_wait();
+               if (m_is_quitting)
+                  return;
+               m_sizes[i] = build_atlas(m_typeface, g_atlas_sizes[i]).size();
+               m_done.arrive_and_wait();
+            }
+         });
+      }
+   }
+
+   ~AtlasWorkers()
+   {
+      m_is_quitting = true;
+      m_start.arrive_and_wait();
+   }
+
+   AtlasWorkers(const AtlasWorkers& other) = delete;
+   AtlasWorkers& operator=(const AtlasWorkers& other) = delete;
+
+   size_t build_atlases()
+   {
+      m_start.arrive_and_wait();
+      m_done.arrive_and_wait();
+
+      size_t total_size = 0;
+      for (const auto size : m_sizes) {
+         total_size += size;
+      }
+      return total_size;
+   }
+
+ private:
+   const Typeface& m_typeface;
+   std::array<size_t, g_atlas_sizes.size()> m_sizes{};
+   std::barrier<> m_start{g_atlas_sizes.size() + 1};
+   std::barrier<> m_done{g_atlas_sizes.size() + 1};
+   bool m_is_quitting = false;
+   std::vector<std::jthread> m_threads;
+};
+
+template<typename TFunc>
+double measure_ms(const int iterations, TFunc func)
+{
+   const auto start = std::chrono::steady_clock::now();
+   for (int i = 0; i < iterations; ++i) {
+      func();
+   }
+   return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / iterations;
+}
+
+}// namespace
+
+int main(const int argc, const char** argv)
+{
+   CommandLine::the().parse(argc, argv);
+   const auto iterations = CommandLine::the().arg_int("iterations"_name).value_or(g_default_iteration_count);
+
+   const FontManger manager;
+   const auto typeface = manager.create_typeface(triglav::io::Path{"regular.typeface"}, 0);
+
+   size_t total_size = 0;
+
+   const auto build_sequentially = [&] {
+      for (const int size : g_atlas_sizes) {
+         total_size += build_atlas(typeface, size).size();
+      }
+   };
+   AtlasWorkers workers(typeface);
+
+   // Opens the face of every thread and fills the FreeType caches before the timing.
+   build_sequentially();
+   total_size += workers.build_atlases();
+
+   const auto sequential_ms = measure_ms(iterations, build_sequentially);
+   const auto parallel_ms = measure_ms(iterations, [&] { total_size += workers.build_atlases(); });
+
+   std::println("{} atlases, {} glyphs each, {} iterations", g_atlas_sizes.size(), Charset::European.count(), iterations);
+   std::println("{:<16} {:>10.2f} ms", "sequential", sequential_ms);
+   std::println("{:<16} {:>10.2f} ms ({:.2f}x)", "parallel", parallel_ms, sequential_ms / parallel_ms);
+
+   return total_size == 0 ? 1 : 0;
+}
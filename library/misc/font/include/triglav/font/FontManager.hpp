@@ -6,6 +6,8 @@
 #include "triglav/io/Path.hpp"
 
 #include <memory>
+#include <mutex>
+#include <span>
 #include <string_view>
 
 namespace triglav::font {
@@ -25,8 +27,13 @@ class FontManger
 
    [[nodiscard]] Typeface create_typeface(const io::Path& path, int variant) const;
 
+   // FreeType requires creating and destroying faces of one library to be serialized.
+   [[nodiscard]] FT_Face open_face(std::span<const u8> font_data, int variant) const;
+   void close_face(FT_Face face) const;
+
  private:
    FT_Library m_library{};
+   mutable std::mutex m_library_mtx;
 };
 
 
@@ -7,12 +7,24 @@
 
 #include <cstdint>
 #include <optional>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
 namespace triglav::font {
 
 using Rune = uint32_t;
 
+enum class GlyphRenderMode : u8
+{
+   Bitmap,
+   // 8-bit signed distance to the glyph outline, 128 marks the edge and higher values are inside.
+   SignedDistanceField,
+};
+
+// Distance in pixels covered by the signed distance field on each side of the outline.
+constexpr i32 g_sdf_spread = 8;
+
 struct RenderedRune
 {
    std::vector<u8> data;
@@ -24,10 +36,27 @@ struct RenderedRune
    i32 bitmap_top;
 };
 
+// Dimensions of a glyph bitmap without rasterizing it.
+struct GlyphMetrics
+{
+   u32 width;
+   u32 height;
+   i32 advance_x;
+   i32 advance_y;
+   i32 bitmap_left;
+   i32 bitmap_top;
+};
+
+class FontManger;
+
+// Keeps the font file in memory and opens a face for each thread that uses it,
+// so the glyphs can be rasterized on several threads at once.
+// Faces of threads that have exited stay open until the typeface is destroyed,
+// use it from long-lived threads such as the thread pool and the rasterizer.
 class Typeface
 {
  public:
-   explicit Typeface(FT_Face face);
+   Typeface(const FontManger& manager, std::vector<u8> font_data, int variant, FT_Face face);
    ~Typeface();
 
    Typeface(const Typeface& other) = delete;
@@ -35,10 +64,18 @@ class Typeface
    Typeface(Typeface&& other) noexcept;
    Typeface& operator=(Typeface&& other) noexcept;
 
-   [[nodiscard]] std::optional<RenderedRune> render_glyph(int size, Rune rune) const;
+   [[nodiscard]] std::optional<RenderedRune> render_glyph(int size, Rune rune, GlyphRenderMode mode = GlyphRenderMode::Bitmap) const;
+   [[nodiscard]] std::optional<GlyphMetrics> glyph_metrics(int size, Rune rune, GlyphRenderMode mode = GlyphRenderMode::Bitmap) const;
 
  private:
-   threading::SafeAccess<FT_Face> m_face{};
+   // Face of the calling thread, opened on first use. The faces are closed with the typeface.
+   [[nodiscard]] FT_Face thread_face() const;
+   void close_faces();
+
+   const FontManger* m_manager;
+   std::vector<u8> m_font_data;
+   int m_variant;
+   mutable threading::SafeReadWriteAccess<std::unordered_map<std::thread::id, FT_Face>> m_faces;
 };
 
 }// namespace triglav::font
\ No newline at end of file
@@ -2,6 +2,8 @@
 
 #include "Charset.hpp"
 
+#include "triglav/io/AsyncFileReader.hpp"
+
 #include <freetype/freetype.h>
 #include <stdexcept>
 
@@ -27,13 +29,36 @@ FontManger::~FontManger()
 
 Typeface FontManger::create_typeface(const io::Path& path, const int variant) const
 {
+   auto font_data = io::read_file_contents(path);
+   if (not font_data.has_value()) {
+      throw std::runtime_error("failed to read typeface");
+   }
+
+   const auto face = this->open_face(*font_data, variant);
+   if (face == nullptr) {
+      throw std::runtime_error("failed to create typeface");
+   }
+
+   return Typeface(*this, std::move(*font_data), variant, face);
+}
+
+FT_Face FontManger::open_face(const std::span<const u8> font_data, const int variant) const
+{
+   std::unique_lock lk{m_library_mtx};
+
    FT_Face face;
-   const auto err = FT_New_Face(m_library, path.string().data(), variant, &face);
+   const auto err = FT_New_Memory_Face(m_library, font_data.data(), static_cast<FT_Long>(font_data.size()), variant, &face);
    if (err != 0) {
-      throw std::runtime_error("failed to create typeface");
+      return nullptr;
    }
 
-   return Typeface(face);
+   return face;
+}
+
+void FontManger::close_face(const FT_Face face) const
+{
+   std::unique_lock lk{m_library_mtx};
+   FT_Done_Face(face);
 }
 
 }// namespace triglav::font
\ No newline at end of file
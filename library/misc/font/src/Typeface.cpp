@@ -1,64 +1,169 @@
 #include "Typeface.hpp"
 
+#include "FontManager.hpp"
+
 #include <cstring>
 #include <freetype/freetype.h>
+#include <freetype/ftoutln.h>
+#include <ranges>
 #include <utility>
 
 namespace triglav::font {
 
-Typeface::Typeface(const FT_Face face) :
-    m_face(face)
+Typeface::Typeface(const FontManger& manager, std::vector<u8> font_data, const int variant, const FT_Face face) :
+    m_manager(&manager),
+    m_font_data(std::move(font_data)),
+    m_variant(variant)
 {
+   m_faces.access()->emplace(std::this_thread::get_id(), face);
 }
 
 Typeface::~Typeface()
 {
-   auto face_access = m_face.access();
-   FT_Done_Face(*face_access);
+   this->close_faces();
 }
 
+// The faces point into the font data, moving the vector keeps its buffer in place.
 Typeface::Typeface(Typeface&& other) noexcept :
-    m_face(std::exchange(other.m_face.access().value(), nullptr))
+    m_manager(std::exchange(other.m_manager, nullptr)),
+    m_font_data(std::move(other.m_font_data)),
+    m_variant(other.m_variant),
+    m_faces(std::exchange(other.m_faces.access().value(), {}))
 {
 }
 
 Typeface& Typeface::operator=(Typeface&& other) noexcept
 {
-   auto other_face_access = other.m_face.access();
-   auto face_access = m_face.access();
-   *face_access = std::exchange(*other_face_access, nullptr);
+   if (this == &other)
+      return *this;
+
+   this->close_faces();
+   m_manager = std::exchange(other.m_manager, nullptr);
+   m_font_data = std::move(other.m_font_data);
+   m_variant = other.m_variant;
+   *m_faces.access() = std::exchange(other.m_faces.access().value(), {});
    return *this;
 }
 
-std::optional<RenderedRune> Typeface::render_glyph(const int size, const Rune rune) const
+FT_Face Typeface::thread_face() const
+{
+   const auto thread_id = std::this_thread::get_id();
+   {
+      auto faces = m_faces.read_access();
+      if (const auto it = faces->find(thread_id); it != faces->end()) {
+         return it->second;
+      }
+   }
+
+   const auto face = m_manager->open_face(m_font_data, m_variant);
+   if (face == nullptr)
+      return nullptr;
+
+   m_faces.access()->emplace(thread_id, face);
+   return face;
+}
+
+void Typeface::close_faces()
+{
+   auto faces = m_faces.access();
+   for (const auto face : std::views::values(*faces)) {
+      m_manager->close_face(face);
+   }
+   faces->clear();
+}
+
+std::optional<RenderedRune> Typeface::render_glyph(const int size, const Rune rune, const GlyphRenderMode mode) const
 {
-   auto face_access = m_face.const_access();
+   const auto face = this->thread_face();
+   if (face == nullptr) {
+      return std::nullopt;
+   }
 
-   if (auto err = FT_Set_Pixel_Sizes(*face_access, 0, size); err != FT_Err_Ok) {
+   if (auto err = FT_Set_Pixel_Sizes(face, 0, size); err != FT_Err_Ok) {
       return std::nullopt;
    }
 
-   const auto index = FT_Get_Char_Index(*face_access, rune);
+   const auto index = FT_Get_Char_Index(face, rune);
 
-   if (auto err = FT_Load_Glyph(*face_access, index, FT_LOAD_DEFAULT); err != FT_Err_Ok) {
+   if (auto err = FT_Load_Glyph(face, index, FT_LOAD_DEFAULT); err != FT_Err_Ok) {
       return std::nullopt;
    }
-   if (auto err = FT_Render_Glyph(face_access.value()->glyph, FT_RENDER_MODE_NORMAL); err != FT_Err_Ok) {
+   const auto render_mode = mode == GlyphRenderMode::SignedDistanceField ? FT_RENDER_MODE_SDF : FT_RENDER_MODE_NORMAL;
+   if (auto err = FT_Render_Glyph(face->glyph, render_mode); err != FT_Err_Ok) {
       return std::nullopt;
    }
 
-   std::vector<u8> data(face_access.value()->glyph->bitmap.width * face_access.value()->glyph->bitmap.rows);
-   std::memcpy(data.data(), face_access.value()->glyph->bitmap.buffer, sizeof(u8) * data.size());
+   const auto& bitmap = face->glyph->bitmap;
+   std::vector<u8> data(bitmap.width * bitmap.rows);
+   for (u32 y = 0; y < bitmap.rows; ++y) {
+      std::memcpy(&data[y * bitmap.width], &bitmap.buffer[static_cast<i32>(y) * bitmap.pitch], sizeof(u8) * bitmap.width);
+   }
 
    return RenderedRune{
       std::move(data),
-      face_access.value()->glyph->bitmap.width,
-      face_access.value()->glyph->bitmap.rows,
-      static_cast<i32>(face_access.value()->glyph->advance.x >> 6),
-      static_cast<i32>(face_access.value()->glyph->advance.y >> 6),
-      face_access.value()->glyph->bitmap_left,
-      face_access.value()->glyph->bitmap_top,
+      face->glyph->bitmap.width,
+      face->glyph->bitmap.rows,
+      static_cast<i32>(face->glyph->advance.x >> 6),
+      static_cast<i32>(face->glyph->advance.y >> 6),
+      face->glyph->bitmap_left,
+      face->glyph->bitmap_top,
+   };
+}
+
+std::optional<GlyphMetrics> Typeface::glyph_metrics(const int size, const Rune rune, const GlyphRenderMode mode) const
+{
+   const auto face = this->thread_face();
+   if (face == nullptr) {
+      return std::nullopt;
+   }
+
+   if (auto err = FT_Set_Pixel_Sizes(face, 0, size); err != FT_Err_Ok) {
+      return std::nullopt;
+   }
+
+   const auto index = FT_Get_Char_Index(face, rune);
+
+   if (auto err = FT_Load_Glyph(face, index, FT_LOAD_DEFAULT); err != FT_Err_Ok) {
+      return std::nullopt;
+   }
+
+   const auto* glyph = face->glyph;
+   const auto advance_x = static_cast<i32>(glyph->advance.x >> 6);
+   const auto advance_y = static_cast<i32>(glyph->advance.y >> 6);
+
+   if (glyph->format != FT_GLYPH_FORMAT_OUTLINE) {
+      return GlyphMetrics{
+         static_cast<u32>(glyph->metrics.width >> 6),
+         static_cast<u32>(glyph->metrics.height >> 6),
+         advance_x,
+         advance_y,
+         static_cast<i32>(glyph->metrics.horiBearingX >> 6),
+         static_cast<i32>(glyph->metrics.horiBearingY >> 6),
+      };
+   }
+
+   // Same pixel grid fitting as the one FreeType applies when rendering the outline.
+   FT_BBox box;
+   FT_Outline_Get_CBox(&glyph->outline, &box);
+   const auto x_min = box.xMin & ~63;
+   const auto y_min = box.yMin & ~63;
+   const auto x_max = (box.xMax + 63) & ~63;
+   const auto y_max = (box.yMax + 63) & ~63;
+
+   GlyphMetrics metrics{
+      static_cast<u32>((x_max - x_min) >> 6), static_cast<u32>((y_max - y_min) >> 6), advance_x, advance_y,
+      static_cast<i32>(x_min >> 6),           static_cast<i32>(y_max >> 6),
    };
+
+   // The distance field extends past the outline by the spread on each side.
+   if (mode == GlyphRenderMode::SignedDistanceField && metrics.width != 0 && metrics.height != 0) {
+      metrics.width += 2 * static_cast<u32>(g_sdf_spread);
+      metrics.height += 2 * static_cast<u32>(g_sdf_spread);
+      metrics.bitmap_left -= g_sdf_spread;
+      metrics.bitmap_top += g_sdf_spread;
+   }
+
+   return metrics;
 }
 
 }// namespace triglav::font
\ No newline at end of file
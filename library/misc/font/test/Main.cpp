@@ -0,0 +1,7 @@
+#include "triglav/testing_core/GTest.hpp"
+
+int main(int argc, char** argv)
+{
+   testing::InitGoogleTest(&argc, argv);
+   return RUN_ALL_TESTS();
+}
@@ -0,0 +1,149 @@
+#include "triglav/font/FontManager.hpp"
+#include "triglav/testing_core/GTest.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+using triglav::font::FontManger;
+using triglav::font::g_sdf_spread;
+using triglav::font::GlyphRenderMode;
+using triglav::font::RenderedRune;
+using triglav::font::Rune;
+using triglav::u32;
+
+namespace {
+
+constexpr int g_sdf_base_size = 48;
+
+triglav::font::Typeface load_typeface(const FontManger& manager)
+{
+   return manager.create_typeface(triglav::io::Path{"regular.typeface"}, 0);
+}
+
+float sample_bitmap(const RenderedRune& glyph, const int x, const int y)
+{
+   if (x < 0 || y < 0 || x >= static_cast<int>(glyph.width) || y >= static_cast<int>(glyph.height))
+      return 0.0f;
+   return static_cast<float>(glyph.data[static_cast<size_t>(y) * glyph.width + static_cast<size_t>(x)]);
+}
+
+// Mirrors the signed distance field sampling done in shader/ui/text_render.slang.
+float sdf_coverage(const RenderedRune& sdf, const float scale, const float glyph_x, const float glyph_y)
+{
+   const float x = glyph_x / scale - static_cast<float>(sdf.bitmap_left) - 0.5f;
+   const float y = static_cast<float>(sdf.bitmap_top) - glyph_y / scale - 0.5f;
+   const float x0 = std::floor(x);
+   const float y0 = std::floor(y);
+   const float tx = x - x0;
+   const float ty = y - y0;
+   const int ix = static_cast<int>(x0);
+   const int iy = static_cast<int>(y0);
+
+   const float top = std::lerp(sample_bitmap(sdf, ix, iy), sample_bitmap(sdf, ix + 1, iy), tx);
+   const float bottom = std::lerp(sample_bitmap(sdf, ix, iy + 1), sample_bitmap(sdf, ix + 1, iy + 1), tx);
+   const float value = std::lerp(top, bottom, ty);
+
+   const float distance = (value - 128.0f) * static_cast<float>(g_sdf_spread) / 128.0f;
+   return std::clamp(distance * scale + 0.5f, 0.0f, 1.0f);
+}
+
+// Average absolute coverage difference between the bitmap glyph and the scaled distance field.
+float compare_with_bitmap(const triglav::font::Typeface& typeface, const Rune rune, const int size)
+{
+   const auto bitmap = typeface.render_glyph(size, rune);
+   const auto sdf = typeface.render_glyph(g_sdf_base_size, rune, GlyphRenderMode::SignedDistanceField);
+   EXPECT_TRUE(bitmap.has_value());
+   EXPECT_TRUE(sdf.has_value());
+
+   const float scale = static_cast<float>(size) / static_cast<float>(g_sdf_base_size);
+
+   float total_error = 0.0f;
+   for (u32 y = 0; y < bitmap->height; ++y) {
+      for (u32 x = 0; x < bitmap->width; ++x) {
+         const float glyph_x = static_cast<float>(bitmap->bitmap_left) + static_cast<float>(x) + 0.5f;
+         const float glyph_y = static_cast<float>(bitmap->bitmap_top) - static_cast<float>(y) - 0.5f;
+         const float expected = sample_bitmap(*bitmap, static_cast<int>(x), static_cast<int>(y)) / 255.0f;
+         total_error += std::abs(sdf_coverage(*sdf, scale, glyph_x, glyph_y) - expected);
+      }
+   }
+
+   return total_error / static_cast<float>(bitmap->width * bitmap->height);
+}
+
+}// namespace
+
+TEST(TypefaceTest, GlyphMetricsMatchRenderedBitmap)
+{
+   const FontManger manager;
+   const auto typeface = load_typeface(manager);
+
+   for (const auto mode : {GlyphRenderMode::Bitmap, GlyphRenderMode::SignedDistanceField}) {
+      for (const Rune rune : {Rune{'A'}, Rune{'g'}, Rune{'O'}, Rune{'%'}, Rune{0x105}}) {
+         const auto metrics = typeface.glyph_metrics(24, rune, mode);
+         const auto glyph = typeface.render_glyph(24, rune, mode);
+         ASSERT_TRUE(metrics.has_value());
+         ASSERT_TRUE(glyph.has_value());
+
+         EXPECT_EQ(metrics->width, glyph->width);
+         EXPECT_EQ(metrics->height, glyph->height);
+         EXPECT_EQ(metrics->bitmap_left, glyph->bitmap_left);
+         EXPECT_EQ(metrics->bitmap_top, glyph->bitmap_top);
+         EXPECT_EQ(metrics->advance_x, glyph->advance_x);
+      }
+   }
+}
+
+TEST(TypefaceTest, SignedDistanceFieldMatchesBitmap)
+{
+   const FontManger manager;
+   const auto typeface = load_typeface(manager);
+
+   for (const int size : {14, 24, 48, 96}) {
+      for (const Rune rune : {'A', 'g', 'O', 'W', '%', '8'}) {
+         EXPECT_LT(compare_with_bitmap(typeface, rune, size), 0.06f) << "rune: " << rune << ", size: " << size;
+      }
+   }
+}
+
+TEST(TypefaceTest, GlyphsRenderedOnSeveralThreadsMatch)
+{
+   const FontManger manager;
+   const auto typeface = load_typeface(manager);
+
+   constexpr auto runes = std::array{Rune{'A'}, Rune{'g'}, Rune{'O'}, Rune{'W'}, Rune{'%'}, Rune{0x105}};
+   constexpr auto sizes = std::array{14, 24, 48, 96};
+
+   std::vector<RenderedRune> expected;
+   for (const int size : sizes) {
+      for (const Rune rune : runes) {
+         expected.push_back(*typeface.render_glyph(size, rune));
+      }
+   }
+
+   // Each thread uses its own face, so they can't disturb each other's pixel size.
+   std::vector<std::vector<RenderedRune>> results(sizes.size());
+   {
+      std::vector<std::jthread> threads;
+      for (size_t i = 0; i < sizes.size(); ++i) {
+         threads.emplace_back([&, i] {
+            for (const int size : sizes) {
+               for (const Rune rune : runes) {
+                  results[i].push_back(*typeface.render_glyph(size, rune));
+               }
+            }
+         });
+      }
+   }
+
+   for (const auto& result : results) {
+      ASSERT_EQ(result.size(), expected.size());
+      for (size_t i = 0; i < result.size(); ++i) {
+         EXPECT_EQ(result[i].data, expected[i].data);
+         EXPECT_EQ(result[i].width, expected[i].width);
+         EXPECT_EQ(result[i].height, expected[i].height);
+      }
+   }
+}
\ No newline at end of file
@@ -6,6 +6,8 @@
 #include "triglav/io/DisplacedStream.hpp"
 #include "triglav/io/File.hpp"
 
+#include <vector>
+
 namespace triglav::gltf {
 
 class BufferManager
@@ -13,7 +15,7 @@ class BufferManager
  public:
    struct BufferWithOffset
    {
-      io::ISeekableStream* stream;
+      io::IFile* file;
       MemoryOffset offset;
    };
 
@@ -22,6 +24,9 @@ class BufferManager
    [[nodiscard]] io::Deserializer read_buffer_view(u32 buffer_view_id, MemoryOffset additional_offset = 0) const;
    [[nodiscard]] io::DisplacedStream buffer_view_to_stream(u32 buffer_view_id, MemoryOffset additional_offset = 0) const;
 
+   // Position-independent read of a buffer view's content, can be called concurrently.
+   [[nodiscard]] io::Result<std::vector<u8>> read_buffer_view_data(u32 buffer_view_id, MemoryOffset additional_offset = 0) const;
+
  private:
    Document& m_document;
    std::vector<BufferWithOffset> m_buffers;
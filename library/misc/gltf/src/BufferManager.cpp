@@ -27,9 +27,9 @@ io::Deserializer BufferManager::read_buffer_view(const u32 buffer_view_id, const
    const auto& buffer_view = m_document.buffer_views.at(buffer_view_id);
 
    auto& buffer = m_buffers.at(buffer_view.buffer);
-   buffer.stream->seek(io::SeekPosition::Begin, buffer.offset + buffer_view.byte_offset + additional_offset);
+   buffer.file->seek(io::SeekPosition::Begin, buffer.offset + buffer_view.byte_offset + additional_offset);
 
-   return io::Deserializer(*buffer.stream);
+   return io::Deserializer(*buffer.file);
 }
 
 io::DisplacedStream BufferManager::buffer_view_to_stream(const u32 buffer_view_id, const MemoryOffset additional_offset) const
@@ -38,8 +38,28 @@ io::DisplacedStream BufferManager::buffer_view_to_stream(const u32 buffer_view_i
    auto& buffer = m_buffers.at(buffer_view.buffer);
    const auto offset = buffer.offset + buffer_view.byte_offset + additional_offset;
 
-   buffer.stream->seek(io::SeekPosition::Begin, offset);
-   return {*buffer.stream, offset, buffer_view.byte_length};
+   buffer.file->seek(io::SeekPosition::Begin, offset);
+   return {*buffer.file, offset, buffer_view.byte_length};
+}
+
+io::Result<std::vector<u8>> BufferManager::read_buffer_view_data(const u32 buffer_view_id, const MemoryOffset additional_offset) const
+{
+   const auto& buffer_view = m_document.buffer_views.at(buffer_view_id);
+   const auto& buffer = m_buffers.at(buffer_view.buffer);
+   if (additional_offset > static_cast<MemoryOffset>(buffer_view.byte_length)) {
+      return std::unexpected(io::Status::BufferTooSmall);
+   }
+
+   std::vector<u8> result(buffer_view.byte_length - additional_offset);
+   const auto read_res = buffer.file->read_at(result, buffer.offset + buffer_view.byte_offset + additional_offset);
+   if (!read_res.has_value()) {
+      return std::unexpected(read_res.error());
+   }
+   if (*read_res != result.size()) {
+      return std::unexpected(io::Status::BufferTooSmall);
+   }
+
+   return result;
 }
 
 }// namespace triglav::gltf
@@ -6,9 +6,11 @@
 
 #include "triglav/Ranges.hpp"
 #include "triglav/io/LimitedReader.hpp"
+#include "triglav/io/MemoryStream.hpp"
 
 #include <format>
 #include <ranges>
+#include <stdexcept>
 #include <unordered_map>
 
 namespace triglav::gltf {
@@ -44,7 +46,13 @@ std::vector<TAccessorType> accessor_to_array(const u32 accessor_id, const Docume
    std::vector<TAccessorType> result;
    result.resize(accessor.count);
 
-   auto buffer_view = buffer_manager.read_buffer_view(accessor.buffer_view, accessor.byte_offset);
+   const auto accessor_data = buffer_manager.read_buffer_view_data(accessor.buffer_view, accessor.byte_offset);
+   if (!accessor_data.has_value()) {
+      throw std::runtime_error(std::format("gltf: failed to read accessor {}", accessor_id));
+   }
+
+   io::MemoryStream accessor_stream(*accessor_data);
+   io::Deserializer buffer_view(accessor_stream);
    if constexpr (std::is_same_v<TAccessorType, Vector4i>) {
       if (accessor.component_type == ComponentType::UnsignedByte) {
          for (const u32 i : Range(0u, accessor.count)) {
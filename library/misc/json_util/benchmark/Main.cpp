@@ -0,0 +1,315 @@
+#include "triglav/ArrayMap.hpp"
+#include "triglav/io/CommandLine.hpp"
+#include "triglav/io/DynamicWriter.hpp"
+#include "triglav/io/StringReader.hpp"
+#include "triglav/json_util/Deserialize.hpp"
+#include "triglav/json_util/JsonUtil.hpp"
+#include "triglav/json_util/Serialize.hpp"
+#include "triglav/meta/Meta.hpp"
+#include "triglav/meta/TypeRegistry.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include <print>
+#include <string>
+#include <vector>
+
+using triglav::io::CommandLine;
+
+using namespace triglav::name_literals;
+
+namespace bench {
+
+enum class Channel
+{
+   Red,
+   Green,
+   Blue,
+   Alpha,
+};
+
+struct Sampler
+{
+   TG_META_BODY(Sampler)
+ public:
+   std::string texture;
+   Channel channel;
+   float scale;
+   float bias;
+};
+
+// Mirrors the shape of material and animation files, many scalar fields and a few nested values.
+struct Material
+{
+   TG_META_BODY(Material)
+ public:
+   std::string name;
+   std::string shader;
+   int priority;
+   float roughness;
+   float metallic;
+   float emission;
+   float opacity;
+   float normal_strength;
+   float displacement;
+   float ior;
+   float sheen;
+   float clearcoat;
+   double anisotropy;
+   triglav::u32 layer_mask;
+   triglav::i64 flags;
+   triglav::Vector3 base_color;
+   triglav::Vector4 tint;
+   Channel alpha_channel;
+   Sampler albedo;
+   Sampler normal;
+   std::vector<Sampler> detail_samplers;
+   std::vector<std::string> tags;
+   std::optional<float> alpha_cutoff;
+   triglav::ArrayMap<std::string, float> parameters;
+};
+
+}// namespace bench
+
+#define TG_TYPE(NS) NS(bench, Channel)
+TG_META_ENUM_BEGIN
+TG_META_ENUM_VALUE(Red)
+TG_META_ENUM_VALUE(Green)
+TG_META_ENUM_VALUE(Blue)
+TG_META_ENUM_VALUE(Alpha)
+TG_META_ENUM_END
+#undef TG_TYPE
+
+#define TG_TYPE(NS) NS(bench, Sampler)
+TG_META_CLASS_BEGIN
+TG_META_PROPERTY(texture, std::string)
+TG_META_PROPERTY(channel, bench::Channel)
+TG_META_PROPERTY(scale, float)
+TG_META_PROPERTY(bias, float)
+TG_META_CLASS_END
+#undef TG_TYPE
+
+#define TG_TYPE(NS) NS(bench, Material)
+TG_META_CLASS_BEGIN
+TG_META_PROPERTY(name, std::string)
+TG_META_PROPERTY(shader, std::string)
+TG_META_PROPERTY(priority, int)
+TG_META_PROPERTY(roughness, float)
+TG_META_PROPERTY(metallic, float)
+TG_META_PROPERTY(emission, float)
+TG_META_PROPERTY(opacity, float)
+TG_META_PROPERTY(normal_strength, float)
+TG_META_PROPERTY(displacement, float)
+TG_META_PROPERTY(ior, float)
+TG_META_PROPERTY(sheen, float)
+TG_META_PROPERTY(clearcoat, float)
+TG_META_PROPERTY(anisotropy, double)
+TG_META_PROPERTY(layer_mask, triglav::u32)
+TG_META_PROPERTY(flags, triglav::i64)
+TG_META_PROPERTY(base_color, triglav::Vector3)
+TG_META_PROPERTY(tint, triglav::Vector4)
+TG_META_PROPERTY(alpha_channel, bench::Channel)
+TG_META_PROPERTY(albedo, bench::Sampler)
+TG_META_PROPERTY(normal, bench::Sampler)
+TG_META_ARRAY_PROPERTY(detail_samplers, bench::Sampler)
+TG_META_ARRAY_PROPERTY(tags, std::string)
+TG_META_OPTIONAL_PROPERTY(alpha_cutoff, float)
+TG_META_MAP_PROPERTY(parameters, std::string, float)
+TG_META_CLASS_END
+#undef TG_TYPE
+
+namespace {
+
+constexpr auto g_default_iteration_count = 20000;
+constexpr auto g_default_sampler_count = 20000;
+constexpr auto g_document_iteration_count = 10;
+
+std::atomic<std::size_t> g_live_bytes{};
+std::atomic<std::size_t> g_peak_bytes{};
+
+// Tracks the heap usage so the peak memory of both deserialization paths can be compared.
+void track_allocation(const std::size_t size)
+{
+   const auto live = g_live_bytes.fetch_add(size, std::memory_order_relaxed) + size;
+   auto peak = g_peak_bytes.load(std::memory_order_relaxed);
+   while (live > peak && !g_peak_bytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+   }
+}
+
+std::size_t reset_peak_bytes()
+{
+   const auto live = g_live_bytes.load(std::memory_order_relaxed);
+   g_peak_bytes.store(live, std::memory_order_relaxed);
+   return live;
+}
+
+bench::Material make_material()
+{
+   bench::Material result{};
+   result.name = "rusty_metal_plate";
+   result.shader = "shader/pbr/material.fshader";
+   result.priority = 3;
+   result.roughness = 0.75f;
+   result.metallic = 1.0f;
+   result.ior = 1.45f;
+   result.anisotropy = 0.125;
+   result.layer_mask = 0xff;
+   result.flags = 1 << 20;
+   result.base_color = {0.5f, 0.25f, 0.125f};
+   result.tint = {1.0f, 1.0f, 1.0f, 0.5f};
+   result.alpha_channel = bench::Channel::Alpha;
+   result.albedo = {"texture/rust_albedo.tex", bench::Channel::Red, 1.0f, 0.0f};
+   result.normal = {"texture/rust_normal.tex", bench::Channel::Green, 2.0f, -0.5f};
+   for (int i = 0; i < 4; ++i) {
+      result.detail_samplers.push_back({"texture/detail.tex", bench::Channel::Blue, static_cast<float>(i), 0.25f});
+      result.tags.push_back("tag");
+   }
+   result.alpha_cutoff = 0.5f;
+   result.parameters = {{"wear", 0.3f}, {"dirt", 0.6f}, {"wetness", 0.0f}};
+   return result;
+}
+
+template<typename TFunc>
+double measure_ns(const int iterations, TFunc func)
+{
+   const auto start = std::chrono::steady_clock::now();
+   for (int i = 0; i < iterations; ++i) {
+      func();
+   }
+   return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / iterations;
+}
+
+const triglav::meta::Member* find_member_linear(const triglav::meta::Type& type, const triglav::Name name)
+{
+   for (const auto& member : type.members) {
+      if (member.name == name)
+         return &member;
+   }
+   return nullptr;
+}
+
+template<typename TFunc>
+void report_document(const std::string_view name, const std::size_t document_size, TFunc func)
+{
+   const auto baseline = reset_peak_bytes();
+   std::size_t extra_bytes = 0;
+   const auto start = std::chrono::steady_clock::now();
+   for (int i = 0; i < g_document_iteration_count; ++i) {
+      extra_bytes = std::max(extra_bytes, func());
+   }
+   const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+   const auto peak_bytes = g_peak_bytes.load(std::memory_order_relaxed) - baseline + extra_bytes;
+   const auto throughput = static_cast<double>(document_size * g_document_iteration_count) / seconds / (1024.0 * 1024.0);
+   std::println("{:<16} {:>10.1f} MiB/s, peak {:>8.1f} KiB", name, throughput, static_cast<double>(peak_bytes) / 1024.0);
+}
+
+}// namespace
+
+void* operator new(const std::size_t size)
+{
+   auto* block = static_cast<std::max_align_t*>(std::malloc(size + sizeof(std::max_align_t)));
+   if (block == nullptr)
+      throw std::bad_alloc{};
+
+   *reinterpret_cast<std::size_t*>(block) = size;
+   track_allocation(size);
+   return block + 1;
+}
+
+void operator delete(void* ptr) noexcept
+{
+   if (ptr == nullptr)
+      return;
+
+   auto* block = static_cast<std::max_align_t*>(ptr) - 1;
+   g_live_bytes.fetch_sub(*reinterpret_cast<std::size_t*>(block), std::memory_order_relaxed);
+   std::free(block);
+}
+
+void operator delete(void* ptr, std::size_t /*size*/) noexcept
+{
+   operator delete(ptr);
+}
+
+int main(const int argc, const char** argv)
+{
+   CommandLine::the().parse(argc, argv);
+   const auto iterations = CommandLine::the().arg_int("iterations"_name).value_or(g_default_iteration_count);
+
+   auto material = make_material();
+
+   triglav::io::DynamicWriter json_writer;
+   triglav::json_util::serialize(material.to_meta_ref(), json_writer);
+   const std::string json{reinterpret_cast<const char*>(json_writer.data()), json_writer.size()};
+
+   const auto serialize_ns = measure_ns(iterations, [&] {
+      triglav::io::DynamicWriter writer(json.size());
+      triglav::json_util::serialize(material.to_meta_ref(), writer);
+   });
+   const auto deserialize_ns = measure_ns(iterations, [&] {
+      bench::Material dst{};
+      triglav::io::StringReader reader(json);
+      triglav::json_util::deserialize(dst.to_meta_ref(), reader);
+   });
+
+   // Looks up every member of the type, the way scripts and the editor access properties by name.
+   const auto& type = triglav::meta::TypeRegistry::the().registered_type("bench::Material"_name);
+   std::vector<triglav::Name> names;
+   for (const auto& member : type.info().members) {
+      names.push_back(member.name);
+   }
+
+   std::size_t found = 0;
+   const auto table_ns = measure_ns(iterations, [&] {
+      for (const auto name : names) {
+         found += type.find_member(name) != nullptr;
+      }
+   });
+   const auto linear_ns = measure_ns(iterations, [&] {
+      for (const auto name : names) {
+         found += find_member_linear(type.info(), name) != nullptr;
+      }
+   });
+
+   std::println("Document of {} bytes, {} iterations", json.size(), iterations);
+   std::println("{:<16} {:>10.1f} ns", "serialize", serialize_ns);
+   std::println("{:<16} {:>10.1f} ns", "deserialize", deserialize_ns);
+   std::println("{:<16} {:>10.1f} ns ({} members)", "lookup table", table_ns, names.size());
+   std::println("{:<16} {:>10.1f} ns ({} members)", "lookup linear", linear_ns, names.size());
+
+   // A large document, like glTF JSON chunks, to compare the streaming reader with building the document first.
+   const auto sampler_count = CommandLine::the().arg_int("samplerCount"_name).value_or(g_default_sampler_count);
+   auto large_material = make_material();
+   large_material.detail_samplers.resize(sampler_count, large_material.albedo);
+
+   triglav::io::DynamicWriter large_writer;
+   triglav::json_util::serialize(large_material.to_meta_ref(), large_writer);
+   const std::string large_json{reinterpret_cast<const char*>(large_writer.data()), large_writer.size()};
+   large_material = {};
+
+   std::println("Document of {} bytes", large_json.size());
+   report_document("streaming", large_json.size(), [&] {
+      bench::Material dst{};
+      triglav::io::StringReader reader(large_json);
+      triglav::json_util::deserialize(dst.to_meta_ref(), reader);
+      found += dst.detail_samplers.size();
+      return std::size_t{0};
+   });
+   report_document("document", large_json.size(), [&] {
+      bench::Material dst{};
+      triglav::io::StringReader reader(large_json);
+      triglav::json_util::RapidJsonInputStream stream(reader);
+      rapidjson::Document doc;
+      doc.ParseStream(stream);
+      triglav::json_util::deserialize_document(dst.to_meta_ref(), doc);
+      found += dst.detail_samplers.size();
+      // The document allocates through rapidjson's own allocator.
+      return doc.GetAllocator().Capacity() + doc.GetStackCapacity();
+   });
+
+   return found == 0 ? 1 : 0;
+}
@@ -1,10 +1,16 @@
 #pragma once
 
 #include "triglav/io/Stream.hpp"
+#include "triglav/json_util/JsonUtil.hpp"
 #include "triglav/meta/Meta.hpp"
 
 namespace triglav::json_util {
 
+// Parses the document in a single pass, writing values into the destination as they are read.
+// On a parse error, values read before the error are kept.
 bool deserialize(const meta::ClassRef& dst, io::IReader& reader);
 
-}
\ No newline at end of file
+// Deserializes a document that has already been parsed.
+bool deserialize_document(const meta::ClassRef& dst, const rapidjson::Value& src);
+
+}// namespace triglav::json_util
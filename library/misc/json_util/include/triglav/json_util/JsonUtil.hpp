@@ -22,13 +22,16 @@
 #pragma warning(pop)
 #endif
 #include <optional>
+#include <vector>
 
-#include "triglav/io/BufferedReader.hpp"
 #include "triglav/io/Path.hpp"
 #include "triglav/io/Stream.hpp"
 
 namespace triglav::json_util {
 
+constexpr MemorySize g_json_read_chunk_size = 64 * 1024;
+
+// Reads the source in large chunks, the parser calls Peek and Take for every character.
 class RapidJsonInputStream
 {
  public:
@@ -36,8 +39,23 @@ class RapidJsonInputStream
 
    explicit RapidJsonInputStream(io::IReader& reader);
 
-   Ch Peek() const;
-   Ch Take();
+   Ch Peek() const
+   {
+      if (m_position == m_bytes_read) [[unlikely]] {
+         this->read_next_chunk();
+      }
+      return m_position < m_bytes_read ? m_buffer[m_position] : '\0';
+   }
+
+   Ch Take()
+   {
+      const auto result = this->Peek();
+      if (m_position < m_bytes_read) {
+         ++m_position;
+      }
+      return result;
+   }
+
    size_t Tell() const;
    Ch* PutBegin();
    void Put(Ch /*c*/);
@@ -45,8 +63,14 @@ class RapidJsonInputStream
    size_t PutEnd(Ch* /*begin*/);
 
  private:
-   mutable io::BufferedReader m_reader;
-   size_t m_total_bytes_read = 0;
+   void read_next_chunk() const;
+
+   io::IReader& m_reader;
+   mutable std::vector<Ch> m_buffer;
+   mutable MemorySize m_position{0};
+   mutable MemorySize m_bytes_read{0};
+   mutable MemorySize m_chunk_offset{0};
+   mutable bool m_is_eof{false};
 };
 
 std::optional<rapidjson::Document> create_document_from_file(const io::Path& path);
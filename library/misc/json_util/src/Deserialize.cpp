@@ -1,5 +1,6 @@
 #include "Deserialize.hpp"
 
+#include "DeserializeHandler.hpp"
 #include "JsonUtil.hpp"
 
 #include "triglav/meta/TypeRegistry.hpp"
@@ -85,9 +86,7 @@ Quaternion read_quaternion(const rapidjson::Value& src)
 #define TG_JSON_GETTER_triglav__Quaternion read_quaternion(val)
 #define TG_JSON_GETTER(x) TG_CONCAT(TG_JSON_GETTER_, x)
 
-void deserialize_class(const meta::ClassRef& dst, const rapidjson::Value& src);
-void deserialize_value(const meta::Ref& dst, const rapidjson::Value& src);
-void deserialize_property_ref(const meta::PropertyRef& dst, const rapidjson::Value& src);
+void deserialize_property(void* handle, const meta::PropertyPlan& plan, const rapidjson::Value& src);
 
 void deserialize_primitive_value(const meta::PropertyRef& dst, const rapidjson::Value& val)
 {
@@ -105,17 +104,22 @@ void deserialize_primitive_value(const meta::PropertyRef& dst, const rapidjson::
    }
 }
 
-void deserialize_class(const meta::ClassRef& dst, const rapidjson::Value& src)
+void deserialize_class(void* handle, const meta::RegisteredType& type, const rapidjson::Value& src)
 {
-   for (const auto property_ref : dst.properties()) {
-      const auto prop_name = property_ref.identifier().data();
-      if (!src.HasMember(prop_name))
+   for (const auto& plan : type.property_plan()) {
+      const auto it = src.FindMember(plan.member->identifier.data());
+      if (it == src.MemberEnd())
          continue;
 
-      deserialize_property_ref(property_ref, src[prop_name]);
+      deserialize_property(handle, plan, it->value);
    }
 }
 
+void deserialize_value(void* handle, const meta::RegisteredType& type, const rapidjson::Value& src)
+{
+   deserialize_property(handle, type.self_plan(), src);
+}
+
 void deserialize_enum(const meta::EnumRef& dst, const rapidjson::Value& src)
 {
    if (src.IsString()) {
@@ -125,15 +129,15 @@ void deserialize_enum(const meta::EnumRef& dst, const rapidjson::Value& src)
    }
 }
 
-void deserialize_array(const meta::ArrayRef& dst, const rapidjson::Value& src)
+void deserialize_array(const meta::ArrayRef& dst, const meta::RegisteredType& type, const rapidjson::Value& src)
 {
    const auto& src_arr = src.GetArray();
    for (const auto& val : src_arr) {
-      deserialize_value(dst.append_ref(), val);
+      deserialize_value(dst.append_ref().raw_handle(), type, val);
    }
 }
 
-void deserialize_map(const meta::MapRef& dst, const rapidjson::Value& src)
+void deserialize_map(const meta::MapRef& dst, const meta::RegisteredType& type, const rapidjson::Value& src)
 {
    const auto& src_obj = src.GetObj();
 
@@ -147,7 +151,7 @@ void deserialize_map(const meta::MapRef& dst, const rapidjson::Value& src)
             continue;
 
          meta::Ref key_ref(&enum_val, dst.key_type());
-         deserialize_value(dst.get_ref(key_ref), val.value);
+         deserialize_value(dst.get_ref(key_ref).raw_handle(), type, val.value);
       }
 
       return;
@@ -157,59 +161,66 @@ void deserialize_map(const meta::MapRef& dst, const rapidjson::Value& src)
       std::string key_name = val.name.GetString();
       meta::Ref key_ref(&key_name, "std::string"_name);
 
-      deserialize_value(dst.get_ref(key_ref), val.value);
+      deserialize_value(dst.get_ref(key_ref).raw_handle(), type, val.value);
    }
 }
 
-void deserialize_optional(const meta::OptionalRef& dst, const rapidjson::Value& src)
+void deserialize_optional(const meta::OptionalRef& dst, const meta::RegisteredType& type, const rapidjson::Value& src)
 {
    if (src.IsNull()) {
       dst.reset();
       return;
    }
-   deserialize_value(dst.get_ref(), src);
+   deserialize_value(dst.get_ref().raw_handle(), type, src);
 }
 
-void deserialize_property_ref(const meta::PropertyRef& dst, const rapidjson::Value& src)
+// Follows the plan resolved for the type, so no type or member is looked up while reading.
+void deserialize_property(void* handle, const meta::PropertyPlan& plan, const rapidjson::Value& src)
 {
-   switch (dst.ref_kind()) {
-   case meta::RefKind::Primitive:
+   const meta::PropertyRef dst{handle, plan.member};
+   if (plan.kind == meta::RefKind::Primitive) {
       deserialize_primitive_value(dst, src);
+      return;
+   }
+   if (plan.type == nullptr)
+      return;
+
+   switch (plan.kind) {
+   case meta::RefKind::Primitive:
       break;
    case meta::RefKind::Class:
-      deserialize_class(dst.to_class_ref(), src);
+      deserialize_class(dst.value_handle(), *plan.type, src);
       break;
    case meta::RefKind::Enum:
-      deserialize_enum(dst.to_enum_ref(), src);
+      deserialize_enum(meta::EnumRef{handle, plan.member, plan.type->info().members}, src);
       break;
    case meta::RefKind::Array:
-      deserialize_array(dst.to_array_ref(), src);
+      deserialize_array(dst.to_array_ref(), *plan.type, src);
       break;
    case meta::RefKind::Map:
-      deserialize_map(dst.to_map_ref(), src);
+      deserialize_map(dst.to_map_ref(), *plan.type, src);
       break;
    case meta::RefKind::Optional:
-      deserialize_optional(dst.to_optional_ref(), src);
+      deserialize_optional(dst.to_optional_ref(), *plan.type, src);
       break;
    }
 }
 
-void deserialize_value(const meta::Ref& dst, const rapidjson::Value& src)
-{
-   deserialize_property_ref(dst.to_property_ref(), src);
-}
-
 bool deserialize(const meta::ClassRef& dst, io::IReader& reader)
 {
    RapidJsonInputStream stream(reader);
+   DeserializeHandler handler(dst);
 
-   rapidjson::Document doc;
-   doc.ParseStream(stream);
-   if (doc.HasParseError()) {
+   rapidjson::Reader json_reader;
+   return !json_reader.Parse(stream, handler).IsError();
+}
+
+bool deserialize_document(const meta::ClassRef& dst, const rapidjson::Value& src)
+{
+   if (!src.IsObject())
       return false;
-   }
 
-   deserialize_value(dst, doc);
+   deserialize_value(dst.raw_handle(), meta::TypeRegistry::the().registered_type(dst.type()), src);
    return true;
 }
 
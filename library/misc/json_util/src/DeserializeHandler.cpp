@@ -0,0 +1,356 @@
+#include "DeserializeHandler.hpp"
+
+#include <span>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace triglav::json_util {
+
+using namespace name_literals;
+
+namespace {
+
+template<typename T>
+void set_scalar(const meta::PropertyRef& dst, const DeserializeHandler::Scalar& value)
+{
+   if constexpr (std::is_arithmetic_v<T>) {
+      std::visit(
+         [&]<typename TValue>(const TValue& scalar) {
+            if constexpr (std::is_arithmetic_v<TValue>) {
+               dst.set<T>(static_cast<T>(scalar));
+            }
+         },
+         value);
+   } else if constexpr (std::is_same_v<T, std::string>) {
+      if (const auto* str = std::get_if<std::string_view>(&value); str != nullptr) {
+         dst.set<T>(std::string{*str});
+      }
+   }
+}
+
+void set_primitive(const meta::PropertyRef& dst, const DeserializeHandler::Scalar& value)
+{
+   switch (dst.type()) {
+#define TG_META_PRIMITIVE(iden, ty_name)  \
+   case make_name_id(TG_STRING(ty_name)): \
+      set_scalar<ty_name>(dst, value);    \
+      break;
+
+      TG_META_PRIMITIVE_LIST
+
+#undef TG_META_PRIMITIVE
+   default:
+      break;
+   }
+}
+
+// Vectors, matrices and quaternions are stored as arrays of numbers, in the same order the serializer writes them.
+template<typename T>
+void set_composite(const meta::PropertyRef& dst, const std::span<const float> values)
+{
+   if constexpr (std::is_same_v<T, Vector2>) {
+      if (values.size() == 2)
+         dst.set<T>(Vector2{values[0], values[1]});
+   } else if constexpr (std::is_same_v<T, Vector3>) {
+      if (values.size() == 3)
+         dst.set<T>(Vector3{values[0], values[1], values[2]});
+   } else if constexpr (std::is_same_v<T, Vector4>) {
+      if (values.size() == 4)
+         dst.set<T>(Vector4{values[0], values[1], values[2], values[3]});
+   } else if constexpr (std::is_same_v<T, Matrix4x4>) {
+      if (values.size() == 16) {
+         Matrix4x4 result{};
+         for (int row = 0; row < 4; ++row) {
+            result[row] = Vector4{values[4 * row], values[4 * row + 1], values[4 * row + 2], values[4 * row + 3]};
+         }
+         dst.set<T>(Matrix4x4{result});
+      }
+   } else if constexpr (std::is_same_v<T, Quaternion>) {
+      if (values.size() == 4)
+         dst.set<T>(Quaternion{values[0], values[1], values[2], values[3]});
+   }
+}
+
+void set_composite_primitive(const meta::PropertyRef& dst, const std::span<const float> values)
+{
+   switch (dst.type()) {
+#define TG_META_PRIMITIVE(iden, ty_name)   \
+   case make_name_id(TG_STRING(ty_name)):  \
+      set_composite<ty_name>(dst, values); \
+      break;
+
+      TG_META_PRIMITIVE_LIST
+
+#undef TG_META_PRIMITIVE
+   default:
+      break;
+   }
+}
+
+bool is_composite_primitive(const Name type)
+{
+   return type == "triglav::Vector2"_name || type == "triglav::Vector3"_name || type == "triglav::Vector4"_name ||
+          type == "triglav::Matrix4x4"_name || type == "triglav::Quaternion"_name;
+}
+
+}// namespace
+
+DeserializeHandler::DeserializeHandler(const meta::ClassRef& dst) :
+    m_root(Target{dst.raw_handle(), meta::TypeRegistry::the().registered_type(dst.type()).self_plan()})
+{
+}
+
+bool DeserializeHandler::Null()
+{
+   return this->on_null();
+}
+
+bool DeserializeHandler::Bool(bool /*value*/)
+{
+   // No boolean primitives are reflected.
+   return this->on_scalar(Scalar{std::monostate{}});
+}
+
+bool DeserializeHandler::Int(const int value)
+{
+   return this->on_scalar(Scalar{static_cast<i64>(value)});
+}
+
+bool DeserializeHandler::Uint(const unsigned value)
+{
+   return this->on_scalar(Scalar{static_cast<u64>(value)});
+}
+
+bool DeserializeHandler::Int64(const int64_t value)
+{
+   return this->on_scalar(Scalar{static_cast<i64>(value)});
+}
+
+bool DeserializeHandler::Uint64(const uint64_t value)
+{
+   return this->on_scalar(Scalar{static_cast<u64>(value)});
+}
+
+bool DeserializeHandler::Double(const double value)
+{
+   return this->on_scalar(Scalar{value});
+}
+
+bool DeserializeHandler::RawNumber(const Ch* str, const rapidjson::SizeType length, const bool copy)
+{
+   return this->String(str, length, copy);
+}
+
+bool DeserializeHandler::String(const Ch* str, const rapidjson::SizeType length, bool /*copy*/)
+{
+   return this->on_scalar(Scalar{std::string_view{str, length}});
+}
+
+bool DeserializeHandler::StartObject()
+{
+   return this->on_start(true);
+}
+
+bool DeserializeHandler::Key(const Ch* str, const rapidjson::SizeType length, bool /*copy*/)
+{
+   if (m_frames.empty())
+      return false;
+
+   auto& frame = m_frames.back();
+   const std::string_view key{str, length};
+
+   if (frame.kind == FrameKind::Class) {
+      const auto* plan = frame.target.plan.type->find_property_plan(make_name_id(key));
+      if (plan != nullptr) {
+         frame.next_target.emplace(frame.target.handle, *plan);
+      } else {
+         frame.next_target.reset();
+      }
+   } else if (frame.kind == FrameKind::Map) {
+      const auto& plan = frame.target.plan;
+      const auto map_ref = meta::PropertyRef{frame.target.handle, plan.member}.to_map_ref();
+
+      frame.next_target.reset();
+      if (map_ref.key_type() == "std::string"_name) {
+         std::string key_value{key};
+         frame.next_target.emplace(map_ref.get_ref(meta::Ref{&key_value, "std::string"_name}).raw_handle(), plan.type->self_plan());
+      } else {
+         // if key is not string we assume it's an enum
+         int enum_value = meta::enum_string_to_value(map_ref.key_type(), key);
+         if (enum_value != -1) {
+            frame.next_target.emplace(map_ref.get_ref(meta::Ref{&enum_value, map_ref.key_type()}).raw_handle(), plan.type->self_plan());
+         }
+      }
+   }
+
+   return true;
+}
+
+bool DeserializeHandler::EndObject(rapidjson::SizeType /*member_count*/)
+{
+   return this->on_end();
+}
+
+bool DeserializeHandler::StartArray()
+{
+   return this->on_start(false);
+}
+
+bool DeserializeHandler::EndArray(rapidjson::SizeType /*element_count*/)
+{
+   if (!m_frames.empty() && m_frames.back().kind == FrameKind::Composite) {
+      const auto& target = m_frames.back().target;
+      const std::span values{m_composite_values.data(), m_composite_count};
+      set_composite_primitive(meta::PropertyRef{target.handle, target.plan.member}, values);
+   }
+   return this->on_end();
+}
+
+std::optional<DeserializeHandler::Target> DeserializeHandler::take_target()
+{
+   if (m_frames.empty())
+      return std::exchange(m_root, std::nullopt);
+
+   auto& frame = m_frames.back();
+   switch (frame.kind) {
+   case FrameKind::Class:
+   case FrameKind::Map:
+      return std::exchange(frame.next_target, std::nullopt);
+   case FrameKind::Array: {
+      const auto& plan = frame.target.plan;
+      const auto array_ref = meta::PropertyRef{frame.target.handle, plan.member}.to_array_ref();
+      return Target{array_ref.append_ref().raw_handle(), plan.type->self_plan()};
+   }
+   case FrameKind::Composite:
+   case FrameKind::Skip:
+      break;
+   }
+   return std::nullopt;
+}
+
+bool DeserializeHandler::on_scalar(const Scalar& value)
+{
+   if (!m_frames.empty() && m_frames.back().kind == FrameKind::Skip)
+      return true;
+
+   if (!m_frames.empty() && m_frames.back().kind == FrameKind::Composite) {
+      if (m_composite_count < m_composite_values.size()) {
+         std::visit(
+            [&]<typename TValue>(const TValue& scalar) {
+               if constexpr (std::is_arithmetic_v<TValue>) {
+                  m_composite_values[m_composite_count++] = static_cast<float>(scalar);
+               }
+            },
+            value);
+      }
+      return true;
+   }
+
+   auto target = this->take_target();
+   if (!target.has_value())
+      return true;
+
+   if (target->plan.kind == meta::RefKind::Optional) {
+      const auto optional_ref = meta::PropertyRef{target->handle, target->plan.member}.to_optional_ref();
+      target.emplace(optional_ref.get_ref().raw_handle(), target->plan.type->self_plan());
+   }
+
+   const meta::PropertyRef dst{target->handle, target->plan.member};
+   if (target->plan.kind == meta::RefKind::Primitive) {
+      set_primitive(dst, value);
+   } else if (target->plan.kind == meta::RefKind::Enum) {
+      const meta::EnumRef enum_ref{target->handle, target->plan.member, target->plan.type->info().members};
+      if (const auto* str = std::get_if<std::string_view>(&value); str != nullptr) {
+         enum_ref.set_string(*str);
+      } else if (const auto* number = std::get_if<i64>(&value); number != nullptr) {
+         enum_ref.set<int>(static_cast<int>(*number));
+      } else if (const auto* unsigned_number = std::get_if<u64>(&value); unsigned_number != nullptr) {
+         enum_ref.set<int>(static_cast<int>(*unsigned_number));
+      }
+   }
+
+   return true;
+}
+
+bool DeserializeHandler::on_null()
+{
+   if (!m_frames.empty() && (m_frames.back().kind == FrameKind::Skip || m_frames.back().kind == FrameKind::Composite))
+      return true;
+
+   const auto target = this->take_target();
+   if (target.has_value() && target->plan.kind == meta::RefKind::Optional) {
+      meta::PropertyRef{target->handle, target->plan.member}.to_optional_ref().reset();
+   }
+   return true;
+}
+
+bool DeserializeHandler::on_start(const bool is_object)
+{
+   if (!m_frames.empty() && (m_frames.back().kind == FrameKind::Skip || m_frames.back().kind == FrameKind::Composite)) {
+      this->push_frame(FrameKind::Skip, {});
+      return true;
+   }
+
+   auto target = this->take_target();
+   if (!target.has_value()) {
+      this->push_frame(FrameKind::Skip, {});
+      return true;
+   }
+
+   if (target->plan.kind == meta::RefKind::Optional) {
+      const auto optional_ref = meta::PropertyRef{target->handle, target->plan.member}.to_optional_ref();
+      target.emplace(optional_ref.get_ref().raw_handle(), target->plan.type->self_plan());
+   }
+
+   const auto kind = target->plan.kind;
+   if (kind != meta::RefKind::Primitive && target->plan.type == nullptr) {
+      this->push_frame(FrameKind::Skip, {});
+      return true;
+   }
+
+   if (is_object && kind == meta::RefKind::Class) {
+      // Members of the class are addressed relative to the class itself.
+      auto* class_handle = meta::PropertyRef{target->handle, target->plan.member}.value_handle();
+      this->push_frame(FrameKind::Class, Target{class_handle, target->plan.type->self_plan()});
+   } else if (is_object && kind == meta::RefKind::Map) {
+      this->push_frame(FrameKind::Map, *target);
+   } else if (!is_object && kind == meta::RefKind::Array) {
+      this->push_frame(FrameKind::Array, *target);
+   } else if (!is_object && kind == meta::RefKind::Primitive &&
+              is_composite_primitive(meta::PropertyRef{target->handle, target->plan.member}.type())) {
+      m_composite_count = 0;
+      this->push_frame(FrameKind::Composite, *target);
+   } else {
+      this->push_frame(FrameKind::Skip, {});
+   }
+   return true;
+}
+
+bool DeserializeHandler::on_end()
+{
+   if (m_frames.empty())
+      return false;
+
+   auto& frame = m_frames.back();
+   if (frame.kind == FrameKind::Skip && frame.skip_depth > 0) {
+      --frame.skip_depth;
+      return true;
+   }
+
+   m_frames.pop_back();
+   return true;
+}
+
+void DeserializeHandler::push_frame(const FrameKind kind, const Target& target)
+{
+   // Nested skipped values only need to be counted.
+   if (kind == FrameKind::Skip && !m_frames.empty() && m_frames.back().kind == FrameKind::Skip) {
+      ++m_frames.back().skip_depth;
+      return;
+   }
+
+   m_frames.push_back(Frame{kind, target, std::nullopt, 0});
+}
+
+}// namespace triglav::json_util
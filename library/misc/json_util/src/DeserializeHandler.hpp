@@ -0,0 +1,81 @@
+#pragma once
+
+#include "JsonUtil.hpp"
+
+#include "triglav/meta/TypeRegistry.hpp"
+
+#include <array>
+#include <optional>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+namespace triglav::json_util {
+
+// Receives the tokens of the document from the SAX reader and writes them directly into the destination object.
+// Members the destination doesn't have and values of unexpected kinds are skipped.
+class DeserializeHandler
+{
+ public:
+   using Ch = char;
+   using Scalar = std::variant<std::monostate, i64, u64, double, std::string_view>;
+
+   explicit DeserializeHandler(const meta::ClassRef& dst);
+
+   bool Null();
+   bool Bool(bool value);
+   bool Int(int value);
+   bool Uint(unsigned value);
+   bool Int64(int64_t value);
+   bool Uint64(uint64_t value);
+   bool Double(double value);
+   bool RawNumber(const Ch* str, rapidjson::SizeType length, bool copy);
+   bool String(const Ch* str, rapidjson::SizeType length, bool copy);
+   bool StartObject();
+   bool Key(const Ch* str, rapidjson::SizeType length, bool copy);
+   bool EndObject(rapidjson::SizeType member_count);
+   bool StartArray();
+   bool EndArray(rapidjson::SizeType element_count);
+
+ private:
+   // Value about to be read, the handle is the object owning the member of the plan.
+   struct Target
+   {
+      void* handle;
+      meta::PropertyPlan plan;
+   };
+
+   enum class FrameKind
+   {
+      Class,
+      Array,
+      Map,
+      Composite,
+      Skip,
+   };
+
+   struct Frame
+   {
+      FrameKind kind;
+      // Class, array or map being filled and for composite primitives the value to assign.
+      Target target;
+      // Target of the value following the last key.
+      std::optional<Target> next_target;
+      u32 skip_depth;
+   };
+
+   std::optional<Target> take_target();
+   bool on_scalar(const Scalar& value);
+   bool on_null();
+   bool on_start(bool is_object);
+   bool on_end();
+   void push_frame(FrameKind kind, const Target& target);
+
+   std::optional<Target> m_root;
+   std::vector<Frame> m_frames;
+   // Components of the vector, matrix or quaternion being read.
+   std::array<float, 16> m_composite_values{};
+   u32 m_composite_count{};
+};
+
+}// namespace triglav::json_util
@@ -5,27 +5,31 @@
 namespace triglav::json_util {
 
 RapidJsonInputStream::RapidJsonInputStream(io::IReader& reader) :
-    m_reader(reader)
+    m_reader(reader),
+    m_buffer(g_json_read_chunk_size)
 {
 }
-RapidJsonInputStream::Ch RapidJsonInputStream::Peek() const
-{
-   if (!m_reader.has_next())
-      return 0;
 
-   return m_reader.peek();
-}
-RapidJsonInputStream::Ch RapidJsonInputStream::Take()
+size_t RapidJsonInputStream::Tell() const
 {
-   if (!m_reader.has_next())
-      return 0;
-
-   m_total_bytes_read += 1;
-   return m_reader.next();
+   return m_chunk_offset + m_position;
 }
-size_t RapidJsonInputStream::Tell() const
+
+void RapidJsonInputStream::read_next_chunk() const
 {
-   return m_total_bytes_read;
+   if (m_is_eof)
+      return;
+
+   m_chunk_offset += m_bytes_read;
+   m_position = 0;
+   m_bytes_read = 0;
+
+   const auto res = m_reader.read({reinterpret_cast<u8*>(m_buffer.data()), m_buffer.size()});
+   if (!res.has_value() || *res == 0) {
+      m_is_eof = true;
+      return;
+   }
+   m_bytes_read = *res;
 }
 
 RapidJsonInputStream::Ch* RapidJsonInputStream::PutBegin()
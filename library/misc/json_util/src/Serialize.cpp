@@ -121,7 +121,7 @@ void write_quaternion(TWriter& writer, Quaternion vec)
 using namespace name_literals;
 
 template<typename TWriter>
-bool serialize_property_ref(TWriter& writer, const meta::PropertyRef& ref);
+bool serialize_property(TWriter& writer, void* handle, const meta::PropertyPlan& plan);
 
 template<typename TWriter>
 bool serialize_primitive(TWriter& writer, const meta::PropertyRef& ref)
@@ -142,13 +142,13 @@ bool serialize_primitive(TWriter& writer, const meta::PropertyRef& ref)
 }
 
 template<typename TWriter>
-bool serialize_class(TWriter& writer, const meta::ClassRef& ref)
+bool serialize_class(TWriter& writer, void* handle, const meta::RegisteredType& type)
 {
    writer.StartObject();
-   for (const meta::PropertyRef property_ref : ref.properties()) {
-      writer.Key(property_ref.identifier().data());
+   for (const auto& plan : type.property_plan()) {
+      writer.Key(plan.member->identifier.data());
 
-      if (!serialize_property_ref(writer, property_ref))
+      if (!serialize_property(writer, handle, plan))
          return false;
    }
    writer.EndObject();
@@ -157,9 +157,9 @@ bool serialize_class(TWriter& writer, const meta::ClassRef& ref)
 }
 
 template<typename TWriter>
-bool serialize_ref(TWriter& writer, const meta::Ref& ref)
+bool serialize_value(TWriter& writer, void* handle, const meta::RegisteredType& type)
 {
-   return serialize_property_ref(writer, ref.to_property_ref());
+   return serialize_property(writer, handle, type.self_plan());
 }
 
 template<typename TWriter>
@@ -170,11 +170,11 @@ bool serialize_enum(TWriter& writer, const meta::EnumRef& ref)
 }
 
 template<typename TWriter>
-bool serialize_array(TWriter& writer, const meta::ArrayRef& ref)
+bool serialize_array(TWriter& writer, const meta::ArrayRef& ref, const meta::RegisteredType& type)
 {
    writer.StartArray();
    for (size_t i = 0; i < ref.size(); ++i) {
-      if (!serialize_ref(writer, ref.at_ref(i)))
+      if (!serialize_value(writer, ref.at_ref(i).raw_handle(), type))
          return false;
    }
    writer.EndArray();
@@ -182,16 +182,19 @@ bool serialize_array(TWriter& writer, const meta::ArrayRef& ref)
 }
 
 template<typename TWriter>
-bool serialize_map_enum_key(TWriter& writer, const meta::MapRef& ref)
+bool serialize_map_enum_key(TWriter& writer, const meta::MapRef& ref, const meta::PropertyPlan& plan)
 {
+   if (plan.key_type == nullptr)
+      return false;
+
    writer.StartObject();
 
    auto key_ref = ref.first_key_ref();
    while (!key_ref.is_nullptr()) {
-      writer.Key(key_ref.to_enum_ref().string().data());
+      const meta::EnumRef key_enum{key_ref.raw_handle(), plan.key_type->self_member(), plan.key_type->info().members};
+      writer.Key(key_enum.string().data());
 
-      auto value_ref = ref.get_ref(key_ref);
-      if (!serialize_ref(writer, value_ref))
+      if (!serialize_value(writer, ref.get_ref(key_ref).raw_handle(), *plan.type))
          return false;
 
       key_ref = ref.next_key_ref(key_ref);
@@ -201,10 +204,10 @@ bool serialize_map_enum_key(TWriter& writer, const meta::MapRef& ref)
 }
 
 template<typename TWriter>
-bool serialize_map(TWriter& writer, const meta::MapRef& ref)
+bool serialize_map(TWriter& writer, const meta::MapRef& ref, const meta::PropertyPlan& plan)
 {
    if (ref.key_type() != "std::string"_name)
-      return serialize_map_enum_key(writer, ref);
+      return serialize_map_enum_key(writer, ref, plan);
 
    writer.StartObject();
 
@@ -212,8 +215,7 @@ bool serialize_map(TWriter& writer, const meta::MapRef& ref)
    while (!key_ref.is_nullptr()) {
       writer.Key(key_ref.as<std::string>().data());
 
-      auto value_ref = ref.get_ref(key_ref);
-      if (!serialize_ref(writer, value_ref))
+      if (!serialize_value(writer, ref.get_ref(key_ref).raw_handle(), *plan.type))
          return false;
 
       key_ref = ref.next_key_ref(key_ref);
@@ -223,32 +225,39 @@ bool serialize_map(TWriter& writer, const meta::MapRef& ref)
 }
 
 template<typename TWriter>
-bool serialize_optional(TWriter& writer, const meta::OptionalRef& ref)
+bool serialize_optional(TWriter& writer, const meta::OptionalRef& ref, const meta::RegisteredType& type)
 {
    if (!ref.has_value()) {
       writer.Null();
       return true;
    }
 
-   return serialize_ref(writer, ref.get_ref());
+   return serialize_value(writer, ref.get_ref().raw_handle(), type);
 }
 
+// Follows the plan resolved for the type, so no type or member is looked up while writing.
 template<typename TWriter>
-bool serialize_property_ref(TWriter& writer, const meta::PropertyRef& ref)
+bool serialize_property(TWriter& writer, void* handle, const meta::PropertyPlan& plan)
 {
-   switch (ref.ref_kind()) {
-   case meta::RefKind::Primitive:
+   const meta::PropertyRef ref{handle, plan.member};
+   if (plan.kind == meta::RefKind::Primitive)
       return serialize_primitive(writer, ref);
+   if (plan.type == nullptr)
+      return false;
+
+   switch (plan.kind) {
+   case meta::RefKind::Primitive:
+      break;
    case meta::RefKind::Class:
-      return serialize_class(writer, ref.to_class_ref());
+      return serialize_class(writer, ref.value_handle(), *plan.type);
    case meta::RefKind::Enum:
-      return serialize_enum(writer, ref.to_enum_ref());
+      return serialize_enum(writer, meta::EnumRef{handle, plan.member, plan.type->info().members});
    case meta::RefKind::Array:
-      return serialize_array(writer, ref.to_array_ref());
+      return serialize_array(writer, ref.to_array_ref(), *plan.type);
    case meta::RefKind::Map:
-      return serialize_map(writer, ref.to_map_ref());
+      return serialize_map(writer, ref.to_map_ref(), plan);
    case meta::RefKind::Optional:
-      return serialize_optional(writer, ref.to_optional_ref());
+      return serialize_optional(writer, ref.to_optional_ref(), *plan.type);
    }
 
    return false;
@@ -260,14 +269,15 @@ using JsonPrettyWriter = rapidjson::PrettyWriter<OutputBuffer>;
 bool serialize(const meta::ClassRef& dst, io::IWriter& writer, const bool pretty_print)
 {
    OutputBuffer output_buffer(writer);
+   const auto& type = meta::TypeRegistry::the().registered_type(dst.type());
 
    if (pretty_print) {
       JsonPrettyWriter json_writer(output_buffer);
       json_writer.SetIndent(' ', 2);
-      return serialize_class(json_writer, dst);
+      return serialize_class(json_writer, dst.raw_handle(), type);
    } else {
       JsonWriter json_writer(output_buffer);
-      return serialize_class(json_writer, dst);
+      return serialize_class(json_writer, dst.raw_handle(), type);
    }
 }
 
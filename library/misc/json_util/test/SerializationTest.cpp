@@ -72,6 +72,25 @@ TG_META_ENUM_VALUE(Sunday)
 TG_META_ENUM_END
 #undef TG_TYPE
 
+struct Transform
+{
+   TG_META_BODY(Transform)
+ public:
+   triglav::Vector3 position;
+   triglav::Vector4 color;
+   std::vector<Contained> children;
+   std::vector<Weekday> days;
+};
+
+#define TG_TYPE(NS) Transform
+TG_META_CLASS_BEGIN
+TG_META_PROPERTY(position, triglav::Vector3)
+TG_META_PROPERTY(color, triglav::Vector4)
+TG_META_ARRAY_PROPERTY(children, Contained)
+TG_META_ARRAY_PROPERTY(days, Weekday)
+TG_META_CLASS_END
+#undef TG_TYPE
+
 TEST(JsonTest, Deserilization)
 {
    static constexpr auto json_string = R"(
@@ -170,3 +189,80 @@ TEST(JsonTest, Serialization)
       ASSERT_EQ(expected_string, result);
    }
 }
+
+TEST(JsonTest, StreamingMatchesDocument)
+{
+   static constexpr auto json_string = R"(
+{
+   "unknown": {"nested": [1, {"foo": 2}, [3, 4]], "bar": "ignored"},
+   "foo": 25,
+   "bar": "escaped \"quote\"",
+   "contained": {"value": 12.37, "extra": [1, 2]},
+   "weekday": "Friday",
+   "colors": ["white", "red", "blue"],
+   "optional_int": 30,
+   "optional_float": null,
+   "float_map": {"pi": 3.1415, "e": 2.7183},
+   "enum_map": {"Friday": 5, "Someday": 6, "Sunday": 7}
+}
+)";
+
+   BasicStruct streamed{};
+   triglav::io::StringReader reader(json_string);
+   ASSERT_TRUE(triglav::json_util::deserialize(streamed.to_meta_ref(), reader));
+
+   rapidjson::Document doc;
+   doc.Parse(json_string);
+   ASSERT_FALSE(doc.HasParseError());
+   BasicStruct parsed{};
+   ASSERT_TRUE(triglav::json_util::deserialize_document(parsed.to_meta_ref(), doc));
+
+   ASSERT_EQ(streamed.foo, 25);
+   ASSERT_EQ(streamed.bar, "escaped \"quote\"");
+   ASSERT_EQ(streamed.contained.value, 12.37);
+   ASSERT_EQ(streamed.enum_map.size(), 2);
+
+   ASSERT_EQ(streamed.foo, parsed.foo);
+   ASSERT_EQ(streamed.bar, parsed.bar);
+   ASSERT_EQ(streamed.contained.value, parsed.contained.value);
+   ASSERT_EQ(streamed.weekday, parsed.weekday);
+   ASSERT_EQ(streamed.colors, parsed.colors);
+   ASSERT_EQ(streamed.optional_int, parsed.optional_int);
+   ASSERT_EQ(streamed.optional_float, parsed.optional_float);
+   ASSERT_EQ(streamed.float_map["pi"], parsed.float_map["pi"]);
+   ASSERT_EQ(streamed.float_map["e"], parsed.float_map["e"]);
+   ASSERT_EQ(streamed.enum_map[Weekday::Friday], parsed.enum_map[Weekday::Friday]);
+   ASSERT_EQ(streamed.enum_map[Weekday::Sunday], parsed.enum_map[Weekday::Sunday]);
+}
+
+TEST(JsonTest, StreamingReadsVectorsAndArrays)
+{
+   Transform transform{};
+   transform.position = {1.0f, -2.5f, 3.0f};
+   transform.color = {0.25f, 0.5f, 0.75f, 1.0f};
+   transform.children = {Contained{1.5}, Contained{-4.0}};
+   transform.days = {Weekday::Monday, Weekday::Sunday};
+
+   triglav::io::DynamicWriter writer(2048);
+   ASSERT_TRUE(triglav::json_util::serialize(transform.to_meta_ref(), writer));
+   const std::string json{reinterpret_cast<const char*>(writer.data()), writer.size()};
+
+   Transform result{};
+   triglav::io::StringReader reader(json);
+   ASSERT_TRUE(triglav::json_util::deserialize(result.to_meta_ref(), reader));
+
+   ASSERT_EQ(result.position, transform.position);
+   ASSERT_EQ(result.color, transform.color);
+   ASSERT_EQ(result.children.size(), 2);
+   ASSERT_EQ(result.children[0].value, 1.5);
+   ASSERT_EQ(result.children[1].value, -4.0);
+   ASSERT_EQ(result.days, transform.days);
+}
+
+TEST(JsonTest, StreamingRejectsMalformedDocument)
+{
+   BasicStruct basic_struct{};
+   triglav::io::StringReader reader(R"({"foo": 25, "bar": )");
+   ASSERT_FALSE(triglav::json_util::deserialize(basic_struct.to_meta_ref(), reader));
+   ASSERT_EQ(basic_struct.foo, 25);
+}
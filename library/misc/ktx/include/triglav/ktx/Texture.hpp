@@ -66,6 +66,8 @@ class Texture
    [[nodiscard]] bool uncompress() const;
    [[nodiscard]] bool is_compressed() const;
    [[nodiscard]] Vector2u dimensions() const;
+   // Only valid for textures with loaded image data.
+   [[nodiscard]] std::span<const u8> image_data(u32 mip_level) const;
    void print_debug_info() const;
    void generate_mipmaps() const;
 
@@ -255,6 +255,15 @@ Vector2u Texture::dimensions() const
    return result;
 }
 
+std::span<const u8> Texture::image_data(const u32 mip_level) const
+{
+   ktx_size_t offset{};
+   if (ktxTexture_GetImageOffset(m_ktxTexture, mip_level, 0, 0, &offset) != KTX_SUCCESS) {
+      return {};
+   }
+   return {ktxTexture_GetData(m_ktxTexture) + offset, ktxTexture_GetImageSize(m_ktxTexture, mip_level)};
+}
+
 void Texture::print_debug_info() const
 {
    std::println(stderr, "Format: {}", static_cast<u32>(ktxTexture2_GetVkFormat(reinterpret_cast<ktxTexture2*>(m_ktxTexture))));
@@ -58,7 +58,7 @@ class Buffer
    Buffer& operator=(Buffer&& other) noexcept;
 
 
-   [[nodiscard]] Status write_indirect(const void* data, size_t size);
+   [[nodiscard]] Status write_indirect(const void* data, size_t size, size_t offset = 0);
    [[nodiscard]] size_t size() const;
    [[nodiscard]] BufferAddress buffer_address() const;
 
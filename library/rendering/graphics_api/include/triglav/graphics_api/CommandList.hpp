@@ -54,6 +54,8 @@ class CommandList
    void copy_buffer(const Buffer& source, const Buffer& dest) const;
    void copy_buffer(const Buffer& source, const Buffer& dest, u32 src_offset, u32 dst_offset, u32 size) const;
    void copy_buffer_to_texture(const Buffer& source, const Texture& destination, int mip_level = 0) const;
+   void copy_buffer_to_texture_regions(const Buffer& source, const Texture& destination,
+                                       std::span<const BufferTextureCopyRegion> regions) const;
    void copy_texture_to_buffer(const Texture& source, const Buffer& destination, int mip_level = 0,
                                TextureState src_texture_state = TextureState::TransferSrc) const;
    void copy_texture(const Texture& source, TextureState src_state, const Texture& destination, TextureState dst_state, u32 src_mip = 0,
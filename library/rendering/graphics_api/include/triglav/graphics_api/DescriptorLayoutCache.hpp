@@ -5,6 +5,7 @@
 
 #include <map>
 #include <span>
+#include <vector>
 
 namespace triglav::graphics_api {
 
@@ -13,12 +14,22 @@ class DescriptorLayoutCache
  public:
    using Hash = u64;
 
+   explicit DescriptorLayoutCache(VkDevice device);
+
    VkDescriptorSetLayout find_layout(std::span<DescriptorBinding> bindings);
 
  private:
-   VkDevice m_device;
+   struct Layout
+   {
+      std::vector<DescriptorBinding> bindings;
+      vulkan::DescriptorSetLayout layout;
+   };
+
    VkDescriptorSetLayout construct_layout(Hash hash, std::span<DescriptorBinding> bindings);
-   std::map<Hash, vulkan::DescriptorSetLayout> m_pools;
+
+   VkDevice m_device;
+   // Layouts with colliding hashes share the bucket, the bindings tell them apart.
+   std::map<Hash, std::vector<Layout>> m_layouts;
 };
 
 }// namespace triglav::graphics_api
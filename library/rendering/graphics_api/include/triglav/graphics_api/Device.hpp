@@ -17,6 +17,7 @@
 
 #include "triglav/ktx/Texture.hpp"
 
+#include <atomic>
 #include <memory>
 #include <span>
 #include <vector>
@@ -68,6 +69,7 @@ class Device
    [[nodiscard]] Result<Buffer> create_buffer(BufferUsageFlags usage, uint64_t size);
    [[nodiscard]] Result<Fence> create_fence() const;
    [[nodiscard]] Result<Semaphore> create_semaphore() const;
+   [[nodiscard]] Result<Semaphore> create_timeline_semaphore(u64 initial_value = 0) const;
    [[nodiscard]] Result<Texture> create_texture_from_ktx(const ktx::Texture& texture, TextureUsageFlags usage_flags,
                                                          TextureState final_state);
    [[nodiscard]] Result<Texture> create_texture(const ColorFormat& format, const Resolution& image_size,
@@ -89,9 +91,14 @@ class Device
    [[nodiscard]] Status submit_command_list(const CommandList& command_list, const Semaphore& wait_semaphore,
                                             const Semaphore& signal_semaphore, const Fence& fence);
    [[nodiscard]] Status submit_command_list_one_time(const CommandList& command_list);
+   // Submits the whole batch with a single call per queue family, the fence is attached to the queue of the last command list.
+   [[nodiscard]] Status submit_batch(const SubmitBatch& batch, const Fence* fence);
+   // Number of queue submissions made by the device so far.
+   [[nodiscard]] u64 submission_count() const;
    [[nodiscard]] VkDevice vulkan_device() const;
    [[nodiscard]] VkPhysicalDevice vulkan_physical_device() const;
    [[nodiscard]] QueueManager& queue_manager();
+   [[nodiscard]] std::span<const QueueFamilyInfo> queue_family_infos() const;
    [[nodiscard]] SamplerCache& sampler_cache();
    [[nodiscard]] DeviceFeatureFlags enabled_features() const;
    [[nodiscard]] Result<ktx::Texture> export_ktx_texture(const Texture& texture);
@@ -110,6 +117,7 @@ class Device
    DeviceFeatureFlags m_enabled_features;
    QueueManager m_queue_manager;
    SamplerCache m_sampler_cache;
+   std::atomic<u64> m_submission_count{0};
 };
 
 using DeviceUPtr = std::unique_ptr<Device>;
@@ -272,6 +272,8 @@ struct DescriptorBinding
    DescriptorType type;
    u32 count;
    PipelineStage stage;
+
+   bool operator==(const DescriptorBinding& other) const = default;
 };
 
 enum class TextureUsage
@@ -330,6 +332,8 @@ enum class TextureState
 
 class Texture;
 
+constexpr u32 g_queue_family_ignored = ~0u;
+
 struct TextureBarrierInfo
 {
    const Texture* texture{};
@@ -337,6 +341,8 @@ struct TextureBarrierInfo
    TextureState target_state;
    int base_mip_level{};
    int mip_level_count{};
+   u32 source_queue_family{g_queue_family_ignored};
+   u32 target_queue_family{g_queue_family_ignored};
 };
 
 struct TextureRegion
@@ -346,6 +352,16 @@ struct TextureRegion
    int mip_level{};
 };
 
+struct BufferTextureCopyRegion
+{
+   MemorySize buffer_offset{};
+   // Row length of the buffer data in texels, zero if the rows are tightly packed.
+   u32 buffer_row_length{};
+   Vector2i texture_offset{};
+   Vector2u extent{};
+   int mip_level{};
+};
+
 enum class SampleCount : uint32_t
 {
    Single = (1 << 0),
@@ -536,7 +552,7 @@ TRIGLAV_DECL_FLAGS(BufferAccess)
 
 struct RenderAttachment
 {
-   Texture* texture;
+   const Texture* texture;
    TextureState state;
    AttachmentAttributeFlags flags;
    ClearValue clear_value;
@@ -560,6 +576,8 @@ struct BufferBarrier
    const Buffer* buffer;
    BufferAccessFlags src_access;
    BufferAccessFlags dst_access;
+   u32 src_queue_family{g_queue_family_ignored};
+   u32 dst_queue_family{g_queue_family_ignored};
 };
 
 enum class QueryType
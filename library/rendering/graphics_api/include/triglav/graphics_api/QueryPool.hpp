@@ -4,6 +4,7 @@
 
 #include "triglav/Int.hpp"
 
+#include <optional>
 #include <span>
 
 namespace triglav::graphics_api {
@@ -19,6 +20,8 @@ class QueryPool
 
    void get_result(std::span<float> out, u32 first) const;
    [[nodiscard]] float get_difference(u32 begin, u32 end) const;
+   // Doesn't wait for the results, timestamps that aren't available yet are set to nullopt.
+   void get_available_timestamps_ns(std::span<std::optional<u64>> out, u32 first) const;
    [[nodiscard]] VkQueryPool vulkan_query_pool() const;
 
  private:
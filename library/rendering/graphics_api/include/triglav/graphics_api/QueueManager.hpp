@@ -10,6 +10,7 @@
 
 #include <atomic>
 #include <mutex>
+#include <optional>
 #include <span>
 #include <vector>
 
@@ -24,6 +25,10 @@ struct QueueFamilyInfo
    WorkTypeFlags flags{WorkType::None};
 };
 
+// Returns position of the family with the fewest capabilities that supports all requested work types,
+// so that compute-only and transfer-only work lands on dedicated families when the device has them.
+[[nodiscard]] std::optional<u32> select_queue_family(std::span<const QueueFamilyInfo> infos, WorkTypeFlags flags);
+
 class QueueManager
 {
  public:
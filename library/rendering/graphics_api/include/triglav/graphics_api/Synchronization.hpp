@@ -3,8 +3,13 @@
 #include "GraphicsApi.hpp"
 #include "vulkan/ObjectWrapper.hpp"
 
+#include <span>
+#include <vector>
+
 namespace triglav::graphics_api {
 
+class CommandList;
+
 DECLARE_VLK_WRAPPED_CHILD_OBJECT(Fence, Device)
 DECLARE_VLK_WRAPPED_CHILD_OBJECT(Semaphore, Device)
 
@@ -27,6 +32,10 @@ class Semaphore
 
    [[nodiscard]] VkSemaphore vulkan_semaphore() const;
 
+   // Only valid for timeline semaphores.
+   [[nodiscard]] u64 counter_value() const;
+   void await(u64 value) const;
+
  private:
    vulkan::Semaphore m_semaphore;
 };
@@ -58,4 +67,36 @@ class SemaphoreArrayView
    size_t m_count;
 };
 
+// Collects command lists with their semaphore operations so that they can be submitted together.
+// Value of a binary semaphore operation is ignored.
+class SubmitBatch
+{
+ public:
+   struct Submit
+   {
+      const CommandList* command_list;
+      u32 wait_offset;
+      u32 wait_count;
+      u32 signal_offset;
+      u32 signal_count;
+   };
+
+   void add_command_list(const CommandList& command_list);
+   void wait_semaphore(const Semaphore& semaphore, u64 value = 0);
+   void wait_semaphores(SemaphoreArrayView semaphores);
+   void signal_semaphore(const Semaphore& semaphore, u64 value = 0);
+   void signal_semaphores(SemaphoreArrayView semaphores);
+   void clear();
+
+   [[nodiscard]] bool is_empty() const;
+   [[nodiscard]] std::span<const Submit> submits() const;
+   [[nodiscard]] std::span<const VkSemaphoreSubmitInfo> waits(const Submit& submit) const;
+   [[nodiscard]] std::span<const VkSemaphoreSubmitInfo> signals(const Submit& submit) const;
+
+ private:
+   std::vector<Submit> m_submits;
+   std::vector<VkSemaphoreSubmitInfo> m_waits;
+   std::vector<VkSemaphoreSubmitInfo> m_signals;
+};
+
 }// namespace triglav::graphics_api
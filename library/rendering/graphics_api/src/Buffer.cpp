@@ -113,7 +113,7 @@ size_t Buffer::size() const
    return m_size;
 }
 
-Status Buffer::write_indirect(const void* data, size_t size)
+Status Buffer::write_indirect(const void* data, const size_t size, const size_t offset)
 {
    auto transfer_buffer = m_device.create_buffer(BufferUsage::HostVisible | BufferUsage::TransferSrc, size);
    if (not transfer_buffer.has_value())
@@ -134,7 +134,11 @@ Status Buffer::write_indirect(const void* data, size_t size)
    if (const auto res = one_time_commands->begin(SubmitType::OneTime); res != Status::Success)
       return res;
 
-   one_time_commands->copy_buffer(*transfer_buffer, *this);
+   if (offset == 0) {
+      one_time_commands->copy_buffer(*transfer_buffer, *this);
+   } else {
+      one_time_commands->copy_buffer(*transfer_buffer, *this, 0, static_cast<u32>(offset), static_cast<u32>(size));
+   }
 
    if (const auto res = one_time_commands->finish(); res != Status::Success)
       return res;
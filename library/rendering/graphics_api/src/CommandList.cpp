@@ -12,6 +12,7 @@
 #include "triglav/Ranges.hpp"
 
 #include <cassert>
+#include <vector>
 
 namespace triglav::graphics_api {
 
@@ -189,6 +190,31 @@ void CommandList::copy_buffer_to_texture(const Buffer& source, const Texture& de
                           &region);
 }
 
+void CommandList::copy_buffer_to_texture_regions(const Buffer& source, const Texture& destination,
+                                                 const std::span<const BufferTextureCopyRegion> regions) const
+{
+   std::vector<VkBufferImageCopy> vk_regions;
+   vk_regions.reserve(regions.size());
+   for (const auto& region : regions) {
+      vk_regions.push_back(VkBufferImageCopy{
+         .bufferOffset = region.buffer_offset,
+         .bufferRowLength = region.buffer_row_length,
+         .bufferImageHeight = 0,
+         .imageSubresource{
+            .aspectMask = vulkan::to_vulkan_aspect_flags(destination.usage_flags()),
+            .mipLevel = static_cast<u32>(region.mip_level),
+            .baseArrayLayer = 0,
+            .layerCount = 1,
+         },
+         .imageOffset{region.texture_offset.x, region.texture_offset.y, 0},
+         .imageExtent{region.extent.x, region.extent.y, 1},
+      });
+   }
+
+   vkCmdCopyBufferToImage(m_command_buffer, source.vulkan_buffer(), destination.vulkan_image(), VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                          static_cast<u32>(vk_regions.size()), vk_regions.data());
+}
+
 void CommandList::copy_texture_to_buffer(const Texture& source, const Buffer& destination, const int mip_level,
                                          const TextureState src_texture_state) const
 {
@@ -285,8 +311,8 @@ void CommandList::texture_barrier(const PipelineStageFlags source_stage, const P
       barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
       barrier.oldLayout = vulkan::to_vulkan_image_layout(info.texture->format(), info.source_state);
       barrier.newLayout = vulkan::to_vulkan_image_layout(info.texture->format(), info.target_state);
-      barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-      barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+      barrier.srcQueueFamilyIndex = info.source_queue_family;
+      barrier.dstQueueFamilyIndex = info.target_queue_family;
       barrier.image = info.texture->vulkan_image();
       barrier.subresourceRange.aspectMask = vulkan::to_vulkan_aspect_flags(info.texture->usage_flags());
       barrier.subresourceRange.baseMipLevel = info.base_mip_level;
@@ -327,8 +353,8 @@ void CommandList::buffer_barrier(const PipelineStageFlags source_stage, const Pi
       vkBarrier.srcAccessMask = vulkan::to_vulkan_access_flags(barrier.src_access);
       vkBarrier.dstAccessMask = vulkan::to_vulkan_access_flags(barrier.dst_access);
       vkBarrier.buffer = barrier.buffer->vulkan_buffer();
-      vkBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-      vkBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+      vkBarrier.srcQueueFamilyIndex = barrier.src_queue_family;
+      vkBarrier.dstQueueFamilyIndex = barrier.dst_queue_family;
       vkBarrier.offset = 0;
       vkBarrier.size = VK_WHOLE_SIZE;
    }
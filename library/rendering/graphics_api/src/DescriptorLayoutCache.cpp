@@ -14,20 +14,28 @@ DescriptorLayoutCache::Hash hash_bindings(const std::span<DescriptorBinding> bin
    DescriptorLayoutCache::Hash result{};
    for (const auto& binding : bindings) {
       result *= 57922373ull;
-      result += 26987ull * binding.count + 15559ull * static_cast<u64>(binding.stage) + 39181ull * static_cast<u64>(binding.type);
+      result += 26987ull * binding.count + 15559ull * static_cast<u64>(binding.stage) + 39181ull * static_cast<u64>(binding.type) +
+                72467ull * binding.binding;
    }
    return result;
 }
 
 }// namespace
 
+DescriptorLayoutCache::DescriptorLayoutCache(const VkDevice device) :
+    m_device(device)
+{
+}
+
 VkDescriptorSetLayout DescriptorLayoutCache::find_layout(const std::span<DescriptorBinding> bindings)
 {
    const auto hash = hash_bindings(bindings);
-   auto it = m_pools.find(hash);
-   if (it != m_pools.end()) {
-      // TODO: Verify no collision happened
-      return *it->second;
+   if (const auto it = m_layouts.find(hash); it != m_layouts.end()) {
+      for (const auto& layout : it->second) {
+         if (std::ranges::equal(layout.bindings, bindings)) {
+            return *layout.layout;
+         }
+      }
    }
 
    return this->construct_layout(hash, bindings);
@@ -56,10 +64,10 @@ VkDescriptorSetLayout DescriptorLayoutCache::construct_layout(const Hash hash, c
       throw std::runtime_error("error creating layout");
    }
 
-   auto [it, success] = m_pools.emplace(hash, std::move(layout));
-   assert(success);
+   auto& bucket = m_layouts[hash];
+   bucket.emplace_back(std::vector<DescriptorBinding>{bindings.begin(), bindings.end()}, std::move(layout));
 
-   return *it->second;
+   return *bucket.back().layout;
 }
 
 }// namespace triglav::graphics_api
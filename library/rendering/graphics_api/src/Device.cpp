@@ -95,7 +95,13 @@ Result<Swapchain> Device::create_swapchain(const Surface& surface, ColorFormat c
    swapchain_info.presentMode = vulkan::to_vulkan_present_mode(present_mode);
    swapchain_info.imageExtent = VkExtent2D{resolution.width, resolution.height};
    swapchain_info.imageFormat = *vulkan_color_format;
-   swapchain_info.imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+   // Rendering directly to the swapchain images requires them to be usable as color attachments.
+   TextureUsageFlags usage_flags{TextureUsage::TransferDst};
+   swapchain_info.imageUsage = VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+   if (capabilities.supportedUsageFlags & VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT) {
+      usage_flags |= TextureUsage::ColorAttachment;
+      swapchain_info.imageUsage |= VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+   }
    if (old_swapchain != nullptr) {
       swapchain_info.oldSwapchain = old_swapchain->vulkan_swapchain();
    }
@@ -150,8 +156,7 @@ Result<Swapchain> Device::create_swapchain(const Surface& surface, ColorFormat c
          return std::unexpected(Status::UnsupportedDevice);
       }
 
-      swapchain_textures.emplace_back(image, std::move(image_view), color_format, TextureUsage::ColorAttachment | TextureUsage::TransferDst,
-                                      resolution.width, resolution.height, 1);
+      swapchain_textures.emplace_back(image, std::move(image_view), color_format, usage_flags, resolution.width, resolution.height, 1);
    }
 
    return Swapchain(m_queue_manager, resolution, std::move(swapchain_textures), std::move(swapchain), color_format);
@@ -269,6 +274,25 @@ Result<Semaphore> Device::create_semaphore() const
    return Semaphore(std::move(semaphore));
 }
 
+Result<Semaphore> Device::create_timeline_semaphore(const u64 initial_value) const
+{
+   VkSemaphoreTypeCreateInfo type_info{};
+   type_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+   type_info.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+   type_info.initialValue = initial_value;
+
+   VkSemaphoreCreateInfo semaphore_info{};
+   semaphore_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+   semaphore_info.pNext = &type_info;
+
+   vulkan::Semaphore semaphore(*m_device);
+   if (semaphore.construct(&semaphore_info) != VK_SUCCESS) {
+      return std::unexpected(Status::UnsupportedDevice);
+   }
+
+   return Semaphore(std::move(semaphore));
+}
+
 Result<Texture> Device::create_texture_from_ktx(const ktx::Texture& texture, const TextureUsageFlags usage_flags,
                                                 const TextureState final_state)
 {
@@ -493,6 +517,7 @@ Status Device::submit_command_list(const CommandList& command_list, const Semaph
    if (auto status = vkQueueSubmit(*queue_accessor, 1, &submit_info, vulkan_fence); status != VK_SUCCESS) {
       return Status::UnsupportedDevice;
    }
+   ++m_submission_count;
 
    return Status::Success;
 }
@@ -523,6 +548,7 @@ Status Device::submit_command_list_one_time(const CommandList& command_list)
    if (vkQueueSubmit(*queue_accessor, 1, &submit_info, nullptr) != VK_SUCCESS) {
       return Status::UnsupportedDevice;
    }
+   ++m_submission_count;
    if (vkQueueWaitIdle(*queue_accessor) != VK_SUCCESS) {
       return Status::UnsupportedDevice;
    }
@@ -530,6 +556,74 @@ Status Device::submit_command_list_one_time(const CommandList& command_list)
    return Status::Success;
 }
 
+Status Device::submit_batch(const SubmitBatch& batch, const Fence* fence)
+{
+   struct QueueSubmits
+   {
+      WorkTypeFlags work_types;
+      u32 queue_index;
+      std::vector<VkSubmitInfo2> submit_infos;
+   };
+
+   const auto submits = batch.submits();
+   if (submits.empty()) {
+      return Status::Success;
+   }
+
+   std::vector<VkCommandBufferSubmitInfo> command_buffer_infos;
+   command_buffer_infos.reserve(submits.size());
+
+   // Queues are submitted in order of their first use.
+   std::vector<QueueSubmits> queue_submits;
+   for (const auto& submit : submits) {
+      auto& cmd_buffer_info = command_buffer_infos.emplace_back(VkCommandBufferSubmitInfo{VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO});
+      cmd_buffer_info.commandBuffer = submit.command_list->vulkan_command_buffer();
+
+      const auto waits = batch.waits(submit);
+      const auto signals = batch.signals(submit);
+
+      VkSubmitInfo2 submit_info{VK_STRUCTURE_TYPE_SUBMIT_INFO_2};
+      submit_info.waitSemaphoreInfoCount = static_cast<u32>(waits.size());
+      submit_info.pWaitSemaphoreInfos = waits.data();
+      submit_info.commandBufferInfoCount = 1;
+      submit_info.pCommandBufferInfos = &cmd_buffer_info;
+      submit_info.signalSemaphoreInfoCount = static_cast<u32>(signals.size());
+      submit_info.pSignalSemaphoreInfos = signals.data();
+
+      const auto work_types = submit.command_list->work_types();
+      const auto queue_index = m_queue_manager.queue_index(work_types);
+      auto it = std::ranges::find_if(queue_submits, [queue_index](const QueueSubmits& qs) { return qs.queue_index == queue_index; });
+      if (it == queue_submits.end()) {
+         it = queue_submits.emplace(queue_submits.end(), work_types, queue_index);
+      }
+      it->submit_infos.emplace_back(submit_info);
+   }
+
+   const auto fence_queue_index = m_queue_manager.queue_index(submits.back().command_list->work_types());
+   for (const auto& queue_submit : queue_submits) {
+      VkFence vulkan_fence{};
+      if (fence != nullptr && queue_submit.queue_index == fence_queue_index) {
+         vulkan_fence = fence->vulkan_fence();
+      }
+
+      auto& queue = m_queue_manager.next_queue(queue_submit.work_types);
+      auto queue_accessor = queue.access();
+
+      if (vkQueueSubmit2(*queue_accessor, static_cast<u32>(queue_submit.submit_infos.size()), queue_submit.submit_infos.data(),
+                         vulkan_fence) != VK_SUCCESS) {
+         return Status::UnsupportedDevice;
+      }
+      ++m_submission_count;
+   }
+
+   return Status::Success;
+}
+
+u64 Device::submission_count() const
+{
+   return m_submission_count.load();
+}
+
 VkDevice Device::vulkan_device() const
 {
    return *m_device;
@@ -545,6 +639,11 @@ QueueManager& Device::queue_manager()
    return m_queue_manager;
 }
 
+std::span<const QueueFamilyInfo> Device::queue_family_infos() const
+{
+   return m_queue_family_infos;
+}
+
 void Device::await_all() const
 {
    vkDeviceWaitIdle(*m_device);
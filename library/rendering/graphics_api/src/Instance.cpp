@@ -239,6 +239,7 @@ Result<DeviceUPtr> Instance::create_device(const Surface* surface, const DeviceP
 
    VkPhysicalDeviceVulkan13Features vulkan13_features{VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES};
    vulkan13_features.dynamicRendering = true;
+   vulkan13_features.synchronization2 = true;
    device_features.pNext = &vulkan13_features;
 
    VkPhysicalDeviceVulkan12Features vulkan12_features{VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES};
@@ -247,6 +248,7 @@ Result<DeviceUPtr> Instance::create_device(const Surface* surface, const DeviceP
    vulkan12_features.bufferDeviceAddress = true;
    vulkan12_features.drawIndirectCount = true;
    vulkan12_features.runtimeDescriptorArray = true;
+   vulkan12_features.timelineSemaphore = true;
    vulkan13_features.pNext = &vulkan12_features;
 
    VkPhysicalDeviceVulkan11Features vulkan11_features{VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_1_FEATURES};
@@ -40,6 +40,23 @@ float QueryPool::get_difference(const u32 begin, const u32 end) const
    return static_cast<float>(timestamps[timestamps.size() - 1] - timestamps[0]) * m_timestamp_period / 1000000.0f;
 }
 
+void QueryPool::get_available_timestamps_ns(std::span<std::optional<u64>> out, const u32 first) const
+{
+   // Each result is followed by its availability.
+   std::vector<u64> results{};
+   results.resize(2 * out.size());
+   vkGetQueryPoolResults(m_query_pool.parent(), *m_query_pool, first, static_cast<u32>(out.size()), sizeof(u64) * results.size(),
+                         results.data(), 2 * sizeof(u64), VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+
+   for (MemorySize i = 0; i < out.size(); ++i) {
+      if (results[2 * i + 1] == 0) {
+         out[i].reset();
+      } else {
+         out[i] = static_cast<u64>(static_cast<double>(results[2 * i]) * m_timestamp_period);
+      }
+   }
+}
+
 VkQueryPool QueryPool::vulkan_query_pool() const
 {
    return *m_query_pool;
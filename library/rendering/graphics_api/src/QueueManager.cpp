@@ -5,6 +5,7 @@
 #include "triglav/Int.hpp"
 #include "triglav/threading/Threading.hpp"
 
+#include <limits>
 #include <stdexcept>
 
 namespace triglav::graphics_api {
@@ -27,6 +28,27 @@ u32 work_type_flag_count(const WorkTypeFlags flags)
 
 }// namespace
 
+std::optional<u32> select_queue_family(const std::span<const QueueFamilyInfo> infos, const WorkTypeFlags flags)
+{
+   std::optional<u32> result{};
+   u32 best_flag_count = std::numeric_limits<u32>::max();
+
+   for (u32 index = 0; index < infos.size(); ++index) {
+      const auto& info = infos[index];
+      if (!(info.flags & flags))
+         continue;
+
+      // On ties the first family wins, which is usually the universal one.
+      const auto flag_count = work_type_flag_count(info.flags);
+      if (flag_count < best_flag_count) {
+         best_flag_count = flag_count;
+         result = index;
+      }
+   }
+
+   return result;
+}
+
 QueueManager::QueueManager(Device& device, const std::span<QueueFamilyInfo> infos) :
     m_semaphore_factory(device),
     m_semaphore_pool(m_semaphore_factory),
@@ -35,21 +57,14 @@ QueueManager::QueueManager(Device& device, const std::span<QueueFamilyInfo> info
 {
    m_queue_indices.fill(std::numeric_limits<u32>::max());
 
-   std::array<u32, 16> queue_counts{};
-   queue_counts.fill(std::numeric_limits<u32>::max());
-
-   u32 index{};
    for (const auto& info : infos) {
       m_queue_groups.emplace_back(std::make_unique<QueueGroup>(device, info));
-      for (u32 flags_int = 1; flags_int < 16; ++flags_int) {
-         const WorkTypeFlags flags{flags_int};
-         const auto flag_count = work_type_flag_count(flags);
-         if (info.flags & flags && queue_counts[flags_int] >= flag_count) {
-            queue_counts[flags_int] = flag_count;
-            m_queue_indices[flags_int] = index;
-         }
+   }
+
+   for (u32 flags_int = 1; flags_int < 16; ++flags_int) {
+      if (const auto index = select_queue_family(infos, WorkTypeFlags{flags_int}); index.has_value()) {
+         m_queue_indices[flags_int] = *index;
       }
-      ++index;
    }
 }
 
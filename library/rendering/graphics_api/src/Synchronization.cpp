@@ -1,7 +1,22 @@
 #include "Synchronization.hpp"
 
+#include <cassert>
+
 namespace triglav::graphics_api {
 
+namespace {
+
+VkSemaphoreSubmitInfo to_semaphore_submit_info(const VkSemaphore semaphore, const u64 value)
+{
+   VkSemaphoreSubmitInfo info{VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO};
+   info.semaphore = semaphore;
+   info.value = value;
+   info.stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+   return info;
+}
+
+}// namespace
+
 Fence::Fence(vulkan::Fence fence) :
     m_fence(std::move(fence))
 {
@@ -28,6 +43,22 @@ VkSemaphore Semaphore::vulkan_semaphore() const
    return *m_semaphore;
 }
 
+u64 Semaphore::counter_value() const
+{
+   u64 value{};
+   vkGetSemaphoreCounterValue(m_semaphore.parent(), *m_semaphore, &value);
+   return value;
+}
+
+void Semaphore::await(const u64 value) const
+{
+   VkSemaphoreWaitInfo wait_info{VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO};
+   wait_info.semaphoreCount = 1;
+   wait_info.pSemaphores = &(*m_semaphore);
+   wait_info.pValues = &value;
+   vkWaitSemaphores(m_semaphore.parent(), &wait_info, UINT64_MAX);
+}
+
 const VkSemaphore* SemaphoreArray::vulkan_semaphores() const
 {
    return m_semaphores.data();
@@ -71,4 +102,68 @@ size_t SemaphoreArrayView::semaphore_count() const
    return m_count;
 }
 
+void SubmitBatch::add_command_list(const CommandList& command_list)
+{
+   m_submits.emplace_back(&command_list, static_cast<u32>(m_waits.size()), 0, static_cast<u32>(m_signals.size()), 0);
+}
+
+void SubmitBatch::wait_semaphore(const Semaphore& semaphore, const u64 value)
+{
+   assert(!m_submits.empty());
+   m_waits.emplace_back(to_semaphore_submit_info(semaphore.vulkan_semaphore(), value));
+   ++m_submits.back().wait_count;
+}
+
+void SubmitBatch::wait_semaphores(const SemaphoreArrayView semaphores)
+{
+   assert(!m_submits.empty());
+   for (size_t i = 0; i < semaphores.semaphore_count(); ++i) {
+      m_waits.emplace_back(to_semaphore_submit_info(semaphores.vulkan_semaphores()[i], 0));
+   }
+   m_submits.back().wait_count += static_cast<u32>(semaphores.semaphore_count());
+}
+
+void SubmitBatch::signal_semaphore(const Semaphore& semaphore, const u64 value)
+{
+   assert(!m_submits.empty());
+   m_signals.emplace_back(to_semaphore_submit_info(semaphore.vulkan_semaphore(), value));
+   ++m_submits.back().signal_count;
+}
+
+void SubmitBatch::signal_semaphores(const SemaphoreArrayView semaphores)
+{
+   assert(!m_submits.empty());
+   for (size_t i = 0; i < semaphores.semaphore_count(); ++i) {
+      m_signals.emplace_back(to_semaphore_submit_info(semaphores.vulkan_semaphores()[i], 0));
+   }
+   m_submits.back().signal_count += static_cast<u32>(semaphores.semaphore_count());
+}
+
+void SubmitBatch::clear()
+{
+   m_submits.clear();
+   m_waits.clear();
+   m_signals.clear();
+}
+
+bool SubmitBatch::is_empty() const
+{
+   return m_submits.empty();
+}
+
+std::span<const SubmitBatch::Submit> SubmitBatch::submits() const
+{
+   return m_submits;
+}
+
+std::span<const VkSemaphoreSubmitInfo> SubmitBatch::waits(const Submit& submit) const
+{
+   return std::span{m_waits}.subspan(submit.wait_offset, submit.wait_count);
+}
+
+std::span<const VkSemaphoreSubmitInfo> SubmitBatch::signals(const Submit& submit) const
+{
+   return std::span{m_signals}.subspan(submit.signal_offset, submit.signal_count);
+}
+
 }// namespace triglav::graphics_api
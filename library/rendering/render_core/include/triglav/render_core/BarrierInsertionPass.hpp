@@ -33,6 +33,8 @@ class BarrierInsertionPass
    void visit(const detail::cmd::ExportBuffer& cmd);
 
    void default_visit(const detail::Command& cmd);
+   // Releases resources handed over to jobs on other queue families.
+   void finish();
 
    [[nodiscard]] std::vector<detail::Command>& commands();
 
@@ -61,6 +63,7 @@ class BarrierInsertionPass
                               std::optional<graphics_api::PipelineStage> last_used_stage = std::nullopt);
 
    void setup_buffer_barrier(BufferRef buff_ref, graphics_api::BufferAccess target_access, graphics_api::PipelineStageFlags target_stages);
+   void add_queue_acquire_barriers();
 
    BuildContext& m_context;
    std::vector<detail::Command> m_commands;
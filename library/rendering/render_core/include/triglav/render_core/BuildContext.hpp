@@ -2,6 +2,7 @@
 
 #include "Job.hpp"
 #include "PipelineCache.hpp"
+#include "QueueSchedule.hpp"
 #include "RenderCore.hpp"
 #include "ResourceStorage.hpp"
 #include "detail/Commands.hpp"
@@ -17,6 +18,7 @@
 #include <deque>
 #include <map>
 #include <optional>
+#include <set>
 #include <variant>
 #include <vector>
 
@@ -74,6 +76,9 @@ class BuildContext
                                           float scale = 1.0f);
    void declare_sized_render_target(Name rt_name, Vector2i rt_dims, graphics_api::ColorFormat rt_format = GAPI_FORMAT(RGBA, UNorm8));
    void declare_sized_depth_target(Name dt_name, Vector2i dt_dims, graphics_api::ColorFormat rt_format = GAPI_FORMAT(D, UNorm16));
+   // Render target backed by textures imported into the resource storage, such as swapchain images.
+   // The job is recorded once per imported texture, the variant is selected with JobGraph::set_import_index.
+   void declare_imported_render_target(Name rt_name, graphics_api::ColorFormat rt_format);
    void declare_buffer(Name buff_name, MemorySize size);
    void declare_staging_buffer(Name buff_name, MemorySize size);
    void declare_proportional_buffer(Name buff_name, float scale, MemorySize stride);
@@ -167,6 +172,7 @@ class BuildContext
 
    // Barriers
    void buffer_barrier(const BufferBarrier& barrier);
+   void texture_barrier(const TextureBarrier& barrier);
 
    // Ray tracing
    void bind_rt_generation_shader(RayGenShaderName ray_gen_shader);
@@ -191,15 +197,27 @@ class BuildContext
    }
 
    Job build_job(PipelineCache& pipeline_cache, ResourceStorage& storage, Name job_name = {});
+   // Records the job with the resources already in the storage, the declarations must be the same as when they were created.
+   Job record_job(PipelineCache& pipeline_cache, ResourceStorage& storage, Name job_name = {});
 
    void write_commands(ResourceStorage& storage, DescriptorStorage& desc_storage, graphics_api::CommandList& cmd_list, PipelineCache& cache,
                        graphics_api::DescriptorPool* pool, u32 frame_index, u32 enabled_flags);
+   // Returns commands of the flag variation with the barriers inserted.
+   [[nodiscard]] std::vector<detail::Command> insert_barriers(u32 enabled_flags);
 
    void create_resources(ResourceStorage& storage);
    [[nodiscard]] std::optional<graphics_api::DescriptorPool> create_descriptor_pool() const;
 
    [[nodiscard]] graphics_api::WorkTypeFlags work_types() const;
    [[nodiscard]] Vector2i screen_size() const;
+   [[nodiscard]] std::vector<ResourceExport> exported_resources() const;
+   [[nodiscard]] std::vector<Name> external_resources() const;
+   // Whether the job accesses resources it doesn't declare, their queue ownership can't be transferred.
+   [[nodiscard]] bool has_untracked_resources() const;
+
+   // Assigns the job to a queue family, resources shared with jobs on other families change their owner.
+   void set_queue_ownership(graphics_api::WorkTypeFlags queue_work_types, std::vector<QueueOwnershipTransfer> releases,
+                            std::vector<QueueOwnershipTransfer> acquires);
 
    void export_texture(Name tex_name, graphics_api::PipelineStage pipeline_stage, graphics_api::TextureState state,
                        graphics_api::TextureUsageFlags flags);
@@ -225,10 +243,13 @@ class BuildContext
                                                        graphics_api::Pipeline& pipeline) const;
    void write_descriptor(ResourceStorage& storage, const graphics_api::DescriptorView& desc_view,
                          const detail::cmd::BindDescriptors& descriptors, u32 frame_index) const;
+   [[nodiscard]] DescriptorStorage::Key descriptor_key(ResourceStorage& storage, const graphics_api::Pipeline& pipeline,
+                                                       const detail::cmd::BindDescriptors& descriptors, u32 frame_index) const;
 
    graphics_api::RenderingInfo create_rendering_info(ResourceStorage& storage, const detail::cmd::BeginRenderPass& begin_render_pass,
                                                      u32 frame_index) const;
    const graphics_api::Texture& resolve_texture_ref(ResourceStorage& storage, TextureRef tex_ref, u32 frame_index) const;
+   const graphics_api::Texture& resolve_named_texture(ResourceStorage& storage, Name tex_name, u32 frame_index) const;
    const graphics_api::TextureView& resolve_texture_view_ref(ResourceStorage& storage, TextureRef tex_ref, u32 frame_index) const;
    const graphics_api::Buffer& resolve_buffer_ref(ResourceStorage& storage, BufferRef buff_ref, u32 frame_index) const;
    void handle_pending_graphic_state();
@@ -283,6 +304,11 @@ class BuildContext
    std::vector<detail::Command> m_commands;
 
    graphics_api::WorkTypeFlags m_work_types{};
+   graphics_api::WorkTypeFlags m_queue_work_types{};
+   std::vector<QueueOwnershipTransfer> m_queue_releases;
+   std::vector<QueueOwnershipTransfer> m_queue_acquires;
+   std::set<Name> m_external_resources;
+   bool m_has_untracked_resources{};
    GraphicPipelineState m_graphic_pipeline_state{};
    ComputePipelineState m_compute_pipeline_state{};
    RayTracingPipelineState m_ray_tracing_pipeline_state{};
@@ -293,6 +319,12 @@ class BuildContext
    std::vector<Name> m_flags;
    std::deque<std::tuple<u32, bool>> m_flag_stack;
    std::vector<detail::cmd::PushConstant> m_pending_push_constants;
+   std::vector<Name> m_profile_zones;
+   u32 m_active_profile_zone{};
+   std::optional<u32> m_first_profile_zone;
+   std::optional<Name> m_imported_render_target;
+   u32 m_import_count{1};
+   u32 m_import_index{0};
 
    std::vector<std::optional<detail::DescriptorAndStage>> m_descriptors;
 };
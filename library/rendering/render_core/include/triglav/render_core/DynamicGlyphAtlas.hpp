@@ -0,0 +1,171 @@
+#pragma once
+
+#include "triglav/Int.hpp"
+#include "triglav/Math.hpp"
+#include "triglav/Name.hpp"
+#include "triglav/font/Typeface.hpp"
+#include "triglav/graphics_api/Buffer.hpp"
+#include "triglav/graphics_api/CommandList.hpp"
+#include "triglav/graphics_api/Synchronization.hpp"
+#include "triglav/graphics_api/Texture.hpp"
+
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace triglav::graphics_api {
+class Device;
+}
+
+namespace triglav::render_core {
+
+using GlyphIndex = u32;
+
+// Index 0 is reserved and describes an empty glyph.
+constexpr GlyphIndex g_empty_glyph_index = 0;
+
+struct GlyphInfo
+{
+   Vector2 tex_coord_top_left;
+   Vector2 tex_coord_bottom_right;
+   Vector2 size;
+   Vector2 advance;
+   Vector2 padding;
+   u32 atlas_page;
+   u32 reserved;
+};
+
+static_assert(sizeof(GlyphInfo) % 16 == 0);
+
+struct GlyphKey
+{
+   TypefaceName typeface;
+   int font_size;
+   font::Rune rune;
+   font::GlyphRenderMode render_mode;
+
+   auto operator<=>(const GlyphKey& other) const = default;
+};
+
+enum class GlyphResidency : u8
+{
+   MetricsOnly,
+   Pending,
+   Resident,
+};
+
+// Glyph atlas shared by all typefaces and font sizes.
+// Glyphs are added with their metrics only, bitmaps are rasterized on a background thread
+// once a glyph is requested for rendering and packed into fixed size pages.
+// When no page has room left, the least recently used page is evicted.
+// Once all glyph slots are taken, slots of glyphs from evicted pages are reused for new glyphs.
+class DynamicGlyphAtlas
+{
+ public:
+   static constexpr u32 page_size = 1024;
+   static constexpr u32 page_count = 8;
+   static constexpr u32 max_glyph_count = 16384;
+
+   explicit DynamicGlyphAtlas(graphics_api::Device& device);
+   ~DynamicGlyphAtlas();
+
+   DynamicGlyphAtlas(const DynamicGlyphAtlas& other) = delete;
+   DynamicGlyphAtlas& operator=(const DynamicGlyphAtlas& other) = delete;
+   DynamicGlyphAtlas(DynamicGlyphAtlas&& other) noexcept = delete;
+   DynamicGlyphAtlas& operator=(DynamicGlyphAtlas&& other) noexcept = delete;
+
+   // Returns an index of the glyph, only glyph metrics get loaded.
+   // Returns g_empty_glyph_index if the glyph cannot be loaded and std::nullopt if no slot is free at the moment.
+   // The index stays valid until the recycle generation changes.
+   [[nodiscard]] std::optional<GlyphIndex> find_or_add_glyph(const font::Typeface& typeface, const GlyphKey& key);
+   [[nodiscard]] GlyphInfo glyph_info(GlyphIndex index) const;
+
+   // Returns true if the glyph bitmap is present in the atlas, otherwise schedules its rasterization.
+   bool request_residency(GlyphIndex index);
+   void touch_pages(u32 page_mask);
+
+   // Uploads regions of pages and glyph infos modified since the last flush, doesn't wait for the queue.
+   void flush_uploads();
+
+   // Incremented every time new glyphs become available on the GPU.
+   [[nodiscard]] u64 residency_generation() const;
+   [[nodiscard]] u64 eviction_generation() const;
+   [[nodiscard]] u32 evicted_pages_since(u64 generation) const;
+   // Incremented every time slots of evicted glyphs get reused for other glyphs.
+   [[nodiscard]] u64 recycle_generation() const;
+
+   [[nodiscard]] const graphics_api::Buffer& glyph_buffer() const;
+   [[nodiscard]] const graphics_api::Texture& page_texture(u32 page) const;
+
+ private:
+   struct Shelf
+   {
+      u32 top;
+      u32 height;
+      u32 cursor;
+   };
+
+   struct Page
+   {
+      graphics_api::Texture texture;
+      // Mirrors the page pixels, so dirty regions can be copied in place.
+      graphics_api::Buffer staging_buffer;
+      std::vector<u8> pixels;
+      std::vector<Shelf> shelves;
+      std::vector<GlyphIndex> glyphs;
+      u32 shelf_top{};
+      u32 pending_count{};
+      u64 last_used{};
+      u64 eviction_generation{};
+      std::vector<graphics_api::BufferTextureCopyRegion> dirty_regions;
+   };
+
+   struct GlyphSlot
+   {
+      GlyphKey key;
+      const font::Typeface* typeface;
+      font::GlyphMetrics metrics;
+      GlyphResidency residency;
+      u32 page;
+      Vector2u offset;
+      bool is_free;
+   };
+
+   [[nodiscard]] bool allocate_region(u32 page_id, GlyphSlot& slot);
+   [[nodiscard]] std::optional<u32> find_page_for(GlyphSlot& slot);
+   [[nodiscard]] std::optional<GlyphIndex> allocate_slot();
+   void evict_page(u32 page_id);
+   void write_glyph_info(GlyphIndex index);
+   void upload_dirty_regions();
+   void rasterizer_routine();
+
+   graphics_api::Device& m_device;
+   graphics_api::Buffer m_glyph_buffer;
+   graphics_api::CommandList m_upload_commands;
+   graphics_api::Fence m_upload_fence;
+   std::vector<Page> m_pages;
+   std::vector<GlyphSlot> m_slots;
+   std::vector<GlyphInfo> m_glyph_infos;
+   std::map<GlyphKey, GlyphIndex> m_glyph_indices;
+   std::vector<GlyphIndex> m_free_slots;
+
+   u32 m_dirty_info_begin{max_glyph_count};
+   u32 m_dirty_info_end{};
+   u64 m_tick{};
+   u64 m_residency_generation{};
+   u64 m_eviction_generation{};
+   u64 m_recycle_generation{};
+   bool m_has_new_glyphs{};
+
+   mutable std::mutex m_mutex;
+   std::condition_variable m_rasterize_cv;
+   std::deque<GlyphIndex> m_rasterize_queue;
+   bool m_is_quitting{};
+   std::thread m_rasterizer_thread;
+};
+
+}// namespace triglav::render_core
@@ -59,6 +59,8 @@ class GenerateCommandListPass
    void default_visit(const detail::Command&) const;
 
  private:
+   void write_profile_timestamp(u32 zone, bool is_closing) const;
+
    BuildContext& m_context;
    PipelineCache& m_pipeline_cache;
    DescriptorStorage& m_descriptor_storage;
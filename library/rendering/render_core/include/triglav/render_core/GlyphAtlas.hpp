@@ -1,54 +1,97 @@
 #pragma once
 
+#include "DynamicGlyphAtlas.hpp"
+
+#include "triglav/LruCache.hpp"
 #include "triglav/Math.hpp"
 #include "triglav/String.hpp"
-#include "triglav/font/Charset.hpp"
 #include "triglav/font/Typeface.hpp"
-#include "triglav/graphics_api/Texture.hpp"
 
 #include <map>
+#include <mutex>
+#include <string>
+#include <vector>
 
 namespace triglav::render_core {
 
-struct GlyphVertex
-{
-   Vector2 position;
-   Vector2 tex_coord;
-};
-
 struct TextMetric
 {
    float width;
    float height;
 };
 
-struct GlyphInfo
+struct GlyphEncodeResult
 {
-   Vector2 tex_coord_top_left;
-   Vector2 tex_coord_bottom_right;
-   Vector2 size;
-   Vector2 advance;
-   Vector2 padding;
+   u32 glyph_count;
+   u32 page_mask;
+   bool is_resident;
 };
 
+// Glyph size at which signed distance fields get rasterized, all font sizes share these glyphs.
+constexpr int g_sdf_glyph_size = 48;
+
+// Glyphs of a single typeface and font size, backed by the shared dynamic atlas.
 class GlyphAtlas
 {
  public:
-   GlyphAtlas(graphics_api::Device& device, const font::Typeface& typeface, const font::Charset& atlas_runes, int glyph_size,
-              uint32_t width, uint32_t height);
+   GlyphAtlas(DynamicGlyphAtlas& dynamic_atlas, const font::Typeface& typeface, TypefaceName typeface_name, int glyph_size,
+              font::GlyphRenderMode render_mode = font::GlyphRenderMode::Bitmap);
+
+   GlyphAtlas(const GlyphAtlas& other) = delete;
+   GlyphAtlas& operator=(const GlyphAtlas& other) = delete;
 
-   [[nodiscard]] std::vector<GlyphVertex> create_glyph_vertices(StringView text, TextMetric* out_metric = nullptr) const;
-   [[nodiscard]] const graphics_api::Texture& texture() const;
-   [[nodiscard]] graphics_api::Texture& texture();
    [[nodiscard]] TextMetric measure_text(StringView text) const;
    [[nodiscard]] u32 find_rune_index(StringView text, float offset) const;
-   [[nodiscard]] const graphics_api::Buffer& storage_buffer() const;
+
+   // Writes atlas glyph indices of the text and requests rasterization of glyphs missing from the atlas.
+   // The indices are only valid for rendering if all glyphs are resident.
+   GlyphEncodeResult encode_text(StringView text, u32* out_indices) const;
+
+   [[nodiscard]] DynamicGlyphAtlas& dynamic_atlas() const;
+   [[nodiscard]] font::GlyphRenderMode render_mode() const;
+   // Scale from the size of glyphs stored in the atlas to the requested font size.
+   [[nodiscard]] float glyph_scale() const;
 
  private:
-   float m_glyph_size{};
-   graphics_api::Texture m_texture;
-   graphics_api::Buffer m_glyph_storage_buffer;
-   std::map<font::Rune, GlyphInfo> m_glyph_infos;
+   // Glyph properties needed for text layout, cached to avoid querying the shared atlas.
+   struct CachedGlyph
+   {
+      GlyphIndex index;
+      float advance;
+      float height;
+      bool is_loaded;
+   };
+
+   struct CachedTextMetric
+   {
+      std::string text;
+      TextMetric metric;
+   };
+
+   // The lock is released while a missing glyph gets loaded, so FreeType calls don't block other threads.
+   [[nodiscard]] CachedGlyph cached_glyph(Rune rune, std::unique_lock<std::mutex>& glyph_lk) const;
+   [[nodiscard]] CachedGlyph load_glyph(Rune rune) const;
+   // Drops cached glyph indices once the shared atlas reuses slots of evicted glyphs.
+   void drop_recycled_glyphs() const;
+   // Glyphs without a slot in the atlas are measured with a fallback advance, such metrics are not exact.
+   [[nodiscard]] TextMetric calculate_text_metric(StringView text, bool& out_is_exact) const;
+
+   DynamicGlyphAtlas& m_dynamic_atlas;
+   const font::Typeface& m_typeface;
+   TypefaceName m_typeface_name;
+   int m_glyph_size{};
+   font::GlyphRenderMode m_render_mode{};
+   int m_atlas_glyph_size{};
+   float m_glyph_scale{};
+
+   // Runes from the basic multilingual plane are indexed directly, the table grows on demand.
+   mutable std::vector<CachedGlyph> m_direct_glyphs;
+   mutable std::map<Rune, CachedGlyph> m_other_glyphs;
+   mutable u64 m_recycle_generation{};
+   mutable std::mutex m_glyph_mtx;
+   // Keyed by the text hash, the stored text tells colliding strings apart.
+   mutable LruCache<u64, CachedTextMetric> m_text_metrics;
+   mutable std::mutex m_text_metric_mtx;
 };
 
-}// namespace triglav::render_core
\ No newline at end of file
+}// namespace triglav::render_core
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "DynamicGlyphAtlas.hpp"
 #include "GlyphAtlas.hpp"
 
 #include "triglav/Int.hpp"
@@ -8,6 +9,7 @@
 #include "triglav/resource/ResourceManager.hpp"
 
 #include <map>
+#include <mutex>
 
 namespace triglav::render_core {
 
@@ -19,19 +21,30 @@ struct GlyphProperties
    [[nodiscard]] u64 hash() const;
 };
 
+// Smallest font size rendered from signed distance fields, smaller text stays sharper with bitmap glyphs.
+constexpr int g_default_sdf_min_font_size = 32;
+
 class GlyphCache
 {
  public:
    using Hash = u64;
 
-   GlyphCache(graphics_api::Device& device, resource::ResourceManager& resource_manager);
+   // With signed distance field rendering a single set of glyphs per typeface serves all large font sizes.
+   GlyphCache(graphics_api::Device& device, resource::ResourceManager& resource_manager,
+              int sdf_min_font_size = g_default_sdf_min_font_size);
 
    const GlyphAtlas& find_glyph_atlas(const GlyphProperties& properties);
+   [[nodiscard]] DynamicGlyphAtlas& dynamic_atlas();
+   [[nodiscard]] font::GlyphRenderMode render_mode(int font_size) const;
 
  private:
-   graphics_api::Device& m_device;
    resource::ResourceManager& m_resource_manager;
+   int m_sdf_min_font_size;
+   DynamicGlyphAtlas m_dynamic_atlas;
    std::map<Hash, GlyphAtlas> m_atlases;
+   // Atlases keep a reference to their typeface.
+   std::map<TypefaceName, resource::ResourceRef<ResourceType::Typeface>> m_typeface_refs;
+   std::mutex m_atlases_mtx;
 };
 
 }// namespace triglav::render_core
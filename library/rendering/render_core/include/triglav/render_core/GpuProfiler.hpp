@@ -0,0 +1,62 @@
+#pragma once
+
+#include "RenderCore.hpp"
+
+#include "triglav/Int.hpp"
+#include "triglav/Name.hpp"
+#include "triglav/graphics_api/QueryPool.hpp"
+
+#include <array>
+#include <map>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace triglav::graphics_api {
+class Device;
+}
+
+namespace triglav::render_core {
+
+// Measures GPU time of jobs and their render passes with timestamp queries.
+// Every zone has a begin and an end query in each frame in flight, zone ranges are reserved per job
+// when the job gets built and reused on rebuilds.
+class GpuProfiler
+{
+ public:
+   static constexpr u32 max_zone_count = 256;
+
+   explicit GpuProfiler(graphics_api::Device& device);
+
+   // Returns the index of the first zone, the first zone spans the whole job.
+   [[nodiscard]] std::optional<u32> reserve_zones(Name job_name, std::span<const Name> zone_names);
+   [[nodiscard]] u32 query_index(u32 frame_index, u32 zone, bool is_closing) const;
+   [[nodiscard]] graphics_api::QueryPool& query_pool();
+
+   // Passes timestamps of the previous submission of this frame to the Profiler,
+   // must be called once the frame's fence is signaled, before the frame is submitted again.
+   void collect(u32 frame_index);
+   void on_job_submitted(Name job_name, u32 frame_index);
+
+ private:
+   struct ZoneRange
+   {
+      u32 first;
+      u32 count;
+      u32 capacity;
+   };
+
+   struct FrameSubmission
+   {
+      std::vector<Name> jobs;
+      i64 submit_ns{};
+   };
+
+   graphics_api::QueryPool m_query_pool;
+   std::map<Name, ZoneRange> m_job_zones;
+   std::array<Name, max_zone_count> m_zone_names{};
+   u32 m_zone_top{};
+   std::array<FrameSubmission, FRAMES_IN_FLIGHT_COUNT> m_submissions;
+};
+
+}// namespace triglav::render_core
@@ -14,26 +14,36 @@ class Job
  public:
    struct Frame
    {
-      DescriptorStorage desc_storage;
       std::vector<graphics_api::CommandList> command_list;
    };
 
-   Job(graphics_api::Device& device, std::optional<graphics_api::DescriptorPool> descriptor_pool, std::span<Frame> job_frames,
-       const graphics_api::WorkTypeFlags& work_types, std::vector<Name> flags);
+   Job(graphics_api::Device& device, std::optional<graphics_api::DescriptorPool> descriptor_pool, DescriptorStorage desc_storage,
+       std::span<Frame> job_frames, const graphics_api::WorkTypeFlags& work_types, std::vector<Name> flags, u32 import_count = 1);
 
    void enable_flag(Name name);
    void disable_flag(Name name);
+   [[nodiscard]] bool has_flag(Name name) const;
+   [[nodiscard]] std::vector<Name> enabled_flags() const;
+   // Selects which of the imported textures the job writes to.
+   void set_import_index(u32 import_index);
 
    void execute(u32 frame_index, graphics_api::SemaphoreArrayView wait_semaphores, graphics_api::SemaphoreArrayView signal_semaphores,
                 const graphics_api::Fence* fence) const;
+   [[nodiscard]] const graphics_api::CommandList& command_list(u32 frame_index) const;
 
  private:
+   [[nodiscard]] u32 variant_index() const;
+
    graphics_api::Device& m_device;
    std::optional<graphics_api::DescriptorPool> m_descriptor_pool;
+   // The sets are shared by all the frames.
+   DescriptorStorage m_desc_storage;
    std::array<Frame, FRAMES_IN_FLIGHT_COUNT> m_job_frames;
    graphics_api::WorkTypeFlags m_work_types;
    std::vector<Name> m_flags{};
    u32 m_enabled_flags{0};
+   u32 m_import_count{1};
+   u32 m_import_index{0};
 };
 
 }// namespace triglav::render_core
@@ -2,6 +2,7 @@
 
 #include "BuildContext.hpp"
 #include "Job.hpp"
+#include "QueueSchedule.hpp"
 
 #include "triglav/graphics_api/Synchronization.hpp"
 
@@ -34,6 +35,23 @@ struct JobSemaphores
    std::array<JobFrameSemaphores, FRAMES_IN_FLIGHT_COUNT> frame_semaphores;
 };
 
+// Timeline semaphore signaled with the frame serial each time the job is submitted.
+struct JobTimeline
+{
+   graphics_api::Semaphore semaphore;
+   u64 value{};
+   u64 previous_value{};
+};
+
+enum class SubmissionMode
+{
+   // Each job is submitted separately, dependencies are synchronized with binary semaphores.
+   PerJob,
+   // All jobs of a frame are submitted in a single batch per queue, dependencies between
+   // internal jobs are synchronized with timeline semaphores.
+   Batched,
+};
+
 class JobGraph
 {
  public:
@@ -52,19 +70,30 @@ class JobGraph
    void add_dependency_to_previous_frame(Name target_dep);
    void build_jobs(Name target_job);
    void rebuild_job(Name job);
+   // Records the job's commands again keeping its resources, the caller must make sure the job isn't in use.
+   void rerecord_job(Name job);
    [[nodiscard]] graphics_api::Semaphore& semaphore(Name wait_job, Name signal_job, u32 frame_index);
    [[nodiscard]] graphics_api::SemaphoreArrayView wait_semaphores(Name wait_job, u32 frame_index);
    [[nodiscard]] graphics_api::SemaphoreArrayView signal_semaphores(Name signal_job, u32 frame_index);
 
    void enable_flag(Name job, Name flag);
    void disable_flag(Name job, Name flag);
+   void set_import_index(Name job, u32 import_index);
+   void set_submission_mode(SubmissionMode mode);
    void execute(Name target_job, u32 frame_index, const graphics_api::Fence* fence);
    void build_semaphores();
+   // Blocks until the last submission of the job has completed, requires the batched submission mode.
+   void await_job(Name job) const;
 
    ResourceStorage& resources();
 
  private:
    void deduce_job_order(Name target_job);
+   void schedule_queues();
+   void apply_queue_schedule(Name job);
+   void replace_built_job(Name name, Job&& job);
+   void submit_batched(u32 frame_index, const graphics_api::Fence* fence);
+   [[nodiscard]] bool is_timeline_dependency(Name target, Name dependency) const;
 
    graphics_api::Device& m_device;
    resource::ResourceManager& m_resource_manager;
@@ -73,15 +102,20 @@ class JobGraph
    Vector2i m_screen_size{};
    bool m_has_built_semaphores = false;
    bool m_is_first_frame = true;
+   SubmissionMode m_submission_mode = SubmissionMode::PerJob;
+   u64 m_frame_serial = 0;
+   graphics_api::SubmitBatch m_submit_batch;
 
    std::map<Name, BuildContext> m_contexts;
    std::map<Name, Job> m_jobs;
    std::map<Name, JobSemaphores> m_job_semaphores;
+   std::map<Name, JobTimeline> m_job_timelines;
    std::vector<Name> m_external_jobs;
    std::multimap<Name, Name> m_dependencies;
    std::multimap<Name, Name> m_interframe_dependencies;
    std::vector<Name> m_job_order;
    std::optional<Name> m_last_target_job;
+   QueueSchedule m_queue_schedule;
 };
 
 }// namespace triglav::render_core
\ No newline at end of file
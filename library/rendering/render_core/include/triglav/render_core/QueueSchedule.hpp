@@ -0,0 +1,55 @@
+#pragma once
+
+#include "triglav/Name.hpp"
+#include "triglav/graphics_api/GraphicsApi.hpp"
+#include "triglav/graphics_api/QueueManager.hpp"
+
+#include <map>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace triglav::render_core {
+
+struct ResourceExport
+{
+   Name name;
+   // Only set for textures, the state in which the texture is handed over.
+   std::optional<graphics_api::TextureState> texture_state;
+   u32 mip_count{1};
+};
+
+struct JobQueueUsage
+{
+   Name job_name;
+   graphics_api::WorkTypeFlags work_types;
+   std::vector<ResourceExport> exported_resources;
+   std::vector<Name> external_resources;
+   // Resources referenced directly are created for exclusive use of the graphics family.
+   bool has_untracked_resources{};
+};
+
+struct QueueOwnershipTransfer
+{
+   ResourceExport resource;
+   Name src_job;
+   Name dst_job;
+   u32 src_queue_family{};
+   u32 dst_queue_family{};
+};
+
+struct QueueSchedule
+{
+   // Work types used to select the queue family of each job.
+   std::map<Name, graphics_api::WorkTypeFlags> queue_work_types;
+   std::map<Name, u32> queue_families;
+   std::vector<QueueOwnershipTransfer> transfers;
+};
+
+// Places jobs on the queue families matching their work types, jobs are expected in execution order.
+// Ownership of an exported resource can only be handed over to a single consumer, if a resource is
+// shared by more jobs on different families all of its users are kept on the graphics family.
+// Jobs with untracked resources always run on the graphics family.
+[[nodiscard]] QueueSchedule schedule_job_queues(std::span<const JobQueueUsage> jobs, std::span<const graphics_api::QueueFamilyInfo> families);
+
+}// namespace triglav::render_core
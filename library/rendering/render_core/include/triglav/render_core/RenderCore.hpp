@@ -168,6 +168,8 @@ struct BufferBarrier
    graphics_api::PipelineStageFlags dst_stage_flags{};
    graphics_api::BufferAccessFlags src_buffer_access{};
    graphics_api::BufferAccessFlags dst_buffer_access{};
+   u32 src_queue_family{graphics_api::g_queue_family_ignored};
+   u32 dst_queue_family{graphics_api::g_queue_family_ignored};
 };
 
 struct TextureBarrier
@@ -179,6 +181,8 @@ struct TextureBarrier
    graphics_api::TextureState dst_state{};
    u32 base_mip_level{0};
    u32 mip_level_count{1};
+   u32 src_queue_family{graphics_api::g_queue_family_ignored};
+   u32 dst_queue_family{graphics_api::g_queue_family_ignored};
 };
 
 inline u32 calculate_mip_count(const Vector2i& dims)
@@ -1,21 +1,45 @@
 #pragma once
 
+#include "GpuProfiler.hpp"
+
 #include "triglav/Name.hpp"
 #include "triglav/graphics_api/DescriptorArray.hpp"
 #include "triglav/graphics_api/QueryPool.hpp"
 #include "triglav/graphics_api/Texture.hpp"
 
+#include <optional>
+#include <span>
 #include <unordered_map>
+#include <vector>
 
 namespace triglav::render_core {
 
 class DescriptorStorage
 {
  public:
+   // Resolved contents of a descriptor set, the layout followed by the bound resources.
+   using Key = std::vector<u64>;
+
    graphics_api::DescriptorArray& store_descriptor_array(graphics_api::DescriptorArray&& desc_array);
 
+   // Returns a set that was already written with the same contents.
+   [[nodiscard]] std::optional<graphics_api::DescriptorView> find_descriptor_set(const Key& key) const;
+   void store_descriptor_set(Key key, graphics_api::DescriptorView desc_view);
+   void count_bind();
+   [[nodiscard]] u32 descriptor_set_count() const;
+   [[nodiscard]] u32 bind_count() const;
+
  private:
+   struct StoredSet
+   {
+      Key key;
+      graphics_api::DescriptorView desc_view;
+   };
+
    std::vector<graphics_api::DescriptorArray> m_descriptor_arrays;
+   // Sets with colliding hashes share the bucket, the keys tell them apart.
+   std::unordered_map<u64, std::vector<StoredSet>> m_descriptor_sets;
+   u32 m_bind_count{};
 };
 
 class ResourceStorage
@@ -28,6 +52,11 @@ class ResourceStorage
    void register_texture(Name name, u32 frame_index, graphics_api::Texture&& texture);
    graphics_api::Texture& texture(Name name, u32 frame_index);
 
+   // Textures owned outside of the storage, the job using them has to be rebuilt when they are imported again.
+   void import_textures(Name name, std::span<const graphics_api::Texture> textures);
+   [[nodiscard]] const graphics_api::Texture& imported_texture(Name name, u32 import_index) const;
+   [[nodiscard]] u32 imported_texture_count(Name name) const;
+
    void register_texture_mip_view(Name name, u32 mip_index, u32 frame_index, graphics_api::TextureView&& texture_view);
    graphics_api::TextureView& texture_mip_view(Name name, u32 mip_index, u32 frame_index);
 
@@ -36,13 +65,16 @@ class ResourceStorage
 
    [[nodiscard]] graphics_api::QueryPool& timestamps();
    [[nodiscard]] graphics_api::QueryPool& pipeline_stats();
+   [[nodiscard]] GpuProfiler& gpu_profiler();
 
  private:
    std::unordered_map<ResourceID, graphics_api::Texture> m_textures;
+   std::unordered_map<Name, std::vector<const graphics_api::Texture*>> m_imported_textures;
    std::unordered_map<ResourceID, graphics_api::TextureView> m_texture_mip_views;
    std::unordered_map<ResourceID, graphics_api::Buffer> m_buffers;
    graphics_api::QueryPool m_timestamps;
    graphics_api::QueryPool m_pipeline_stats;
+   GpuProfiler m_gpu_profiler;
 };
 
 }// namespace triglav::render_core
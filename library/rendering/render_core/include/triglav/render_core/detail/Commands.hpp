@@ -191,10 +191,13 @@ struct BeginRenderPass
 {
    Name pass_name;
    std::vector<PassRenderTarget> render_targets;
+   u32 profile_zone;
 };
 
 struct EndRenderPass
-{};
+{
+   u32 profile_zone;
+};
 
 struct BeginDebugLabel
 {
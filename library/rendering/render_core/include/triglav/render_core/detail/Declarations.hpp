@@ -28,6 +28,8 @@ struct Texture
       0.0f,
       0.0f,
    };
+   // Imported textures are owned outside of the job graph and are not created with the job.
+   bool is_imported{false};
 
    [[nodiscard]] Vector2i dimensions(const Vector2i& screen_dim) const
    {
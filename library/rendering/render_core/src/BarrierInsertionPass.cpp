@@ -41,11 +41,33 @@ namespace {
 
    return access;
 }
+
+gapi::PipelineStageFlags queue_acquire_stages(const gapi::WorkTypeFlags work_types)
+{
+   using enum gapi::WorkType;
+   using gapi::PipelineStage;
+
+   gapi::PipelineStageFlags result{PipelineStage::Transfer};
+   if (work_types & Compute) {
+      result |= PipelineStage::ComputeShader;
+   }
+   if (work_types & Graphics) {
+      result |= PipelineStage::DrawIndirect;
+      result |= PipelineStage::VertexInput;
+      result |= PipelineStage::VertexShader;
+      result |= PipelineStage::FragmentShader;
+      result |= PipelineStage::EarlyZ;
+      result |= PipelineStage::AttachmentOutput;
+   }
+   return result;
+}
+
 }// namespace
 
 BarrierInsertionPass::BarrierInsertionPass(BuildContext& context) :
     m_context(context)
 {
+   this->add_queue_acquire_barriers();
 }
 
 void BarrierInsertionPass::visit(const detail::cmd::BindDescriptors& cmd)
@@ -203,11 +225,56 @@ void BarrierInsertionPass::default_visit(const detail::Command& cmd)
    m_commands.push_back(cmd);
 }
 
+void BarrierInsertionPass::finish()
+{
+   for (const auto& transfer : m_context.m_queue_releases) {
+      if (transfer.resource.texture_state.has_value()) {
+         const auto& tex = m_context.declaration<detail::decl::Texture>(transfer.resource.name);
+         gapi::PipelineStageFlags src_stages{};
+         for (u32 mip_level = 0; mip_level < transfer.resource.mip_count; ++mip_level) {
+            src_stages |= tex.last_stages[mip_level];
+         }
+
+         auto barrier = std::make_unique<TextureBarrier>(transfer.resource.name, src_stages, gapi::PipelineStage::End,
+                                                         *transfer.resource.texture_state, *transfer.resource.texture_state, 0,
+                                                         transfer.resource.mip_count, transfer.src_queue_family, transfer.dst_queue_family);
+         this->add_command<detail::cmd::PlaceTextureBarrier>(std::move(barrier));
+      } else {
+         const auto& buffer = m_context.declaration<detail::decl::Buffer>(transfer.resource.name);
+         auto barrier = std::make_unique<BufferBarrier>(transfer.resource.name, buffer.last_stages, gapi::PipelineStage::End,
+                                                        buffer.current_access, gapi::BufferAccess::None, transfer.src_queue_family,
+                                                        transfer.dst_queue_family);
+         this->add_command<detail::cmd::PlaceBufferBarrier>(std::move(barrier));
+      }
+   }
+}
+
 std::vector<detail::Command>& BarrierInsertionPass::commands()
 {
    return m_commands;
 }
 
+void BarrierInsertionPass::add_queue_acquire_barriers()
+{
+   const auto dst_stages = queue_acquire_stages(m_context.m_queue_work_types);
+
+   for (const auto& transfer : m_context.m_queue_acquires) {
+      const External resource_ref{transfer.resource.name};
+      if (transfer.resource.texture_state.has_value()) {
+         auto barrier = std::make_unique<TextureBarrier>(resource_ref, gapi::PipelineStage::Entrypoint, dst_stages,
+                                                         *transfer.resource.texture_state, *transfer.resource.texture_state, 0,
+                                                         transfer.resource.mip_count, transfer.src_queue_family, transfer.dst_queue_family);
+         this->add_command<detail::cmd::PlaceTextureBarrier>(std::move(barrier));
+      } else {
+         gapi::BufferAccessFlags dst_access{gapi::BufferAccess::MemoryRead};
+         dst_access |= gapi::BufferAccess::MemoryWrite;
+         auto barrier = std::make_unique<BufferBarrier>(resource_ref, gapi::PipelineStage::Entrypoint, dst_stages, gapi::BufferAccess::None,
+                                                        dst_access, transfer.src_queue_family, transfer.dst_queue_family);
+         this->add_command<detail::cmd::PlaceBufferBarrier>(std::move(barrier));
+      }
+   }
+}
+
 void BarrierInsertionPass::setup_texture_barrier(const TextureRef tex_ref, const graphics_api::TextureState target_state,
                                                  const graphics_api::PipelineStageFlags target_stages,
                                                  const std::optional<graphics_api::PipelineStage> last_used_stage)
@@ -11,6 +11,7 @@
 #include "triglav/graphics_api/GraphicsApi.hpp"
 #include "triglav/resource/ResourceManager.hpp"
 
+#include <cstdint>
 #include <cstring>
 
 namespace triglav::render_core {
@@ -43,6 +44,11 @@ namespace {
    return std::format("{}.frame{}", resolved_name, frame_index);
 }
 
+u64 to_descriptor_key(const void* object)
+{
+   return reinterpret_cast<std::uintptr_t>(object);
+}
+
 }// namespace
 
 BuildContext::BuildContext(graphics_api::Device& device, resource::ResourceManager& resource_manager, const Vector2i screen_size) :
@@ -76,6 +82,18 @@ void BuildContext::declare_render_target(const Name rt_name, gapi::ColorFormat r
    this->add_declaration<detail::decl::Texture>(rt_name, std::nullopt, rt_format, gapi::TextureUsage::ColorAttachment);
 }
 
+void BuildContext::declare_imported_render_target(const Name rt_name, const gapi::ColorFormat rt_format)
+{
+   assert(!m_imported_render_target.has_value() && "only a single imported render target is supported per job");
+
+   this->m_render_targets.emplace(rt_name, detail::RenderTarget{gapi::ClearValue::color(gapi::ColorPalette::Black),
+                                                                gapi::AttachmentAttribute::Color | gapi::AttachmentAttribute::ClearImage |
+                                                                   gapi::AttachmentAttribute::StoreImage});
+   this->add_declaration<detail::decl::Texture>(rt_name, std::nullopt, rt_format, gapi::TextureUsage::ColorAttachment);
+   this->declaration<detail::decl::Texture>(rt_name).is_imported = true;
+   m_imported_render_target = rt_name;
+}
+
 void BuildContext::declare_depth_target(Name dt_name, graphics_api::ColorFormat rt_format)
 {
    this->m_render_targets.emplace(dt_name, detail::RenderTarget{gapi::ClearValue::depth_stencil(1.0f, 0),
@@ -340,14 +358,18 @@ void BuildContext::begin_render_pass_raw(const Name pass_name, const std::span<N
 
    std::vector<Name> render_target_names(render_targets.size());
    std::ranges::copy(render_targets, render_target_names.begin());
-   this->add_command<detail::cmd::BeginRenderPass>(pass_name, std::move(pass_render_targets));
+
+   // Zone 0 is reserved for the whole job.
+   m_profile_zones.emplace_back(pass_name);
+   m_active_profile_zone = static_cast<u32>(m_profile_zones.size());
+   this->add_command<detail::cmd::BeginRenderPass>(pass_name, std::move(pass_render_targets), m_active_profile_zone);
 }
 
 void BuildContext::end_render_pass()
 {
    m_graphic_pipeline_state.depth_target_format.reset();
    m_graphic_pipeline_state.render_target_formats.clear();
-   this->add_command<detail::cmd::EndRenderPass>();
+   this->add_command<detail::cmd::EndRenderPass>(m_active_profile_zone);
 }
 
 void BuildContext::clear_color(const Name target_name, const Vector4 color)
@@ -452,6 +474,51 @@ void BuildContext::write_descriptor(ResourceStorage& storage, const graphics_api
    }
 }
 
+DescriptorStorage::Key BuildContext::descriptor_key(ResourceStorage& storage, const graphics_api::Pipeline& pipeline,
+                                                   const detail::cmd::BindDescriptors& descriptors, const u32 frame_index) const
+{
+   // Each pipeline owns its set layout, so the pipeline stands for the layout.
+   DescriptorStorage::Key key{to_descriptor_key(&pipeline)};
+   key.reserve(1 + 2 * descriptors.descriptors.size());
+
+   for (const auto& desc_variant : descriptors.descriptors) {
+      key.push_back(desc_variant->descriptor.index());
+      std::visit(
+         [this, frame_index, &key, &storage]<typename TDescriptor>(const TDescriptor& desc) {
+            if constexpr (std::is_same_v<TDescriptor, detail::descriptor::RWTexture> ||
+                          std::is_same_v<TDescriptor, detail::descriptor::Texture>) {
+               key.push_back(to_descriptor_key(&this->resolve_texture_view_ref(storage, desc.tex_ref, frame_index)));
+            } else if constexpr (std::is_same_v<TDescriptor, detail::descriptor::SamplableTexture>) {
+               const gapi::Texture& texture = this->resolve_texture_ref(storage, desc.tex_ref, frame_index);
+               key.push_back(to_descriptor_key(&texture));
+               key.push_back(to_descriptor_key(&m_device.sampler_cache().find_sampler(texture.sampler_properties())));
+            } else if constexpr (std::is_same_v<TDescriptor, detail::descriptor::SampledTextureArray>) {
+               key.push_back(desc.tex_refs.size());
+               for (const auto& tex_ref : desc.tex_refs) {
+                  key.push_back(to_descriptor_key(&this->resolve_texture_ref(storage, tex_ref, frame_index)));
+               }
+            } else if constexpr (std::is_same_v<TDescriptor, detail::descriptor::UniformBuffer> ||
+                                 std::is_same_v<TDescriptor, detail::descriptor::StorageBuffer>) {
+               key.push_back(to_descriptor_key(&this->resolve_buffer_ref(storage, desc.buff_ref, frame_index)));
+            } else if constexpr (std::is_same_v<TDescriptor, detail::descriptor::UniformBufferRange>) {
+               key.push_back(to_descriptor_key(&this->resolve_buffer_ref(storage, desc.buff_ref, frame_index)));
+               key.push_back(desc.offset);
+               key.push_back(desc.size);
+            } else if constexpr (std::is_same_v<TDescriptor, detail::descriptor::UniformBufferArray>) {
+               key.push_back(desc.buffers.size());
+               for (const auto ref : desc.buffers) {
+                  key.push_back(to_descriptor_key(&this->resolve_buffer_ref(storage, ref, frame_index)));
+               }
+            } else if constexpr (std::is_same_v<TDescriptor, detail::descriptor::AccelerationStructure>) {
+               key.push_back(to_descriptor_key(desc.acceleration_structure));
+            }
+         },
+         desc_variant->descriptor);
+   }
+
+   return key;
+}
+
 void BuildContext::draw_mesh(const geometry::DeviceMesh& mesh)
 {
    this->bind_vertex_buffer(&mesh.vertex_buffer);
@@ -527,7 +594,7 @@ gapi::RenderingInfo BuildContext::create_rendering_info(ResourceStorage& storage
 
    for (const auto& render_target : begin_render_pass.render_targets) {
       gapi::RenderAttachment attachment{};
-      attachment.texture = &storage.texture(render_target.texture_name, frame_index);
+      attachment.texture = &this->resolve_named_texture(storage, render_target.texture_name, frame_index);
       attachment.state = gapi::TextureState::RenderTarget;
       attachment.clear_value = render_target.clear_value;
       attachment.flags = render_target.flags;
@@ -553,7 +620,7 @@ const gapi::Texture& BuildContext::resolve_texture_ref(ResourceStorage& storage,
    return std::visit(
       [this, frame_index, &storage]<typename TVariant>(const TVariant& var) -> const gapi::Texture& {
          if constexpr (std::is_same_v<TVariant, Name>) {
-            return storage.texture(var, frame_index);
+            return this->resolve_named_texture(storage, var, frame_index);
          } else if constexpr (std::is_same_v<TVariant, External>) {
             return storage.texture(var.name, frame_index);
          } else if constexpr (std::is_same_v<TVariant, TextureMip>) {
@@ -571,6 +638,14 @@ const gapi::Texture& BuildContext::resolve_texture_ref(ResourceStorage& storage,
       tex_ref);
 }
 
+const gapi::Texture& BuildContext::resolve_named_texture(ResourceStorage& storage, const Name tex_name, const u32 frame_index) const
+{
+   if (m_imported_render_target == tex_name) {
+      return storage.imported_texture(tex_name, m_import_index);
+   }
+   return storage.texture(tex_name, frame_index);
+}
+
 const graphics_api::TextureView& BuildContext::resolve_texture_view_ref(ResourceStorage& storage, const TextureRef tex_ref,
                                                                         const u32 frame_index) const
 {
@@ -630,6 +705,13 @@ void BuildContext::handle_pending_graphic_state()
 
 void BuildContext::prepare_texture(const TextureRef tex_ref, const gapi::TextureState state, const gapi::TextureUsageFlags usage)
 {
+   if (std::holds_alternative<External>(tex_ref)) {
+      m_external_resources.emplace(std::get<External>(tex_ref).name);
+   }
+   if (std::holds_alternative<const gapi::Texture*>(tex_ref) || std::holds_alternative<TextureName>(tex_ref)) {
+      m_has_untracked_resources = true;
+   }
+
    if (!std::holds_alternative<Name>(tex_ref) && !std::holds_alternative<FromLastFrame>(tex_ref) &&
        !std::holds_alternative<TextureMip>(tex_ref)) {
       return;
@@ -654,6 +736,13 @@ void BuildContext::prepare_texture(const TextureRef tex_ref, const gapi::Texture
 
 void BuildContext::prepare_buffer(const BufferRef buff_ref, const gapi::BufferUsage usage)
 {
+   if (std::holds_alternative<External>(buff_ref)) {
+      m_external_resources.emplace(std::get<External>(buff_ref).name);
+   }
+   if (std::holds_alternative<const gapi::Buffer*>(buff_ref)) {
+      m_has_untracked_resources = true;
+   }
+
    if (!std::holds_alternative<Name>(buff_ref) && !std::holds_alternative<FromLastFrame>(buff_ref)) {
       return;
    }
@@ -921,6 +1010,11 @@ void BuildContext::buffer_barrier(const BufferBarrier& barrier)
    this->add_command<detail::cmd::PlaceBufferBarrier>(std::make_unique<BufferBarrier>(barrier));
 }
 
+void BuildContext::texture_barrier(const TextureBarrier& barrier)
+{
+   this->add_command<detail::cmd::PlaceTextureBarrier>(std::make_unique<TextureBarrier>(barrier));
+}
+
 void BuildContext::bind_rt_generation_shader(RayGenShaderName ray_gen_shader)
 {
    m_work_types |= gapi::WorkType::Graphics;
@@ -981,43 +1075,89 @@ void BuildContext::trace_rays(const Vector3i dimensions)
    ++m_descriptor_counts.total_descriptor_sets;
 }
 
-Job BuildContext::build_job(PipelineCache& pipeline_cache, ResourceStorage& storage, [[maybe_unused]] const Name job_name)
+Job BuildContext::build_job(PipelineCache& pipeline_cache, ResourceStorage& storage, const Name job_name)
+{
+   this->create_resources(storage);
+   return this->record_job(pipeline_cache, storage, job_name);
+}
+
+Job BuildContext::record_job(PipelineCache& pipeline_cache, ResourceStorage& storage, [[maybe_unused]] const Name job_name)
 {
+   m_import_count = m_imported_render_target.has_value() ? storage.imported_texture_count(*m_imported_render_target) : 1;
+   assert(m_import_count > 0);
+
    auto pool = this->create_descriptor_pool();
 
    std::vector<Job::Frame> frames;
    frames.reserve(FRAMES_IN_FLIGHT_COUNT);
 
    const auto flag_count = 1u << m_flags.size();
+   const auto queue_work_types = m_queue_work_types == gapi::WorkType::None ? m_work_types : m_queue_work_types;
 
-   this->create_resources(storage);
+   if (m_work_types & gapi::WorkType::Graphics || m_work_types & gapi::WorkType::Compute) {
+      m_first_profile_zone = storage.gpu_profiler().reserve_zones(job_name, m_profile_zones);
+   }
+
+   DescriptorStorage desc_storage;
 
    for (const auto frame_index : Range(0, FRAMES_IN_FLIGHT_COUNT)) {
-      DescriptorStorage desc_storage;
       std::vector<gapi::CommandList> command_lists;
 
       for (const auto enabled_flags : Range(0u, flag_count)) {
-         auto command_list = GAPI_CHECK(m_device.create_command_list(m_work_types));
-         GAPI_CHECK_STATUS(command_list.begin(gapi::SubmitType::Normal));
+         for (const auto import_index : Range(0u, m_import_count)) {
+            m_import_index = import_index;
+
+            auto command_list = GAPI_CHECK(m_device.create_command_list(queue_work_types));
+            GAPI_CHECK_STATUS(command_list.begin(gapi::SubmitType::Normal));
 
-         this->write_commands(storage, desc_storage, command_list, pipeline_cache, pool.has_value() ? &(*pool) : nullptr, frame_index,
-                              enabled_flags);
+            this->write_commands(storage, desc_storage, command_list, pipeline_cache, pool.has_value() ? &(*pool) : nullptr, frame_index,
+                                 enabled_flags);
 
-         GAPI_CHECK_STATUS(command_list.finish());
+            GAPI_CHECK_STATUS(command_list.finish());
 
-         TG_SET_DEBUG_NAME(command_list, create_command_list_name(job_name, frame_index, enabled_flags));
+            TG_SET_DEBUG_NAME(command_list, create_command_list_name(job_name, frame_index, enabled_flags));
 
-         command_lists.emplace_back(std::move(command_list));
+            command_lists.emplace_back(std::move(command_list));
+         }
       }
 
-      frames.emplace_back(std::move(desc_storage), std::move(command_lists));
+      frames.emplace_back(std::move(command_lists));
+   }
+
+   if (desc_storage.bind_count() != 0 && job_name != 0) {
+      log_debug("job {}: {} descriptor sets for {} binds", resolve_name(job_name), desc_storage.descriptor_set_count(),
+                desc_storage.bind_count());
    }
 
-   return {m_device, std::move(pool), frames, m_work_types, m_flags};
+   return {m_device, std::move(pool), std::move(desc_storage), frames, queue_work_types, m_flags, m_import_count};
 }
 
 void BuildContext::write_commands(ResourceStorage& storage, DescriptorStorage& desc_storage, gapi::CommandList& cmd_list,
                                   PipelineCache& cache, graphics_api::DescriptorPool* pool, const u32 frame_index, const u32 enabled_flags)
+{
+   const auto commands = this->insert_barriers(enabled_flags);
+
+   auto& gpu_profiler = storage.gpu_profiler();
+   if (m_first_profile_zone.has_value()) {
+      const auto zone_count = static_cast<u32>(m_profile_zones.size()) + 1;
+      cmd_list.reset_timestamp_array(gpu_profiler.query_pool(), gpu_profiler.query_index(frame_index, *m_first_profile_zone, false),
+                                     2 * zone_count);
+      cmd_list.write_timestamp(gapi::PipelineStage::Entrypoint, gpu_profiler.query_pool(),
+                               gpu_profiler.query_index(frame_index, *m_first_profile_zone, false));
+   }
+
+   GenerateCommandListPass generate_pass(*this, cache, desc_storage, storage, cmd_list, pool, frame_index);
+   for (const auto& cmd_variant : commands) {
+      visit_command(generate_pass, cmd_variant);
+   }
+
+   if (m_first_profile_zone.has_value()) {
+      cmd_list.write_timestamp(gapi::PipelineStage::End, gpu_profiler.query_pool(),
+                               gpu_profiler.query_index(frame_index, *m_first_profile_zone, true));
+   }
+}
+
+std::vector<detail::Command> BuildContext::insert_barriers(const u32 enabled_flags)
 {
    ApplyFlagConditionsPass apply_conditions_pass(m_flags, enabled_flags);
    for (const auto& cmd_variant : m_commands) {
@@ -1030,11 +1170,9 @@ void BuildContext::write_commands(ResourceStorage& storage, DescriptorStorage& d
    for (const auto& cmd_variant : apply_conditions_pass.commands()) {
       visit_command(barrier_insertion_pass, cmd_variant);
    }
+   barrier_insertion_pass.finish();
 
-   GenerateCommandListPass generate_pass(*this, cache, desc_storage, storage, cmd_list, pool, frame_index);
-   for (const auto& cmd_variant : barrier_insertion_pass.commands()) {
-      visit_command(generate_pass, cmd_variant);
-   }
+   return std::move(barrier_insertion_pass.commands());
 }
 
 void BuildContext::create_resources(ResourceStorage& storage)
@@ -1044,6 +1182,9 @@ void BuildContext::create_resources(ResourceStorage& storage)
          std::visit(
             [this, frame_index, &storage]<typename TDecl>(const TDecl& decl) {
                if constexpr (std::is_same_v<TDecl, detail::decl::Texture>) {
+                  if (decl.is_imported)
+                     return;
+
                   auto size = decl.tex_dims.value_or(m_screen_size);
                   if (decl.scaling.has_value()) {
                      size = Vector2i(Vector2(size) * decl.scaling.value());
@@ -1111,7 +1252,7 @@ std::optional<gapi::DescriptorPool> BuildContext::create_descriptor_pool() const
       return std::nullopt;
    }
 
-   const auto multiplier = FRAMES_IN_FLIGHT_COUNT * this->flag_variation_count();
+   const auto multiplier = FRAMES_IN_FLIGHT_COUNT * this->flag_variation_count() * m_import_count;
 
    std::vector<std::pair<gapi::DescriptorType, u32>> descriptor_counts;
    if (m_descriptor_counts.storage_texture_count != 0) {
@@ -1142,6 +1283,39 @@ graphics_api::WorkTypeFlags BuildContext::work_types() const
    return m_work_types;
 }
 
+std::vector<ResourceExport> BuildContext::exported_resources() const
+{
+   std::vector<ResourceExport> result;
+   for (const auto& cmd : m_commands) {
+      if (const auto* export_buffer = std::get_if<detail::cmd::ExportBuffer>(&cmd); export_buffer != nullptr) {
+         result.emplace_back(export_buffer->buff_name);
+      } else if (const auto* export_texture = std::get_if<detail::cmd::ExportTexture>(&cmd); export_texture != nullptr) {
+         const auto& tex_decl = this->declaration<detail::decl::Texture>(export_texture->tex_name);
+         const auto mip_count = tex_decl.create_mip_levels ? calculate_mip_count(tex_decl.dimensions(m_screen_size)) : 1u;
+         result.emplace_back(export_texture->tex_name, export_texture->state, mip_count);
+      }
+   }
+   return result;
+}
+
+std::vector<Name> BuildContext::external_resources() const
+{
+   return {m_external_resources.begin(), m_external_resources.end()};
+}
+
+bool BuildContext::has_untracked_resources() const
+{
+   return m_has_untracked_resources;
+}
+
+void BuildContext::set_queue_ownership(const graphics_api::WorkTypeFlags queue_work_types, std::vector<QueueOwnershipTransfer> releases,
+                                       std::vector<QueueOwnershipTransfer> acquires)
+{
+   m_queue_work_types = queue_work_types;
+   m_queue_releases = std::move(releases);
+   m_queue_acquires = std::move(acquires);
+}
+
 Vector2i BuildContext::screen_size() const
 {
    return m_screen_size;
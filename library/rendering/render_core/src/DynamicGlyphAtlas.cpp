@@ -0,0 +1,460 @@
+#include "DynamicGlyphAtlas.hpp"
+
+#include "RenderCore.hpp"
+
+#include "triglav/graphics_api/Device.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace triglav::render_core {
+
+namespace gapi = graphics_api;
+
+namespace {
+
+constexpr u32 g_glyph_separation = 2;
+
+gapi::BufferTextureCopyRegion page_region(const Vector2u offset, const Vector2u extent)
+{
+   return gapi::BufferTextureCopyRegion{
+      .buffer_offset = offset.x + static_cast<MemorySize>(offset.y) * DynamicGlyphAtlas::page_size,
+      .buffer_row_length = DynamicGlyphAtlas::page_size,
+      .texture_offset = {static_cast<i32>(offset.x), static_cast<i32>(offset.y)},
+      .extent = extent,
+   };
+}
+
+}// namespace
+
+DynamicGlyphAtlas::DynamicGlyphAtlas(gapi::Device& device) :
+    m_device(device),
+    m_glyph_buffer(GAPI_CHECK(device.create_buffer(gapi::BufferUsage::StorageBuffer | gapi::BufferUsage::TransferDst,
+                                                   sizeof(GlyphInfo) * max_glyph_count))),
+    m_upload_commands(GAPI_CHECK(device.create_command_list(gapi::WorkType::Graphics))),
+    m_upload_fence(GAPI_CHECK(device.create_fence()))
+{
+   m_pages.reserve(page_count);
+   for (u32 page_id = 0; page_id < page_count; ++page_id) {
+      auto& page = m_pages.emplace_back(Page{
+         .texture = GAPI_CHECK(device.create_texture(GAPI_FORMAT(R, UNorm8), {page_size, page_size})),
+         .staging_buffer =
+            GAPI_CHECK(device.create_buffer(gapi::BufferUsage::HostVisible | gapi::BufferUsage::TransferSrc, page_size * page_size)),
+         .pixels = std::vector<u8>(page_size * page_size),
+      });
+      page.texture.set_anisotropy_state(false);
+      GAPI_CHECK_STATUS(page.texture.write(device, page.pixels.data()));
+   }
+
+   m_slots.reserve(max_glyph_count);
+   m_slots.emplace_back(GlyphSlot{
+      .key = {TypefaceName{}, 0, 0, font::GlyphRenderMode::Bitmap},
+      .typeface = nullptr,
+      .metrics = {},
+      .residency = GlyphResidency::Resident,
+      .page = 0,
+      .offset = {},
+      .is_free = false,
+   });
+
+   m_glyph_infos.resize(max_glyph_count);
+   GAPI_CHECK_STATUS(m_glyph_buffer.write_indirect(m_glyph_infos.data(), sizeof(GlyphInfo) * m_glyph_infos.size()));
+
+   m_rasterizer_thread = std::thread(&DynamicGlyphAtlas::rasterizer_routine, this);
+}
+
+DynamicGlyphAtlas::~DynamicGlyphAtlas()
+{
+   {
+      std::unique_lock lk{m_mutex};
+      m_is_quitting = true;
+   }
+   m_rasterize_cv.notify_one();
+   m_rasterizer_thread.join();
+
+   m_upload_fence.await();
+}
+
+std::optional<GlyphIndex> DynamicGlyphAtlas::find_or_add_glyph(const font::Typeface& typeface, const GlyphKey& key)
+{
+   {
+      std::unique_lock lk{m_mutex};
+      if (const auto it = m_glyph_indices.find(key); it != m_glyph_indices.end()) {
+         return it->second;
+      }
+   }
+
+   const auto metrics = typeface.glyph_metrics(key.font_size, key.rune, key.render_mode);
+
+   std::unique_lock lk{m_mutex};
+   if (const auto it = m_glyph_indices.find(key); it != m_glyph_indices.end()) {
+      return it->second;
+   }
+
+   if (not metrics.has_value()) {
+      m_glyph_indices.emplace(key, g_empty_glyph_index);
+      return g_empty_glyph_index;
+   }
+
+   const auto index = this->allocate_slot();
+   if (not index.has_value()) {
+      return std::nullopt;
+   }
+
+   m_slots[*index] = GlyphSlot{
+      .key = key,
+      .typeface = &typeface,
+      .metrics = *metrics,
+      .residency = GlyphResidency::MetricsOnly,
+      .page = 0,
+      .offset = {},
+      .is_free = false,
+   };
+   m_glyph_indices.emplace(key, *index);
+
+   auto& info = m_glyph_infos[*index];
+   info.size = {metrics->width, metrics->height};
+   info.advance = {metrics->advance_x, metrics->advance_y};
+   info.padding = {metrics->bitmap_left, metrics->bitmap_top};
+
+   return index;
+}
+
+GlyphInfo DynamicGlyphAtlas::glyph_info(const GlyphIndex index) const
+{
+   std::unique_lock lk{m_mutex};
+   return m_glyph_infos[index];
+}
+
+bool DynamicGlyphAtlas::request_residency(const GlyphIndex index)
+{
+   std::unique_lock lk{m_mutex};
+
+   auto& slot = m_slots[index];
+   if (slot.residency == GlyphResidency::Resident) {
+      m_pages[slot.page].last_used = m_tick;
+      return true;
+   }
+   if (slot.residency == GlyphResidency::Pending) {
+      return false;
+   }
+
+   // Empty glyphs such as spaces don't occupy any space in the atlas.
+   if (slot.metrics.width == 0 || slot.metrics.height == 0) {
+      slot.residency = GlyphResidency::Resident;
+      this->write_glyph_info(index);
+      return true;
+   }
+
+   const auto page_id = this->find_page_for(slot);
+   if (not page_id.has_value()) {
+      return false;
+   }
+
+   auto& page = m_pages[*page_id];
+   page.glyphs.push_back(index);
+   page.last_used = m_tick;
+   ++page.pending_count;
+
+   slot.residency = GlyphResidency::Pending;
+   slot.page = *page_id;
+
+   m_rasterize_queue.push_back(index);
+   lk.unlock();
+
+   m_rasterize_cv.notify_one();
+   return false;
+}
+
+void DynamicGlyphAtlas::touch_pages(const u32 page_mask)
+{
+   std::unique_lock lk{m_mutex};
+   for (u32 page_id = 0; page_id < page_count; ++page_id) {
+      if (page_mask & (1u << page_id)) {
+         m_pages[page_id].last_used = m_tick;
+      }
+   }
+}
+
+void DynamicGlyphAtlas::flush_uploads()
+{
+   std::unique_lock lk{m_mutex};
+
+   if (std::ranges::any_of(m_pages, [](const Page& page) { return not page.dirty_regions.empty(); })) {
+      this->upload_dirty_regions();
+   }
+
+   if (m_dirty_info_begin < m_dirty_info_end) {
+      GAPI_CHECK_STATUS(m_glyph_buffer.write_indirect(&m_glyph_infos[m_dirty_info_begin],
+                                                      sizeof(GlyphInfo) * (m_dirty_info_end - m_dirty_info_begin),
+                                                      sizeof(GlyphInfo) * m_dirty_info_begin));
+      m_dirty_info_begin = max_glyph_count;
+      m_dirty_info_end = 0;
+   }
+
+   if (m_has_new_glyphs) {
+      ++m_residency_generation;
+      m_has_new_glyphs = false;
+   }
+
+   ++m_tick;
+}
+
+u64 DynamicGlyphAtlas::recycle_generation() const
+{
+   std::unique_lock lk{m_mutex};
+   return m_recycle_generation;
+}
+
+u64 DynamicGlyphAtlas::residency_generation() const
+{
+   std::unique_lock lk{m_mutex};
+   return m_residency_generation;
+}
+
+u64 DynamicGlyphAtlas::eviction_generation() const
+{
+   std::unique_lock lk{m_mutex};
+   return m_eviction_generation;
+}
+
+u32 DynamicGlyphAtlas::evicted_pages_since(const u64 generation) const
+{
+   std::unique_lock lk{m_mutex};
+
+   u32 result{};
+   for (u32 page_id = 0; page_id < page_count; ++page_id) {
+      if (m_pages[page_id].eviction_generation > generation) {
+         result |= 1u << page_id;
+      }
+   }
+   return result;
+}
+
+const graphics_api::Buffer& DynamicGlyphAtlas::glyph_buffer() const
+{
+   return m_glyph_buffer;
+}
+
+const graphics_api::Texture& DynamicGlyphAtlas::page_texture(const u32 page) const
+{
+   return m_pages[page].texture;
+}
+
+bool DynamicGlyphAtlas::allocate_region(const u32 page_id, GlyphSlot& slot)
+{
+   auto& page = m_pages[page_id];
+   const auto width = slot.metrics.width + g_glyph_separation;
+   const auto height = slot.metrics.height + g_glyph_separation;
+
+   // Pick the shelf that wastes the least vertical space.
+   Shelf* best_shelf = nullptr;
+   for (auto& shelf : page.shelves) {
+      if (shelf.height < height || shelf.cursor + width > page_size)
+         continue;
+      if (best_shelf == nullptr || shelf.height < best_shelf->height) {
+         best_shelf = &shelf;
+      }
+   }
+
+   // Don't waste too much space on a shelf made for larger glyphs.
+   if (best_shelf == nullptr || best_shelf->height > 2 * height) {
+      if (page.shelf_top + height <= page_size && width <= page_size) {
+         best_shelf = &page.shelves.emplace_back(Shelf{page.shelf_top, height, 0});
+         page.shelf_top += height;
+      } else if (best_shelf == nullptr) {
+         return false;
+      }
+   }
+
+   slot.offset = {best_shelf->cursor, best_shelf->top};
+   best_shelf->cursor += width;
+   return true;
+}
+
+std::optional<u32> DynamicGlyphAtlas::find_page_for(GlyphSlot& slot)
+{
+   for (u32 page_id = 0; page_id < page_count; ++page_id) {
+      if (this->allocate_region(page_id, slot)) {
+         return page_id;
+      }
+   }
+
+   // Evict the least recently used page that wasn't used by the current or the previous frame.
+   std::optional<u32> lru_page{};
+   for (u32 page_id = 0; page_id < page_count; ++page_id) {
+      const auto& page = m_pages[page_id];
+      if (page.pending_count != 0 || page.last_used + 1 >= m_tick)
+         continue;
+      if (not lru_page.has_value() || page.last_used < m_pages[*lru_page].last_used) {
+         lru_page = page_id;
+      }
+   }
+
+   if (not lru_page.has_value())
+      return std::nullopt;
+
+   this->evict_page(*lru_page);
+   if (not this->allocate_region(*lru_page, slot))
+      return std::nullopt;
+
+   return lru_page;
+}
+
+std::optional<GlyphIndex> DynamicGlyphAtlas::allocate_slot()
+{
+   if (m_slots.size() < max_glyph_count) {
+      const auto index = static_cast<GlyphIndex>(m_slots.size());
+      m_slots.emplace_back();
+      return index;
+   }
+
+   while (not m_free_slots.empty()) {
+      const auto index = m_free_slots.back();
+      m_free_slots.pop_back();
+
+      // The glyph may have been requested again since its page got evicted.
+      auto& slot = m_slots[index];
+      slot.is_free = false;
+      if (slot.residency != GlyphResidency::MetricsOnly)
+         continue;
+
+      m_glyph_indices.erase(slot.key);
+      ++m_recycle_generation;
+      return index;
+   }
+
+   return std::nullopt;
+}
+
+void DynamicGlyphAtlas::evict_page(const u32 page_id)
+{
+   auto& page = m_pages[page_id];
+   for (const auto index : page.glyphs) {
+      auto& slot = m_slots[index];
+      slot.residency = GlyphResidency::MetricsOnly;
+      if (not slot.is_free) {
+         slot.is_free = true;
+         m_free_slots.push_back(index);
+      }
+   }
+
+   page.glyphs.clear();
+   page.shelves.clear();
+   page.shelf_top = 0;
+   std::ranges::fill(page.pixels, 0);
+   page.dirty_regions.assign(1, page_region({0, 0}, {page_size, page_size}));
+   page.eviction_generation = ++m_eviction_generation;
+}
+
+void DynamicGlyphAtlas::write_glyph_info(const GlyphIndex index)
+{
+   static constexpr auto page_size_fp = static_cast<float>(page_size);
+
+   const auto& slot = m_slots[index];
+   const auto left = static_cast<float>(slot.offset.x);
+   const auto top = static_cast<float>(slot.offset.y);
+   const auto right = left + static_cast<float>(slot.metrics.width);
+   const auto bottom = top + static_cast<float>(slot.metrics.height);
+
+   auto& info = m_glyph_infos[index];
+   info.tex_coord_top_left = {left / page_size_fp, top / page_size_fp};
+   info.tex_coord_bottom_right = {right / page_size_fp, bottom / page_size_fp};
+   info.atlas_page = slot.page;
+
+   m_dirty_info_begin = std::min(m_dirty_info_begin, index);
+   m_dirty_info_end = std::max(m_dirty_info_end, index + 1);
+   m_has_new_glyphs = true;
+}
+
+void DynamicGlyphAtlas::upload_dirty_regions()
+{
+   // The previous upload may still read from the staging buffers.
+   m_upload_fence.await();
+
+   GAPI_CHECK_STATUS(m_upload_commands.begin(gapi::SubmitType::OneTime));
+
+   for (auto& page : m_pages) {
+      if (page.dirty_regions.empty())
+         continue;
+
+      {
+         const auto mapped_memory = GAPI_CHECK(page.staging_buffer.map_memory());
+         for (const auto& region : page.dirty_regions) {
+            for (u32 y = 0; y < region.extent.y; ++y) {
+               const auto offset = region.buffer_offset + static_cast<MemorySize>(y) * page_size;
+               mapped_memory.write_offset(&page.pixels[offset], region.extent.x, offset);
+            }
+         }
+      }
+
+      const gapi::TextureBarrierInfo transfer_barrier{
+         .texture = &page.texture,
+         .source_state = gapi::TextureState::ShaderRead,
+         .target_state = gapi::TextureState::TransferDst,
+         .base_mip_level = 0,
+         .mip_level_count = 1,
+      };
+      m_upload_commands.texture_barrier(gapi::PipelineStage::FragmentShader, gapi::PipelineStage::Transfer, transfer_barrier);
+
+      m_upload_commands.copy_buffer_to_texture_regions(page.staging_buffer, page.texture, page.dirty_regions);
+
+      const gapi::TextureBarrierInfo shader_read_barrier{
+         .texture = &page.texture,
+         .source_state = gapi::TextureState::TransferDst,
+         .target_state = gapi::TextureState::ShaderRead,
+         .base_mip_level = 0,
+         .mip_level_count = 1,
+      };
+      m_upload_commands.texture_barrier(gapi::PipelineStage::Transfer, gapi::PipelineStage::FragmentShader, shader_read_barrier);
+
+      page.dirty_regions.clear();
+   }
+
+   GAPI_CHECK_STATUS(m_upload_commands.finish());
+
+   const gapi::SemaphoreArray empty;
+   GAPI_CHECK_STATUS(m_device.submit_command_list(m_upload_commands, empty, empty, &m_upload_fence, gapi::WorkType::Graphics));
+}
+
+void DynamicGlyphAtlas::rasterizer_routine()
+{
+   std::unique_lock lk{m_mutex};
+
+   while (true) {
+      m_rasterize_cv.wait(lk, [this] { return m_is_quitting || not m_rasterize_queue.empty(); });
+      if (m_is_quitting)
+         break;
+
+      const auto index = m_rasterize_queue.front();
+      m_rasterize_queue.pop_front();
+
+      const auto key = m_slots[index].key;
+      const auto* typeface = m_slots[index].typeface;
+
+      lk.unlock();
+      const auto glyph = typeface->render_glyph(key.font_size, key.rune, key.render_mode);
+      lk.lock();
+
+      auto& slot = m_slots[index];
+      auto& page = m_pages[slot.page];
+      --page.pending_count;
+
+      if (glyph.has_value()) {
+         // The bitmap never exceeds the region reserved from the glyph metrics.
+         const auto width = std::min(glyph->width, slot.metrics.width);
+         const auto height = std::min(glyph->height, slot.metrics.height);
+         for (u32 y = 0; y < height; ++y) {
+            std::memcpy(&page.pixels[slot.offset.x + (slot.offset.y + y) * page_size], &glyph->data[y * glyph->width], width);
+         }
+         if (width != 0 && height != 0) {
+            page.dirty_regions.push_back(page_region(slot.offset, {width, height}));
+         }
+      }
+
+      slot.residency = GlyphResidency::Resident;
+      this->write_glyph_info(index);
+   }
+}
+
+}// namespace triglav::render_core
@@ -92,9 +92,18 @@ void GenerateCommandListPass::visit(const detail::cmd::BindDescriptors& cmd) con
    assert(m_descriptor_pool != nullptr);
    assert(m_current_pipeline != nullptr);
 
-   auto& descriptor_array = m_context.allocate_descriptors(m_descriptor_storage, *m_descriptor_pool, *m_current_pipeline);
-   m_context.write_descriptor(m_resource_storage, descriptor_array[0], cmd, m_frame_index);
-   m_command_list.bind_descriptor_set(m_current_pipeline->pipeline_type(), descriptor_array[0]);
+   // Flag variants, frames and draws binding the same resources share the set.
+   auto key = m_context.descriptor_key(m_resource_storage, *m_current_pipeline, cmd, m_frame_index);
+   auto desc_view = m_descriptor_storage.find_descriptor_set(key);
+   if (not desc_view.has_value()) {
+      auto& descriptor_array = m_context.allocate_descriptors(m_descriptor_storage, *m_descriptor_pool, *m_current_pipeline);
+      m_context.write_descriptor(m_resource_storage, descriptor_array[0], cmd, m_frame_index);
+      desc_view = descriptor_array[0];
+      m_descriptor_storage.store_descriptor_set(std::move(key), *desc_view);
+   }
+
+   m_command_list.bind_descriptor_set(m_current_pipeline->pipeline_type(), *desc_view);
+   m_descriptor_storage.count_bind();
 }
 
 void GenerateCommandListPass::visit(const detail::cmd::BindVertexBuffer& cmd) const
@@ -166,6 +175,8 @@ void GenerateCommandListPass::visit(const detail::cmd::PlaceTextureBarrier& cmd)
    info.target_state = cmd.barrier->dst_state;
    info.base_mip_level = cmd.barrier->base_mip_level;
    info.mip_level_count = cmd.barrier->mip_level_count;
+   info.source_queue_family = cmd.barrier->src_queue_family;
+   info.target_queue_family = cmd.barrier->dst_queue_family;
    m_command_list.texture_barrier(cmd.barrier->src_stage_flags, cmd.barrier->dst_stage_flags, info);
 }
 
@@ -175,6 +186,8 @@ void GenerateCommandListPass::visit(const detail::cmd::PlaceBufferBarrier& cmd)
    barrier.buffer = &m_context.resolve_buffer_ref(m_resource_storage, cmd.barrier->buffer_ref, m_frame_index);
    barrier.src_access = cmd.barrier->src_buffer_access;
    barrier.dst_access = cmd.barrier->dst_buffer_access;
+   barrier.src_queue_family = cmd.barrier->src_queue_family;
+   barrier.dst_queue_family = cmd.barrier->dst_queue_family;
    m_command_list.buffer_barrier(cmd.barrier->src_stage_flags, cmd.barrier->dst_stage_flags, std::array{barrier});
 }
 
@@ -197,13 +210,16 @@ void GenerateCommandListPass::visit(const detail::cmd::BeginRenderPass& cmd) con
    m_command_list.begin_debug_label(name, {0.1f, 0.5f, 0.1f, 1.0f});
 #endif
 
+   this->write_profile_timestamp(cmd.profile_zone, false);
+
    const auto rendering_info = m_context.create_rendering_info(m_resource_storage, cmd, m_frame_index);
    m_command_list.begin_rendering(rendering_info);
 }
 
-void GenerateCommandListPass::visit(const detail::cmd::EndRenderPass& /*cmd*/) const
+void GenerateCommandListPass::visit(const detail::cmd::EndRenderPass& cmd) const
 {
    m_command_list.end_rendering();
+   this->write_profile_timestamp(cmd.profile_zone, true);
 #ifndef NDEBUG
    m_command_list.end_debug_label();
 #endif
@@ -264,4 +280,14 @@ void GenerateCommandListPass::default_visit(const detail::Command&) const
    assert(false && "unsupported instructions");
 }
 
+void GenerateCommandListPass::write_profile_timestamp(const u32 zone, const bool is_closing) const
+{
+   if (not m_context.m_first_profile_zone.has_value())
+      return;
+
+   auto& gpu_profiler = m_resource_storage.gpu_profiler();
+   m_command_list.write_timestamp(is_closing ? gapi::PipelineStage::End : gapi::PipelineStage::Entrypoint, gpu_profiler.query_pool(),
+                                  gpu_profiler.query_index(m_frame_index, *m_context.m_first_profile_zone + zone, is_closing));
+}
+
 }// namespace triglav::render_core
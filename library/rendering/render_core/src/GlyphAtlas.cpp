@@ -1,193 +1,206 @@
 #include "GlyphAtlas.hpp"
 
-#include "RenderCore.hpp"
-
-#include "triglav/graphics_api/Device.hpp"
-
-#include <cstring>
-#include <locale>
-#include <vector>
+#include "triglav/detail/Crc.hpp"
 
 namespace triglav::render_core {
 
-namespace gapi = graphics_api;
-
-GlyphAtlas::GlyphAtlas(gapi::Device& device, const font::Typeface& typeface, const font::Charset& atlas_runes, const int glyph_size,
-                       const uint32_t width, const uint32_t height) :
-    m_glyph_size(static_cast<float>(glyph_size)),
-    m_texture(check_result(device.create_texture(GAPI_FORMAT(R, UNorm8), {width, height}))),
-    m_glyph_storage_buffer(
-       GAPI_CHECK(device.create_buffer(gapi::BufferUsage::StorageBuffer | gapi::BufferUsage::TransferDst | gapi::BufferUsage::TransferSrc,
-                                       sizeof(GlyphInfo) * atlas_runes.count())))
+namespace {
+
+constexpr Rune g_ascii_rune_count = 0x80;
+constexpr Rune g_direct_rune_limit = 0x10000;
+constexpr Rune g_direct_table_growth = 0x100;
+constexpr MemorySize g_text_metric_cache_capacity = 512;
+
+}// namespace
+
+GlyphAtlas::GlyphAtlas(DynamicGlyphAtlas& dynamic_atlas, const font::Typeface& typeface, const TypefaceName typeface_name,
+                       const int glyph_size, const font::GlyphRenderMode render_mode) :
+    m_dynamic_atlas(dynamic_atlas),
+    m_typeface(typeface),
+    m_typeface_name(typeface_name),
+    m_glyph_size(glyph_size),
+    m_render_mode(render_mode),
+    m_atlas_glyph_size(render_mode == font::GlyphRenderMode::SignedDistanceField ? g_sdf_glyph_size : glyph_size),
+    m_glyph_scale(static_cast<float>(glyph_size) / static_cast<float>(m_atlas_glyph_size)),
+    m_direct_glyphs(g_ascii_rune_count),
+    m_text_metrics(g_text_metric_cache_capacity)
 {
-   std::vector<uint8_t> atlas_data{};
-   atlas_data.resize(width * height);
-
-   const auto width_fp = static_cast<float>(width);
-   const auto height_fp = static_cast<float>(height);
-
-   static constexpr uint32_t separation = 4;
+}
 
-   uint32_t left = separation;
-   uint32_t top = separation;
-   uint32_t max_height = 0;
+TextMetric GlyphAtlas::measure_text(const StringView text) const
+{
+   const auto hash = detail::hash_string(text.to_std());
+   {
+      std::unique_lock lk{m_text_metric_mtx};
+      if (const auto* cached = m_text_metrics.find(hash); cached != nullptr && cached->text == text.to_std()) {
+         return cached->metric;
+      }
+   }
 
-   std::vector<GlyphInfo> glyph_info_vec;
-   glyph_info_vec.reserve(atlas_runes.count());
+   bool is_exact{};
+   const auto metric = this->calculate_text_metric(text, is_exact);
+   if (not is_exact) {
+      // Cache the metric only once every glyph got a slot, otherwise it would keep the fallback advance.
+      return metric;
+   }
 
-   for (const auto rune : atlas_runes) {
-      auto glyph = typeface.render_glyph(glyph_size, rune);
-      assert(glyph.has_value());
+   std::unique_lock lk{m_text_metric_mtx};
+   m_text_metrics.insert(hash, CachedTextMetric{std::string{text.to_std()}, metric});
+   return metric;
+}
 
-      auto bottom = top + glyph->height;
-      assert((bottom + separation) <= height);
+u32 GlyphAtlas::find_rune_index(const StringView text, const float offset) const
+{
+   std::unique_lock lk{m_glyph_mtx};
 
-      max_height = std::max(max_height, glyph->height + separation);
-      auto right = left + glyph->width;
-      if (right > width) {
-         left = separation;
-         right = left + glyph->width;
-         top += max_height;
-         bottom = top + glyph->height;
-         max_height = glyph->height + separation;
-      }
+   float width = 0.0f;
 
-      m_glyph_infos.emplace(
-         rune, glyph_info_vec.emplace_back(GlyphInfo{{static_cast<float>(left) / width_fp, static_cast<float>(top) / height_fp},
-                                                     {static_cast<float>(right) / width_fp, static_cast<float>(bottom) / height_fp},
-                                                     {glyph->width, glyph->height},
-                                                     {glyph->advance_x, glyph->advance_y},
-                                                     {glyph->bitmap_left, glyph->bitmap_top}}));
+   u32 index = 0;
+   for (const Rune rune : text) {
+      const float rune_width = this->cached_glyph(rune, lk).advance;
 
-      for (u32 y = 0; y < glyph->height; ++y) {
-         std::memcpy(&atlas_data[left + (top + y) * width], &glyph->data[y * glyph->width], glyph->width);
+      if ((width + 0.5f * rune_width) >= offset) {
+         return index;
       }
 
-      left = right + separation;
+      width += rune_width;
+      ++index;
    }
 
-   m_texture.write(device, atlas_data.data());
-   m_texture.set_anisotropy_state(false);
-
-   GAPI_CHECK_STATUS(m_glyph_storage_buffer.write_indirect(glyph_info_vec.data(), sizeof(GlyphInfo) * glyph_info_vec.size()));
+   return index;
 }
 
-std::vector<GlyphVertex> GlyphAtlas::create_glyph_vertices(const StringView text, TextMetric* out_metric) const
+GlyphEncodeResult GlyphAtlas::encode_text(const StringView text, u32* out_indices) const
 {
-   std::vector<GlyphVertex> vertices;
-   vertices.reserve(text.size() * 6);
+   std::unique_lock lk{m_glyph_mtx};
+   this->drop_recycled_glyphs();
 
-   float x = 0.0f;
-   float max_height = 0.0f;
+   GlyphEncodeResult result{0, 0, true};
 
-   for (const auto ch : text) {
-      if (not m_glyph_infos.contains(ch)) {
-         x += m_glyph_size;
+   for (const Rune rune : text) {
+      const auto glyph = this->cached_glyph(rune, lk);
+      if (not glyph.is_loaded) {
+         result.is_resident = false;
          continue;
       }
 
-      const auto& info = m_glyph_infos.at(ch);
-      if (max_height < info.size.y) {
-         max_height = info.size.y;
-      }
-
-      const auto right = x + info.size.x;
-
-      // top left
-      vertices.emplace_back(glm::vec2{x + info.padding.x, -info.padding.y},
-                            glm::vec2{info.tex_coord_top_left.x, info.tex_coord_top_left.y});
-
-      // bottom left
-      vertices.emplace_back(glm::vec2{x + info.padding.x, -info.padding.y + info.size.y},
-                            glm::vec2{info.tex_coord_top_left.x, info.tex_coord_bottom_right.y});
-
-      // top right
-      vertices.emplace_back(glm::vec2{right + info.padding.x, -info.padding.y},
-                            glm::vec2{info.tex_coord_bottom_right.x, info.tex_coord_top_left.y});
-
-      // top right
-      vertices.emplace_back(glm::vec2{right + info.padding.x, -info.padding.y},
-                            glm::vec2{info.tex_coord_bottom_right.x, info.tex_coord_top_left.y});
-
-      // bottom left
-      vertices.emplace_back(glm::vec2{x + info.padding.x, -info.padding.y + info.size.y},
-                            glm::vec2{info.tex_coord_top_left.x, info.tex_coord_bottom_right.y});
+      const auto index = glyph.index;
+      if (index == g_empty_glyph_index)
+         continue;
 
-      // bottom right
-      vertices.emplace_back(glm::vec2{right + info.padding.x, -info.padding.y + info.size.y},
-                            glm::vec2{info.tex_coord_bottom_right.x, info.tex_coord_bottom_right.y});
+      if (m_dynamic_atlas.request_residency(index)) {
+         result.page_mask |= 1u << m_dynamic_atlas.glyph_info(index).atlas_page;
+      } else {
+         result.is_resident = false;
+      }
 
-      x += info.advance.x;
+      out_indices[result.glyph_count++] = index;
    }
 
-   if (out_metric != nullptr) {
-      out_metric->width = x;
-      out_metric->height = max_height;
+   // Indices written before a slot got reused may point to other glyphs, the text needs to be encoded again.
+   if (m_dynamic_atlas.recycle_generation() != m_recycle_generation) {
+      result.is_resident = false;
    }
 
-   return vertices;
+   return result;
 }
 
-const graphics_api::Texture& GlyphAtlas::texture() const
+DynamicGlyphAtlas& GlyphAtlas::dynamic_atlas() const
 {
-   return m_texture;
+   return m_dynamic_atlas;
 }
 
-graphics_api::Texture& GlyphAtlas::texture()
+font::GlyphRenderMode GlyphAtlas::render_mode() const
 {
-   return m_texture;
+   return m_render_mode;
 }
 
-TextMetric GlyphAtlas::measure_text(const StringView text) const
+float GlyphAtlas::glyph_scale() const
 {
-   float width = 0.0f;
-   float height = 0.0f;
+   return m_glyph_scale;
+}
 
-   for (const Rune rune : text) {
-      if (not m_glyph_infos.contains(rune)) {
-         width += m_glyph_size;
-         continue;
-      }
+GlyphAtlas::CachedGlyph GlyphAtlas::cached_glyph(const Rune rune, std::unique_lock<std::mutex>& glyph_lk) const
+{
+   if (rune < m_direct_glyphs.size() && m_direct_glyphs[rune].is_loaded) {
+      return m_direct_glyphs[rune];
+   }
+   if (const auto it = m_other_glyphs.find(rune); it != m_other_glyphs.end()) {
+      return it->second;
+   }
+
+   glyph_lk.unlock();
+   const auto glyph = this->load_glyph(rune);
+   glyph_lk.lock();
+
+   // Glyphs that didn't get a slot in the atlas are loaded again next time.
+   if (not glyph.is_loaded) {
+      return glyph;
+   }
 
-      const auto& info = m_glyph_infos.at(rune);
-      if (info.size.y > height) {
-         height = info.size.y;
+   // Another thread may have loaded the same glyph meanwhile, the atlas returns the same index for both.
+   if (rune < g_direct_rune_limit) {
+      if (rune >= m_direct_glyphs.size()) {
+         m_direct_glyphs.resize((rune / g_direct_table_growth + 1) * g_direct_table_growth);
       }
+      m_direct_glyphs[rune] = glyph;
+   } else {
+      m_other_glyphs.insert_or_assign(rune, glyph);
+   }
+   return glyph;
+}
 
-      width += info.advance.x;
+GlyphAtlas::CachedGlyph GlyphAtlas::load_glyph(const Rune rune) const
+{
+   const auto index = m_dynamic_atlas.find_or_add_glyph(m_typeface, GlyphKey{m_typeface_name, m_atlas_glyph_size, rune, m_render_mode});
+   if (not index.has_value()) {
+      return CachedGlyph{g_empty_glyph_index, static_cast<float>(m_glyph_size), 0.0f, false};
+   }
+   if (*index == g_empty_glyph_index) {
+      return CachedGlyph{g_empty_glyph_index, static_cast<float>(m_glyph_size), 0.0f, true};
    }
 
-   return TextMetric{.width = width, .height = height};
+   const auto info = m_dynamic_atlas.glyph_info(*index);
+
+   auto height = info.size.y;
+   if (m_render_mode == font::GlyphRenderMode::SignedDistanceField && height > 0.0f) {
+      height -= 2.0f * static_cast<float>(font::g_sdf_spread);
+   }
+
+   return CachedGlyph{*index, m_glyph_scale * info.advance.x, m_glyph_scale * height, true};
 }
 
-u32 GlyphAtlas::find_rune_index(const StringView text, const float offset) const
+void GlyphAtlas::drop_recycled_glyphs() const
 {
+   const auto generation = m_dynamic_atlas.recycle_generation();
+   if (generation == m_recycle_generation)
+      return;
+
+   m_direct_glyphs.assign(m_direct_glyphs.size(), CachedGlyph{});
+   m_other_glyphs.clear();
+   m_recycle_generation = generation;
+}
+
+TextMetric GlyphAtlas::calculate_text_metric(const StringView text, bool& out_is_exact) const
+{
+   std::unique_lock lk{m_glyph_mtx};
+
    float width = 0.0f;
+   float height = 0.0f;
+   out_is_exact = true;
 
-   u32 index = 0;
    for (const Rune rune : text) {
-      float rune_width;
-      if (not m_glyph_infos.contains(rune)) {
-         rune_width = m_glyph_size;
-      } else {
-         const auto& info = m_glyph_infos.at(rune);
-         rune_width = info.advance.x;
+      const auto glyph = this->cached_glyph(rune, lk);
+      if (not glyph.is_loaded) {
+         out_is_exact = false;
       }
-
-      if ((width + 0.5f * rune_width) >= offset) {
-         return index;
+      if (glyph.height > height) {
+         height = glyph.height;
       }
-
-      width += rune_width;
-      ++index;
+      width += glyph.advance;
    }
 
-   return index;
-}
-
-const graphics_api::Buffer& GlyphAtlas::storage_buffer() const
-{
-   return m_glyph_storage_buffer;
+   return TextMetric{.width = width, .height = height};
 }
 
-}// namespace triglav::render_core
\ No newline at end of file
+}// namespace triglav::render_core
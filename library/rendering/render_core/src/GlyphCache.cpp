@@ -13,26 +13,44 @@ u64 GlyphProperties::hash() const
 
 // GlyphCache
 
-GlyphCache::GlyphCache(graphics_api::Device& device, resource::ResourceManager& resource_manager) :
-    m_device(device),
-    m_resource_manager(resource_manager)
+GlyphCache::GlyphCache(graphics_api::Device& device, resource::ResourceManager& resource_manager,
+                       const int sdf_min_font_size) :
+    m_resource_manager(resource_manager),
+    m_sdf_min_font_size(sdf_min_font_size),
+    m_dynamic_atlas(device)
 {
 }
 
 const GlyphAtlas& GlyphCache::find_glyph_atlas(const GlyphProperties& properties)
 {
+   std::unique_lock lk{m_atlases_mtx};
+
    auto hash = properties.hash();
    auto it = m_atlases.find(hash);
    if (it != m_atlases.end()) {
       return it->second;
    }
 
+   if (!m_typeface_refs.contains(properties.typeface)) {
+      m_typeface_refs.emplace(properties.typeface, m_resource_manager.acquire(properties.typeface));
+   }
+
    auto& typeface = m_resource_manager.get(properties.typeface);
-   auto [atlas_it, ok] = m_atlases.emplace(hash, GlyphAtlas(m_device, typeface, font::Charset::European, properties.font_size,
-                                                            22 * properties.font_size, 22 * properties.font_size));
+   auto [atlas_it, ok] = m_atlases.try_emplace(hash, m_dynamic_atlas, typeface, properties.typeface, properties.font_size,
+                                                 this->render_mode(properties.font_size));
    assert(ok);
 
    return atlas_it->second;
 }
 
+DynamicGlyphAtlas& GlyphCache::dynamic_atlas()
+{
+   return m_dynamic_atlas;
+}
+
+font::GlyphRenderMode GlyphCache::render_mode(const int font_size) const
+{
+   return font_size >= m_sdf_min_font_size ? font::GlyphRenderMode::SignedDistanceField : font::GlyphRenderMode::Bitmap;
+}
+
 }// namespace triglav::render_core
\ No newline at end of file
@@ -0,0 +1,124 @@
+#include "GpuProfiler.hpp"
+
+#include "triglav/NameResolution.hpp"
+#include "triglav/Profiler.hpp"
+#include "triglav/graphics_api/Device.hpp"
+
+#include <algorithm>
+#include <format>
+
+namespace triglav::render_core {
+
+namespace {
+
+std::string_view profile_zone_name(Profiler& profiler, const Name name)
+{
+   const auto resolved_name = resolve_name(name);
+   if (not resolved_name.empty())
+      return resolved_name;
+
+   return profiler.intern(std::format("{:016x}", name));
+}
+
+}// namespace
+
+GpuProfiler::GpuProfiler(graphics_api::Device& device) :
+    m_query_pool(GAPI_CHECK(device.create_query_pool(graphics_api::QueryType::Timestamp, 2 * max_zone_count * FRAMES_IN_FLIGHT_COUNT)))
+{
+}
+
+std::optional<u32> GpuProfiler::reserve_zones(const Name job_name, const std::span<const Name> zone_names)
+{
+   const auto zone_count = static_cast<u32>(zone_names.size()) + 1;
+
+   auto it = m_job_zones.find(job_name);
+   if (it == m_job_zones.end() || it->second.capacity < zone_count) {
+      if (m_zone_top + zone_count > max_zone_count)
+         return std::nullopt;
+
+      it = m_job_zones.insert_or_assign(job_name, ZoneRange{m_zone_top, zone_count, zone_count}).first;
+      m_zone_top += zone_count;
+   }
+
+   const auto first = it->second.first;
+   m_zone_names[first] = job_name;
+   std::ranges::copy(zone_names, m_zone_names.begin() + first + 1);
+   it->second.count = zone_count;
+
+   return first;
+}
+
+u32 GpuProfiler::query_index(const u32 frame_index, const u32 zone, const bool is_closing) const
+{
+   return 2 * (frame_index * max_zone_count + zone) + (is_closing ? 1 : 0);
+}
+
+graphics_api::QueryPool& GpuProfiler::query_pool()
+{
+   return m_query_pool;
+}
+
+void GpuProfiler::collect(const u32 frame_index)
+{
+   auto& submission = m_submissions[frame_index];
+   auto& profiler = Profiler::the();
+   if (submission.jobs.empty() || not profiler.is_capturing()) {
+      submission.jobs.clear();
+      return;
+   }
+
+   struct Timing
+   {
+      Name name;
+      u64 begin_ns;
+      u64 end_ns;
+   };
+
+   std::vector<Timing> timings;
+   std::vector<std::optional<u64>> timestamps;
+   for (const Name job_name : submission.jobs) {
+      const auto it = m_job_zones.find(job_name);
+      if (it == m_job_zones.end())
+         continue;
+
+      const auto& range = it->second;
+      timestamps.resize(2 * range.count);
+      m_query_pool.get_available_timestamps_ns(timestamps, this->query_index(frame_index, range.first, false));
+
+      for (u32 zone = 0; zone < range.count; ++zone) {
+         const auto begin = timestamps[2 * zone];
+         const auto end = timestamps[2 * zone + 1];
+         if (begin.has_value() && end.has_value()) {
+            timings.emplace_back(m_zone_names[range.first + zone], *begin, *end);
+         }
+      }
+   }
+
+   // GPU and CPU clocks are not calibrated, the first GPU timestamp is aligned with the submission of the frame.
+   if (not timings.empty()) {
+      const auto gpu_begin = std::ranges::min(timings, {}, &Timing::begin_ns).begin_ns;
+      for (const auto& timing : timings) {
+         profiler.add_zone({
+            .name = profile_zone_name(profiler, timing.name),
+            .category = "gpu",
+            .detail = {},
+            .track = g_gpu_profile_track,
+            .begin_ns = submission.submit_ns + static_cast<i64>(timing.begin_ns - gpu_begin),
+            .end_ns = submission.submit_ns + static_cast<i64>(timing.end_ns - gpu_begin),
+         });
+      }
+   }
+
+   submission.jobs.clear();
+}
+
+void GpuProfiler::on_job_submitted(const Name job_name, const u32 frame_index)
+{
+   auto& submission = m_submissions[frame_index];
+   if (submission.jobs.empty()) {
+      submission.submit_ns = Profiler::the().now_ns();
+   }
+   submission.jobs.emplace_back(job_name);
+}
+
+}// namespace triglav::render_core
@@ -1,16 +1,19 @@
 #include "Job.hpp"
 
+#include "triglav/Ranges.hpp"
 #include "triglav/Template.hpp"
 
 namespace triglav::render_core {
 
-Job::Job(graphics_api::Device& device, std::optional<graphics_api::DescriptorPool> descriptor_pool, const std::span<Frame> job_frames,
-         const graphics_api::WorkTypeFlags& work_types, std::vector<Name> flags) :
+Job::Job(graphics_api::Device& device, std::optional<graphics_api::DescriptorPool> descriptor_pool, DescriptorStorage desc_storage,
+         const std::span<Frame> job_frames, const graphics_api::WorkTypeFlags& work_types, std::vector<Name> flags, const u32 import_count) :
     m_device(device),
     m_descriptor_pool(std::move(descriptor_pool)),
+    m_desc_storage(std::move(desc_storage)),
     m_job_frames(span_to_array<Frame, FRAMES_IN_FLIGHT_COUNT>(job_frames)),
     m_work_types(work_types),
-    m_flags(std::move(flags))
+    m_flags(std::move(flags)),
+    m_import_count(import_count)
 {
 }
 
@@ -26,12 +29,45 @@ void Job::disable_flag(const Name name)
    m_enabled_flags &= ~(1 << index);
 }
 
+bool Job::has_flag(const Name name) const
+{
+   return std::ranges::find(m_flags, name) != m_flags.end();
+}
+
+std::vector<Name> Job::enabled_flags() const
+{
+   std::vector<Name> result;
+   for (const auto [index, flag] : Enumerate(m_flags)) {
+      if (m_enabled_flags & (1 << index)) {
+         result.emplace_back(flag);
+      }
+   }
+   return result;
+}
+
+void Job::set_import_index(const u32 import_index)
+{
+   assert(import_index < m_import_count);
+   m_import_index = import_index;
+}
+
 void Job::execute(const u32 frame_index, const graphics_api::SemaphoreArrayView wait_semaphores,
                   const graphics_api::SemaphoreArrayView signal_semaphores, const graphics_api::Fence* fence) const
 {
    assert(frame_index < FRAMES_IN_FLIGHT_COUNT);
-   GAPI_CHECK_STATUS(m_device.submit_command_list(m_job_frames.at(frame_index).command_list.at(m_enabled_flags), wait_semaphores,
+   GAPI_CHECK_STATUS(m_device.submit_command_list(m_job_frames.at(frame_index).command_list.at(this->variant_index()), wait_semaphores,
                                                   signal_semaphores, fence, m_work_types));
 }
 
+const graphics_api::CommandList& Job::command_list(const u32 frame_index) const
+{
+   assert(frame_index < FRAMES_IN_FLIGHT_COUNT);
+   return m_job_frames.at(frame_index).command_list.at(this->variant_index());
+}
+
+u32 Job::variant_index() const
+{
+   return m_enabled_flags * m_import_count + m_import_index;
+}
+
 }// namespace triglav::render_core
@@ -2,7 +2,9 @@
 
 #include "triglav/Ranges.hpp"
 
+#include <cassert>
 #include <deque>
+#include <ranges>
 #include <set>
 
 namespace triglav::render_core {
@@ -76,14 +78,28 @@ void JobGraph::disable_flag(const Name job, const Name flag)
    m_jobs.at(job).disable_flag(flag);
 }
 
+void JobGraph::set_import_index(const Name job, const u32 import_index)
+{
+   m_jobs.at(job).set_import_index(import_index);
+}
+
+void JobGraph::set_submission_mode(const SubmissionMode mode)
+{
+   assert(!m_has_built_semaphores);
+   m_submission_mode = mode;
+}
+
 void JobGraph::build_jobs(const Name target_job)
 {
    this->deduce_job_order(target_job);
+   this->schedule_queues();
 
    for (auto& name : m_job_order) {
       if (!m_contexts.contains(name))
          continue;
 
+      this->apply_queue_schedule(name);
+
       auto& ctx = m_contexts.at(name);
       m_jobs.emplace(name, ctx.build_job(m_pipeline_cache, m_resource_storage, name));
       m_job_semaphores.emplace(name, JobSemaphores{});
@@ -95,9 +111,29 @@ void JobGraph::build_jobs(const Name target_job)
 
 void JobGraph::rebuild_job(const Name job)
 {
-   auto& ctx = m_contexts.at(job);
-   m_jobs.erase(job);
-   m_jobs.emplace(job, ctx.build_job(m_pipeline_cache, m_resource_storage, job));
+   // The job keeps the queue family it was scheduled on when the graph was built.
+   this->apply_queue_schedule(job);
+   this->replace_built_job(job, m_contexts.at(job).build_job(m_pipeline_cache, m_resource_storage, job));
+}
+
+void JobGraph::rerecord_job(const Name job)
+{
+   this->apply_queue_schedule(job);
+   this->replace_built_job(job, m_contexts.at(job).record_job(m_pipeline_cache, m_resource_storage, job));
+}
+
+void JobGraph::replace_built_job(const Name name, Job&& job)
+{
+   // Flags are switched from outside of the job, they carry over to the new one.
+   if (const auto it = m_jobs.find(name); it != m_jobs.end()) {
+      for (const Name flag : it->second.enabled_flags()) {
+         if (job.has_flag(flag)) {
+            job.enable_flag(flag);
+         }
+      }
+      m_jobs.erase(it);
+   }
+   m_jobs.emplace(name, std::move(job));
 }
 
 graphics_api::Semaphore& JobGraph::semaphore(const Name wait_job, const Name signal_job, const u32 frame_index)
@@ -121,6 +157,16 @@ void JobGraph::execute(const Name target_job, const u32 frame_index, const graph
 
    this->deduce_job_order(target_job);
 
+   // Command lists of this frame are reused so its previous submission must have completed.
+   auto& gpu_profiler = m_resource_storage.gpu_profiler();
+   gpu_profiler.collect(frame_index);
+
+   if (m_submission_mode == SubmissionMode::Batched) {
+      this->submit_batched(frame_index, fence);
+      m_is_first_frame = false;
+      return;
+   }
+
    for (Name job_name : m_job_order) {
       if (!m_jobs.contains(job_name)) {
          continue;
@@ -133,11 +179,77 @@ void JobGraph::execute(const Name target_job, const u32 frame_index, const graph
       auto& wait_sems = m_is_first_frame ? job_semaphores.wait_in_frame_semaphores : job_semaphores.wait_semaphores;
 
       job.execute(frame_index, wait_sems, job_semaphores.signal_semaphores, fence_ptr);
+      gpu_profiler.on_job_submitted(job_name, frame_index);
    }
 
    m_is_first_frame = false;
 }
 
+void JobGraph::submit_batched(const u32 frame_index, const graphics_api::Fence* fence)
+{
+   ++m_frame_serial;
+   m_submit_batch.clear();
+
+   auto& gpu_profiler = m_resource_storage.gpu_profiler();
+
+   for (Name job_name : m_job_order) {
+      if (!m_jobs.contains(job_name)) {
+         continue;
+      }
+
+      const auto& job = m_jobs.at(job_name);
+      const auto& job_semaphores = m_job_semaphores.at(job_name).frame_semaphores[frame_index];
+
+      m_submit_batch.add_command_list(job.command_list(frame_index));
+
+      // Binary semaphores are only left on the edges to external jobs.
+      m_submit_batch.wait_semaphores(m_is_first_frame ? job_semaphores.wait_in_frame_semaphores : job_semaphores.wait_semaphores);
+
+      // Dependencies precede the job in the order, so they have already been signaled with the current serial.
+      for (Name dependency : equal_range(m_dependencies, job_name)) {
+         if (!this->is_timeline_dependency(job_name, dependency))
+            continue;
+
+         const auto& dep_timeline = m_job_timelines.at(dependency);
+         m_submit_batch.wait_semaphore(dep_timeline.semaphore, dep_timeline.value);
+      }
+
+      for (Name dependency : equal_range(m_interframe_dependencies, job_name)) {
+         if (!this->is_timeline_dependency(job_name, dependency))
+            continue;
+
+         const auto& dep_timeline = m_job_timelines.at(dependency);
+         const auto value = dep_timeline.value == m_frame_serial ? dep_timeline.previous_value : dep_timeline.value;
+         if (value != 0) {
+            m_submit_batch.wait_semaphore(dep_timeline.semaphore, value);
+         }
+      }
+
+      auto& timeline = m_job_timelines.at(job_name);
+      timeline.previous_value = timeline.value;
+      timeline.value = m_frame_serial;
+
+      m_submit_batch.signal_semaphore(timeline.semaphore, timeline.value);
+      m_submit_batch.signal_semaphores(job_semaphores.signal_semaphores);
+
+      gpu_profiler.on_job_submitted(job_name, frame_index);
+   }
+
+   GAPI_CHECK_STATUS(m_device.submit_batch(m_submit_batch, fence));
+}
+
+void JobGraph::await_job(const Name job) const
+{
+   assert(m_submission_mode == SubmissionMode::Batched);
+   const auto& timeline = m_job_timelines.at(job);
+   timeline.semaphore.await(timeline.value);
+}
+
+bool JobGraph::is_timeline_dependency(const Name target, const Name dependency) const
+{
+   return m_submission_mode == SubmissionMode::Batched && m_jobs.contains(target) && m_jobs.contains(dependency);
+}
+
 ResourceStorage& JobGraph::resources()
 {
    return m_resource_storage;
@@ -153,6 +265,9 @@ void JobGraph::build_semaphores()
       auto& job_semaphores = semaphores.frame_semaphores;
 
       for (Name dependency : equal_range(m_dependencies, job_name)) {
+         if (this->is_timeline_dependency(job_name, dependency))
+            continue;
+
          for (const u32 frame_index : Range(0, FRAMES_IN_FLIGHT_COUNT)) {
             auto [sem, ok] = job_semaphores[frame_index].owned_semaphores.emplace(dependency, GAPI_CHECK(m_device.create_semaphore()));
             assert(ok);
@@ -166,6 +281,9 @@ void JobGraph::build_semaphores()
       }
 
       for (Name dependency : equal_range(m_interframe_dependencies, job_name)) {
+         if (this->is_timeline_dependency(job_name, dependency))
+            continue;
+
          for (const u32 frame_index : Range(0, FRAMES_IN_FLIGHT_COUNT)) {
             const u32 previous_frame_index = (frame_index + FRAMES_IN_FLIGHT_COUNT - 1) % FRAMES_IN_FLIGHT_COUNT;
 
@@ -180,9 +298,50 @@ void JobGraph::build_semaphores()
       }
    }
 
+   if (m_submission_mode == SubmissionMode::Batched) {
+      for (const auto& job_name : m_jobs | std::views::keys) {
+         m_job_timelines.emplace(job_name, JobTimeline{GAPI_CHECK(m_device.create_timeline_semaphore())});
+      }
+   }
+
    m_has_built_semaphores = true;
 }
 
+void JobGraph::schedule_queues()
+{
+   std::vector<JobQueueUsage> usages;
+   usages.reserve(m_job_order.size());
+   for (const Name name : m_job_order) {
+      if (!m_contexts.contains(name))
+         continue;
+
+      const auto& ctx = m_contexts.at(name);
+      usages.emplace_back(name, ctx.work_types(), ctx.exported_resources(), ctx.external_resources(), ctx.has_untracked_resources());
+   }
+
+   m_queue_schedule = schedule_job_queues(usages, m_device.queue_family_infos());
+}
+
+void JobGraph::apply_queue_schedule(const Name job)
+{
+   const auto work_types_it = m_queue_schedule.queue_work_types.find(job);
+   if (work_types_it == m_queue_schedule.queue_work_types.end())
+      return;
+
+   std::vector<QueueOwnershipTransfer> releases;
+   std::vector<QueueOwnershipTransfer> acquires;
+   for (const auto& transfer : m_queue_schedule.transfers) {
+      if (transfer.src_job == job) {
+         releases.emplace_back(transfer);
+      }
+      if (transfer.dst_job == job) {
+         acquires.emplace_back(transfer);
+      }
+   }
+
+   m_contexts.at(job).set_queue_ownership(work_types_it->second, std::move(releases), std::move(acquires));
+}
+
 void JobGraph::deduce_job_order(const Name target_job)
 {
    if (m_last_target_job.has_value() && *m_last_target_job == target_job) {
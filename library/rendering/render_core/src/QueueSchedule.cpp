@@ -0,0 +1,97 @@
+#include "QueueSchedule.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+namespace triglav::render_core {
+
+namespace gapi = graphics_api;
+
+namespace {
+
+[[nodiscard]] bool is_consumer(const JobQueueUsage& job, const Name resource)
+{
+   return std::ranges::find(job.external_resources, resource) != job.external_resources.end();
+}
+
+[[nodiscard]] u32 family_index(const std::span<const gapi::QueueFamilyInfo> families, const gapi::WorkTypeFlags work_types)
+{
+   const auto position = gapi::select_queue_family(families, work_types);
+   assert(position.has_value());
+   return families[*position].index;
+}
+
+}// namespace
+
+QueueSchedule schedule_job_queues(const std::span<const JobQueueUsage> jobs, const std::span<const gapi::QueueFamilyInfo> families)
+{
+   QueueSchedule schedule;
+
+   for (const auto& job : jobs) {
+      const auto work_types = job.work_types == gapi::WorkType::None || job.has_untracked_resources
+                                 ? job.work_types | gapi::WorkType::Graphics
+                                 : job.work_types;
+      schedule.queue_work_types[job.job_name] = work_types;
+      schedule.queue_families[job.job_name] = family_index(families, work_types);
+   }
+
+   // Moving a job to the graphics family can create new conflicts, repeat until nothing changes.
+   bool has_changed = true;
+   while (has_changed) {
+      has_changed = false;
+
+      for (const auto& producer : jobs) {
+         for (const auto& resource : producer.exported_resources) {
+            const auto producer_family = schedule.queue_families.at(producer.job_name);
+
+            u32 consumer_count = 0;
+            u32 foreign_consumer_count = 0;
+            for (const auto& consumer : jobs) {
+               if (&consumer == &producer || !is_consumer(consumer, resource.name))
+                  continue;
+
+               ++consumer_count;
+               if (schedule.queue_families.at(consumer.job_name) != producer_family) {
+                  ++foreign_consumer_count;
+               }
+            }
+
+            if (foreign_consumer_count == 0 || consumer_count == 1)
+               continue;
+
+            for (const auto& job : jobs) {
+               if (&job != &producer && !is_consumer(job, resource.name))
+                  continue;
+
+               auto& work_types = schedule.queue_work_types.at(job.job_name);
+               if (work_types & gapi::WorkType::Graphics)
+                  continue;
+
+               work_types |= gapi::WorkType::Graphics;
+               schedule.queue_families.at(job.job_name) = family_index(families, work_types);
+               has_changed = true;
+            }
+         }
+      }
+   }
+
+   for (const auto& producer : jobs) {
+      for (const auto& resource : producer.exported_resources) {
+         const auto consumer_it = std::ranges::find_if(
+            jobs, [&](const JobQueueUsage& job) { return &job != &producer && is_consumer(job, resource.name); });
+         if (consumer_it == jobs.end())
+            continue;
+
+         const auto src_family = schedule.queue_families.at(producer.job_name);
+         const auto dst_family = schedule.queue_families.at(consumer_it->job_name);
+         if (src_family == dst_family)
+            continue;
+
+         schedule.transfers.emplace_back(resource, producer.job_name, consumer_it->job_name, src_family, dst_family);
+      }
+   }
+
+   return schedule;
+}
+
+}// namespace triglav::render_core
@@ -18,6 +18,16 @@ ResourceStorage::ResourceID to_resource_id(const Name name, const u32 mip_level,
    return name + 82646923u * frame_id + 24318937u * mip_level;
 }
 
+u64 hash_descriptor_key(const DescriptorStorage::Key& key)
+{
+   u64 result{};
+   for (const auto value : key) {
+      result *= 61463267ull;
+      result += value;
+   }
+   return result;
+}
+
 }// namespace
 
 graphics_api::DescriptorArray& DescriptorStorage::store_descriptor_array(graphics_api::DescriptorArray&& desc_array)
@@ -25,9 +35,46 @@ graphics_api::DescriptorArray& DescriptorStorage::store_descriptor_array(graphic
    return m_descriptor_arrays.emplace_back(std::move(desc_array));
 }
 
+std::optional<graphics_api::DescriptorView> DescriptorStorage::find_descriptor_set(const Key& key) const
+{
+   const auto it = m_descriptor_sets.find(hash_descriptor_key(key));
+   if (it == m_descriptor_sets.end()) {
+      return std::nullopt;
+   }
+
+   for (const auto& stored_set : it->second) {
+      if (stored_set.key == key) {
+         return stored_set.desc_view;
+      }
+   }
+   return std::nullopt;
+}
+
+void DescriptorStorage::store_descriptor_set(Key key, const graphics_api::DescriptorView desc_view)
+{
+   const auto hash = hash_descriptor_key(key);
+   m_descriptor_sets[hash].emplace_back(std::move(key), desc_view);
+}
+
+void DescriptorStorage::count_bind()
+{
+   ++m_bind_count;
+}
+
+u32 DescriptorStorage::descriptor_set_count() const
+{
+   return static_cast<u32>(m_descriptor_arrays.size());
+}
+
+u32 DescriptorStorage::bind_count() const
+{
+   return m_bind_count;
+}
+
 ResourceStorage::ResourceStorage(graphics_api::Device& device) :
     m_timestamps(GAPI_CHECK(device.create_query_pool(graphics_api::QueryType::Timestamp, g_max_timestamp_count))),
-    m_pipeline_stats(GAPI_CHECK(device.create_query_pool(graphics_api::QueryType::PipelineStats, g_max_timestamp_count)))
+    m_pipeline_stats(GAPI_CHECK(device.create_query_pool(graphics_api::QueryType::PipelineStats, g_max_timestamp_count))),
+    m_gpu_profiler(device)
 {
 }
 
@@ -45,6 +92,29 @@ graphics_api::Texture& ResourceStorage::texture(const Name name, const u32 frame
    return m_textures.at(to_resource_id(name, frame_index));
 }
 
+void ResourceStorage::import_textures(const Name name, const std::span<const graphics_api::Texture> textures)
+{
+   auto& imported = m_imported_textures[name];
+   imported.clear();
+   imported.reserve(textures.size());
+   for (const auto& texture : textures) {
+      imported.emplace_back(&texture);
+   }
+}
+
+const graphics_api::Texture& ResourceStorage::imported_texture(const Name name, const u32 import_index) const
+{
+   return *m_imported_textures.at(name).at(import_index);
+}
+
+u32 ResourceStorage::imported_texture_count(const Name name) const
+{
+   const auto it = m_imported_textures.find(name);
+   if (it == m_imported_textures.end())
+      return 0;
+   return static_cast<u32>(it->second.size());
+}
+
 void ResourceStorage::register_texture_mip_view(const Name name, const u32 mip_index, const u32 frame_index,
                                                 graphics_api::TextureView&& texture_view)
 {
@@ -84,4 +154,9 @@ graphics_api::QueryPool& ResourceStorage::pipeline_stats()
    return m_pipeline_stats;
 }
 
-}// namespace triglav::render_core
\ No newline at end of file
+GpuProfiler& ResourceStorage::gpu_profiler()
+{
+   return m_gpu_profiler;
+}
+
+}// namespace triglav::render_core
@@ -0,0 +1,89 @@
+#include "triglav/render_core/GlyphCache.hpp"
+#include "triglav/testing_core/GTest.hpp"
+#include "triglav/testing_render_util/RenderSupport.hpp"
+
+#include <array>
+#include <chrono>
+#include <thread>
+
+using triglav::u32;
+using triglav::font::g_sdf_spread;
+using triglav::font::GlyphRenderMode;
+using triglav::render_core::g_default_sdf_min_font_size;
+using triglav::render_core::g_sdf_glyph_size;
+using triglav::render_core::GlyphAtlas;
+using triglav::render_core::GlyphCache;
+using triglav::render_core::GlyphEncodeResult;
+using triglav::testing_render_util::RenderSupport;
+
+using namespace triglav::name_literals;
+using namespace triglav::string_literals;
+using namespace std::chrono_literals;
+
+namespace {
+
+constexpr auto g_typeface = "engine/fonts/inter/regular.typeface"_rc;
+
+// Encodes the text until all of its glyphs get rasterized by the atlas thread.
+GlyphEncodeResult encode_resident_text(GlyphCache& glyph_cache, const GlyphAtlas& atlas, const triglav::StringView text, u32* out_indices)
+{
+   GlyphEncodeResult result{};
+   for (int attempt = 0; attempt < 100; ++attempt) {
+      result = atlas.encode_text(text, out_indices);
+      glyph_cache.dynamic_atlas().flush_uploads();
+      if (result.is_resident)
+         break;
+      std::this_thread::sleep_for(10ms);
+   }
+   return result;
+}
+
+}// namespace
+
+TEST(GlyphCacheTest, LargeTextUsesSignedDistanceFields)
+{
+   GlyphCache glyph_cache(RenderSupport::device(), RenderSupport::resource_manager());
+
+   const auto& small_atlas = glyph_cache.find_glyph_atlas({g_typeface, 14});
+   const auto& large_atlas = glyph_cache.find_glyph_atlas({g_typeface, g_default_sdf_min_font_size});
+   const auto& huge_atlas = glyph_cache.find_glyph_atlas({g_typeface, 2 * g_default_sdf_min_font_size});
+
+   ASSERT_EQ(small_atlas.render_mode(), GlyphRenderMode::Bitmap);
+   ASSERT_EQ(large_atlas.render_mode(), GlyphRenderMode::SignedDistanceField);
+   ASSERT_EQ(huge_atlas.render_mode(), GlyphRenderMode::SignedDistanceField);
+   ASSERT_FLOAT_EQ(huge_atlas.glyph_scale(), static_cast<float>(2 * g_default_sdf_min_font_size) / g_sdf_glyph_size);
+
+   // Both sizes are laid out from the same glyphs.
+   const auto large_metric = large_atlas.measure_text("Triglav Engine"_strv);
+   const auto huge_metric = huge_atlas.measure_text("Triglav Engine"_strv);
+   ASSERT_GT(large_metric.width, 0.0f);
+   ASSERT_FLOAT_EQ(huge_metric.width, 2.0f * large_metric.width);
+   ASSERT_FLOAT_EQ(huge_metric.height, 2.0f * large_metric.height);
+}
+
+TEST(GlyphCacheTest, SignedDistanceFieldGlyphsAreShared)
+{
+   GlyphCache glyph_cache(RenderSupport::device(), RenderSupport::resource_manager(), 1);
+
+   const auto& large_atlas = glyph_cache.find_glyph_atlas({g_typeface, 40});
+   const auto& huge_atlas = glyph_cache.find_glyph_atlas({g_typeface, 80});
+
+   std::array<u32, 8> large_indices{};
+   const auto large_result = encode_resident_text(glyph_cache, large_atlas, "Glyph"_strv, large_indices.data());
+   ASSERT_TRUE(large_result.is_resident);
+   ASSERT_EQ(large_result.glyph_count, 5);
+
+   std::array<u32, 8> huge_indices{};
+   const auto huge_result = encode_resident_text(glyph_cache, huge_atlas, "Glyph"_strv, huge_indices.data());
+   ASSERT_TRUE(huge_result.is_resident);
+   ASSERT_EQ(huge_indices, large_indices);
+
+   for (u32 i = 0; i < large_result.glyph_count; ++i) {
+      const auto info = glyph_cache.dynamic_atlas().glyph_info(large_indices[i]);
+      // Distance field bitmaps extend by the spread on each side of the outline.
+      ASSERT_GT(info.size.x, 2.0f * g_sdf_spread);
+      ASSERT_GT(info.size.y, 2.0f * g_sdf_spread);
+      ASSERT_GT(info.tex_coord_bottom_right.x, info.tex_coord_top_left.x);
+      ASSERT_GT(info.tex_coord_bottom_right.y, info.tex_coord_top_left.y);
+   }
+}
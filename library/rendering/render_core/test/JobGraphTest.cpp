@@ -125,3 +125,103 @@ TEST(JobGraphTest, BasicInterframeDependency)
 
    ASSERT_EQ(read_buffer<int>(storage.buffer("basic_interframe_dependency.user"_name, 1)), 67);
 }
+
+TEST(JobGraphTest, BatchedSubmission)
+{
+   PipelineCache pipeline_cache(RenderSupport::device(), RenderSupport::resource_manager());
+   ResourceStorage storage(RenderSupport::device());
+   JobGraph graph(RenderSupport::device(), RenderSupport::resource_manager(), pipeline_cache, storage, Vector2i{800, 600});
+   graph.set_submission_mode(triglav::render_core::SubmissionMode::Batched);
+
+   auto& first_ctx = graph.add_job("batched_submission.first"_name);
+   auto& second_ctx = graph.add_job("batched_submission.second"_name);
+   auto& third_ctx = graph.add_job("batched_submission.third"_name);
+   graph.add_dependency("batched_submission.second"_name, "batched_submission.first"_name);
+   graph.add_dependency("batched_submission.third"_name, "batched_submission.second"_name);
+
+   // Each job increments the number and stores the result, so any reordering changes the stored values.
+   first_ctx.init_buffer("batched_submission.data"_name, 5);
+   first_ctx.bind_compute_shader("testing/shader/increase_number.cshader"_rc);
+   first_ctx.bind_storage_buffer(0, "batched_submission.data"_name);
+   first_ctx.dispatch({1, 1, 1});
+   first_ctx.declare_staging_buffer("batched_submission.first_user"_name, sizeof(int));
+   first_ctx.copy_buffer("batched_submission.data"_name, "batched_submission.first_user"_name);
+   first_ctx.export_buffer("batched_submission.data"_name, PipelineStage::ComputeShader, BufferAccess::ShaderRead,
+                           BufferUsage::TransferSrc | BufferUsage::StorageBuffer);
+
+   second_ctx.bind_compute_shader("testing/shader/increase_number.cshader"_rc);
+   second_ctx.bind_storage_buffer(0, "batched_submission.data"_external);
+   second_ctx.dispatch({1, 1, 1});
+   second_ctx.declare_staging_buffer("batched_submission.second_user"_name, sizeof(int));
+   second_ctx.copy_buffer("batched_submission.data"_external, "batched_submission.second_user"_name);
+
+   third_ctx.bind_compute_shader("testing/shader/increase_number.cshader"_rc);
+   third_ctx.bind_storage_buffer(0, "batched_submission.data"_external);
+   third_ctx.dispatch({1, 1, 1});
+   third_ctx.declare_staging_buffer("batched_submission.third_user"_name, sizeof(int));
+   third_ctx.copy_buffer("batched_submission.data"_external, "batched_submission.third_user"_name);
+
+   graph.build_jobs("batched_submission.third"_name);
+
+   for ([[maybe_unused]] const int _ : triglav::Range(0, 4)) {
+      for (const int frame_index : triglav::Range(0, triglav::render_core::FRAMES_IN_FLIGHT_COUNT)) {
+         const auto submission_count = RenderSupport::device().submission_count();
+         graph.execute("batched_submission.third"_name, frame_index, nullptr);
+
+         // All jobs use the same queue, so the whole frame is a single submission.
+         ASSERT_EQ(RenderSupport::device().submission_count() - submission_count, 1);
+
+         graph.await_job("batched_submission.third"_name);
+         ASSERT_EQ(read_buffer<int>(storage.buffer("batched_submission.first_user"_name, frame_index)), 6);
+         ASSERT_EQ(read_buffer<int>(storage.buffer("batched_submission.second_user"_name, frame_index)), 7);
+         ASSERT_EQ(read_buffer<int>(storage.buffer("batched_submission.third_user"_name, frame_index)), 8);
+      }
+   }
+}
+
+TEST(JobGraphTest, RerecordKeepsResourcesAndFlags)
+{
+   PipelineCache pipeline_cache(RenderSupport::device(), RenderSupport::resource_manager());
+   ResourceStorage storage(RenderSupport::device());
+   JobGraph graph(RenderSupport::device(), RenderSupport::resource_manager(), pipeline_cache, storage, Vector2i{800, 600});
+
+   auto& build_context = graph.add_job("rerecord"_name);
+   build_context.declare_flag("should_increase"_name);
+   build_context.declare_staging_buffer("rerecord.user"_name, sizeof(int));
+   build_context.init_buffer("rerecord.data"_name, 5);
+
+   build_context.if_enabled("should_increase"_name);
+   build_context.bind_compute_shader("testing/shader/increase_number.cshader"_rc);
+   build_context.bind_storage_buffer(0, "rerecord.data"_name);
+   build_context.dispatch({1, 1, 1});
+   build_context.end_if();
+
+   build_context.copy_buffer("rerecord.data"_name, "rerecord.user"_name);
+
+   graph.build_jobs("rerecord"_name);
+   graph.enable_flag("rerecord"_name, "should_increase"_name);
+
+   auto fence = GAPI_CHECK(RenderSupport::device().create_fence());
+   fence.await();
+
+   graph.execute("rerecord"_name, 0, &fence);
+   fence.await();
+   ASSERT_EQ(read_buffer<int>(storage.buffer("rerecord.user"_name, 0)), 6);
+
+   const auto* user_buffer = &storage.buffer("rerecord.user"_name, 0);
+   graph.rerecord_job("rerecord"_name);
+   ASSERT_EQ(&storage.buffer("rerecord.user"_name, 0), user_buffer);
+
+   // The flag carries over to the recorded job.
+   write_buffer(storage.buffer("rerecord.user"_name, 0), 0);
+   graph.execute("rerecord"_name, 0, &fence);
+   fence.await();
+   ASSERT_EQ(read_buffer<int>(storage.buffer("rerecord.user"_name, 0)), 6);
+
+   graph.disable_flag("rerecord"_name, "should_increase"_name);
+   graph.rebuild_job("rerecord"_name);
+
+   graph.execute("rerecord"_name, 0, &fence);
+   fence.await();
+   ASSERT_EQ(read_buffer<int>(storage.buffer("rerecord.user"_name, 0)), 5);
+}
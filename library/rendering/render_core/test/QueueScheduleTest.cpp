@@ -0,0 +1,163 @@
+#include "triglav/render_core/BuildContext.hpp"
+#include "triglav/render_core/QueueSchedule.hpp"
+#include "triglav/testing_core/GTest.hpp"
+#include "triglav/testing_render_util/RenderSupport.hpp"
+
+#include <array>
+
+using triglav::u32;
+using triglav::Vector2i;
+using triglav::graphics_api::BufferAccess;
+using triglav::graphics_api::BufferUsage;
+using triglav::graphics_api::PipelineStage;
+using triglav::graphics_api::QueueFamilyInfo;
+using triglav::graphics_api::WorkType;
+using triglav::render_core::BuildContext;
+using triglav::render_core::JobQueueUsage;
+using triglav::render_core::QueueOwnershipTransfer;
+using triglav::render_core::ResourceExport;
+using triglav::render_core::schedule_job_queues;
+using triglav::testing_render_util::RenderSupport;
+
+using namespace triglav::name_literals;
+using namespace triglav::render_core::literals;
+
+namespace detail = triglav::render_core::detail;
+
+namespace {
+
+// Family layout of a typical discrete GPU.
+const std::array DesktopFamilies{
+   QueueFamilyInfo{0, 16, WorkType::Graphics | WorkType::Compute | WorkType::Transfer | WorkType::Presentation},
+   QueueFamilyInfo{1, 2, WorkType::Transfer},
+   QueueFamilyInfo{2, 8, WorkType::Compute | WorkType::Transfer},
+};
+
+}// namespace
+
+TEST(QueueScheduleTest, SingleFamilyFallback)
+{
+   const std::array families{
+      QueueFamilyInfo{0, 1, WorkType::Graphics | WorkType::Compute | WorkType::Transfer | WorkType::Presentation},
+   };
+   const std::array jobs{
+      JobQueueUsage{"upload"_name, WorkType::Transfer, {ResourceExport{"data"_name}}, {}},
+      JobQueueUsage{"cull"_name, WorkType::Compute | WorkType::Transfer, {}, {"data"_name}},
+   };
+
+   const auto schedule = schedule_job_queues(jobs, families);
+
+   ASSERT_EQ(schedule.queue_families.at("upload"_name), 0);
+   ASSERT_EQ(schedule.queue_families.at("cull"_name), 0);
+   ASSERT_TRUE(schedule.transfers.empty());
+}
+
+TEST(QueueScheduleTest, DedicatedFamilies)
+{
+   const std::array jobs{
+      JobQueueUsage{"upload"_name, WorkType::Transfer, {ResourceExport{"data"_name}}, {}},
+      JobQueueUsage{"cull"_name, WorkType::Compute | WorkType::Transfer, {ResourceExport{"draw_calls"_name}}, {"data"_name}},
+      JobQueueUsage{"render"_name, WorkType::Graphics, {}, {"draw_calls"_name}},
+   };
+
+   const auto schedule = schedule_job_queues(jobs, DesktopFamilies);
+
+   ASSERT_EQ(schedule.queue_families.at("upload"_name), 1);
+   ASSERT_EQ(schedule.queue_families.at("cull"_name), 2);
+   ASSERT_EQ(schedule.queue_families.at("render"_name), 0);
+
+   ASSERT_EQ(schedule.transfers.size(), 2);
+   ASSERT_EQ(schedule.transfers[0].resource.name, "data"_name);
+   ASSERT_EQ(schedule.transfers[0].dst_job, "cull"_name);
+   ASSERT_EQ(schedule.transfers[0].src_queue_family, 1);
+   ASSERT_EQ(schedule.transfers[0].dst_queue_family, 2);
+   ASSERT_EQ(schedule.transfers[1].resource.name, "draw_calls"_name);
+   ASSERT_EQ(schedule.transfers[1].dst_job, "render"_name);
+   ASSERT_EQ(schedule.transfers[1].src_queue_family, 2);
+   ASSERT_EQ(schedule.transfers[1].dst_queue_family, 0);
+}
+
+TEST(QueueScheduleTest, SharedResourceStaysOnGraphics)
+{
+   const std::array jobs{
+      JobQueueUsage{"upload"_name, WorkType::Transfer, {ResourceExport{"data"_name}}, {}},
+      JobQueueUsage{"cull"_name, WorkType::Compute, {}, {"data"_name}},
+      JobQueueUsage{"render"_name, WorkType::Graphics, {}, {"data"_name}},
+   };
+
+   const auto schedule = schedule_job_queues(jobs, DesktopFamilies);
+
+   ASSERT_EQ(schedule.queue_families.at("upload"_name), 0);
+   ASSERT_EQ(schedule.queue_families.at("cull"_name), 0);
+   ASSERT_EQ(schedule.queue_families.at("render"_name), 0);
+   ASSERT_TRUE(schedule.transfers.empty());
+}
+
+TEST(QueueScheduleTest, UntrackedResourcesStayOnGraphics)
+{
+   const std::array jobs{
+      JobQueueUsage{"animate"_name, WorkType::Compute, {}, {}, true},
+      JobQueueUsage{"cull"_name, WorkType::Compute, {}, {}},
+      JobQueueUsage{"render"_name, WorkType::Graphics, {}, {}, true},
+   };
+
+   const auto schedule = schedule_job_queues(jobs, DesktopFamilies);
+
+   ASSERT_EQ(schedule.queue_families.at("animate"_name), 0);
+   ASSERT_EQ(schedule.queue_families.at("cull"_name), 2);
+   ASSERT_EQ(schedule.queue_families.at("render"_name), 0);
+   ASSERT_TRUE(schedule.transfers.empty());
+}
+
+TEST(QueueScheduleTest, RawBufferIsUntracked)
+{
+   const auto buffer =
+      GAPI_CHECK(RenderSupport::device().create_buffer(BufferUsage::StorageBuffer | BufferUsage::TransferDst, sizeof(int)));
+
+   BuildContext tracked(RenderSupport::device(), RenderSupport::resource_manager(), Vector2i{800, 600});
+   tracked.declare_buffer("queue_schedule.tracked"_name, sizeof(int));
+   tracked.fill_buffer("queue_schedule.tracked"_name, 5);
+   ASSERT_FALSE(tracked.has_untracked_resources());
+
+   BuildContext untracked(RenderSupport::device(), RenderSupport::resource_manager(), Vector2i{800, 600});
+   untracked.declare_buffer("queue_schedule.tracked"_name, sizeof(int));
+   untracked.copy_buffer("queue_schedule.tracked"_name, &buffer);
+   ASSERT_TRUE(untracked.has_untracked_resources());
+}
+
+TEST(QueueScheduleTest, OwnershipTransferBarriers)
+{
+   const QueueOwnershipTransfer transfer{ResourceExport{"queue_schedule.data"_name}, "upload"_name, "render"_name, 1, 0};
+
+   BuildContext producer(RenderSupport::device(), RenderSupport::resource_manager(), Vector2i{800, 600});
+   producer.declare_buffer("queue_schedule.data"_name, sizeof(int));
+   producer.fill_buffer("queue_schedule.data"_name, 5);
+   producer.export_buffer("queue_schedule.data"_name, PipelineStage::Transfer, BufferAccess::TransferWrite, BufferUsage::TransferSrc);
+   producer.set_queue_ownership(WorkType::Transfer, {transfer}, {});
+
+   const auto producer_commands = producer.insert_barriers(0);
+   ASSERT_FALSE(producer_commands.empty());
+   const auto* release = std::get_if<detail::cmd::PlaceBufferBarrier>(&producer_commands.back());
+   ASSERT_NE(release, nullptr);
+   ASSERT_EQ(release->barrier->src_queue_family, 1);
+   ASSERT_EQ(release->barrier->dst_queue_family, 0);
+   ASSERT_EQ(release->barrier->src_stage_flags, PipelineStage::Transfer);
+   ASSERT_EQ(release->barrier->src_buffer_access, BufferAccess::TransferWrite);
+
+   BuildContext consumer(RenderSupport::device(), RenderSupport::resource_manager(), Vector2i{800, 600});
+   consumer.declare_staging_buffer("queue_schedule.user"_name, sizeof(int));
+   consumer.copy_buffer("queue_schedule.data"_external, "queue_schedule.user"_name);
+   consumer.set_queue_ownership(WorkType::Graphics | WorkType::Transfer, {}, {transfer});
+
+   ASSERT_EQ(consumer.external_resources().size(), 1);
+   ASSERT_EQ(consumer.external_resources()[0], "queue_schedule.data"_name);
+
+   const auto consumer_commands = consumer.insert_barriers(0);
+   ASSERT_FALSE(consumer_commands.empty());
+   const auto* acquire = std::get_if<detail::cmd::PlaceBufferBarrier>(&consumer_commands.front());
+   ASSERT_NE(acquire, nullptr);
+   ASSERT_EQ(acquire->barrier->src_queue_family, 1);
+   ASSERT_EQ(acquire->barrier->dst_queue_family, 0);
+   ASSERT_TRUE(acquire->barrier->dst_stage_flags & PipelineStage::Transfer);
+   ASSERT_TRUE(acquire->barrier->dst_stage_flags & PipelineStage::FragmentShader);
+}
@@ -0,0 +1,251 @@
+#include "triglav/desktop/ISurface.hpp"
+#include "triglav/font/FontManager.hpp"
+#include "triglav/graphics_api/Instance.hpp"
+#include "triglav/io/CommandLine.hpp"
+#include "triglav/io/File.hpp"
+#include "triglav/io/Logging.hpp"
+#include "triglav/ktx/Texture.hpp"
+#include "triglav/project/Name.hpp"
+#include "triglav/project/PathManager.hpp"
+#include "triglav/renderer/OffscreenSurface.hpp"
+#include "triglav/renderer/Renderer.hpp"
+#include "triglav/resource/ResourceManager.hpp"
+#include "triglav/threading/ThreadPool.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <print>
+#include <vector>
+
+using triglav::u32;
+using triglav::u8;
+using triglav::Vector2;
+using triglav::Vector2i;
+using triglav::Vector2u;
+using triglav::io::CommandLine;
+using triglav::project::PathManager;
+using triglav::renderer::OffscreenSurface;
+using triglav::renderer::Renderer;
+using triglav::resource::ResourceManager;
+using triglav::threading::ThreadPool;
+
+namespace desktop = triglav::desktop;
+namespace gapi = triglav::graphics_api;
+
+using namespace triglav::name_literals;
+
+TG_PROJECT_NAME(demo)
+
+TG_DEFINE_AWAITER(LoadAssetsAwaiter, ResourceManager, OnLoadedAssets)
+
+namespace {
+
+constexpr auto g_default_width = 1280;
+constexpr auto g_default_height = 720;
+constexpr auto g_default_frame_count = 300;
+constexpr auto g_default_warmup_frame_count = 30;
+constexpr auto g_default_pixel_tolerance = 8;
+constexpr auto g_default_max_diff_percent = 1;
+// Fixed step so that the final frame doesn't depend on how fast the frames were rendered.
+constexpr auto g_frame_delta = 1.0f / 60.0f;
+
+// Stands in for the window, the renderer only uses it for the cursor and the dimensions.
+class HeadlessSurface final : public desktop::ISurface
+{
+ public:
+   explicit HeadlessSurface(const Vector2i dimension) :
+       m_dimension(dimension)
+   {
+   }
+
+   void lock_cursor() override {}
+   void unlock_cursor() override {}
+   void hide_cursor() const override {}
+   void set_cursor_icon(desktop::CursorIcon /*icon*/) override {}
+   void set_keyboard_input_mode(desktop::KeyboardInputModeFlags /*mode*/) override {}
+
+   std::shared_ptr<ISurface> create_popup(Vector2u /*dimensions*/, Vector2 /*offset*/, desktop::WindowAttributeFlags /*flags*/) override
+   {
+      return nullptr;
+   }
+
+   [[nodiscard]] desktop::ModifierFlags modifiers() const override
+   {
+      return {};
+   }
+
+   [[nodiscard]] bool is_cursor_locked() const override
+   {
+      return false;
+   }
+
+   [[nodiscard]] Vector2i dimension() const override
+   {
+      return m_dimension;
+   }
+
+ private:
+   Vector2i m_dimension;
+};
+
+void load_asset_list(ResourceManager& resource_manager, const triglav::ResourceName name)
+{
+   LoadAssetsAwaiter awaiter(resource_manager);
+   resource_manager.load_asset_list(PathManager::the().translate_path(name));
+   awaiter.await();
+}
+
+// Nearest-rank percentile, the samples must be sorted.
+float percentile(const std::vector<float>& samples, const float rank)
+{
+   const auto index = static_cast<size_t>(std::ceil(rank / 100.0f * static_cast<float>(samples.size())));
+   return samples[std::clamp<size_t>(index, 1, samples.size()) - 1];
+}
+
+void report_frame_times(const std::string_view name, std::vector<float> samples)
+{
+   std::ranges::sort(samples);
+   std::println("{:<10} p50 {:>8.3f} ms, p95 {:>8.3f} ms, p99 {:>8.3f} ms, max {:>8.3f} ms", name, percentile(samples, 50.0f),
+                percentile(samples, 95.0f), percentile(samples, 99.0f), samples.back());
+}
+
+// The output target is BGRA, the KTX images are stored as RGBA.
+void swap_red_and_blue(std::vector<u8>& pixels)
+{
+   for (size_t i = 0; i + 3 < pixels.size(); i += 4) {
+      std::swap(pixels[i], pixels[i + 2]);
+   }
+}
+
+bool write_image(const triglav::io::Path& path, const std::vector<u8>& pixels, const Vector2u dimensions)
+{
+   const auto texture = triglav::ktx::Texture::create({triglav::ktx::Format::R8G8B8A8_SRGB, dimensions, false, false});
+   if (not texture.has_value())
+      return false;
+   if (not texture->set_image_from_buffer(pixels, 0, 0, 0))
+      return false;
+   return texture->write_to_file(path);
+}
+
+// Returns true if the image matches the golden image within the tolerance.
+bool compare_with_golden(const triglav::io::Path& path, const std::vector<u8>& pixels, const Vector2u dimensions)
+{
+   const auto file = triglav::io::open_file(path, triglav::io::FileMode::Read);
+   if (not file.has_value()) {
+      std::println(stderr, "failed to open golden image {}", path.string());
+      return false;
+   }
+
+   const auto golden = triglav::ktx::Texture::from_stream(**file);
+   if (not golden.has_value() || golden->dimensions() != dimensions) {
+      std::println(stderr, "golden image {} doesn't match the output dimensions {}x{}", path.string(), dimensions.x, dimensions.y);
+      return false;
+   }
+
+   const auto golden_pixels = golden->image_data(0);
+   if (golden_pixels.size() != pixels.size()) {
+      std::println(stderr, "golden image {} has an unexpected format", path.string());
+      return false;
+   }
+
+   const auto pixel_tolerance = CommandLine::the().arg_int("pixelTolerance"_name).value_or(g_default_pixel_tolerance);
+   const auto max_diff_percent = CommandLine::the().arg_int("maxDiffPercent"_name).value_or(g_default_max_diff_percent);
+
+   double total_diff = 0.0;
+   size_t differing_pixels = 0;
+   for (size_t i = 0; i < pixels.size(); i += 4) {
+      int pixel_diff = 0;
+      for (size_t channel = 0; channel < 4; ++channel) {
+         const auto diff = std::abs(static_cast<int>(pixels[i + channel]) - static_cast<int>(golden_pixels[i + channel]));
+         total_diff += diff;
+         pixel_diff = std::max(pixel_diff, diff);
+      }
+      if (pixel_diff > pixel_tolerance) {
+         ++differing_pixels;
+      }
+   }
+
+   const auto pixel_count = static_cast<double>(pixels.size() / 4);
+   const auto differing_percent = 100.0 * static_cast<double>(differing_pixels) / pixel_count;
+   std::println("golden     mean diff {:.3f}, {:.3f}% pixels differ by more than {}", total_diff / static_cast<double>(pixels.size()),
+                differing_percent, pixel_tolerance);
+
+   return differing_percent <= max_diff_percent;
+}
+
+}// namespace
+
+int main(const int argc, const char** argv)
+{
+   CommandLine::the().parse(argc, argv);
+
+   triglav::LogManager::the().register_listener<triglav::io::StreamLogger>(triglav::io::stdout_writer());
+   triglav::threading::set_thread_id(triglav::threading::g_main_thread);
+   ThreadPool::the().initialize(static_cast<u32>(CommandLine::the().arg_int("threads"_name).value_or(4)));
+
+   const auto width = static_cast<u32>(CommandLine::the().arg_int("width"_name).value_or(g_default_width));
+   const auto height = static_cast<u32>(CommandLine::the().arg_int("height"_name).value_or(g_default_height));
+   const auto frame_count = CommandLine::the().arg_int("frames"_name).value_or(g_default_frame_count);
+   const auto warmup_frame_count = CommandLine::the().arg_int("warmupFrames"_name).value_or(g_default_warmup_frame_count);
+
+   // No display, the device is picked without checking for presentation support.
+   const auto instance = GAPI_CHECK(gapi::Instance::create_instance(nullptr));
+   auto device = GAPI_CHECK(instance.create_device(nullptr, gapi::DevicePickStrategy::PreferDedicated, {}));
+
+   triglav::font::FontManger font_manager;
+   ResourceManager resource_manager(*device, font_manager);
+   load_asset_list(resource_manager, "engine/index.yaml"_rc);
+   load_asset_list(resource_manager, "index.yaml"_rc);
+
+   HeadlessSurface desktop_surface({static_cast<int>(width), static_cast<int>(height)});
+
+   int status = EXIT_SUCCESS;
+   {
+      Renderer renderer(desktop_surface, *device, resource_manager, {width, height});
+
+      std::vector<float> cpu_frame_times;
+      std::vector<float> gpu_frame_times;
+      cpu_frame_times.reserve(frame_count);
+      gpu_frame_times.reserve(frame_count);
+
+      for (int frame = 0; frame < warmup_frame_count + frame_count; ++frame) {
+         const auto start = std::chrono::steady_clock::now();
+         renderer.on_render(g_frame_delta);
+         const auto cpu_time = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+         if (frame >= warmup_frame_count) {
+            cpu_frame_times.push_back(cpu_time);
+            gpu_frame_times.push_back(renderer.last_gpu_frame_time());
+         }
+      }
+      renderer.on_close();
+
+      std::println("Rendered {} frames at {}x{} after {} warmup frames", frame_count, width, height, warmup_frame_count);
+      if (frame_count > 0) {
+         report_frame_times("cpu", std::move(cpu_frame_times));
+         report_frame_times("gpu", std::move(gpu_frame_times));
+      }
+
+      auto pixels = dynamic_cast<const OffscreenSurface&>(renderer.render_surface()).read_output();
+      swap_red_and_blue(pixels);
+
+      if (const auto output = CommandLine::the().arg("output"_name); output.has_value()) {
+         if (not write_image(triglav::io::Path{*output}, pixels, {width, height})) {
+            std::println(stderr, "failed to write output image {}", *output);
+            status = EXIT_FAILURE;
+         }
+      }
+
+      if (const auto golden = CommandLine::the().arg("golden"_name); golden.has_value()) {
+         if (not compare_with_golden(triglav::io::Path{*golden}, pixels, {width, height})) {
+            status = EXIT_FAILURE;
+         }
+      }
+   }
+
+   ThreadPool::the().quit();
+
+   return status;
+}
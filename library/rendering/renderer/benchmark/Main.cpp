@@ -0,0 +1,198 @@
+#include "triglav/io/CommandLine.hpp"
+#include "triglav/renderer/DirtyRegionTracker.hpp"
+#include "triglav/renderer/TerrainBrush.hpp"
+#include "triglav/threading/ThreadPool.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <format>
+#include <print>
+#include <random>
+#include <vector>
+
+using triglav::MemorySize;
+using triglav::u8;
+using triglav::Vector2i;
+using triglav::io::CommandLine;
+using triglav::renderer::DirtyRegion;
+using triglav::renderer::DirtyRegionTracker;
+using triglav::renderer::TerrainBrush;
+using triglav::threading::ThreadPool;
+
+using namespace triglav::name_literals;
+
+namespace {
+
+constexpr Vector2i g_terrain_size{1024, 1024};
+constexpr auto g_default_frame_count = 600;
+constexpr auto g_default_strokes_per_frame = 8;
+constexpr auto g_brush_radius = 40.0f;
+constexpr auto g_default_brush_stroke_count = 200;
+constexpr std::array g_brush_kernel_radii{16.0f, 64.0f, 256.0f};
+
+struct Terrain
+{
+   std::vector<float> height;
+   std::vector<u8> blending;
+};
+
+// Stands in for the mapped staging buffer, the terrain is copied into it before each upload.
+struct Staging
+{
+   std::vector<float> height;
+   std::vector<u8> blending;
+};
+
+template<typename T>
+MemorySize copy_regions(std::vector<T>& dst, const std::vector<T>& src, const std::span<const DirtyRegion> regions)
+{
+   MemorySize bytes = 0;
+   for (const auto& region : regions) {
+      const auto row_size = static_cast<MemorySize>(region.extent().x) * sizeof(T);
+      for (int y = region.min.y; y < region.max.y; ++y) {
+         const auto offset = static_cast<MemorySize>(y) * g_terrain_size.x + region.min.x;
+         std::memcpy(dst.data() + offset, src.data() + offset, row_size);
+         bytes += row_size;
+      }
+   }
+   return bytes;
+}
+
+struct Result
+{
+   std::chrono::nanoseconds duration{};
+   MemorySize uploaded_bytes{};
+};
+
+Result run(const int frame_count, const int strokes_per_frame, const bool upload_dirty_regions)
+{
+   const auto texel_count = static_cast<MemorySize>(g_terrain_size.x) * g_terrain_size.y;
+   Terrain terrain{std::vector<float>(texel_count), std::vector<u8>(texel_count)};
+   Staging staging{std::vector<float>(texel_count), std::vector<u8>(texel_count)};
+   DirtyRegionTracker height_regions(g_terrain_size);
+   DirtyRegionTracker blending_regions(g_terrain_size);
+   const std::array full_region{DirtyRegion{{0, 0}, g_terrain_size}};
+
+   std::mt19937 rng(1234);
+   std::uniform_int_distribution<int> step_dist(-6, 6);
+   Vector2i position{g_terrain_size.x / 2, g_terrain_size.y / 2};
+
+   Result result;
+   const auto start = std::chrono::steady_clock::now();
+   for (int frame = 0; frame < frame_count; ++frame) {
+      for (int stroke = 0; stroke < strokes_per_frame; ++stroke) {
+         position = glm::clamp(position + Vector2i{step_dist(rng), step_dist(rng)}, Vector2i{0, 0}, g_terrain_size - Vector2i{1, 1});
+
+         const TerrainBrush brush{position, g_brush_radius};
+         height_regions.mark(triglav::renderer::shift_terrain(terrain.height, g_terrain_size, brush, 0.001f));
+         if (stroke % 2 == 0) {
+            blending_regions.mark(triglav::renderer::paint_terrain(terrain.blending, g_terrain_size, brush, 0.01f));
+         }
+      }
+
+      if (upload_dirty_regions) {
+         result.uploaded_bytes += copy_regions(staging.height, terrain.height, height_regions.regions());
+         result.uploaded_bytes += copy_regions(staging.blending, terrain.blending, blending_regions.regions());
+      } else {
+         result.uploaded_bytes += copy_regions(staging.height, terrain.height, full_region);
+         result.uploaded_bytes += copy_regions(staging.blending, terrain.blending, full_region);
+      }
+      height_regions.clear();
+      blending_regions.clear();
+   }
+   result.duration = std::chrono::steady_clock::now() - start;
+
+   return result;
+}
+
+struct BrushKernel
+{
+   std::string_view name;
+   void (*apply)(Terrain& terrain, const TerrainBrush& brush);
+};
+
+void apply_shift(Terrain& terrain, const TerrainBrush& brush)
+{
+   triglav::renderer::shift_terrain(terrain.height, g_terrain_size, brush, 0.001f);
+}
+
+void apply_level(Terrain& terrain, const TerrainBrush& brush)
+{
+   triglav::renderer::level_terrain(terrain.height, g_terrain_size, brush, 0.2f, 0.5f);
+}
+
+void apply_smooth(Terrain& terrain, const TerrainBrush& brush)
+{
+   triglav::renderer::smooth_terrain(terrain.height, g_terrain_size, brush, 0.5f);
+}
+
+void apply_paint(Terrain& terrain, const TerrainBrush& brush)
+{
+   triglav::renderer::paint_terrain(terrain.blending, g_terrain_size, brush, 0.01f);
+}
+
+constexpr std::array g_brush_kernels{
+   BrushKernel{"shift", apply_shift},
+   BrushKernel{"level", apply_level},
+   BrushKernel{"smooth", apply_smooth},
+   BrushKernel{"paint", apply_paint},
+};
+
+// Average time of a single stroke of the brush kernel.
+std::chrono::nanoseconds run_brush(const BrushKernel& kernel, const float radius, const int stroke_count)
+{
+   const auto texel_count = static_cast<MemorySize>(g_terrain_size.x) * g_terrain_size.y;
+   Terrain terrain{std::vector<float>(texel_count), std::vector<u8>(texel_count)};
+
+   const auto start = std::chrono::steady_clock::now();
+   for (int stroke = 0; stroke < stroke_count; ++stroke) {
+      const Vector2i offset{stroke % 64, (stroke / 64) % 64};
+      kernel.apply(terrain, TerrainBrush{g_terrain_size / 2 + offset - Vector2i{32, 32}, radius});
+   }
+   return (std::chrono::steady_clock::now() - start) / stroke_count;
+}
+
+void report_brushes(const std::string_view mode, const int stroke_count)
+{
+   for (const auto radius : g_brush_kernel_radii) {
+      for (const auto& kernel : g_brush_kernels) {
+         const auto duration = std::chrono::duration<double, std::micro>(run_brush(kernel, radius, stroke_count)).count();
+         std::println("{:<10} {:<8} radius {:>5.0f} {:>10.1f} us/stroke", mode, kernel.name, radius, duration);
+      }
+   }
+}
+
+void report(const std::string_view name, const Result& result, const int frame_count, const int strokes_per_frame)
+{
+   const auto seconds = std::chrono::duration<double>(result.duration).count();
+   const auto stroke_count = static_cast<double>(frame_count) * strokes_per_frame;
+   std::println("{:<14} {:>10.1f} strokes/s, {:>8.3f} ms/frame, {:>10.1f} KiB uploaded/frame", name, stroke_count / seconds,
+                1000.0 * seconds / frame_count, static_cast<double>(result.uploaded_bytes) / 1024.0 / frame_count);
+}
+
+}// namespace
+
+int main(const int argc, const char** argv)
+{
+   CommandLine::the().parse(argc, argv);
+
+   const auto frame_count = CommandLine::the().arg_int("frames"_name).value_or(g_default_frame_count);
+   const auto strokes_per_frame = CommandLine::the().arg_int("strokesPerFrame"_name).value_or(g_default_strokes_per_frame);
+
+   std::println("Terrain {}x{}, brush radius {}, {} strokes per frame", g_terrain_size.x, g_terrain_size.y, g_brush_radius,
+                strokes_per_frame);
+
+   report("full upload", run(frame_count, strokes_per_frame, false), frame_count, strokes_per_frame);
+   report("dirty regions", run(frame_count, strokes_per_frame, true), frame_count, strokes_per_frame);
+
+   const auto brush_stroke_count = CommandLine::the().arg_int("brushStrokes"_name).value_or(g_default_brush_stroke_count);
+   const auto thread_count = CommandLine::the().arg_int("threads"_name).value_or(4);
+
+   report_brushes("serial", brush_stroke_count);
+   ThreadPool::the().initialize(static_cast<triglav::u32>(thread_count));
+   report_brushes(std::format("{} threads", thread_count), brush_stroke_count);
+   ThreadPool::the().quit();
+
+   return 0;
+}
@@ -101,6 +101,22 @@ struct Config
    }
 };
 
+// How much of the rendering jobs a change of a property invalidates, ordered by the cost of applying it.
+enum class ConfigChange
+{
+   // Doesn't affect any of the jobs.
+   None,
+   // Switches job flags, the variants for both states are already recorded.
+   FlagOnly,
+   // The affected job is recorded again, its resources are kept.
+   PipelineOnly,
+   // The affected job is rebuilt along with its resources.
+   ResourceChanging,
+};
+
+// Classifies a change of the property given the config after the change.
+[[nodiscard]] ConfigChange classify_config_change(ConfigProperty property, const Config& config);
+
 class ConfigManager
 {
  public:
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "triglav/Int.hpp"
+#include "triglav/Math.hpp"
+#include "triglav/geometry/Geometry.hpp"
+
+#include <span>
+#include <vector>
+
+namespace triglav::renderer {
+
+// CPU implementation of the math in shader/bindless_geometry/culling.slang, used to validate the shader.
+
+struct DepthRange
+{
+   float near_plane;
+   float far_plane;
+};
+
+// X and Y are in normalized device coordinates, Z is the linear depth.
+struct ScreenBounds
+{
+   Vector3 min;
+   Vector3 max;
+};
+
+[[nodiscard]] float to_linear_depth(float depth, DepthRange range);
+[[nodiscard]] ScreenBounds project_bounding_box(const geometry::BoundingBox& box, const Matrix4x4& model_view_projection,
+                                                DepthRange range);
+[[nodiscard]] bool is_in_frustum(const ScreenBounds& bounds, DepthRange range);
+
+// Max depth pyramid, mirrors the one built by hi_zbuffer_construct.
+class HierarchicalDepth
+{
+ public:
+   HierarchicalDepth(Vector2u size, std::vector<float> depth);
+
+   [[nodiscard]] u32 mip_count() const;
+   [[nodiscard]] Vector2u mip_size(u32 mip) const;
+   [[nodiscard]] float load(Vector2u coord, u32 mip) const;
+   [[nodiscard]] bool is_occluded(const ScreenBounds& bounds, DepthRange range) const;
+
+ private:
+   struct Mip
+   {
+      Vector2u size;
+      std::vector<float> depth;
+   };
+
+   std::vector<Mip> m_mips;
+};
+
+struct CullingObject
+{
+   geometry::BoundingBox bounding_box;
+   Matrix4x4 transform;
+};
+
+struct CullingResult
+{
+   std::vector<u32> visible;
+   std::vector<u32> rejected;
+   u32 culled_count{};
+};
+
+// The first phase tests all objects against depth of objects visible in the last frame,
+// occluded objects are kept as rejected and tested again in the second phase.
+[[nodiscard]] CullingResult cull_objects(std::span<const CullingObject> objects, const Matrix4x4& view_projection, DepthRange range,
+                                         const HierarchicalDepth& depth);
+void retest_rejected_objects(CullingResult& result, std::span<const CullingObject> objects, const Matrix4x4& view_projection,
+                             DepthRange range, const HierarchicalDepth& depth);
+
+}// namespace triglav::renderer
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "triglav/Math.hpp"
+
+#include <span>
+#include <vector>
+
+namespace triglav::renderer {
+
+// Rectangle of texels, max is exclusive.
+struct DirtyRegion
+{
+   Vector2i min;
+   Vector2i max;
+
+   [[nodiscard]] Vector2i extent() const;
+   [[nodiscard]] MemorySize area() const;
+   [[nodiscard]] bool empty() const;
+};
+
+// Coalesces modified rectangles of a 2D buffer so they can be uploaded with a few copies.
+class DirtyRegionTracker
+{
+ public:
+   explicit DirtyRegionTracker(Vector2i size, u32 max_region_count = 8);
+
+   void mark(DirtyRegion region);
+   void mark_all();
+   void clear();
+
+   [[nodiscard]] bool empty() const;
+   [[nodiscard]] std::span<const DirtyRegion> regions() const;
+   [[nodiscard]] MemorySize area() const;
+   [[nodiscard]] Vector2i size() const;
+
+ private:
+   Vector2i m_size;
+   u32 m_max_region_count;
+   std::vector<DirtyRegion> m_regions;
+};
+
+}// namespace triglav::renderer
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "triglav/Math.hpp"
+#include "triglav/Name.hpp"
+
+namespace triglav::graphics_api {
+class Fence;
+}
+
+namespace triglav::render_core {
+class BuildContext;
+class JobGraph;
+}// namespace triglav::render_core
+
+namespace triglav::renderer {
+
+// Target the renderer's output job draws core.color_out to.
+class IRenderSurface
+{
+ public:
+   virtual ~IRenderSurface() = default;
+
+   // The output job renders the frame to core.color_out, declared with declare_output_target.
+   virtual void add_present_jobs(render_core::JobGraph& job_graph, Name output_job) = 0;
+   virtual void declare_output_target(render_core::BuildContext& ctx) const = 0;
+   virtual void export_output_target(render_core::BuildContext& ctx) const = 0;
+
+   virtual void await_for_frame(u32 frame_index) const = 0;
+   // Must be called before the job graph is executed.
+   virtual void acquire_image(render_core::JobGraph& job_graph, u32 frame_index) = 0;
+   // Fence to signal with the job graph execution, null when the surface signals it itself.
+   [[nodiscard]] virtual const graphics_api::Fence* job_fence(u32 frame_index) const = 0;
+   virtual void present(render_core::JobGraph& job_graph, u32 frame_index) = 0;
+   virtual void resize(Vector2u new_resolution) = 0;
+   virtual void recreate_present_jobs() = 0;
+
+   [[nodiscard]] virtual Vector2u resolution() const = 0;
+};
+
+}// namespace triglav::renderer
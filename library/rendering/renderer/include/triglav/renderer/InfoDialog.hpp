@@ -19,6 +19,10 @@ namespace triglav::desktop {
 class ISurface;
 }
 
+namespace triglav::renderer::stage {
+struct ShadowMapCounters;
+}
+
 namespace triglav::renderer {
 
 class InfoDialog final : public ui_core::IWidget
@@ -39,7 +43,10 @@ class InfoDialog final : public ui_core::IWidget
    void set_max_fps(float value) const;
    void set_avg_fps(float value) const;
    void set_gpu_time(float value) const;
+   void set_cpu_times(float update_scene, float prepare_frame, float submit) const;
    void set_triangle_count(u32 value) const;
+   void set_object_counts(u32 visible_count, u32 culled_count) const;
+   void set_shadow_caster_counts(const stage::ShadowMapCounters& counters) const;
    void set_camera_pos(Vector3 value) const;
    void set_orientation(Vector2 value) const;
 
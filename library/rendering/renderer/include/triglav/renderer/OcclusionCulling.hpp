@@ -16,6 +16,16 @@ namespace triglav::renderer {
 
 class BindlessScene;
 
+// Layout of the counters written by the culling shaders.
+struct CullingCounters
+{
+   // Objects rejected by the first phase and tested again in the second.
+   u32 rejected_count;
+   u32 visible_count;
+   u32 culled_count;
+   u32 padding;
+};
+
 class OcclusionCulling
 {
  public:
@@ -29,10 +39,21 @@ class OcclusionCulling
    void on_finalize(render_core::BuildContext& ctx) const;
    static void reset_buffers(graphics_api::Device& device, render_core::JobGraph& graph);
 
+   // Number of draw calls the culling buffers can hold, grows with the scene.
+   [[nodiscard]] u32 object_capacity() const;
+   // True if the scene has outgrown the culling buffers and the update view job needs to be rebuilt.
+   [[nodiscard]] bool needs_rebuild() const;
+   [[nodiscard]] static CullingCounters read_counters(render_core::JobGraph& graph, u32 frame_index);
+
  private:
-   void draw_pre_pass_objects(render_core::BuildContext& ctx, const render_objects::MaterialGeometryRenderInfo& info) const;
+   void draw_pre_pass(render_core::BuildContext& ctx, Name pass_name, bool use_last_frame_objects) const;
+   void draw_pre_pass_objects(render_core::BuildContext& ctx, const render_objects::MaterialGeometryRenderInfo& info,
+                              bool use_last_frame_objects) const;
+   void build_hierarchical_depth(render_core::BuildContext& ctx) const;
+   void bind_culling_resources(render_core::BuildContext& ctx) const;
 
    BindlessScene& m_bindless_scene;
+   mutable u32 m_object_capacity{};
 
    TG_SINK(UpdateViewParamsJob, OnResourceDefinition);
    TG_SINK(UpdateViewParamsJob, OnViewPropertiesChanged);
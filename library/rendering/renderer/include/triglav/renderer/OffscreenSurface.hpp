@@ -0,0 +1,44 @@
+#pragma once
+
+#include "IRenderSurface.hpp"
+
+#include "triglav/graphics_api/Synchronization.hpp"
+#include "triglav/render_core/RenderCore.hpp"
+#include "triglav/render_core/ResourceStorage.hpp"
+
+#include <array>
+#include <vector>
+
+namespace triglav::renderer {
+
+// Keeps the rendered frames in core.color_out instead of presenting them, lets the renderer run without a window.
+class OffscreenSurface final : public IRenderSurface
+{
+ public:
+   OffscreenSurface(graphics_api::Device& device, render_core::ResourceStorage& resource_storage, Vector2u resolution);
+
+   void add_present_jobs(render_core::JobGraph& job_graph, Name output_job) override;
+   void declare_output_target(render_core::BuildContext& ctx) const override;
+   void export_output_target(render_core::BuildContext& ctx) const override;
+
+   void await_for_frame(u32 frame_index) const override;
+   void acquire_image(render_core::JobGraph& job_graph, u32 frame_index) override;
+   [[nodiscard]] const graphics_api::Fence* job_fence(u32 frame_index) const override;
+   void present(render_core::JobGraph& job_graph, u32 frame_index) override;
+   void resize(Vector2u new_resolution) override;
+   void recreate_present_jobs() override;
+
+   [[nodiscard]] Vector2u resolution() const override;
+
+   // Copies the last presented frame to the host as tightly packed BGRA pixels, the device must be idle.
+   [[nodiscard]] std::vector<u8> read_output() const;
+
+ private:
+   graphics_api::Device& m_device;
+   render_core::ResourceStorage& m_resource_storage;
+   Vector2u m_resolution{};
+   std::array<graphics_api::Fence, render_core::FRAMES_IN_FLIGHT_COUNT> m_frame_fences;
+   u32 m_last_frame_index{};
+};
+
+}// namespace triglav::renderer
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "Config.hpp"
+#include "stage/PostProcessStage.hpp"
+
+#include "triglav/Name.hpp"
+
+namespace triglav::render_core {
+class BuildContext;
+class JobGraph;
+}// namespace triglav::render_core
+
+namespace triglav::renderer {
+
+class IRenderSurface;
+class UpdateUserInterfaceJob;
+
+// Final pass of the frame, it's the only job that waits for the swapchain image.
+class PostProcessJob
+{
+ public:
+   static constexpr auto JobName = make_name_id("job.post_process");
+
+   PostProcessJob(Config config, UpdateUserInterfaceJob* update_user_interface_job, const IRenderSurface& render_surface);
+
+   void build_job(render_core::BuildContext& ctx) const;
+   void set_config(Config config);
+   void apply_config_flags(render_core::JobGraph& graph) const;
+
+ private:
+   stage::PostProcessStage m_stage;
+   Config m_config;
+};
+
+}// namespace triglav::renderer
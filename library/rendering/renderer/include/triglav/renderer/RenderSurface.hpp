@@ -1,5 +1,7 @@
 #pragma once
 
+#include "IRenderSurface.hpp"
+
 #include "triglav/Math.hpp"
 #include "triglav/graphics_api/Swapchain.hpp"
 #include "triglav/graphics_api/Synchronization.hpp"
@@ -10,26 +12,30 @@ namespace triglav::graphics_api {
 class Surface;
 }
 
-namespace triglav::render_core {
-class JobGraph;
-}
-
 namespace triglav::renderer {
 
-class RenderSurface
+class RenderSurface final : public IRenderSurface
 {
  public:
    RenderSurface(graphics_api::Device& device, desktop::ISurface& desktop_surface, graphics_api::Surface& surface,
                  render_core::ResourceStorage& resource_storage, Vector2u resolution, graphics_api::PresentMode present_mode);
 
-   static void add_present_jobs(render_core::JobGraph& job_graph, Name external_job);
-
-   void await_for_frame(u32 frame_index) const;
-   void present(render_core::JobGraph& job_graph, u32 frame_index);
+   void add_present_jobs(render_core::JobGraph& job_graph, Name output_job) override;
+   // Declares core.color_out as the swapchain image when the swapchain can be rendered to directly,
+   // otherwise as a regular render target that gets copied to the swapchain before present.
+   void declare_output_target(render_core::BuildContext& ctx) const override;
+   void export_output_target(render_core::BuildContext& ctx) const override;
+
+   void await_for_frame(u32 frame_index) const override;
+   void acquire_image(render_core::JobGraph& job_graph, u32 frame_index) override;
+   [[nodiscard]] const graphics_api::Fence* job_fence(u32 frame_index) const override;
+   void present(render_core::JobGraph& job_graph, u32 frame_index) override;
+   void resize(Vector2u new_resolution) override;
    void recreate_swapchain(Vector2u new_resolution);
-   void recreate_present_jobs();
+   void recreate_present_jobs() override;
 
-   [[nodiscard]] Vector2u resolution() const;
+   [[nodiscard]] Vector2u resolution() const override;
+   [[nodiscard]] bool is_rendering_to_swapchain() const;
 
  private:
    graphics_api::Device& m_device;
@@ -41,6 +47,9 @@ class RenderSurface
    graphics_api::Swapchain m_swapchain;
    std::vector<graphics_api::CommandList> m_pre_present_commands;
    std::array<graphics_api::Fence, render_core::FRAMES_IN_FLIGHT_COUNT> m_frame_fences;
+   Name m_output_job{};
+   u32 m_framebuffer_index{};
+   bool m_is_rendering_to_swapchain{false};
    bool m_must_recreate_swapchain{false};
 };
 
@@ -5,14 +5,16 @@
 #include "BindlessScene.hpp"
 #include "Config.hpp"
 #include "DebugWidget.hpp"
+#include "IRenderSurface.hpp"
 #include "InfoDialog.hpp"
 #include "OcclusionCulling.hpp"
+#include "PostProcessJob.hpp"
 #include "RayTracingScene.hpp"
-#include "RenderSurface.hpp"
 #include "RenderingJob.hpp"
 #include "Scene.hpp"
 #include "UpdateUserInterfaceJob.hpp"
 #include "UpdateViewParamsJob.hpp"
+#include "stage/ShadowMapStage.hpp"
 
 #include "triglav/Logging.hpp"
 #include "triglav/desktop/Desktop.hpp"
@@ -27,6 +29,8 @@
 #include "triglav/ui_core/Context.hpp"
 #include "triglav/ui_core/Viewport.hpp"
 
+#include <functional>
+#include <memory>
 #include <optional>
 
 namespace triglav::render_core {
@@ -53,6 +57,9 @@ class Renderer final : public render_core::IRenderer
 
    Renderer(desktop::ISurface& desktop_surface, graphics_api::Surface& surface, graphics_api::Device& device,
             resource::ResourceManager& resource_manager, const graphics_api::Resolution& resolution);
+   // Renders to an offscreen surface instead of the window's swapchain.
+   Renderer(desktop::ISurface& desktop_surface, graphics_api::Device& device, resource::ResourceManager& resource_manager,
+            const graphics_api::Resolution& resolution);
 
    void update_debug_info(bool is_first_frame);
    void on_render(float delta_time);
@@ -67,6 +74,9 @@ class Renderer final : public render_core::IRenderer
    [[nodiscard]] resource::ResourceManager& resource_manager() const;
    [[nodiscard]] std::tuple<uint32_t, uint32_t> screen_resolution() const;
    [[nodiscard]] graphics_api::Device& device() const;
+   [[nodiscard]] const IRenderSurface& render_surface() const;
+   // GPU time of the rendering job in the last frame that has completed, in milliseconds.
+   [[nodiscard]] float last_gpu_frame_time() const;
    void on_config_property_changed(ConfigProperty property, const Config& config);
    void recreate_render_jobs() override;
 
@@ -74,13 +84,22 @@ class Renderer final : public render_core::IRenderer
    AnimationManager& animation_manager();
 
  private:
+   using RenderSurfaceFactory = std::function<std::unique_ptr<IRenderSurface>(render_core::ResourceStorage& resource_storage)>;
+
+   Renderer(desktop::ISurface& desktop_surface, graphics_api::Device& device, resource::ResourceManager& resource_manager,
+            const graphics_api::Resolution& resolution, const RenderSurfaceFactory& create_render_surface);
+
    void update_uniform_data(float delta_time);
+   void update_scene(bool is_first_frame);
    static float calculate_frame_duration();
    glm::vec3 moving_direction();
    void recreate_jobs(Vector2u dimensions);
+   void apply_config_change(ConfigChange change);
+   void write_profile_capture();
 
  private:
    bool m_must_recreate_jobs{false};
+   ConfigChange m_pending_config_change{ConfigChange::None};
    bool m_show_debug_lines{false};
    glm::vec3 m_motion{};
    glm::vec2 m_mouse_offset{};
@@ -100,7 +119,7 @@ class Renderer final : public render_core::IRenderer
    std::optional<RayTracingScene> m_ray_tracing_scene;
 
    render_core::ResourceStorage m_resource_storage;
-   RenderSurface m_render_surface;
+   std::unique_ptr<IRenderSurface> m_render_surface;
    render_core::PipelineCache m_pipeline_cache;
    render_core::JobGraph m_job_graph;
    AnimationManager m_animation_manager;
@@ -109,7 +128,12 @@ class Renderer final : public render_core::IRenderer
    UpdateUserInterfaceJob m_update_user_interface_job;
    OcclusionCulling m_occlusion_culling;
    RenderingJob m_rendering_job;
+   PostProcessJob m_post_process_job;
+   CullingCounters m_culling_counters{};
+   stage::ShadowMapStage* m_shadow_map_stage{};
+   stage::ShadowMapCounters m_shadow_map_counters{};
    u32 m_frame_index{0};
+   float m_last_gpu_frame_time{};
    AnimationID m_current_animation_id{0};
 
    DebugWidget m_debug_widget;
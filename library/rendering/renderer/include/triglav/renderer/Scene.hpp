@@ -2,6 +2,7 @@
 
 #include "Camera.hpp"
 #include "OrthoCamera.hpp"
+#include "TiledTerrain.hpp"
 
 #include "triglav/Name.hpp"
 #include "triglav/String.hpp"
@@ -64,7 +65,8 @@ class Scene
    TG_EVENT(OnAddedBoundingBox, const geometry::BoundingBox&)
    TG_EVENT(OnShadowMapChanged, u32, const OrthoCamera&)
    TG_EVENT(OnViewUpdated, const Camera&)
-   TG_EVENT(OnTerrainUpdated, Vector2i, const std::vector<float>&, const std::vector<u8>&)
+   TG_EVENT(OnTerrainUpdated, const TiledTerrain&)
+   TG_EVENT(OnTerrainTilesChanged, const TiledTerrain&)
 
    explicit Scene(resource::ResourceManager& resource_manager);
 
@@ -93,9 +95,11 @@ class Scene
    void add_bounding_box(const geometry::BoundingBox& box) const;
    [[nodiscard]] const geometry::BVHTree<SceneObjectRef>& bvh() const;
    RayHit trace_ray(const geometry::Ray& ray) const;
-   std::vector<float>& terrain();
-   std::vector<u8>& terrain_blending();
-   void publish_terrain_changes();
+   [[nodiscard]] TiledTerrain& terrain();
+   [[nodiscard]] const TiledTerrain& terrain() const;
+   void set_terrain_directory(const io::Path& directory);
+   // Streams terrain tiles around the camera and publishes the changes since the last call.
+   void update_terrain();
 
    [[nodiscard]] std::map<ObjectID, SceneObjectUPtr>::const_iterator begin() const
    {
@@ -115,9 +119,10 @@ class Scene
    glm::quat m_directional_light_orientation{glm::vec3{-0.3f, 0.0f, 1.62f}};
    std::array<OrthoCamera, 3> m_directional_shadow_map_cameras{};
    std::map<ObjectID, SceneObjectUPtr> m_objects{};
+   // Keeps meshes of the scene objects loaded.
+   std::map<ObjectID, resource::ResourceRef<ResourceType::Mesh>> m_mesh_refs{};
    geometry::BVHTree<SceneObjectRef> m_tree;
-   std::vector<float> m_terrain;
-   std::vector<u8> m_terrain_blending;
+   TiledTerrain m_terrain;
    ObjectID m_top_object_id = 0;
 };
 
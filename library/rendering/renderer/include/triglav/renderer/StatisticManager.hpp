@@ -30,6 +30,10 @@ enum class Stat : u32
    GBufferGpuTime,
    ShadingGpuTime,
    RayTracingGpuTime,
+   UpdateSceneCpuTime,
+   AwaitFrameCpuTime,
+   PrepareFrameCpuTime,
+   SubmitCpuTime,
    Count
 };
 
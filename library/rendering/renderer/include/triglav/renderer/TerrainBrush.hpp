@@ -0,0 +1,29 @@
+#pragma once
+
+#include "DirtyRegionTracker.hpp"
+
+#include "triglav/Math.hpp"
+
+#include <span>
+
+namespace triglav::renderer {
+
+struct TerrainBrush
+{
+   Vector2i center;
+   float radius;
+};
+
+// The kernels modify texels of a row-major terrain layer within the brush radius
+// and return the region they touched, clamped to the layer size.
+
+[[nodiscard]] DirtyRegion brush_region(Vector2i size, const TerrainBrush& brush);
+
+DirtyRegion shift_terrain(std::span<float> height, Vector2i size, const TerrainBrush& brush, float amount);
+DirtyRegion level_terrain(std::span<float> height, Vector2i size, const TerrainBrush& brush, float level, float strength);
+DirtyRegion smooth_terrain(std::span<float> height, Vector2i size, const TerrainBrush& brush, float strength);
+DirtyRegion paint_terrain(std::span<u8> blending, Vector2i size, const TerrainBrush& brush, float strength);
+
+[[nodiscard]] float sample_terrain_average(std::span<const float> height, Vector2i size, const TerrainBrush& brush);
+
+}// namespace triglav::renderer
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "triglav/Math.hpp"
+#include "triglav/io/Path.hpp"
+
+#include <span>
+
+namespace triglav::renderer {
+
+// Keeps the height and blending data of terrain tiles, a single file per tile.
+class TerrainTileStore
+{
+ public:
+   explicit TerrainTileStore(io::Path directory);
+
+   // Returns false if the tile wasn't saved before or its file is invalid.
+   bool load(Vector2i coord, std::span<float> height, std::span<u8> blending) const;
+   bool save(Vector2i coord, std::span<const float> height, std::span<const u8> blending) const;
+
+ private:
+   [[nodiscard]] io::Path tile_path(Vector2i coord) const;
+
+   io::Path m_directory;
+};
+
+}// namespace triglav::renderer
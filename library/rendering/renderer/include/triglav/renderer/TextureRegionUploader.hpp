@@ -0,0 +1,42 @@
+#pragma once
+
+#include "DirtyRegionTracker.hpp"
+
+#include "triglav/graphics_api/Buffer.hpp"
+#include "triglav/graphics_api/CommandList.hpp"
+#include "triglav/graphics_api/Synchronization.hpp"
+
+#include <span>
+
+namespace triglav::graphics_api {
+class Device;
+class Texture;
+}// namespace triglav::graphics_api
+
+namespace triglav::renderer {
+
+// Uploads modified regions of a single mip texture without waiting for the queue.
+// The staging buffer mirrors the whole texture so the regions can be copied in place.
+class TextureRegionUploader
+{
+ public:
+   TextureRegionUploader(graphics_api::Device& device, const graphics_api::Texture& texture);
+   ~TextureRegionUploader();
+
+   TextureRegionUploader(const TextureRegionUploader& other) = delete;
+   TextureRegionUploader& operator=(const TextureRegionUploader& other) = delete;
+
+   // Pixels hold the whole texture, only texels within the regions are read.
+   void upload(std::span<const u8> pixels, std::span<const DirtyRegion> regions);
+
+ private:
+   graphics_api::Device& m_device;
+   const graphics_api::Texture& m_texture;
+   graphics_api::Buffer m_staging_buffer;
+   graphics_api::CommandList m_command_list;
+   graphics_api::Fence m_fence;
+   // The first upload must write the whole texture, its content is undefined before.
+   bool m_is_initialized{false};
+};
+
+}// namespace triglav::renderer
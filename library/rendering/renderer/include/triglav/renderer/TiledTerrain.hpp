@@ -0,0 +1,123 @@
+#pragma once
+
+#include "DirtyRegionTracker.hpp"
+#include "TerrainTileStore.hpp"
+
+#include "triglav/Math.hpp"
+#include "triglav/geometry/Geometry.hpp"
+
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace triglav::renderer {
+
+class CameraBase;
+
+struct TerrainProperties
+{
+   // Height map texels along a side of a tile.
+   i32 tile_resolution{256};
+   float tile_world_size{60.0f};
+   float height_scale{30.0f};
+   // Tiles along a side of the resident window, which follows the camera.
+   i32 window_tile_count{4};
+   // Patches along a side of a tile at LOD 0, halved with each next LOD.
+   i32 patch_count{4};
+   u32 lod_count{3};
+   // Distance from the camera in tiles after which the LOD increases.
+   float lod_distance{1.5f};
+   u32 max_tile_loads_per_update{2};
+};
+
+struct TerrainTile
+{
+   Vector2i coord;
+   u32 lod{};
+   float min_height{};
+   float max_height{};
+   // Tiles are flat until streamed in.
+   bool is_loaded{};
+   bool is_modified{};
+   bool is_visible{true};
+   bool has_stale_bounds{};
+   // Tile-space regions edited before the tile was loaded, they are kept over the loaded content.
+   std::vector<DirtyRegion> pending_height_edits;
+   std::vector<DirtyRegion> pending_blending_edits;
+};
+
+struct TerrainPatchVertex
+{
+   Vector3 position;
+   Vector2 uv;
+   // Point that decides the tessellation of the edge starting at this vertex (xy)
+   // and the edge length in LOD 0 patches (z). Edges of neighbouring patches share
+   // the point, so their tessellation matches even if the LOD of the tiles differs.
+   Vector3 edge;
+};
+
+// Terrain split into tiles, only a window of tiles around the camera is resident.
+// Height and blending of the window are stored in a single row-major layer,
+// texel coordinates are global unless stated otherwise.
+class TiledTerrain
+{
+ public:
+   explicit TiledTerrain(const TerrainProperties& properties = {});
+
+   void set_store(std::optional<TerrainTileStore> store);
+
+   // Moves the window with the camera, streams pending tiles and selects the tile LOD.
+   void update(const CameraBase& camera);
+   void save_modified_tiles();
+
+   // Regions are in window space.
+   void mark_height_dirty(DirtyRegion region);
+   void mark_blending_dirty(DirtyRegion region);
+   void clear_changes();
+
+   [[nodiscard]] std::span<float> height();
+   [[nodiscard]] std::span<const float> height() const;
+   [[nodiscard]] std::span<u8> blending();
+   [[nodiscard]] std::span<const u8> blending() const;
+   [[nodiscard]] Vector2i window_size() const;
+   [[nodiscard]] Vector2i window_origin() const;
+   [[nodiscard]] std::span<const TerrainTile> tiles() const;
+   [[nodiscard]] const TerrainProperties& properties() const;
+
+   [[nodiscard]] bool has_tile_changes() const;
+   [[nodiscard]] std::span<const DirtyRegion> height_changes() const;
+   [[nodiscard]] std::span<const DirtyRegion> blending_changes() const;
+
+   [[nodiscard]] geometry::BoundingBox tile_bounds(const TerrainTile& tile) const;
+   [[nodiscard]] Vector2i world_to_texel(Vector3 position) const;
+   [[nodiscard]] float texel_world_size() const;
+   [[nodiscard]] std::optional<float> sample_height(Vector2i texel) const;
+   [[nodiscard]] std::optional<Vector3> trace_ray(const geometry::Ray& ray) const;
+
+   [[nodiscard]] std::vector<TerrainPatchVertex> build_patches() const;
+   [[nodiscard]] MemorySize max_patch_vertex_count() const;
+
+ private:
+   [[nodiscard]] i32 slot_index(Vector2i coord) const;
+   [[nodiscard]] const TerrainTile* tile_at(Vector2i coord) const;
+   [[nodiscard]] DirtyRegion tile_region(Vector2i coord) const;
+   void move_window(Vector2i tile_origin);
+   void stream_tiles(Vector2i camera_tile);
+   void load_tile(TerrainTile& tile);
+   void save_tile(const TerrainTile& tile) const;
+   void update_bounds(TerrainTile& tile) const;
+   void apply_pending_edits(const TerrainTile& tile, std::span<float> height, std::span<u8> blending) const;
+   void mark_tiles(DirtyRegion region, bool has_height_changed);
+
+   TerrainProperties m_properties;
+   std::optional<TerrainTileStore> m_store;
+   Vector2i m_window_tile_origin;
+   std::vector<TerrainTile> m_tiles;
+   std::vector<float> m_height;
+   std::vector<u8> m_blending;
+   DirtyRegionTracker m_height_changes;
+   DirtyRegionTracker m_blending_changes;
+   bool m_has_tile_changes{true};
+};
+
+}// namespace triglav::renderer
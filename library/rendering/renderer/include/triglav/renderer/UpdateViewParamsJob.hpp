@@ -50,6 +50,8 @@ class UpdateViewParamsJob
    void build_job(render_core::BuildContext& ctx) const;
    void prepare_frame(render_core::JobGraph& graph, u32 frame_index, float delta_time);
    void on_updated(const Camera& camera);
+   // Forces the view dependent resources to be recalculated in the next frame.
+   void invalidate_view_properties();
 
  private:
    bool m_updated_view_properties = true;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../Scene.hpp"
+#include "../TextureRegionUploader.hpp"
 #include "IStage.hpp"
 
 #include "triglav/event/Delegate.hpp"
@@ -13,6 +14,7 @@ class Device;
 
 namespace triglav::renderer {
 class BindlessScene;
+class OcclusionCulling;
 }
 
 namespace triglav::renderer::stage {
@@ -22,7 +24,7 @@ class GBufferStage final : public IStage
  public:
    using Self = GBufferStage;
 
-   GBufferStage(graphics_api::Device& device, BindlessScene& bindless_scene);
+   GBufferStage(graphics_api::Device& device, BindlessScene& bindless_scene, const OcclusionCulling& occlusion_culling);
 
    void build_stage(render_core::BuildContext& ctx, const Config& config) const override;
 
@@ -31,7 +33,8 @@ class GBufferStage final : public IStage
    void build_geometry(render_core::BuildContext& ctx) const;
    void build_terrain(render_core::BuildContext& ctx) const;
 
-   void on_terrain_updated(Vector2i size, const std::vector<float>& height, const std::vector<u8>& blending) const;
+   void on_terrain_updated(const TiledTerrain& terrain);
+   void on_terrain_tiles_changed(const TiledTerrain& terrain);
 
  private:
    void draw_objects_with_render_info(render_core::BuildContext& ctx, const render_objects::MaterialGeometryRenderInfo& info) const;
@@ -40,10 +43,16 @@ class GBufferStage final : public IStage
    geometry::DeviceMesh m_mesh;
    graphics_api::Texture m_terrain_texture;
    graphics_api::Texture m_terrain_blend_texture;
+   TextureRegionUploader m_terrain_uploader;
+   TextureRegionUploader m_terrain_blend_uploader;
    graphics_api::Buffer m_terrain_vertices;
+   graphics_api::Buffer m_terrain_draw_call;
+   graphics_api::Buffer m_terrain_draw_count;
    BindlessScene& m_bindless_scene;
+   const OcclusionCulling& m_occlusion_culling;
 
    TG_SINK(Scene, OnTerrainUpdated);
+   TG_SINK(Scene, OnTerrainTilesChanged);
 };
 
 }// namespace triglav::renderer::stage
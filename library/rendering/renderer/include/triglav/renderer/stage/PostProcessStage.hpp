@@ -6,23 +6,34 @@
 
 namespace triglav::render_core {
 class BuildContext;
-}
+class JobGraph;
+}// namespace triglav::render_core
 
 namespace triglav::renderer {
+class IRenderSurface;
 class UpdateUserInterfaceJob;
-}
+}// namespace triglav::renderer
 
 namespace triglav::renderer::stage {
 
 class PostProcessStage final : public IStage
 {
  public:
-   explicit PostProcessStage(UpdateUserInterfaceJob* update_user_interface_job, Name output_render_target);
+   // Post-processing as part of a larger job, the output is exported for a transfer.
+   PostProcessStage(UpdateUserInterfaceJob* update_user_interface_job, Name output_render_target);
+   // Post-processing in a dedicated job writing to the surface's output.
+   PostProcessStage(UpdateUserInterfaceJob* update_user_interface_job, const IRenderSurface& render_surface);
 
    void build_stage(render_core::BuildContext& ctx, const Config& config) const override;
 
+   // In a dedicated job the antialiasing, bloom and UI visibility are switched with job flags.
+   static void apply_config_flags(render_core::JobGraph& graph, Name job, const Config& config);
+
  private:
+   void draw_post_processing(render_core::BuildContext& ctx, bool enable_fxaa, bool bloom_enabled) const;
+
    UpdateUserInterfaceJob* m_update_user_interface_job;
+   const IRenderSurface* m_render_surface{};
    Name m_output_render_target;
 };
 
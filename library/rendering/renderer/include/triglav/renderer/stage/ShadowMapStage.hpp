@@ -3,42 +3,89 @@
 #include "../UpdateViewParamsJob.hpp"
 #include "IStage.hpp"
 
+#include "triglav/graphics_api/Texture.hpp"
 #include "triglav/render_core/RenderCore.hpp"
 
+#include <array>
+
+namespace triglav::render_core {
+class JobGraph;
+}
+
 namespace triglav::renderer {
 class Scene;
 class BindlessScene;
+class OcclusionCulling;
 }// namespace triglav::renderer
 
 namespace triglav::renderer::stage {
 
+constexpr u32 SHADOW_MAP_CASCADE_COUNT = 3;
+
+// Layout of the counters written by the shadow culling shader.
+struct ShadowMapCounters
+{
+   struct Cascade
+   {
+      u32 visible_count;
+      u32 culled_count;
+   };
+
+   std::array<Cascade, SHADOW_MAP_CASCADE_COUNT> cascades;
+};
+
+struct ShadowCascadeInfo;
+
 class ShadowMapStage final : public IStage
 {
  public:
    using Self = ShadowMapStage;
 
-   ShadowMapStage(Scene& scene, BindlessScene& bindless_scene, UpdateViewParamsJob& update_view_params_job);
+   ShadowMapStage(graphics_api::Device& device, Scene& scene, BindlessScene& bindless_scene, const OcclusionCulling& occlusion_culling,
+                  UpdateViewParamsJob& update_view_params_job);
 
    void build_stage(render_core::BuildContext& ctx, const Config& config) const override;
-   void render_cascade(render_core::BuildContext& ctx, Name pass_name, Name target_name, render_core::BufferRef view_props) const;
-   void render_geometry(render_core::BuildContext& ctx, render_core::BufferRef view_props,
+   void cull_cascade(render_core::BuildContext& ctx, u32 cascade_index) const;
+   void render_static_casters(render_core::BuildContext& ctx, u32 cascade_index) const;
+   void render_cascade(render_core::BuildContext& ctx, const ShadowCascadeInfo& cascade) const;
+   void render_geometry(render_core::BuildContext& ctx, const ShadowCascadeInfo& cascade,
                         const render_objects::MaterialVertexLayoutInfo& layout_info) const;
 
+   // Selects whether the static casters are redrawn this frame, must be called before the rendering job is executed.
+   void prepare_frame(render_core::JobGraph& graph);
+   // Forces the static casters to be redrawn into the cache on the next frame.
+   void invalidate_static_casters() const;
+   [[nodiscard]] static ShadowMapCounters read_counters(render_core::JobGraph& graph, u32 frame_index);
+   static void reset_counters(render_core::JobGraph& graph);
+
    void on_resource_definition(render_core::BuildContext& ctx) const;
    void on_view_properties_changed(render_core::BuildContext& ctx) const;
    void on_view_properties_not_changed(render_core::BuildContext& ctx) const;
    void on_finalize(render_core::BuildContext& ctx) const;
    void on_prepare_frame(render_core::JobGraph& graph, u32 frame_index) const;
 
+   void on_shadow_map_changed(u32 index, const OrthoCamera& camera) const;
+   void on_object_added_to_scene(ObjectID object_id, const SceneObject& object) const;
+   void on_object_changed_transform(ObjectID object_id, const Transform3D& transform) const;
+   void on_object_removed(ObjectID object_id) const;
+
  private:
    Scene& m_scene;
    BindlessScene& m_bindless_scene;
+   const OcclusionCulling& m_occlusion_culling;
+   // Depth of the static casters, shared by the frames in flight.
+   std::array<graphics_api::Texture, SHADOW_MAP_CASCADE_COUNT> m_static_caches;
+   mutable bool m_is_static_update_pending{};
 
    TG_SINK(UpdateViewParamsJob, OnResourceDefinition);
    TG_SINK(UpdateViewParamsJob, OnViewPropertiesChanged);
    TG_SINK(UpdateViewParamsJob, OnViewPropertiesNotChanged);
    TG_SINK(UpdateViewParamsJob, OnFinalize);
    TG_SINK(UpdateViewParamsJob, OnPrepareFrame);
+   TG_SINK(Scene, OnShadowMapChanged);
+   TG_SINK(Scene, OnObjectAddedToScene);
+   TG_SINK(Scene, OnObjectChangedTransform);
+   TG_SINK(Scene, OnObjectRemoved);
 };
 
 }// namespace triglav::renderer::stage
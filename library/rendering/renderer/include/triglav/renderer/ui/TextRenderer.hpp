@@ -16,8 +16,9 @@
 namespace triglav::render_core {
 class BuildContext;
 class JobGraph;
+class DynamicGlyphAtlas;
+class GlyphAtlas;
 class GlyphCache;
-struct GlyphProperties;
 }// namespace triglav::render_core
 
 namespace triglav::renderer::ui {
@@ -26,22 +27,22 @@ struct TextUpdateInfo;
 
 struct TextInfo
 {
+   ui_core::TextId text_id;
    ui_core::Text text;
-   u32 glyph_buffer_offset;
+   const render_core::GlyphAtlas* atlas;
 
    Vector4 color;
    Vector4 crop;
    Vector2 position;
-   u32 atlas_id;
 
    u32 dst_vertex_offset;
    u32 dst_vertex_count;
 };
 
-struct TypefaceInfo
+struct DisplayedText
 {
-   u32 atlas_id;
-   u32 glyph_buffer_offset;
+   TextInfo info;
+   u32 page_mask;
 };
 
 class TextRenderer
@@ -66,7 +67,8 @@ class TextRenderer
    void move_object(u32 src, u32 dst);
 
  private:
-   [[nodiscard]] const TypefaceInfo& get_typeface_info(const render_core::GlyphProperties& glyph_props);
+   void submit_text(TextInfo info, u32 page_mask);
+   void update_glyph_residency(render_core::DynamicGlyphAtlas& atlas);
    memory::Area allocate_vertex_section(ui_core::TextId text_id, u32 vertex_count);
    void free_vertex_section(ui_core::TextId text_id);
 
@@ -78,9 +80,11 @@ class TextRenderer
    graphics_api::Buffer m_draw_calls;
    graphics_api::Buffer m_vertex_buffer;
    std::vector<render_core::TextureRef> m_atlases;
-   graphics_api::Buffer m_combined_glyph_buffer;
-   u32 m_glyph_offset{};
-   std::map<u64, TypefaceInfo> m_typeface_infos;
+   // Texts waiting for their glyphs to be rasterized into the atlas.
+   std::map<ui_core::TextId, TextInfo> m_pending_texts;
+   std::map<ui_core::TextId, DisplayedText> m_displayed_texts;
+   std::vector<u32> m_encode_buffer;
+   u64 m_eviction_generation{};
    memory::HeapAllocator m_vertex_allocator;
    std::map<ui_core::TextId, memory::Area> m_allocated_vertex_sections;
 
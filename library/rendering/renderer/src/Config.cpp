@@ -40,6 +40,29 @@ AmbientOcclusionMethod next_ambient_occlusion_method(const AmbientOcclusionMetho
 
 }// namespace
 
+ConfigChange classify_config_change(const ConfigProperty property, const Config& config)
+{
+   switch (property) {
+   case ConfigProperty::Antialiasing:
+   case ConfigProperty::IsBloomEnabled:
+   case ConfigProperty::IsUIHidden:
+      return ConfigChange::FlagOnly;
+   case ConfigProperty::ShadowCasting:
+      // With ray-traced AO the ray tracing resources exist regardless of the shadow casting method.
+      if (config.ambient_occlusion == AmbientOcclusionMethod::RayTraced) {
+         return ConfigChange::PipelineOnly;
+      }
+      return ConfigChange::ResourceChanging;
+   case ConfigProperty::AmbientOcclusion:
+   case ConfigProperty::IsRenderingParticles:
+      return ConfigChange::ResourceChanging;
+   case ConfigProperty::IsSmoothCameraEnabled:
+      return ConfigChange::None;
+   }
+
+   return ConfigChange::ResourceChanging;
+}
+
 ConfigManager::ConfigManager(const graphics_api::Device& device) :
     m_device(device),
     m_config(get_default_config(device))
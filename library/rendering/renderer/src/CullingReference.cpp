@@ -0,0 +1,162 @@
+#include "CullingReference.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <limits>
+
+namespace triglav::renderer {
+
+namespace {
+
+Vector2u to_texture_space(const Vector2 screen_space, const Vector2u size)
+{
+   const Vector2 tex_res{size};
+   return Vector2u(glm::clamp(0.5f * (screen_space + Vector2{1, 1}) * tex_res, Vector2{0, 0}, tex_res - Vector2{1, 1}));
+}
+
+u32 size_to_mip_level(u32 size)
+{
+   u32 mip_level = 0;
+   while (size > 1) {
+      ++mip_level;
+      size /= 2;
+   }
+   return mip_level;
+}
+
+}// namespace
+
+float to_linear_depth(const float depth, const DepthRange range)
+{
+   return (2.0f * range.near_plane * range.far_plane) / (range.far_plane + range.near_plane - depth * (range.far_plane - range.near_plane));
+}
+
+ScreenBounds project_bounding_box(const geometry::BoundingBox& box, const Matrix4x4& model_view_projection, const DepthRange range)
+{
+   constexpr auto inf = std::numeric_limits<float>::infinity();
+   ScreenBounds bounds{Vector3{inf, inf, inf}, Vector3{-inf, -inf, -inf}};
+
+   for (u32 corner = 0; corner < 8; ++corner) {
+      const Vector4 point{corner & 4 ? box.max.x : box.min.x, corner & 2 ? box.max.y : box.min.y, corner & 1 ? box.max.z : box.min.z, 1.0f};
+      const auto projected = model_view_projection * point;
+      const auto linear_z = to_linear_depth(projected.z / projected.w, range);
+      const auto homogeneous = projected / std::abs(projected.w);
+
+      bounds.min = glm::min(bounds.min, Vector3{homogeneous.x, homogeneous.y, linear_z});
+      bounds.max = glm::max(bounds.max, Vector3{homogeneous.x, homogeneous.y, linear_z});
+   }
+
+   return bounds;
+}
+
+bool is_in_frustum(const ScreenBounds& bounds, const DepthRange range)
+{
+   return bounds.min.x <= 1.0f && bounds.max.x >= -1.0f && bounds.min.y <= 1.0f && bounds.max.y >= -1.0f &&
+          bounds.min.z <= range.far_plane && bounds.max.z >= range.near_plane;
+}
+
+HierarchicalDepth::HierarchicalDepth(const Vector2u size, std::vector<float> depth)
+{
+   assert(depth.size() == static_cast<MemorySize>(size.x) * size.y);
+   m_mips.emplace_back(size, std::move(depth));
+
+   while (m_mips.back().size.x > 1 || m_mips.back().size.y > 1) {
+      const auto& src = m_mips.back();
+      const Vector2u dst_size{std::max(src.size.x / 2, 1u), std::max(src.size.y / 2, 1u)};
+
+      std::vector<float> dst(static_cast<MemorySize>(dst_size.x) * dst_size.y);
+      for (u32 y = 0; y < dst_size.y; ++y) {
+         for (u32 x = 0; x < dst_size.x; ++x) {
+            // Samples outside of the source mip are treated as zero, like in the shader.
+            const Vector2u source{2 * x, 2 * y};
+            float max_sample = 0.0f;
+            for (u32 dy = 0; dy < 2; ++dy) {
+               for (u32 dx = 0; dx < 2; ++dx) {
+                  if (source.x + dx < src.size.x && source.y + dy < src.size.y) {
+                     max_sample = std::max(max_sample, src.depth[(source.y + dy) * src.size.x + source.x + dx]);
+                  }
+               }
+            }
+            dst[y * dst_size.x + x] = max_sample;
+         }
+      }
+
+      m_mips.emplace_back(dst_size, std::move(dst));
+   }
+}
+
+u32 HierarchicalDepth::mip_count() const
+{
+   return static_cast<u32>(m_mips.size());
+}
+
+Vector2u HierarchicalDepth::mip_size(const u32 mip) const
+{
+   return m_mips[mip].size;
+}
+
+float HierarchicalDepth::load(const Vector2u coord, const u32 mip) const
+{
+   const auto& level = m_mips[mip];
+   return level.depth[coord.y * level.size.x + coord.x];
+}
+
+bool HierarchicalDepth::is_occluded(const ScreenBounds& bounds, const DepthRange range) const
+{
+   const auto size = m_mips.front().size;
+   const auto min_tex_space = to_texture_space({bounds.min.x, bounds.min.y}, size);
+   const auto max_tex_space = to_texture_space({bounds.max.x, bounds.max.y}, size);
+
+   const auto diff = max_tex_space - min_tex_space;
+   const auto mip_level = std::min(size_to_mip_level(std::max(diff.x, diff.y)), this->mip_count() - 1);
+   const auto mip_size = this->mip_size(mip_level);
+
+   const Vector2u mip_scale{1u << mip_level, 1u << mip_level};
+   const auto min_mip = glm::min(min_tex_space / mip_scale, mip_size - Vector2u{1, 1});
+   const auto max_mip = glm::min(max_tex_space / mip_scale, mip_size - Vector2u{1, 1});
+
+   const std::array samples{
+      this->load(min_mip, mip_level),
+      this->load(Vector2u{min_mip.x, max_mip.y}, mip_level),
+      this->load(Vector2u{max_mip.x, min_mip.y}, mip_level),
+      this->load(max_mip, mip_level),
+   };
+
+   return std::ranges::none_of(samples, [&](const float sample) { return bounds.min.z < to_linear_depth(sample, range); });
+}
+
+CullingResult cull_objects(const std::span<const CullingObject> objects, const Matrix4x4& view_projection, const DepthRange range,
+                           const HierarchicalDepth& depth)
+{
+   CullingResult result;
+   for (u32 object_id = 0; object_id < objects.size(); ++object_id) {
+      const auto& object = objects[object_id];
+      const auto bounds = project_bounding_box(object.bounding_box, view_projection * object.transform, range);
+      if (not is_in_frustum(bounds, range)) {
+         ++result.culled_count;
+      } else if (depth.is_occluded(bounds, range)) {
+         result.rejected.emplace_back(object_id);
+      } else {
+         result.visible.emplace_back(object_id);
+      }
+   }
+   return result;
+}
+
+void retest_rejected_objects(CullingResult& result, const std::span<const CullingObject> objects, const Matrix4x4& view_projection,
+                             const DepthRange range, const HierarchicalDepth& depth)
+{
+   for (const u32 object_id : result.rejected) {
+      const auto& object = objects[object_id];
+      const auto bounds = project_bounding_box(object.bounding_box, view_projection * object.transform, range);
+      if (depth.is_occluded(bounds, range)) {
+         ++result.culled_count;
+      } else {
+         result.visible.emplace_back(object_id);
+      }
+   }
+   result.rejected.clear();
+}
+
+}// namespace triglav::renderer
@@ -0,0 +1,118 @@
+#include "DirtyRegionTracker.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+namespace triglav::renderer {
+
+namespace {
+
+DirtyRegion merge_regions(const DirtyRegion& lhs, const DirtyRegion& rhs)
+{
+   return {glm::min(lhs.min, rhs.min), glm::max(lhs.max, rhs.max)};
+}
+
+// Regions that overlap or share an edge or a corner get merged into their bounding box.
+// Only regions covering each other or sharing a whole edge merge exactly, otherwise the box also covers clean texels.
+bool touches(const DirtyRegion& lhs, const DirtyRegion& rhs)
+{
+   return lhs.min.x <= rhs.max.x && rhs.min.x <= lhs.max.x && lhs.min.y <= rhs.max.y && rhs.min.y <= lhs.max.y;
+}
+
+}// namespace
+
+Vector2i DirtyRegion::extent() const
+{
+   return max - min;
+}
+
+MemorySize DirtyRegion::area() const
+{
+   if (this->empty())
+      return 0;
+   const auto size = this->extent();
+   return static_cast<MemorySize>(size.x) * static_cast<MemorySize>(size.y);
+}
+
+bool DirtyRegion::empty() const
+{
+   return max.x <= min.x || max.y <= min.y;
+}
+
+DirtyRegionTracker::DirtyRegionTracker(const Vector2i size, const u32 max_region_count) :
+    m_size(size),
+    m_max_region_count(max_region_count)
+{
+   assert(max_region_count > 0);
+}
+
+void DirtyRegionTracker::mark(const DirtyRegion region)
+{
+   DirtyRegion clamped{glm::clamp(region.min, Vector2i{0, 0}, m_size), glm::clamp(region.max, Vector2i{0, 0}, m_size)};
+   if (clamped.empty())
+      return;
+
+   // Merging can make the region touch others, keep going until it's disjoint.
+   bool merged = true;
+   while (merged) {
+      merged = false;
+      for (auto it = m_regions.begin(); it != m_regions.end(); ++it) {
+         if (touches(*it, clamped)) {
+            clamped = merge_regions(*it, clamped);
+            m_regions.erase(it);
+            merged = true;
+            break;
+         }
+      }
+   }
+
+   if (m_regions.size() < m_max_region_count) {
+      m_regions.emplace_back(clamped);
+      return;
+   }
+
+   // Out of regions, merge with the one that grows the least.
+   const auto best = std::ranges::min_element(m_regions, [&](const DirtyRegion& lhs, const DirtyRegion& rhs) {
+      return merge_regions(lhs, clamped).area() - lhs.area() < merge_regions(rhs, clamped).area() - rhs.area();
+   });
+   const auto grown = merge_regions(*best, clamped);
+   m_regions.erase(best);
+   this->mark(grown);
+}
+
+void DirtyRegionTracker::mark_all()
+{
+   m_regions.clear();
+   m_regions.emplace_back(Vector2i{0, 0}, m_size);
+}
+
+void DirtyRegionTracker::clear()
+{
+   m_regions.clear();
+}
+
+bool DirtyRegionTracker::empty() const
+{
+   return m_regions.empty();
+}
+
+std::span<const DirtyRegion> DirtyRegionTracker::regions() const
+{
+   return m_regions;
+}
+
+MemorySize DirtyRegionTracker::area() const
+{
+   MemorySize result = 0;
+   for (const auto& region : m_regions) {
+      result += region.area();
+   }
+   return result;
+}
+
+Vector2i DirtyRegionTracker::size() const
+{
+   return m_size;
+}
+
+}// namespace triglav::renderer
@@ -1,5 +1,7 @@
 #include "InfoDialog.hpp"
 
+#include "stage/ShadowMapStage.hpp"
+
 #include "triglav/Format.hpp"
 #include "triglav/Name.hpp"
 #include "triglav/desktop/ISurface.hpp"
@@ -26,7 +28,11 @@ constexpr std::array g_metrics_labels{
    std::tuple{"metrics.fps_max"_name, "Framerate Max"_strv},
    std::tuple{"metrics.fps_avg"_name, "Framerate Avg"_strv},
    std::tuple{"metrics.triangles"_name, "Triangle Count"_strv},
+   std::tuple{"metrics.visible_objects"_name, "Visible Objects"_strv},
+   std::tuple{"metrics.culled_objects"_name, "Culled Objects"_strv},
+   std::tuple{"metrics.shadow_casters"_name, "Shadow Casters"_strv},
    std::tuple{"metrics.gpu_time"_name, "GPU Render Time"_strv},
+   std::tuple{"metrics.cpu_time"_name, "CPU Update / Prepare / Submit"_strv},
 };
 
 constexpr std::array g_location_labels{
@@ -344,12 +350,33 @@ void InfoDialog::set_gpu_time(const float value) const
    m_values.at("metrics.gpu_time"_name)->set_content(g_buffer_gpu_time_str.view());
 }
 
+void InfoDialog::set_cpu_times(const float update_scene, const float prepare_frame, const float submit) const
+{
+   const auto cpu_time_str = format("{:.2f} / {:.2f} / {:.2f}ms", update_scene, prepare_frame, submit);
+   m_values.at("metrics.cpu_time"_name)->set_content(cpu_time_str.view());
+}
+
 void InfoDialog::set_triangle_count(const u32 value) const
 {
    const auto primitive_count_str = format("{}", value);
    m_values.at("metrics.triangles"_name)->set_content(primitive_count_str.view());
 }
 
+void InfoDialog::set_object_counts(const u32 visible_count, const u32 culled_count) const
+{
+   const auto visible_count_str = format("{}", visible_count);
+   m_values.at("metrics.visible_objects"_name)->set_content(visible_count_str.view());
+   const auto culled_count_str = format("{}", culled_count);
+   m_values.at("metrics.culled_objects"_name)->set_content(culled_count_str.view());
+}
+
+void InfoDialog::set_shadow_caster_counts(const stage::ShadowMapCounters& counters) const
+{
+   const auto& cascades = counters.cascades;
+   const auto caster_count_str = format("{} / {} / {}", cascades[0].visible_count, cascades[1].visible_count, cascades[2].visible_count);
+   m_values.at("metrics.shadow_casters"_name)->set_content(caster_count_str.view());
+}
+
 void InfoDialog::set_camera_pos(const Vector3 value) const
 {
    const auto position_str = format("{:.2f}, {:.2f}, {:.2f}", value.x, value.y, value.z);
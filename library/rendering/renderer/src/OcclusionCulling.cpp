@@ -6,10 +6,13 @@
 #include "triglav/render_core/BuildContext.hpp"
 #include "triglav/render_core/JobGraph.hpp"
 
+#include <bit>
+
 namespace triglav::renderer {
 
 constexpr auto g_draw_call_size = 124;
-constexpr auto g_bindless_object_limit = 80;
+constexpr u32 g_min_object_capacity = 64;
+constexpr CullingCounters g_zero_counters{};
 
 using namespace name_literals;
 using namespace render_core::literals;
@@ -23,20 +26,35 @@ OcclusionCulling::OcclusionCulling(UpdateViewParamsJob& update_view_job, Bindles
 {
 }
 
+namespace {
+
+// Rounded up to a power of two, so the job is only rebuilt when the scene grows significantly.
+u32 calculate_object_capacity(const u32 object_count)
+{
+   return std::bit_ceil(std::max(object_count, g_min_object_capacity));
+}
+
+}// namespace
+
 void OcclusionCulling::on_resource_definition(render_core::BuildContext& ctx) const
 {
+   m_object_capacity = calculate_object_capacity(m_bindless_scene.scene_object_count());
+
    // buffers
    ctx.declare_buffer("occlusion_culling.count_buffer"_name, render_objects::GEOMETRY_RENDER_INFOS.size() * sizeof(u32));
+   ctx.declare_buffer("occlusion_culling.counters"_name, sizeof(CullingCounters));
+   ctx.declare_staging_buffer("occlusion_culling.counters.staging"_name, sizeof(CullingCounters));
+   ctx.declare_buffer("occlusion_culling.rejected_objects"_name, m_object_capacity * sizeof(u32));
    ctx.declare_proportional_texture("occlusion_culling.hierarchical_depth_buffer"_name, GAPI_FORMAT(R, UNorm16), 0.5f, true);
    ctx.declare_proportional_buffer("occlusion_culling.staging_depth_buffer"_name, 0.5f, sizeof(u16));
    ctx.declare_buffer("occlusion_culling.passthrough.count_buffer"_name, render_objects::VERTEX_LAYOUT_INFOS.size() * sizeof(u32));
 
    for (const auto& render_info : render_objects::GEOMETRY_RENDER_INFOS) {
-      ctx.declare_buffer(render_info.draw_call_buffer, sizeof(DrawCall) * g_bindless_object_limit);
+      ctx.declare_buffer(render_info.draw_call_buffer, sizeof(DrawCall) * m_object_capacity);
    }
 
    for (const auto& vertex_info : render_objects::VERTEX_LAYOUT_INFOS) {
-      ctx.declare_buffer(vertex_info.passthrough_buffer, sizeof(DrawCall) * g_bindless_object_limit * 3);
+      ctx.declare_buffer(vertex_info.passthrough_buffer, sizeof(DrawCall) * m_object_capacity);
    }
 
    // rts
@@ -47,46 +65,9 @@ void OcclusionCulling::on_view_properties_changed(render_core::BuildContext& ctx
 {
    TG_DEBUG_LABEL(ctx, "Occlusion culling", {0.2f, 0.2f, 0.8f, 1.0f})
 
-   // Render Depth Pre-Pass
-   {
-      TG_DEBUG_LABEL(ctx, "Depth pre pass", {0.8f, 0.2f, 0.2f, 1.0f})
-
-      render_core::RenderPassScope rt_scope(ctx, "occlusion_culling.depth_prepass"_name, "occlusion_culling.depth_prepass_target"_name);
-      ctx.clear_depth_stencil("occlusion_culling.depth_prepass_target"_name, 1.0f, 0);
-
-      for (const auto& info : render_objects::GEOMETRY_RENDER_INFOS) {
-         this->draw_pre_pass_objects(ctx, info);
-      }
-   }
-
-   {
-      TG_DEBUG_LABEL(ctx, "Pre-pass texture to hi-z bottom", {0.8f, 0.2f, 0.2f, 1.0f})
-
-      // Copy depth buffer to the highest mip of Hi-Z
-      ctx.copy_texture_to_buffer("occlusion_culling.depth_prepass_target"_name, "occlusion_culling.staging_depth_buffer"_name);
-      ctx.copy_buffer_to_texture("occlusion_culling.staging_depth_buffer"_name, "occlusion_culling.hierarchical_depth_buffer"_name);
-   }
-
-   {
-      TG_DEBUG_LABEL(ctx, "Generate hi-Z", {0.8f, 0.2f, 0.2f, 1.0f})
-
-      // Generate the hierarchy
-      const u32 mip_count = render_core::calculate_mip_count(ctx.screen_size() / 2);
-      int depth_width = ctx.screen_size().x / 4;
-      int depth_height = ctx.screen_size().y / 4;
-
-      for (const u32 mip_index : Range(0u, mip_count - 1)) {
-         ctx.bind_compute_shader("shader/bindless_geometry/hi_zbuffer_construct.cshader"_rc);
-
-         ctx.bind_texture(0, render_core::TextureMip{"occlusion_culling.hierarchical_depth_buffer"_name, mip_index});
-         ctx.bind_rw_texture(1, render_core::TextureMip{"occlusion_culling.hierarchical_depth_buffer"_name, mip_index + 1});
-
-         ctx.dispatch({divide_rounded_up(depth_width, 32), divide_rounded_up(depth_height, 32), 1});
-
-         depth_width = std::max(depth_width / 2, 1);
-         depth_height = std::max(depth_height / 2, 1);
-      }
-   }
+   // The first phase uses depth of objects visible in the last frame as occluders.
+   this->draw_pre_pass(ctx, "occlusion_culling.depth_prepass.last_frame"_name, true);
+   this->build_hierarchical_depth(ctx);
 
    {
       TG_DEBUG_LABEL(ctx, "Generate transform matrices", {0.8f, 0.2f, 0.2f, 1.0f})
@@ -114,23 +95,23 @@ void OcclusionCulling::on_view_properties_changed(render_core::BuildContext& ctx
    {
       TG_DEBUG_LABEL(ctx, "Cull objects", {0.8f, 0.2f, 0.2f, 1.0f})
       ctx.fill_buffer("occlusion_culling.count_buffer"_name, std::array<u32, render_objects::GEOMETRY_RENDER_INFOS.size()>{});
+      ctx.fill_buffer("occlusion_culling.counters"_name, CullingCounters{});
 
       ctx.bind_compute_shader("shader/bindless_geometry/culling.cshader"_rc);
+      this->bind_culling_resources(ctx);
+      ctx.dispatch({divide_rounded_up(m_bindless_scene.scene_object_count(), 1024), 1, 1});
+   }
 
-      ctx.bind_storage_buffer(0, &m_bindless_scene.scene_object_buffer());
-      ctx.bind_uniform_buffer(1, &m_bindless_scene.count_buffer());
-      ctx.bind_storage_buffer(2, &m_bindless_scene.transform_matrix_buffer());
-      ctx.bind_storage_buffer(3, "occlusion_culling.count_buffer"_name);
-      ctx.bind_uniform_buffer(4, "core.view_properties"_name);
-      ctx.bind_texture(5, "occlusion_culling.hierarchical_depth_buffer"_name);
-
-      u32 descriptor_index = 6;
-      for (const auto& info : render_objects::GEOMETRY_RENDER_INFOS) {
-         ctx.bind_storage_buffer(descriptor_index, info.draw_call_buffer);
-         ++descriptor_index;
-      }
+   // The second phase draws objects visible so far and tests the rejected objects again,
+   // this recovers objects that were hidden by stale occluders from the last frame.
+   this->draw_pre_pass(ctx, "occlusion_culling.depth_prepass.current_frame"_name, false);
+   this->build_hierarchical_depth(ctx);
 
-      ctx.dispatch({divide_rounded_up(m_bindless_scene.scene_object_count(), 1024), 1, 1});
+   {
+      TG_DEBUG_LABEL(ctx, "Cull rejected objects", {0.8f, 0.2f, 0.2f, 1.0f})
+      ctx.bind_compute_shader("shader/bindless_geometry/culling_rejected.cshader"_rc);
+      this->bind_culling_resources(ctx);
+      ctx.dispatch({divide_rounded_up(m_object_capacity, 256), 1, 1});
    }
 
    {
@@ -164,10 +145,13 @@ void OcclusionCulling::on_view_properties_not_changed(render_core::BuildContext&
    }
 
    ctx.copy_buffer("occlusion_culling.count_buffer"_last_frame, "occlusion_culling.count_buffer"_name);
+   ctx.copy_buffer("occlusion_culling.counters"_last_frame, "occlusion_culling.counters"_name);
 }
 
 void OcclusionCulling::on_finalize(render_core::BuildContext& ctx) const
 {
+   ctx.copy_buffer("occlusion_culling.counters"_name, "occlusion_culling.counters.staging"_name);
+
    for (const auto& info : render_objects::GEOMETRY_RENDER_INFOS) {
       ctx.export_buffer(info.draw_call_buffer, graphics_api::PipelineStage::DrawIndirect, graphics_api::BufferAccess::IndirectCmdRead,
                         graphics_api::BufferUsage::Indirect);
@@ -184,7 +168,26 @@ void OcclusionCulling::on_finalize(render_core::BuildContext& ctx) const
                      graphics_api::BufferAccess::IndirectCmdRead, graphics_api::BufferUsage::Indirect);
 }
 
-void OcclusionCulling::draw_pre_pass_objects(render_core::BuildContext& ctx, const render_objects::MaterialGeometryRenderInfo& info) const
+void OcclusionCulling::draw_pre_pass(render_core::BuildContext& ctx, const Name pass_name, const bool use_last_frame_objects) const
+{
+   TG_DEBUG_LABEL(ctx, "Depth pre pass", {0.8f, 0.2f, 0.2f, 1.0f})
+
+   {
+      render_core::RenderPassScope rt_scope(ctx, pass_name, "occlusion_culling.depth_prepass_target"_name);
+      ctx.clear_depth_stencil("occlusion_culling.depth_prepass_target"_name, 1.0f, 0);
+
+      for (const auto& info : render_objects::GEOMETRY_RENDER_INFOS) {
+         this->draw_pre_pass_objects(ctx, info, use_last_frame_objects);
+      }
+   }
+
+   // Copy depth buffer to the highest mip of Hi-Z
+   ctx.copy_texture_to_buffer("occlusion_culling.depth_prepass_target"_name, "occlusion_culling.staging_depth_buffer"_name);
+   ctx.copy_buffer_to_texture("occlusion_culling.staging_depth_buffer"_name, "occlusion_culling.hierarchical_depth_buffer"_name);
+}
+
+void OcclusionCulling::draw_pre_pass_objects(render_core::BuildContext& ctx, const render_objects::MaterialGeometryRenderInfo& info,
+                                             const bool use_last_frame_objects) const
 {
    const auto& vertex_info = render_objects::VERTEX_LAYOUT_INFOS[info.vertex_layout_id];
 
@@ -193,21 +196,84 @@ void OcclusionCulling::draw_pre_pass_objects(render_core::BuildContext& ctx, con
       return;
    }
 
+   // Draw calls and counts need to come from the same frame.
+   render_core::BufferRef draw_call_buffer = info.draw_call_buffer;
+   render_core::BufferRef count_buffer = "occlusion_culling.count_buffer"_name;
+   if (use_last_frame_objects) {
+      draw_call_buffer = render_core::FromLastFrame(info.draw_call_buffer);
+      count_buffer = "occlusion_culling.count_buffer"_last_frame;
+   }
+
    ctx.bind_vertex_shader("shader/bindless_geometry/depth_prepass.vshader"_rc);
 
    const auto vertex_layout = render_core::vertex_layout_from_components_for_depth_only(vertex_info.components);
    ctx.bind_vertex_layout(vertex_layout);
 
    ctx.bind_uniform_buffer(0, "core.view_properties"_name);
-   ctx.bind_storage_buffer(1, info.draw_call_buffer);
+   ctx.bind_storage_buffer(1, draw_call_buffer);
 
    ctx.bind_fragment_shader("shader/bindless_geometry/depth_prepass.fshader"_rc);
 
    ctx.bind_vertex_buffer(&m_bindless_scene.combined_vertex_buffer());
    ctx.bind_index_buffer(&m_bindless_scene.combined_index_buffer());
 
-   ctx.draw_indexed_indirect_with_count(info.draw_call_buffer, "occlusion_culling.count_buffer"_last_frame, g_bindless_object_limit,
-                                        sizeof(DrawCall), sizeof(u32) * info.index);
+   ctx.draw_indexed_indirect_with_count(draw_call_buffer, count_buffer, m_object_capacity, sizeof(DrawCall), sizeof(u32) * info.index);
+}
+
+void OcclusionCulling::build_hierarchical_depth(render_core::BuildContext& ctx) const
+{
+   TG_DEBUG_LABEL(ctx, "Generate hi-Z", {0.8f, 0.2f, 0.2f, 1.0f})
+
+   const u32 mip_count = render_core::calculate_mip_count(ctx.screen_size() / 2);
+   int depth_width = ctx.screen_size().x / 4;
+   int depth_height = ctx.screen_size().y / 4;
+
+   for (const u32 mip_index : Range(0u, mip_count - 1)) {
+      ctx.bind_compute_shader("shader/bindless_geometry/hi_zbuffer_construct.cshader"_rc);
+
+      ctx.bind_texture(0, render_core::TextureMip{"occlusion_culling.hierarchical_depth_buffer"_name, mip_index});
+      ctx.bind_rw_texture(1, render_core::TextureMip{"occlusion_culling.hierarchical_depth_buffer"_name, mip_index + 1});
+
+      ctx.dispatch({divide_rounded_up(depth_width, 32), divide_rounded_up(depth_height, 32), 1});
+
+      depth_width = std::max(depth_width / 2, 1);
+      depth_height = std::max(depth_height / 2, 1);
+   }
+}
+
+void OcclusionCulling::bind_culling_resources(render_core::BuildContext& ctx) const
+{
+   ctx.bind_storage_buffer(0, &m_bindless_scene.scene_object_buffer());
+   ctx.bind_uniform_buffer(1, &m_bindless_scene.count_buffer());
+   ctx.bind_storage_buffer(2, &m_bindless_scene.transform_matrix_buffer());
+   ctx.bind_storage_buffer(3, "occlusion_culling.count_buffer"_name);
+   ctx.bind_uniform_buffer(4, "core.view_properties"_name);
+   ctx.bind_texture(5, "occlusion_culling.hierarchical_depth_buffer"_name);
+
+   u32 descriptor_index = 6;
+   for (const auto& info : render_objects::GEOMETRY_RENDER_INFOS) {
+      ctx.bind_storage_buffer(descriptor_index, info.draw_call_buffer);
+      ++descriptor_index;
+   }
+
+   ctx.bind_storage_buffer(12, "occlusion_culling.counters"_name);
+   ctx.bind_storage_buffer(13, "occlusion_culling.rejected_objects"_name);
+}
+
+u32 OcclusionCulling::object_capacity() const
+{
+   return m_object_capacity;
+}
+
+bool OcclusionCulling::needs_rebuild() const
+{
+   return m_bindless_scene.scene_object_count() > m_object_capacity;
+}
+
+CullingCounters OcclusionCulling::read_counters(render_core::JobGraph& graph, const u32 frame_index)
+{
+   const auto mapped_counters = GAPI_CHECK(graph.resources().buffer("occlusion_culling.counters.staging"_name, frame_index).map_memory());
+   return mapped_counters.cast<CullingCounters>();
 }
 
 void OcclusionCulling::reset_buffers(graphics_api::Device& device, render_core::JobGraph& graph)
@@ -217,15 +283,20 @@ void OcclusionCulling::reset_buffers(graphics_api::Device& device, render_core::
    const auto cmd_list = GAPI_CHECK(device.create_command_list(graphics_api::WorkType::Transfer));
 
    GAPI_CHECK_STATUS(cmd_list.begin(graphics_api::SubmitType::OneTime));
-   cmd_list.update_buffer(graph.resources().buffer("occlusion_culling.count_buffer"_name, 0), 0,
-                          static_cast<u32>(zero_counts.size() * sizeof(u32)), zero_counts.data());
-   cmd_list.update_buffer(graph.resources().buffer("occlusion_culling.count_buffer"_name, 1), 0,
-                          static_cast<u32>(zero_counts.size() * sizeof(u32)), zero_counts.data());
-   cmd_list.update_buffer(graph.resources().buffer("occlusion_culling.count_buffer"_name, 2), 0,
-                          static_cast<u32>(zero_counts.size() * sizeof(u32)), zero_counts.data());
+   for (const u32 frame_index : Range(0, render_core::FRAMES_IN_FLIGHT_COUNT)) {
+      cmd_list.update_buffer(graph.resources().buffer("occlusion_culling.count_buffer"_name, frame_index), 0,
+                             static_cast<u32>(zero_counts.size() * sizeof(u32)), zero_counts.data());
+      cmd_list.update_buffer(graph.resources().buffer("occlusion_culling.counters"_name, frame_index), 0, sizeof(CullingCounters),
+                             &g_zero_counters);
+   }
    GAPI_CHECK_STATUS(cmd_list.finish());
 
    GAPI_CHECK_STATUS(device.submit_command_list_one_time(cmd_list));
+
+   for (const u32 frame_index : Range(0, render_core::FRAMES_IN_FLIGHT_COUNT)) {
+      auto& staging_counters = graph.resources().buffer("occlusion_culling.counters.staging"_name, frame_index);
+      GAPI_CHECK(staging_counters.map_memory()).write(&g_zero_counters, sizeof(CullingCounters));
+   }
 }
 
 }// namespace triglav::renderer
\ No newline at end of file
@@ -0,0 +1,91 @@
+#include "OffscreenSurface.hpp"
+
+#include "triglav/graphics_api/Device.hpp"
+#include "triglav/render_core/BuildContext.hpp"
+
+#include <cstring>
+
+namespace triglav::renderer {
+
+using namespace name_literals;
+
+namespace {
+
+constexpr MemorySize g_output_pixel_size = 4;
+
+}// namespace
+
+OffscreenSurface::OffscreenSurface(graphics_api::Device& device, render_core::ResourceStorage& resource_storage,
+                                   const Vector2u resolution) :
+    m_device(device),
+    m_resource_storage(resource_storage),
+    m_resolution(resolution),
+    m_frame_fences{GAPI_CHECK(device.create_fence()), GAPI_CHECK(device.create_fence()), GAPI_CHECK(device.create_fence())}
+{
+}
+
+void OffscreenSurface::add_present_jobs(render_core::JobGraph& /*job_graph*/, const Name /*output_job*/)
+{
+   // Nothing is presented, the output job is the last one in the frame.
+}
+
+void OffscreenSurface::declare_output_target(render_core::BuildContext& ctx) const
+{
+   ctx.declare_render_target("core.color_out"_name, GAPI_FORMAT(BGRA, sRGB));
+}
+
+void OffscreenSurface::export_output_target(render_core::BuildContext& ctx) const
+{
+   ctx.export_texture("core.color_out"_name, graphics_api::PipelineStage::Transfer, graphics_api::TextureState::TransferSrc,
+                      graphics_api::TextureUsage::TransferSrc);
+}
+
+void OffscreenSurface::await_for_frame(const u32 frame_index) const
+{
+   m_frame_fences[frame_index].await();
+}
+
+void OffscreenSurface::acquire_image(render_core::JobGraph& /*job_graph*/, const u32 /*frame_index*/) {}
+
+const graphics_api::Fence* OffscreenSurface::job_fence(const u32 frame_index) const
+{
+   return &m_frame_fences[frame_index];
+}
+
+void OffscreenSurface::present(render_core::JobGraph& /*job_graph*/, const u32 frame_index)
+{
+   m_last_frame_index = frame_index;
+}
+
+void OffscreenSurface::resize(const Vector2u new_resolution)
+{
+   m_resolution = new_resolution;
+}
+
+void OffscreenSurface::recreate_present_jobs() {}
+
+Vector2u OffscreenSurface::resolution() const
+{
+   return m_resolution;
+}
+
+std::vector<u8> OffscreenSurface::read_output() const
+{
+   const auto size = static_cast<MemorySize>(m_resolution.x) * m_resolution.y * g_output_pixel_size;
+   auto staging_buffer =
+      GAPI_CHECK(m_device.create_buffer(graphics_api::BufferUsage::HostVisible | graphics_api::BufferUsage::TransferDst, size));
+
+   const auto cmd_list = GAPI_CHECK(m_device.create_command_list(graphics_api::WorkType::Graphics));
+   GAPI_CHECK_STATUS(cmd_list.begin(graphics_api::SubmitType::OneTime));
+   cmd_list.copy_texture_to_buffer(m_resource_storage.texture("core.color_out"_name, m_last_frame_index), staging_buffer);
+   GAPI_CHECK_STATUS(cmd_list.finish());
+
+   GAPI_CHECK_STATUS(m_device.submit_command_list_one_time(cmd_list));
+
+   std::vector<u8> pixels(size);
+   const auto mapped_memory = GAPI_CHECK(staging_buffer.map_memory());
+   std::memcpy(pixels.data(), mapped_memory.ptr(), size);
+   return pixels;
+}
+
+}// namespace triglav::renderer
@@ -0,0 +1,27 @@
+#include "PostProcessJob.hpp"
+
+namespace triglav::renderer {
+
+PostProcessJob::PostProcessJob(const Config config, UpdateUserInterfaceJob* update_user_interface_job,
+                               const IRenderSurface& render_surface) :
+    m_stage(update_user_interface_job, render_surface),
+    m_config(config)
+{
+}
+
+void PostProcessJob::build_job(render_core::BuildContext& ctx) const
+{
+   m_stage.build_stage(ctx, m_config);
+}
+
+void PostProcessJob::set_config(const Config config)
+{
+   m_config = config;
+}
+
+void PostProcessJob::apply_config_flags(render_core::JobGraph& graph) const
+{
+   stage::PostProcessStage::apply_config_flags(graph, JobName, m_config);
+}
+
+}// namespace triglav::renderer
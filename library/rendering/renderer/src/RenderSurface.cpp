@@ -2,6 +2,7 @@
 
 #include "triglav/Ranges.hpp"
 #include "triglav/graphics_api/Device.hpp"
+#include "triglav/render_core/BuildContext.hpp"
 #include "triglav/render_core/JobGraph.hpp"
 
 #include <triglav/desktop/ISurface.hpp>
@@ -20,6 +21,13 @@ Vector2u create_viewport_resolution(const graphics_api::Device& device, const gr
    return resolution;
 }
 
+bool can_render_to_swapchain(const graphics_api::Swapchain& swapchain)
+{
+   if (swapchain.textures().empty() || swapchain.color_format() != GAPI_FORMAT(BGRA, sRGB))
+      return false;
+   return static_cast<bool>(swapchain.textures().front().usage_flags() & graphics_api::TextureUsage::ColorAttachment);
+}
+
 }// namespace
 
 RenderSurface::RenderSurface(graphics_api::Device& device, desktop::ISurface& desktop_surface, graphics_api::Surface& surface,
@@ -33,45 +41,101 @@ RenderSurface::RenderSurface(graphics_api::Device& device, desktop::ISurface& de
     m_present_mode(present_mode),
     m_swapchain(GAPI_CHECK(device.create_swapchain(surface, GAPI_FORMAT(BGRA, sRGB), graphics_api::ColorSpace::sRGB,
                                                    {resolution.x, resolution.y}, m_present_mode))),
-    m_frame_fences{GAPI_CHECK(device.create_fence()), GAPI_CHECK(device.create_fence()), GAPI_CHECK(device.create_fence())}
+    m_frame_fences{GAPI_CHECK(device.create_fence()), GAPI_CHECK(device.create_fence()), GAPI_CHECK(device.create_fence())},
+    m_is_rendering_to_swapchain(can_render_to_swapchain(m_swapchain))
 {
+   if (m_is_rendering_to_swapchain) {
+      m_resource_storage.import_textures("core.color_out"_name, m_swapchain.textures());
+   }
 }
 
-void RenderSurface::add_present_jobs(render_core::JobGraph& job_graph, const Name external_job)
+void RenderSurface::add_present_jobs(render_core::JobGraph& job_graph, const Name output_job)
 {
+   m_output_job = output_job;
+
    job_graph.add_external_job("job.acquire_swapchain_image"_name);
-   job_graph.add_external_job("job.copy_present_image"_name);
    job_graph.add_external_job("job.present_swapchain_image"_name);
 
+   if (m_is_rendering_to_swapchain) {
+      job_graph.add_dependency(output_job, "job.acquire_swapchain_image"_name);
+      job_graph.add_dependency("job.present_swapchain_image"_name, output_job);
+      return;
+   }
+
+   job_graph.add_external_job("job.copy_present_image"_name);
+
    job_graph.add_dependency("job.copy_present_image"_name, "job.acquire_swapchain_image"_name);
-   job_graph.add_dependency("job.copy_present_image"_name, external_job);
+   job_graph.add_dependency("job.copy_present_image"_name, output_job);
    job_graph.add_dependency("job.present_swapchain_image"_name, "job.copy_present_image"_name);
 }
 
+void RenderSurface::declare_output_target(render_core::BuildContext& ctx) const
+{
+   if (m_is_rendering_to_swapchain) {
+      ctx.declare_imported_render_target("core.color_out"_name, m_swapchain.color_format());
+   } else {
+      ctx.declare_render_target("core.color_out"_name, GAPI_FORMAT(BGRA, sRGB));
+   }
+}
+
+void RenderSurface::export_output_target(render_core::BuildContext& ctx) const
+{
+   if (m_is_rendering_to_swapchain) {
+      ctx.export_texture("core.color_out"_name, graphics_api::PipelineStage::End, graphics_api::TextureState::Present,
+                         graphics_api::TextureUsage::None);
+   } else {
+      ctx.export_texture("core.color_out"_name, graphics_api::PipelineStage::Transfer, graphics_api::TextureState::TransferSrc,
+                         graphics_api::TextureUsage::TransferSrc);
+   }
+}
+
 void RenderSurface::await_for_frame(const u32 frame_index) const
 {
    m_frame_fences[frame_index].await();
 }
 
-void RenderSurface::present(render_core::JobGraph& job_graph, const u32 frame_index)
+void RenderSurface::acquire_image(render_core::JobGraph& job_graph, const u32 frame_index)
 {
    if (m_must_recreate_swapchain) {
       recreate_swapchain(m_desktop_surface.dimension());
+      if (m_is_rendering_to_swapchain) {
+         // The output job records commands for each of the swapchain images.
+         job_graph.rebuild_job(m_output_job);
+      }
    }
 
-   const auto [framebuffer_index, must_recreate] = GAPI_CHECK(m_swapchain.get_available_framebuffer(
-      job_graph.semaphore("job.copy_present_image"_name, "job.acquire_swapchain_image"_name, frame_index)));
+   const auto acquiring_job = m_is_rendering_to_swapchain ? m_output_job : "job.copy_present_image"_name;
+   const auto [framebuffer_index, must_recreate] = GAPI_CHECK(
+      m_swapchain.get_available_framebuffer(job_graph.semaphore(acquiring_job, "job.acquire_swapchain_image"_name, frame_index)));
    if (must_recreate) {
       m_must_recreate_swapchain = true;
    }
 
-   GAPI_CHECK_STATUS(
-      m_device.submit_command_list(m_pre_present_commands[framebuffer_index * render_core::FRAMES_IN_FLIGHT_COUNT + frame_index],
-                                   job_graph.wait_semaphores("job.copy_present_image"_name, frame_index),
-                                   job_graph.signal_semaphores("job.copy_present_image"_name, frame_index), &m_frame_fences[frame_index],
-                                   graphics_api::WorkType::Presentation));
+   m_framebuffer_index = framebuffer_index;
+   if (m_is_rendering_to_swapchain) {
+      job_graph.set_import_index(m_output_job, framebuffer_index);
+   }
+}
+
+const graphics_api::Fence* RenderSurface::job_fence(const u32 frame_index) const
+{
+   if (!m_is_rendering_to_swapchain)
+      return nullptr;
+   return &m_frame_fences[frame_index];
+}
+
+void RenderSurface::present(render_core::JobGraph& job_graph, const u32 frame_index)
+{
+   if (!m_is_rendering_to_swapchain) {
+      GAPI_CHECK_STATUS(m_device.submit_command_list(
+         m_pre_present_commands[m_framebuffer_index * render_core::FRAMES_IN_FLIGHT_COUNT + frame_index],
+         job_graph.wait_semaphores("job.copy_present_image"_name, frame_index),
+         job_graph.signal_semaphores("job.copy_present_image"_name, frame_index), &m_frame_fences[frame_index],
+         graphics_api::WorkType::Presentation));
+   }
 
-   const auto status = m_swapchain.present(job_graph.wait_semaphores("job.present_swapchain_image"_name, frame_index), framebuffer_index);
+   const auto status =
+      m_swapchain.present(job_graph.wait_semaphores("job.present_swapchain_image"_name, frame_index), m_framebuffer_index);
    if (status == graphics_api::Status::OutOfDateSwapchain) {
       m_must_recreate_swapchain = true;
    } else {
@@ -82,6 +146,9 @@ void RenderSurface::present(render_core::JobGraph& job_graph, const u32 frame_in
 void RenderSurface::recreate_present_jobs()
 {
    m_pre_present_commands.clear();
+   if (m_is_rendering_to_swapchain)
+      return;
+
    m_pre_present_commands.reserve(m_swapchain.textures().size() * render_core::FRAMES_IN_FLIGHT_COUNT);
 
    for (const auto& swapchain_texture : m_swapchain.textures()) {
@@ -115,6 +182,11 @@ void RenderSurface::recreate_present_jobs()
    }
 }
 
+void RenderSurface::resize(const Vector2u new_resolution)
+{
+   this->recreate_swapchain(new_resolution);
+}
+
 void RenderSurface::recreate_swapchain(const Vector2u new_resolution)
 {
    m_device.await_all();
@@ -123,6 +195,10 @@ void RenderSurface::recreate_swapchain(const Vector2u new_resolution)
 
    m_resolution = new_resolution;
 
+   if (m_is_rendering_to_swapchain) {
+      m_resource_storage.import_textures("core.color_out"_name, m_swapchain.textures());
+   }
+
    RenderSurface::recreate_present_jobs();
    m_must_recreate_swapchain = false;
 }
@@ -132,4 +208,9 @@ Vector2u RenderSurface::resolution() const
    return m_resolution;
 }
 
+bool RenderSurface::is_rendering_to_swapchain() const
+{
+   return m_is_rendering_to_swapchain;
+}
+
 }// namespace triglav::renderer
@@ -2,22 +2,26 @@
 
 #include "AnimationJob.hpp"
 #include "Config.hpp"
+#include "OffscreenSurface.hpp"
+#include "RenderSurface.hpp"
 #include "StatisticManager.hpp"
 #include "stage/AmbientOcclusionStage.hpp"
 #include "stage/GBufferStage.hpp"
-#include "stage/PostProcessStage.hpp"
 #include "stage/RayTracingStage.hpp"
 #include "stage/ShadingStage.hpp"
 #include "stage/ShadowMapStage.hpp"
 
 #include "triglav/Name.hpp"
+#include "triglav/Profiler.hpp"
 #include "triglav/Ranges.hpp"
 #include "triglav/desktop/ISurface.hpp"
 #include "triglav/io/CommandLine.hpp"
+#include "triglav/io/File.hpp"
 #include "triglav/render_core/RenderCore.hpp"
 #include "triglav/render_core/ResourceStorage.hpp"
 #include "triglav/resource/ResourceManager.hpp"
 
+#include <algorithm>
 #include <chrono>
 #include <cmath>
 #include <glm/glm.hpp>
@@ -36,6 +40,13 @@ namespace triglav::renderer {
 
 namespace {
 
+constexpr u32 g_profile_capture_frame_count = 8;
+
+float elapsed_ms(const std::chrono::steady_clock::time_point since)
+{
+   return std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - since).count();
+}
+
 graphics_api::PresentMode get_present_mode()
 {
    const auto present_mode_str = io::CommandLine::the().arg("presentMode"_name);
@@ -55,6 +66,23 @@ graphics_api::PresentMode get_present_mode()
 
 Renderer::Renderer(desktop::ISurface& desktop_surface, graphics_api::Surface& surface, graphics_api::Device& device,
                    ResourceManager& resource_manager, const graphics_api::Resolution& resolution) :
+    Renderer(desktop_surface, device, resource_manager, resolution, [&](render_core::ResourceStorage& resource_storage) {
+       return std::make_unique<RenderSurface>(device, desktop_surface, surface, resource_storage,
+                                              Vector2u{resolution.width, resolution.height}, get_present_mode());
+    })
+{
+}
+
+Renderer::Renderer(desktop::ISurface& desktop_surface, graphics_api::Device& device, ResourceManager& resource_manager,
+                   const graphics_api::Resolution& resolution) :
+    Renderer(desktop_surface, device, resource_manager, resolution, [&](render_core::ResourceStorage& resource_storage) {
+       return std::make_unique<OffscreenSurface>(device, resource_storage, Vector2u{resolution.width, resolution.height});
+    })
+{
+}
+
+Renderer::Renderer(desktop::ISurface& desktop_surface, graphics_api::Device& device, ResourceManager& resource_manager,
+                   const graphics_api::Resolution& resolution, const RenderSurfaceFactory& create_render_surface) :
     m_device(device),
     m_resource_manager(resource_manager),
     m_config_manager(m_device),
@@ -65,7 +93,7 @@ Renderer::Renderer(desktop::ISurface& desktop_surface, graphics_api::Surface& su
     m_ui_context(m_ui_viewport, m_glyph_cache, m_resource_manager),
     m_info_dialog(m_ui_context, m_config_manager, desktop_surface),
     m_resource_storage(m_device),
-    m_render_surface(m_device, desktop_surface, surface, m_resource_storage, {resolution.width, resolution.height}, get_present_mode()),
+    m_render_surface(create_render_surface(m_resource_storage)),
     m_pipeline_cache(m_device, m_resource_manager),
     m_job_graph(m_device, m_resource_manager, m_pipeline_cache, m_resource_storage, {resolution.width, resolution.height}),
     m_animation_manager(m_device, m_resource_manager, m_bindless_scene),
@@ -74,6 +102,7 @@ Renderer::Renderer(desktop::ISurface& desktop_surface, graphics_api::Surface& su
     m_update_user_interface_job(m_device, m_glyph_cache, m_ui_viewport, m_resource_manager, *this),
     m_occlusion_culling(m_update_view_params_job, m_bindless_scene),
     m_rendering_job(m_config_manager.config()),
+    m_post_process_job(m_config_manager.config(), &m_update_user_interface_job, *m_render_surface),
     m_debug_widget(m_ui_context),
     TG_CONNECT(m_config_manager, OnPropertyChanged, on_config_property_changed)
 {
@@ -84,7 +113,11 @@ Renderer::Renderer(desktop::ISurface& desktop_surface, graphics_api::Surface& su
    }
 
    m_info_dialog.add_to_viewport({0, 0, resolution.width, resolution.height}, {0, 0, resolution.width, resolution.height});
-   m_scene.load_level("level/demo.level"_rc);
+   if (const auto level = io::CommandLine::the().arg("level"_name); level.has_value()) {
+      m_scene.load_level(LevelName{make_rc_name(*level).name()});
+   } else {
+      m_scene.load_level("level/demo.level"_rc);
+   }
    // m_scene.load_level("level/simple_animated_human.level"_rc);
 
    m_bindless_scene.write_objects_to_buffer();
@@ -95,14 +128,14 @@ Renderer::Renderer(desktop::ISurface& desktop_surface, graphics_api::Surface& su
 
    m_scene.update_shadow_maps();
 
-   m_rendering_job.emplace_stage<stage::GBufferStage>(m_device, m_bindless_scene);
+   m_rendering_job.emplace_stage<stage::GBufferStage>(m_device, m_bindless_scene, m_occlusion_culling);
    m_rendering_job.emplace_stage<stage::AmbientOcclusionStage>(m_device);
-   m_rendering_job.emplace_stage<stage::ShadowMapStage>(m_scene, m_bindless_scene, m_update_view_params_job);
+   m_shadow_map_stage = &m_rendering_job.emplace_stage<stage::ShadowMapStage>(m_device, m_scene, m_bindless_scene, m_occlusion_culling,
+                                                                              m_update_view_params_job);
    if (m_device.enabled_features() & DeviceFeature::RayTracing) {
       m_rendering_job.emplace_stage<stage::RayTracingStage>(*m_ray_tracing_scene);
    }
    m_rendering_job.emplace_stage<stage::ShadingStage>();
-   m_rendering_job.emplace_stage<stage::PostProcessStage>(&m_update_user_interface_job, "core.color_out"_name);
 
    auto& animation_job = m_job_graph.add_job(AnimationJob::JobName);
    m_animation_job.build_job(animation_job);
@@ -116,17 +149,23 @@ Renderer::Renderer(desktop::ISurface& desktop_surface, graphics_api::Surface& su
    auto& rendering_ctx = m_job_graph.add_job(RenderingJob::JobName);
    m_rendering_job.build_job(rendering_ctx);
 
+   auto& post_process_ctx = m_job_graph.add_job(PostProcessJob::JobName);
+   m_post_process_job.build_job(post_process_ctx);
+
    m_job_graph.add_dependency_to_previous_frame(UpdateViewParamsJob::JobName, UpdateViewParamsJob::JobName);
    m_job_graph.add_dependency_to_previous_frame(UpdateUserInterfaceJob::JobName, UpdateUserInterfaceJob::JobName);
    m_job_graph.add_dependency(UpdateUserInterfaceJob::JobName, AnimationJob::JobName);
    m_job_graph.add_dependency(RenderingJob::JobName, UpdateViewParamsJob::JobName);
    m_job_graph.add_dependency(RenderingJob::JobName, UpdateUserInterfaceJob::JobName);
+   m_job_graph.add_dependency(PostProcessJob::JobName, RenderingJob::JobName);
 
-   RenderSurface::add_present_jobs(m_job_graph, RenderingJob::JobName);
+   m_render_surface->add_present_jobs(m_job_graph, PostProcessJob::JobName);
 
-   m_job_graph.build_jobs(RenderingJob::JobName);
+   m_job_graph.set_submission_mode(render_core::SubmissionMode::Batched);
+   m_job_graph.build_jobs(PostProcessJob::JobName);
+   m_post_process_job.apply_config_flags(m_job_graph);
 
-   m_render_surface.recreate_present_jobs();
+   m_render_surface->recreate_present_jobs();
 
    // stage::ShadingStage::initialize_particles(m_job_graph);
 
@@ -146,56 +185,127 @@ void Renderer::update_debug_info(const bool is_first_frame)
    m_info_dialog.set_max_fps(StatisticManager::the().max(Stat::FramesPerSecond));
    m_info_dialog.set_avg_fps(StatisticManager::the().average(Stat::FramesPerSecond));
    m_info_dialog.set_gpu_time(StatisticManager::the().value(Stat::GBufferGpuTime));
+   m_info_dialog.set_cpu_times(StatisticManager::the().value(Stat::UpdateSceneCpuTime),
+                               StatisticManager::the().value(Stat::PrepareFrameCpuTime),
+                               StatisticManager::the().value(Stat::SubmitCpuTime));
 
    if (!is_first_frame) {
       m_info_dialog.set_triangle_count(m_resource_storage.pipeline_stats().get_int(0));
+      m_info_dialog.set_object_counts(m_culling_counters.visible_count, m_culling_counters.culled_count);
+      m_info_dialog.set_shadow_caster_counts(m_shadow_map_counters);
    }
 
    m_info_dialog.set_camera_pos(m_scene.camera().position());
    m_info_dialog.set_orientation({m_scene.pitch(), m_scene.yaw()});
 }
 
-void Renderer::on_render(const float delta_time)
+void Renderer::update_scene(const bool is_first_frame)
 {
-   static bool is_first_frame = true;
+   TG_PROFILE_SCOPE("Update Scene", "renderer");
+   const auto start = std::chrono::steady_clock::now();
 
+   // The object buffers and the acceleration structures are shared by the frames in flight,
+   // so they're only written before the frame is executed.
    m_bindless_scene.write_objects_to_buffer();
 
-   if (m_must_recreate_jobs) {
-      this->recreate_jobs(m_render_surface.resolution());
-   }
-
    if (m_ray_tracing_scene.has_value()) {
       m_ray_tracing_scene->build_acceleration_structures();
    }
    this->update_debug_info(is_first_frame);
+
+   StatisticManager::the().push_accumulated(Stat::UpdateSceneCpuTime, elapsed_ms(start));
+}
+
+void Renderer::on_render(const float delta_time)
+{
+   static bool is_first_frame = true;
+
    this->update_uniform_data(delta_time);
+   this->update_scene(is_first_frame);
+
+   if (m_occlusion_culling.needs_rebuild()) {
+      m_must_recreate_jobs = true;
+   }
+
+   if (m_must_recreate_jobs) {
+      this->recreate_jobs(m_render_surface->resolution());
+   } else if (m_pending_config_change >= ConfigChange::PipelineOnly) {
+      this->apply_config_change(m_pending_config_change);
+   }
 
    if (not is_first_frame) {
       StatisticManager::the().push_accumulated(Stat::FramesPerSecond, 1.0f / delta_time);
-      StatisticManager::the().push_accumulated(Stat::GBufferGpuTime, m_resource_storage.timestamps().get_difference(0, 1));
+      m_last_gpu_frame_time = m_resource_storage.timestamps().get_difference(0, 1);
+      StatisticManager::the().push_accumulated(Stat::GBufferGpuTime, m_last_gpu_frame_time);
    } else {
       is_first_frame = false;
       OcclusionCulling::reset_buffers(m_device, m_job_graph);
+      stage::ShadowMapStage::reset_counters(m_job_graph);
+   }
+
+   {
+      TG_PROFILE_SCOPE("Await Frame", "renderer");
+      const auto start = std::chrono::steady_clock::now();
+      m_render_surface->await_for_frame(m_frame_index);
+      m_culling_counters = OcclusionCulling::read_counters(m_job_graph, m_frame_index);
+      m_shadow_map_counters = stage::ShadowMapStage::read_counters(m_job_graph, m_frame_index);
+      StatisticManager::the().push_accumulated(Stat::AwaitFrameCpuTime, elapsed_ms(start));
    }
 
-   m_render_surface.await_for_frame(m_frame_index);
+   {
+      TG_PROFILE_SCOPE("Prepare Frame", "renderer");
+      const auto start = std::chrono::steady_clock::now();
+      m_animation_job.prepare_frame(m_job_graph, m_frame_index);
+      m_update_view_params_job.prepare_frame(m_job_graph, m_frame_index, delta_time);
+      m_update_user_interface_job.prepare_frame(m_job_graph, m_frame_index);
+      m_shadow_map_stage->prepare_frame(m_job_graph);
+      StatisticManager::the().push_accumulated(Stat::PrepareFrameCpuTime, elapsed_ms(start));
+   }
 
-   m_animation_job.prepare_frame(m_job_graph, m_frame_index);
-   m_update_view_params_job.prepare_frame(m_job_graph, m_frame_index, delta_time);
-   m_update_user_interface_job.prepare_frame(m_job_graph, m_frame_index);
+   const auto submit_start = std::chrono::steady_clock::now();
 
-   m_job_graph.build_semaphores();
+   m_render_surface->acquire_image(m_job_graph, m_frame_index);
 
-   m_job_graph.execute(RenderingJob::JobName, m_frame_index, nullptr);
+   {
+      TG_PROFILE_SCOPE("Submit", "renderer");
+      m_job_graph.build_semaphores();
+      m_job_graph.execute(PostProcessJob::JobName, m_frame_index, m_render_surface->job_fence(m_frame_index));
+   }
 
-   m_render_surface.present(m_job_graph, m_frame_index);
+   {
+      TG_PROFILE_SCOPE("Present", "renderer");
+      m_render_surface->present(m_job_graph, m_frame_index);
+   }
+
+   StatisticManager::the().push_accumulated(Stat::SubmitCpuTime, elapsed_ms(submit_start));
 
    StatisticManager::the().tick();
 
+   if (Profiler::the().end_frame()) {
+      this->write_profile_capture();
+   }
+
    m_frame_index = (m_frame_index + 1) % render_core::FRAMES_IN_FLIGHT_COUNT;
 }
 
+void Renderer::write_profile_capture()
+{
+   const auto path = io::CommandLine::the().arg("profileOutput"_name).value_or("frame_profile.json");
+   const auto file = io::open_file(io::Path{path}, io::FileMode::Write | io::FileMode::Create);
+   if (not file.has_value()) {
+      log_error("Failed to open profile output file: {}", path);
+      return;
+   }
+
+   const auto trace = Profiler::the().chrome_trace_json();
+   if (not (*file)->write({reinterpret_cast<const u8*>(trace.data()), trace.size()}).has_value()) {
+      log_error("Failed to write profile capture to {}", path);
+      return;
+   }
+
+   log_info("Profile capture written to {}", path);
+}
+
 void Renderer::on_close()
 {
    m_device.await_all();
@@ -207,7 +317,7 @@ void Renderer::on_mouse_move(const Vector2 position)
    event.event_type = ui_core::Event::Type::MouseMoved;
    event.mouse_position = position;
    event.global_mouse_position = position;
-   event.widget_size = m_render_surface.resolution();
+   event.widget_size = m_render_surface->resolution();
    m_info_dialog.on_event(event);
 }
 
@@ -222,7 +332,7 @@ void Renderer::on_mouse_is_pressed(const desktop::MouseButton button, const Vect
    event.event_type = ui_core::Event::Type::MousePressed;
    event.mouse_position = position;
    event.global_mouse_position = position;
-   event.widget_size = m_render_surface.resolution();
+   event.widget_size = m_render_surface->resolution();
    event.data.emplace<ui_core::Event::Mouse>(button);
    m_info_dialog.on_event(event);
 }
@@ -233,7 +343,7 @@ void Renderer::on_mouse_is_released(const desktop::MouseButton button, const Vec
    event.event_type = ui_core::Event::Type::MouseReleased;
    event.mouse_position = position;
    event.global_mouse_position = position;
-   event.widget_size = m_render_surface.resolution();
+   event.widget_size = m_render_surface->resolution();
    event.data.emplace<ui_core::Event::Mouse>(button);
    m_info_dialog.on_event(event);
 }
@@ -287,6 +397,11 @@ void Renderer::on_key_pressed(const Key key)
    if (key == Key::F10) {
       m_config_manager.toggle_rendering_particles();
    }
+   if (key == Key::F11 && not Profiler::the().is_capturing()) {
+      log_info("Capturing {} frames...", g_profile_capture_frame_count);
+      Profiler::the().set_thread_name("Main");
+      Profiler::the().begin_capture(g_profile_capture_frame_count);
+   }
    if (key == Key::T) {
       log_info("Playing Animation...");
       flush_logs();
@@ -316,7 +431,7 @@ ResourceManager& Renderer::resource_manager() const
 
 std::tuple<uint32_t, uint32_t> Renderer::screen_resolution() const
 {
-   return {m_render_surface.resolution().x, m_render_surface.resolution().y};
+   return {m_render_surface->resolution().x, m_render_surface->resolution().y};
 }
 
 float Renderer::calculate_frame_duration()
@@ -362,6 +477,17 @@ void Renderer::recreate_jobs(const Vector2u dimensions)
    m_ui_viewport.set_dimensions(dimensions);
    m_info_dialog.add_to_viewport({0, 0, dimensions}, {0, 0, dimensions});
 
+   if (m_occlusion_culling.needs_rebuild()) {
+      // The scene has outgrown the culling buffers, they're recreated along with the rest of the job's resources.
+      auto& update_view_params_ctx = m_job_graph.replace_job(UpdateViewParamsJob::JobName);
+      m_update_view_params_job.build_job(update_view_params_ctx);
+      m_job_graph.rebuild_job(UpdateViewParamsJob::JobName);
+
+      OcclusionCulling::reset_buffers(m_device, m_job_graph);
+      m_update_view_params_job.invalidate_view_properties();
+      log_info("Occlusion culling capacity increased to {} objects", m_occlusion_culling.object_capacity());
+   }
+
    auto& update_user_interface_ctx = m_job_graph.replace_job(UpdateUserInterfaceJob::JobName);
    m_update_user_interface_job.build_job(update_user_interface_ctx);
    m_job_graph.rebuild_job(UpdateUserInterfaceJob::JobName);
@@ -369,15 +495,46 @@ void Renderer::recreate_jobs(const Vector2u dimensions)
    auto& rendering_ctx = m_job_graph.replace_job(RenderingJob::JobName);
    m_rendering_job.build_job(rendering_ctx);
    m_job_graph.rebuild_job(RenderingJob::JobName);
+   stage::ShadowMapStage::reset_counters(m_job_graph);
 
-   m_render_surface.recreate_present_jobs();
+   auto& post_process_ctx = m_job_graph.replace_job(PostProcessJob::JobName);
+   m_post_process_job.build_job(post_process_ctx);
+   m_job_graph.rebuild_job(PostProcessJob::JobName);
+
+   m_render_surface->recreate_present_jobs();
 
    m_must_recreate_jobs = false;
+   m_pending_config_change = ConfigChange::None;
+}
+
+void Renderer::apply_config_change(const ConfigChange change)
+{
+   if (change == ConfigChange::PipelineOnly) {
+      // Only the rendering job's command lists are replaced, no need to wait for the whole device.
+      m_job_graph.await_job(RenderingJob::JobName);
+
+      auto& rendering_ctx = m_job_graph.replace_job(RenderingJob::JobName);
+      m_rendering_job.build_job(rendering_ctx);
+      m_job_graph.rerecord_job(RenderingJob::JobName);
+   } else {
+      // The post-processing samples the rendering job's textures, so it has to finish before they're recreated.
+      m_job_graph.await_job(PostProcessJob::JobName);
+
+      auto& rendering_ctx = m_job_graph.replace_job(RenderingJob::JobName);
+      m_rendering_job.build_job(rendering_ctx);
+      m_job_graph.rebuild_job(RenderingJob::JobName);
+      stage::ShadowMapStage::reset_counters(m_job_graph);
+
+      // Its own resources stay the same, only the descriptors need to point to the new textures.
+      m_job_graph.rerecord_job(PostProcessJob::JobName);
+   }
+
+   m_pending_config_change = ConfigChange::None;
 }
 
 void Renderer::on_resize(const uint32_t width, const uint32_t height)
 {
-   m_render_surface.recreate_swapchain(Vector2u{width, height});
+   m_render_surface->resize(Vector2u{width, height});
    this->recreate_jobs({width, height});
 }
 
@@ -386,10 +543,27 @@ graphics_api::Device& Renderer::device() const
    return m_device;
 }
 
-void Renderer::on_config_property_changed(const ConfigProperty /*property*/, const Config& config)
+const IRenderSurface& Renderer::render_surface() const
+{
+   return *m_render_surface;
+}
+
+float Renderer::last_gpu_frame_time() const
+{
+   return m_last_gpu_frame_time;
+}
+
+void Renderer::on_config_property_changed(const ConfigProperty property, const Config& config)
 {
-   m_must_recreate_jobs = true;
    m_rendering_job.set_config(config);
+   m_post_process_job.set_config(config);
+
+   const auto change = classify_config_change(property, config);
+   if (change == ConfigChange::FlagOnly) {
+      m_post_process_job.apply_config_flags(m_job_graph);
+   }
+   // The jobs are recorded again at the start of the next frame.
+   m_pending_config_change = std::max(m_pending_config_change, change);
 }
 
 void Renderer::recreate_render_jobs()
@@ -445,8 +619,9 @@ void Renderer::update_uniform_data(const float delta_time)
       m_mouse_offset = {0.0f, 0.0f};
    }
 
-   graphics_api::Resolution res{m_render_surface.resolution().x, m_render_surface.resolution().y};
+   graphics_api::Resolution res{m_render_surface->resolution().x, m_render_surface->resolution().y};
    m_scene.update(res);
+   m_scene.update_terrain();
 
    if (updated) {
       m_scene.update_shadow_maps();
@@ -3,6 +3,7 @@
 #include "Renderer.hpp"
 
 #include "triglav/world/Level.hpp"
+#include "triglav/world/LevelBinary.hpp"
 
 #include <cmath>
 #include <glm/gtc/quaternion.hpp>
@@ -21,11 +22,6 @@ Matrix4x4 SceneObject::model_matrix() const
 Scene::Scene(resource::ResourceManager& resource_manager) :
     m_resource_manager(resource_manager)
 {
-   m_terrain.resize(1024 * 1024);
-   std::ranges::fill(m_terrain, 0.0f);
-
-   m_terrain_blending.resize(1024 * 1024);
-   std::ranges::fill(m_terrain_blending, 0);
 }
 
 void Scene::update(const graphics_api::Resolution& resolution)
@@ -44,6 +40,7 @@ ObjectID Scene::add_object(SceneObject object)
 
    const auto& [it, ok] = m_objects.emplace(object_id, std::make_unique<SceneObject>(std::move(object)));
    assert(ok);
+   m_mesh_refs.emplace(object_id, m_resource_manager.acquire(it->second->model));
    event_OnObjectAddedToScene.publish(it->first, *it->second);
    this->update_bvh();
 
@@ -60,15 +57,19 @@ void Scene::set_transform(const ObjectID object_id, const Transform3D& transform
 
 void Scene::load_level(const LevelName name)
 {
-   auto& level = m_resource_manager.get<ResourceType::Level>(name);
-   auto& root = level.root();
+   const auto& level = m_resource_manager.get<ResourceType::Level>(name);
+   const auto* root = level.find_node("root");
+   if (root == nullptr)
+      return;
 
-   for (const auto& mesh : root.static_meshes()) {
+   // Objects are added straight from the flat arrays of the level.
+   for (u32 index = root->first_mesh; index < root->first_mesh + root->mesh_count; ++index) {
+      const auto mesh_name = level.static_mesh_name(index);
       this->add_object(SceneObject{
-         .model = mesh.mesh_name,
-         .name = mesh.name.c_str(),
-         .transform = mesh.transform,
-         .armature = mesh.armature_name,
+         .model = level.static_mesh_resource(index),
+         .name = String{mesh_name.data(), mesh_name.size()},
+         .transform = level.static_mesh_transform(index),
+         .armature = level.static_mesh_armature(index),
       });
    }
 }
@@ -184,19 +185,33 @@ RayHit Scene::trace_ray(const geometry::Ray& ray) const
    return {hit.distance, hit.payload->id, hit.payload->object};
 }
 
-std::vector<float>& Scene::terrain()
+TiledTerrain& Scene::terrain()
+{
+   return m_terrain;
+}
+
+const TiledTerrain& Scene::terrain() const
 {
    return m_terrain;
 }
 
-std::vector<u8>& Scene::terrain_blending()
+void Scene::set_terrain_directory(const io::Path& directory)
 {
-   return m_terrain_blending;
+   m_terrain.set_store(TerrainTileStore{directory});
 }
 
-void Scene::publish_terrain_changes()
+void Scene::update_terrain()
 {
-   event_OnTerrainUpdated.publish(Vector2i{1024, 1024}, m_terrain, m_terrain_blending);
+   m_terrain.update(m_camera);
+
+   if (m_terrain.has_tile_changes()) {
+      event_OnTerrainTilesChanged.publish(m_terrain);
+   }
+   if (!m_terrain.height_changes().empty() || !m_terrain.blending_changes().empty()) {
+      event_OnTerrainUpdated.publish(m_terrain);
+   }
+
+   m_terrain.clear_changes();
 }
 
 void Scene::update_shadow_maps()
@@ -223,6 +238,7 @@ void Scene::remove_object(const ObjectID object_id)
 {
    event_OnObjectRemoved.publish(object_id);
    m_objects.erase(object_id);
+   m_mesh_refs.erase(object_id);
    this->update_bvh();
 }
 
@@ -0,0 +1,169 @@
+#include "TerrainBrush.hpp"
+
+#include "triglav/threading/ThreadPool.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+namespace triglav::renderer {
+
+namespace {
+
+float u8_to_float(const u8 v)
+{
+   return static_cast<float>(v) / 255.0f;
+}
+
+u8 float_to_u8(const float v)
+{
+   return static_cast<u8>(std::clamp(v, 0.0f, 1.0f) * 255.0f);
+}
+
+// Brushes covering fewer texels are applied on the calling thread.
+constexpr MemorySize g_min_parallel_texel_count = 64 * 64;
+constexpr i32 g_stripe_height = 16;
+
+// Calls func(row_begin, row_end) for stripes of rows, in parallel if there's enough work.
+template<typename TFunc>
+void for_each_row_stripe(const i32 row_count, const MemorySize texel_count, TFunc func)
+{
+   if (texel_count < g_min_parallel_texel_count) {
+      func(0, row_count);
+      return;
+   }
+
+   const auto stripe_count = divide_rounded_up(static_cast<u32>(row_count), static_cast<u32>(g_stripe_height));
+   threading::ThreadPool::the().parallel_for(stripe_count, [&](const u32 stripe) {
+      const auto row_begin = static_cast<i32>(stripe) * g_stripe_height;
+      func(row_begin, std::min(row_begin + g_stripe_height, row_count));
+   });
+}
+
+// Evaluates shape(distance) once for each texel of the brush, distance is normalized to the brush radius.
+// Only a quadrant is evaluated as the distance is symmetric, then each row of the brush region within the radius
+// is passed to func(first_index, weights) with the shape of consecutive texels, so the kernels run without branches.
+template<typename TShapeFunc, typename TRowFunc>
+DirtyRegion apply_brush(const Vector2i size, const TerrainBrush& brush, TShapeFunc shape_func, TRowFunc row_func)
+{
+   const auto region = brush_region(size, brush);
+   if (region.empty())
+      return region;
+
+   const i32 quadrant_size = static_cast<i32>(brush.radius) + 1;
+   std::vector<float> quadrant(static_cast<MemorySize>(quadrant_size) * quadrant_size);
+   // Count of columns within the radius for each row of the quadrant.
+   std::vector<i32> row_extents(quadrant_size);
+
+   for_each_row_stripe(quadrant_size, quadrant.size(), [&](const i32 row_begin, const i32 row_end) {
+      for (i32 dy = row_begin; dy < row_end; ++dy) {
+         i32 extent = 0;
+         for (; extent < quadrant_size; ++extent) {
+            const Vector2 offset = Vector2{extent, dy} / brush.radius;
+            const float dist = glm::length(offset);
+            // The distance grows with the column, so the rest of the row is outside of the brush.
+            if (dist > 1.0f)
+               break;
+            quadrant[static_cast<MemorySize>(dy) * quadrant_size + extent] = shape_func(dist);
+         }
+         row_extents[dy] = extent;
+      }
+   });
+
+   const auto extent = region.extent();
+   for_each_row_stripe(extent.y, static_cast<MemorySize>(region.area()), [&](const i32 row_begin, const i32 row_end) {
+      std::vector<float> weights(extent.x);
+      for (i32 y = region.min.y + row_begin; y < region.min.y + row_end; ++y) {
+         const auto dy = std::abs(y - brush.center.y);
+         const auto row_extent = dy < quadrant_size ? row_extents[dy] : 0;
+         const auto min_x = std::max(brush.center.x - row_extent + 1, region.min.x);
+         const auto max_x = std::min(brush.center.x + row_extent, region.max.x);
+         if (min_x >= max_x)
+            continue;
+
+         const auto* quadrant_row = quadrant.data() + static_cast<MemorySize>(dy) * quadrant_size;
+         for (i32 x = min_x; x < max_x; ++x) {
+            weights[x - min_x] = quadrant_row[std::abs(x - brush.center.x)];
+         }
+         const auto row_size = static_cast<MemorySize>(max_x - min_x);
+         row_func(static_cast<MemorySize>(y) * size.x + min_x, std::span<const float>{weights.data(), row_size});
+      }
+   });
+
+   return region;
+}
+
+}// namespace
+
+DirtyRegion brush_region(const Vector2i size, const TerrainBrush& brush)
+{
+   const i32 radius = static_cast<i32>(brush.radius);
+   const Vector2i min = glm::clamp(brush.center - Vector2i{radius, radius}, Vector2i{0, 0}, size);
+   const Vector2i max = glm::clamp(brush.center + Vector2i{radius + 1, radius + 1}, Vector2i{0, 0}, size);
+   return {min, glm::max(min, max)};
+}
+
+DirtyRegion shift_terrain(const std::span<float> height, const Vector2i size, const TerrainBrush& brush, const float amount)
+{
+   assert(height.size() == static_cast<MemorySize>(size.x) * size.y);
+   return apply_brush(
+      size, brush, [](const float dist) { return std::sin(dist * dist * MATH_PI * 0.5f); },
+      [&](const MemorySize first_index, const std::span<const float> shape) {
+         float* row = height.data() + first_index;
+         for (MemorySize i = 0; i < shape.size(); ++i) {
+            row[i] += amount * (1.0f - shape[i]);
+         }
+      });
+}
+
+DirtyRegion level_terrain(const std::span<float> height, const Vector2i size, const TerrainBrush& brush, const float level,
+                          const float strength)
+{
+   assert(height.size() == static_cast<MemorySize>(size.x) * size.y);
+   return apply_brush(
+      size, brush, [](const float dist) { return std::cos(dist * MATH_PI * 0.5f); },
+      [&](const MemorySize first_index, const std::span<const float> shape) {
+         float* row = height.data() + first_index;
+         for (MemorySize i = 0; i < shape.size(); ++i) {
+            row[i] = std::lerp(row[i], level, shape[i] * strength);
+         }
+      });
+}
+
+DirtyRegion smooth_terrain(const std::span<float> height, const Vector2i size, const TerrainBrush& brush, const float strength)
+{
+   const auto average = sample_terrain_average(height, size, brush);
+   return level_terrain(height, size, brush, average, strength);
+}
+
+DirtyRegion paint_terrain(const std::span<u8> blending, const Vector2i size, const TerrainBrush& brush, const float strength)
+{
+   assert(blending.size() == static_cast<MemorySize>(size.x) * size.y);
+   return apply_brush(
+      size, brush, [](const float dist) { return std::sin(dist * MATH_PI * 0.5f); },
+      [&](const MemorySize first_index, const std::span<const float> shape) {
+         u8* row = blending.data() + first_index;
+         for (MemorySize i = 0; i < shape.size(); ++i) {
+            row[i] = float_to_u8(u8_to_float(row[i]) + strength * (1.0f - shape[i]));
+         }
+      });
+}
+
+float sample_terrain_average(const std::span<const float> height, const Vector2i size, const TerrainBrush& brush)
+{
+   const auto region = brush_region(size, brush);
+   if (region.empty())
+      return 0.0f;
+
+   // Summed serially, a different order would change the result.
+   float sum = 0.0f;
+   for (i32 y = region.min.y; y < region.max.y; ++y) {
+      for (i32 x = region.min.x; x < region.max.x; ++x) {
+         sum += height[static_cast<MemorySize>(y) * size.x + x];
+      }
+   }
+   return sum / static_cast<float>(region.area());
+}
+
+}// namespace triglav::renderer
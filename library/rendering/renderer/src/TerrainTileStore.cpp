@@ -0,0 +1,87 @@
+#include "TerrainTileStore.hpp"
+
+#include "triglav/io/File.hpp"
+
+#include <format>
+#include <utility>
+
+namespace triglav::renderer {
+
+namespace {
+
+constexpr u32 g_terrain_tile_magic = 0x54545254;
+constexpr u32 g_terrain_tile_version = 1;
+
+struct TerrainTileHeader
+{
+   u32 magic;
+   u32 version;
+   u32 texel_count;
+};
+
+bool read_bytes(io::IReader& reader, const std::span<u8> bytes)
+{
+   MemorySize offset = 0;
+   while (offset < bytes.size()) {
+      const auto bytes_read = reader.read(bytes.subspan(offset));
+      if (!bytes_read.has_value() || *bytes_read == 0) {
+         return false;
+      }
+      offset += *bytes_read;
+   }
+   return true;
+}
+
+}// namespace
+
+TerrainTileStore::TerrainTileStore(io::Path directory) :
+    m_directory(std::move(directory))
+{
+}
+
+bool TerrainTileStore::load(const Vector2i coord, const std::span<float> height, const std::span<u8> blending) const
+{
+   const auto file = io::open_file(this->tile_path(coord), io::FileMode::Read);
+   if (!file.has_value()) {
+      return false;
+   }
+
+   TerrainTileHeader header{};
+   if (!read_bytes(**file, {reinterpret_cast<u8*>(&header), sizeof(TerrainTileHeader)}))
+      return false;
+   if (header.magic != g_terrain_tile_magic || header.version != g_terrain_tile_version || header.texel_count != height.size() ||
+       height.size() != blending.size())
+      return false;
+
+   return read_bytes(**file, {reinterpret_cast<u8*>(height.data()), height.size_bytes()}) && read_bytes(**file, blending);
+}
+
+bool TerrainTileStore::save(const Vector2i coord, const std::span<const float> height, const std::span<const u8> blending) const
+{
+   if (!m_directory.exists() && !io::make_directory(m_directory)) {
+      return false;
+   }
+
+   const auto file = io::open_file(this->tile_path(coord), io::FileMode::Write | io::FileMode::Create);
+   if (!file.has_value()) {
+      return false;
+   }
+
+   const TerrainTileHeader header{
+      .magic = g_terrain_tile_magic,
+      .version = g_terrain_tile_version,
+      .texel_count = static_cast<u32>(height.size()),
+   };
+   if (!(*file)->write({reinterpret_cast<const u8*>(&header), sizeof(TerrainTileHeader)}).has_value())
+      return false;
+   if (!(*file)->write({reinterpret_cast<const u8*>(height.data()), height.size_bytes()}).has_value())
+      return false;
+   return (*file)->write(blending).has_value();
+}
+
+io::Path TerrainTileStore::tile_path(const Vector2i coord) const
+{
+   return m_directory.sub(std::format("{}_{}.tile", coord.x, coord.y));
+}
+
+}// namespace triglav::renderer
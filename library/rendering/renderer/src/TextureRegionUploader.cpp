@@ -0,0 +1,105 @@
+#include "TextureRegionUploader.hpp"
+
+#include "triglav/graphics_api/Device.hpp"
+#include "triglav/graphics_api/Texture.hpp"
+
+#include <cassert>
+#include <cstring>
+#include <vector>
+
+namespace triglav::renderer {
+
+namespace gapi = graphics_api;
+
+namespace {
+
+MemorySize texture_size(const gapi::Texture& texture)
+{
+   const auto [width, height] = texture.resolution();
+   return texture.format().pixel_size() * width * height;
+}
+
+}// namespace
+
+TextureRegionUploader::TextureRegionUploader(gapi::Device& device, const gapi::Texture& texture) :
+    m_device(device),
+    m_texture(texture),
+    m_staging_buffer(GAPI_CHECK(device.create_buffer(gapi::BufferUsage::HostVisible | gapi::BufferUsage::TransferSrc, texture_size(texture)))),
+    m_command_list(GAPI_CHECK(device.create_command_list(gapi::WorkType::Graphics))),
+    m_fence(GAPI_CHECK(device.create_fence()))
+{
+}
+
+TextureRegionUploader::~TextureRegionUploader()
+{
+   if (m_is_initialized) {
+      m_fence.await();
+   }
+}
+
+void TextureRegionUploader::upload(const std::span<const u8> pixels, const std::span<const DirtyRegion> regions)
+{
+   if (regions.empty())
+      return;
+
+   const auto [width, height] = m_texture.resolution();
+   const auto pixel_size = m_texture.format().pixel_size();
+   assert(pixels.size() == texture_size(m_texture));
+
+   // The previous copy may still read from the staging buffer.
+   m_fence.await();
+
+   std::vector<gapi::BufferTextureCopyRegion> copy_regions;
+   copy_regions.reserve(regions.size());
+   {
+      const auto mapped_memory = GAPI_CHECK(m_staging_buffer.map_memory());
+      for (const auto& region : regions) {
+         const auto extent = region.extent();
+         const MemorySize row_size = extent.x * pixel_size;
+         for (i32 y = region.min.y; y < region.max.y; ++y) {
+            const MemorySize offset = (static_cast<MemorySize>(y) * width + region.min.x) * pixel_size;
+            mapped_memory.write_offset(pixels.data() + offset, row_size, offset);
+         }
+
+         copy_regions.push_back(gapi::BufferTextureCopyRegion{
+            .buffer_offset = (static_cast<MemorySize>(region.min.y) * width + region.min.x) * pixel_size,
+            .buffer_row_length = width,
+            .texture_offset = region.min,
+            .extent = {extent.x, extent.y},
+         });
+      }
+   }
+
+   GAPI_CHECK_STATUS(m_command_list.begin(gapi::SubmitType::OneTime));
+
+   const gapi::TextureBarrierInfo transfer_barrier{
+      .texture = &m_texture,
+      .source_state = m_is_initialized ? gapi::TextureState::ShaderRead : gapi::TextureState::Undefined,
+      .target_state = gapi::TextureState::TransferDst,
+      .base_mip_level = 0,
+      .mip_level_count = 1,
+   };
+   m_command_list.texture_barrier(gapi::PipelineStage::FragmentShader | gapi::PipelineStage::DomainShader, gapi::PipelineStage::Transfer,
+                                  transfer_barrier);
+
+   m_command_list.copy_buffer_to_texture_regions(m_staging_buffer, m_texture, copy_regions);
+
+   const gapi::TextureBarrierInfo shader_read_barrier{
+      .texture = &m_texture,
+      .source_state = gapi::TextureState::TransferDst,
+      .target_state = gapi::TextureState::ShaderRead,
+      .base_mip_level = 0,
+      .mip_level_count = 1,
+   };
+   m_command_list.texture_barrier(gapi::PipelineStage::Transfer, gapi::PipelineStage::FragmentShader | gapi::PipelineStage::DomainShader,
+                                  shader_read_barrier);
+
+   GAPI_CHECK_STATUS(m_command_list.finish());
+
+   const gapi::SemaphoreArray empty;
+   GAPI_CHECK_STATUS(m_device.submit_command_list(m_command_list, empty, empty, &m_fence, gapi::WorkType::Graphics));
+
+   m_is_initialized = true;
+}
+
+}// namespace triglav::renderer
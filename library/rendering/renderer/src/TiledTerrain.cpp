@@ -0,0 +1,509 @@
+#include "TiledTerrain.hpp"
+
+#include "CameraBase.hpp"
+#include "CullingReference.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+namespace triglav::renderer {
+
+namespace {
+
+template<typename T>
+void copy_rect(const std::span<T> dst, const i32 dst_stride, const Vector2i dst_offset, const std::span<const T> src, const i32 src_stride,
+               const Vector2i src_offset, const Vector2i extent)
+{
+   for (i32 y = 0; y < extent.y; ++y) {
+      const auto src_index = static_cast<MemorySize>(src_offset.y + y) * src_stride + src_offset.x;
+      const auto dst_index = static_cast<MemorySize>(dst_offset.y + y) * dst_stride + dst_offset.x;
+      std::copy_n(src.begin() + src_index, extent.x, dst.begin() + dst_index);
+   }
+}
+
+Vector2i floor_to_int(const Vector2 value)
+{
+   return {static_cast<i32>(std::floor(value.x)), static_cast<i32>(std::floor(value.y))};
+}
+
+}// namespace
+
+TiledTerrain::TiledTerrain(const TerrainProperties& properties) :
+    m_properties(properties),
+    m_window_tile_origin(-properties.window_tile_count / 2, -properties.window_tile_count / 2),
+    m_tiles(properties.window_tile_count * properties.window_tile_count),
+    m_height(static_cast<MemorySize>(this->window_size().x) * this->window_size().y),
+    m_blending(m_height.size()),
+    m_height_changes(this->window_size()),
+    m_blending_changes(this->window_size())
+{
+   const auto count = m_properties.window_tile_count;
+   for (i32 index = 0; index < static_cast<i32>(m_tiles.size()); ++index) {
+      m_tiles[index].coord = m_window_tile_origin + Vector2i{index % count, index / count};
+   }
+   m_height_changes.mark_all();
+   m_blending_changes.mark_all();
+}
+
+void TiledTerrain::set_store(std::optional<TerrainTileStore> store)
+{
+   m_store = std::move(store);
+
+   // Tiles are reloaded from the new store.
+   for (auto& tile : m_tiles) {
+      tile.is_loaded = false;
+      tile.is_modified = false;
+      tile.pending_height_edits.clear();
+      tile.pending_blending_edits.clear();
+   }
+}
+
+void TiledTerrain::update(const CameraBase& camera)
+{
+   const auto position = camera.position();
+   const Vector2 camera_tile_position = Vector2{position.x, position.y} / m_properties.tile_world_size;
+   const auto camera_tile = floor_to_int(camera_tile_position);
+
+   // The camera may move within the two central tiles before the window follows.
+   const auto half_count = m_properties.window_tile_count / 2;
+   const auto offset = camera_tile - m_window_tile_origin;
+   if (offset.x < half_count - 1 || offset.x > half_count || offset.y < half_count - 1 || offset.y > half_count) {
+      this->move_window(camera_tile - Vector2i{half_count, half_count});
+   }
+
+   this->stream_tiles(camera_tile);
+
+   const DepthRange depth_range{camera.near_plane(), camera.far_plane()};
+   for (auto& tile : m_tiles) {
+      if (tile.has_stale_bounds) {
+         this->update_bounds(tile);
+      }
+
+      const auto distance = glm::length(Vector2{tile.coord} + Vector2{0.5f, 0.5f} - camera_tile_position);
+      const auto lod = std::min(m_properties.lod_count - 1, static_cast<u32>(distance / m_properties.lod_distance));
+      const auto bounds = project_bounding_box(this->tile_bounds(tile), camera.view_projection_matrix(), depth_range);
+      const auto is_visible = is_in_frustum(bounds, depth_range);
+      if (lod != tile.lod || is_visible != tile.is_visible) {
+         tile.lod = lod;
+         tile.is_visible = is_visible;
+         m_has_tile_changes = true;
+      }
+   }
+}
+
+void TiledTerrain::save_modified_tiles()
+{
+   for (auto& tile : m_tiles) {
+      if (tile.is_modified) {
+         this->save_tile(tile);
+         tile.is_modified = false;
+      }
+   }
+}
+
+void TiledTerrain::mark_height_dirty(const DirtyRegion region)
+{
+   m_height_changes.mark(region);
+   this->mark_tiles(region, true);
+}
+
+void TiledTerrain::mark_blending_dirty(const DirtyRegion region)
+{
+   m_blending_changes.mark(region);
+   this->mark_tiles(region, false);
+}
+
+void TiledTerrain::clear_changes()
+{
+   m_height_changes.clear();
+   m_blending_changes.clear();
+   m_has_tile_changes = false;
+}
+
+std::span<float> TiledTerrain::height()
+{
+   return m_height;
+}
+
+std::span<const float> TiledTerrain::height() const
+{
+   return m_height;
+}
+
+std::span<u8> TiledTerrain::blending()
+{
+   return m_blending;
+}
+
+std::span<const u8> TiledTerrain::blending() const
+{
+   return m_blending;
+}
+
+Vector2i TiledTerrain::window_size() const
+{
+   const auto size = m_properties.window_tile_count * m_properties.tile_resolution;
+   return {size, size};
+}
+
+Vector2i TiledTerrain::window_origin() const
+{
+   return m_window_tile_origin * m_properties.tile_resolution;
+}
+
+std::span<const TerrainTile> TiledTerrain::tiles() const
+{
+   return m_tiles;
+}
+
+const TerrainProperties& TiledTerrain::properties() const
+{
+   return m_properties;
+}
+
+bool TiledTerrain::has_tile_changes() const
+{
+   return m_has_tile_changes;
+}
+
+std::span<const DirtyRegion> TiledTerrain::height_changes() const
+{
+   return m_height_changes.regions();
+}
+
+std::span<const DirtyRegion> TiledTerrain::blending_changes() const
+{
+   return m_blending_changes.regions();
+}
+
+geometry::BoundingBox TiledTerrain::tile_bounds(const TerrainTile& tile) const
+{
+   const auto tile_size = m_properties.tile_world_size;
+   const auto min = Vector2{tile.coord} * tile_size;
+   return {
+      Vector3{min, tile.min_height * m_properties.height_scale},
+      Vector3{min + Vector2{tile_size, tile_size}, tile.max_height * m_properties.height_scale},
+   };
+}
+
+Vector2i TiledTerrain::world_to_texel(const Vector3 position) const
+{
+   return floor_to_int(Vector2{position.x, position.y} / this->texel_world_size());
+}
+
+float TiledTerrain::texel_world_size() const
+{
+   return m_properties.tile_world_size / static_cast<float>(m_properties.tile_resolution);
+}
+
+std::optional<float> TiledTerrain::sample_height(const Vector2i texel) const
+{
+   const auto local = texel - this->window_origin();
+   const auto size = this->window_size();
+   if (local.x < 0 || local.y < 0 || local.x >= size.x || local.y >= size.y)
+      return std::nullopt;
+
+   const auto* tile = this->tile_at(floor_to_int(Vector2{texel} / static_cast<float>(m_properties.tile_resolution)));
+   if (tile == nullptr || !tile->is_loaded)
+      return std::nullopt;
+
+   return m_height[static_cast<MemorySize>(local.y) * size.x + local.x];
+}
+
+std::optional<Vector3> TiledTerrain::trace_ray(const geometry::Ray& ray) const
+{
+   // Only tiles whose bounds are hit by the ray are marched, nearest first.
+   std::vector<Vector2> ranges;
+   for (const auto& tile : m_tiles) {
+      if (!tile.is_loaded)
+         continue;
+      if (const auto range = this->tile_bounds(tile).intersect(ray); range.has_value()) {
+         ranges.emplace_back(*range);
+      }
+   }
+   std::ranges::sort(ranges, [](const Vector2 lhs, const Vector2 rhs) { return lhs.x < rhs.x; });
+
+   const auto is_below_terrain = [&](const float t) {
+      const auto point = ray.origin + ray.direction * t;
+      const auto height = this->sample_height(this->world_to_texel(point));
+      return height.has_value() && point.z <= *height * m_properties.height_scale;
+   };
+
+   const auto step = 0.5f * this->texel_world_size();
+   for (const auto range : ranges) {
+      float above_t = std::max(range.x, 0.0f);
+      for (float t = above_t; t <= range.y + step; t += step) {
+         if (!is_below_terrain(t)) {
+            above_t = t;
+            continue;
+         }
+
+         float below_t = t;
+         for (int i = 0; i < 8; ++i) {
+            const auto mid_t = 0.5f * (above_t + below_t);
+            (is_below_terrain(mid_t) ? below_t : above_t) = mid_t;
+         }
+         return ray.origin + ray.direction * below_t;
+      }
+   }
+
+   return std::nullopt;
+}
+
+std::vector<TerrainPatchVertex> TiledTerrain::build_patches() const
+{
+   const auto tile_size = m_properties.tile_world_size;
+   const auto texel_origin = Vector2{this->window_origin()};
+   const auto window_size = Vector2{this->window_size()};
+   const auto patch_count_of = [&](const TerrainTile& tile) { return std::max(m_properties.patch_count >> tile.lod, 1); };
+
+   std::vector<TerrainPatchVertex> vertices;
+   for (const auto& tile : m_tiles) {
+      if (!tile.is_visible)
+         continue;
+
+      const auto patch_count = patch_count_of(tile);
+      const auto patch_size = tile_size / static_cast<float>(patch_count);
+      const auto edge_length = static_cast<float>(m_properties.patch_count) / static_cast<float>(patch_count);
+      const auto tile_origin = Vector2{tile.coord} * tile_size;
+
+      // Edges on the tile border are anchored to the segment of the coarser tile.
+      const auto edge_anchor = [&](const Vector2i from, const Vector2i to) -> Vector2 {
+         const auto midpoint = tile_origin + 0.5f * Vector2{from + to} * patch_size;
+         const bool is_vertical = from.x == to.x;
+         const auto border = is_vertical ? from.x : from.y;
+         if (border != 0 && border != patch_count)
+            return midpoint;
+
+         const auto direction = border == 0 ? -1 : 1;
+         const auto* neighbour = this->tile_at(tile.coord + (is_vertical ? Vector2i{direction, 0} : Vector2i{0, direction}));
+         const auto segment_count = neighbour != nullptr ? std::min(patch_count, patch_count_of(*neighbour)) : patch_count;
+         const auto segment_size = tile_size / static_cast<float>(segment_count);
+
+         const auto axis = is_vertical ? 1 : 0;
+         auto anchor = midpoint;
+         anchor[axis] = tile_origin[axis] + (std::floor((midpoint[axis] - tile_origin[axis]) / segment_size) + 0.5f) * segment_size;
+         return anchor;
+      };
+
+      for (i32 y = 0; y < patch_count; ++y) {
+         for (i32 x = 0; x < patch_count; ++x) {
+            const std::array corners{Vector2i{x, y}, Vector2i{x, y + 1}, Vector2i{x + 1, y + 1}, Vector2i{x + 1, y}};
+            for (MemorySize i = 0; i < corners.size(); ++i) {
+               const auto position = tile_origin + Vector2{corners[i]} * patch_size;
+               const auto uv = (position / this->texel_world_size() - texel_origin) / window_size;
+               const auto anchor = edge_anchor(corners[i], corners[(i + 1) % corners.size()]);
+               vertices.push_back({Vector3{position, 0.0f}, uv, Vector3{anchor, edge_length}});
+            }
+         }
+      }
+   }
+
+   return vertices;
+}
+
+MemorySize TiledTerrain::max_patch_vertex_count() const
+{
+   return m_tiles.size() * m_properties.patch_count * m_properties.patch_count * 4;
+}
+
+i32 TiledTerrain::slot_index(const Vector2i coord) const
+{
+   const auto slot = coord - m_window_tile_origin;
+   const auto count = m_properties.window_tile_count;
+   if (slot.x < 0 || slot.y < 0 || slot.x >= count || slot.y >= count)
+      return -1;
+   return slot.y * count + slot.x;
+}
+
+const TerrainTile* TiledTerrain::tile_at(const Vector2i coord) const
+{
+   const auto index = this->slot_index(coord);
+   if (index < 0)
+      return nullptr;
+   return &m_tiles[index];
+}
+
+DirtyRegion TiledTerrain::tile_region(const Vector2i coord) const
+{
+   const auto min = (coord - m_window_tile_origin) * m_properties.tile_resolution;
+   return {min, min + Vector2i{m_properties.tile_resolution, m_properties.tile_resolution}};
+}
+
+void TiledTerrain::move_window(const Vector2i tile_origin)
+{
+   const auto count = m_properties.window_tile_count;
+   const auto resolution = m_properties.tile_resolution;
+   const auto size = this->window_size();
+
+   std::vector<TerrainTile> tiles(m_tiles.size());
+   for (i32 index = 0; index < static_cast<i32>(tiles.size()); ++index) {
+      tiles[index].coord = tile_origin + Vector2i{index % count, index / count};
+   }
+   std::vector<float> height(m_height.size());
+   std::vector<u8> blending(m_blending.size());
+
+   for (auto& tile : m_tiles) {
+      const auto slot = tile.coord - tile_origin;
+      if (slot.x < 0 || slot.y < 0 || slot.x >= count || slot.y >= count) {
+         // Edits of a tile that wasn't streamed in yet are merged with its stored content before it's evicted.
+         if (!tile.is_loaded && (!tile.pending_height_edits.empty() || !tile.pending_blending_edits.empty())) {
+            this->load_tile(tile);
+         }
+         if (tile.is_modified) {
+            this->save_tile(tile);
+         }
+         continue;
+      }
+
+      const auto src_offset = this->tile_region(tile.coord).min;
+      const auto dst_offset = slot * resolution;
+      copy_rect<float>(height, size.x, dst_offset, m_height, size.x, src_offset, {resolution, resolution});
+      copy_rect<u8>(blending, size.x, dst_offset, m_blending, size.x, src_offset, {resolution, resolution});
+      tiles[slot.y * count + slot.x] = tile;
+   }
+
+   m_window_tile_origin = tile_origin;
+   m_tiles = std::move(tiles);
+   m_height = std::move(height);
+   m_blending = std::move(blending);
+
+   m_height_changes.mark_all();
+   m_blending_changes.mark_all();
+   m_has_tile_changes = true;
+}
+
+void TiledTerrain::stream_tiles(const Vector2i camera_tile)
+{
+   std::vector<TerrainTile*> pending;
+   for (auto& tile : m_tiles) {
+      if (!tile.is_loaded) {
+         pending.emplace_back(&tile);
+      }
+   }
+
+   const auto distance = [&](const TerrainTile* tile) {
+      const auto offset = tile->coord - camera_tile;
+      return offset.x * offset.x + offset.y * offset.y;
+   };
+   std::ranges::sort(pending, [&](const TerrainTile* lhs, const TerrainTile* rhs) { return distance(lhs) < distance(rhs); });
+
+   u32 load_count = 0;
+   for (auto* tile : pending) {
+      // Without a store there is nothing to read, tiles stay flat.
+      if (m_store.has_value() && load_count == m_properties.max_tile_loads_per_update)
+         break;
+
+      this->load_tile(*tile);
+      ++load_count;
+   }
+}
+
+void TiledTerrain::load_tile(TerrainTile& tile)
+{
+   tile.is_loaded = true;
+   tile.is_modified = !tile.pending_height_edits.empty() || !tile.pending_blending_edits.empty();
+   tile.has_stale_bounds = true;
+
+   const auto resolution = m_properties.tile_resolution;
+   const auto texel_count = static_cast<MemorySize>(resolution) * resolution;
+   std::vector<float> height(texel_count);
+   std::vector<u8> blending(texel_count);
+   if (m_store.has_value()) {
+      if (!m_store->load(tile.coord, height, blending)) {
+         std::ranges::fill(height, 0.0f);
+         std::ranges::fill(blending, 0);
+      }
+   }
+   this->apply_pending_edits(tile, height, blending);
+   tile.pending_height_edits.clear();
+   tile.pending_blending_edits.clear();
+
+   const auto region = this->tile_region(tile.coord);
+   const auto stride = this->window_size().x;
+   copy_rect<float>(m_height, stride, region.min, height, resolution, {0, 0}, {resolution, resolution});
+   copy_rect<u8>(m_blending, stride, region.min, blending, resolution, {0, 0}, {resolution, resolution});
+
+   m_height_changes.mark(region);
+   m_blending_changes.mark(region);
+}
+
+void TiledTerrain::apply_pending_edits(const TerrainTile& tile, const std::span<float> height, const std::span<u8> blending) const
+{
+   const auto resolution = m_properties.tile_resolution;
+   const auto tile_min = this->tile_region(tile.coord).min;
+   const auto stride = this->window_size().x;
+
+   for (const auto& edit : tile.pending_height_edits) {
+      copy_rect<float>(height, resolution, edit.min, m_height, stride, tile_min + edit.min, edit.extent());
+   }
+   for (const auto& edit : tile.pending_blending_edits) {
+      copy_rect<u8>(blending, resolution, edit.min, m_blending, stride, tile_min + edit.min, edit.extent());
+   }
+}
+
+void TiledTerrain::save_tile(const TerrainTile& tile) const
+{
+   if (!m_store.has_value() || !tile.is_loaded)
+      return;
+
+   const auto resolution = m_properties.tile_resolution;
+   const auto texel_count = static_cast<MemorySize>(resolution) * resolution;
+   std::vector<float> height(texel_count);
+   std::vector<u8> blending(texel_count);
+
+   const auto region = this->tile_region(tile.coord);
+   const auto stride = this->window_size().x;
+   copy_rect<float>(height, resolution, {0, 0}, m_height, stride, region.min, {resolution, resolution});
+   copy_rect<u8>(blending, resolution, {0, 0}, m_blending, stride, region.min, {resolution, resolution});
+
+   [[maybe_unused]] const auto is_saved = m_store->save(tile.coord, height, blending);
+   assert(is_saved);
+}
+
+void TiledTerrain::update_bounds(TerrainTile& tile) const
+{
+   const auto region = this->tile_region(tile.coord);
+   const auto stride = this->window_size().x;
+
+   tile.min_height = std::numeric_limits<float>::infinity();
+   tile.max_height = -std::numeric_limits<float>::infinity();
+   for (i32 y = region.min.y; y < region.max.y; ++y) {
+      const auto row = std::span{m_height}.subspan(static_cast<MemorySize>(y) * stride + region.min.x, m_properties.tile_resolution);
+      const auto [min, max] = std::ranges::minmax(row);
+      tile.min_height = std::min(tile.min_height, min);
+      tile.max_height = std::max(tile.max_height, max);
+   }
+   tile.has_stale_bounds = false;
+}
+
+void TiledTerrain::mark_tiles(const DirtyRegion region, const bool has_height_changed)
+{
+   const DirtyRegion clamped{glm::max(region.min, Vector2i{0, 0}), glm::min(region.max, this->window_size())};
+   if (clamped.empty())
+      return;
+
+   const auto tile_min = clamped.min / m_properties.tile_resolution;
+   const auto tile_max = (clamped.max - Vector2i{1, 1}) / m_properties.tile_resolution;
+   for (i32 y = tile_min.y; y <= tile_max.y; ++y) {
+      for (i32 x = tile_min.x; x <= tile_max.x; ++x) {
+         auto& tile = m_tiles[y * m_properties.window_tile_count + x];
+         if (tile.is_loaded) {
+            tile.is_modified = true;
+            tile.has_stale_bounds |= has_height_changed;
+            continue;
+         }
+
+         // The edit would be overwritten once the tile is streamed in, it's applied on top of the loaded content.
+         const auto region_of_tile = this->tile_region(tile.coord);
+         const DirtyRegion edit{glm::max(clamped.min, region_of_tile.min) - region_of_tile.min,
+                                glm::min(clamped.max, region_of_tile.max) - region_of_tile.min};
+         (has_height_changed ? tile.pending_height_edits : tile.pending_blending_edits).emplace_back(edit);
+      }
+   }
+}
+
+}// namespace triglav::renderer
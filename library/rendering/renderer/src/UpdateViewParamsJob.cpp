@@ -97,4 +97,9 @@ void UpdateViewParamsJob::on_updated(const Camera& camera)
    m_view_properties.aspect = camera.viewport_aspect();
 }
 
+void UpdateViewParamsJob::invalidate_view_properties()
+{
+   m_updated_view_properties = true;
+}
+
 }// namespace triglav::renderer
\ No newline at end of file
@@ -1,12 +1,15 @@
 #include "stage/GBufferStage.hpp"
 
 #include "BindlessScene.hpp"
+#include "OcclusionCulling.hpp"
 
 #include "triglav/geometry/DebugMesh.hpp"
 #include "triglav/geometry/Geometry.hpp"
 #include "triglav/render_core/BuildContext.hpp"
 #include "triglav/render_core/RenderCore.hpp"
 
+#include <array>
+
 namespace triglav::renderer::stage {
 
 using namespace name_literals;
@@ -22,87 +25,57 @@ geometry::DeviceMesh create_skybox_mesh(graphics_api::Device& device)
    return mesh.upload_to_device(device);
 }
 
-struct TerrainVertex
+// Drawn with a single indirect draw call, as the patch count changes with the tile LOD.
+struct TerrainDrawCall
 {
-   Vector3 position;
-   Vector2 uv;
+   u32 vertex_count;
+   u32 instance_count;
+   u32 first_vertex;
+   u32 first_instance;
 };
 
-const render_core::VertexLayout terrain_layout = render_core::VertexLayout{sizeof(TerrainVertex)}
-                                                    .add("position"_name, GAPI_FORMAT(RGB, Float32), offsetof(TerrainVertex, position))
-                                                    .add("uv"_name, GAPI_FORMAT(RG, Float32), offsetof(TerrainVertex, uv));
+const render_core::VertexLayout terrain_layout =
+   render_core::VertexLayout{sizeof(TerrainPatchVertex)}
+      .add("position"_name, GAPI_FORMAT(RGB, Float32), offsetof(TerrainPatchVertex, position))
+      .add("uv"_name, GAPI_FORMAT(RG, Float32), offsetof(TerrainPatchVertex, uv))
+      .add("edge"_name, GAPI_FORMAT(RGB, Float32), offsetof(TerrainPatchVertex, edge));
 
-graphics_api::Texture generate_terrain_bitmap(graphics_api::Device& device, const u32 w, const u32 h)
+graphics_api::Texture create_terrain_texture(graphics_api::Device& device, const graphics_api::ColorFormat& format, const Vector2i size)
 {
-   std::vector<float> terrain_vertices(w * h);
-   for (u32 y = 0; y < h; ++y) {
-      for (u32 x = 0; x < w; ++x) {
-         const float xx = 2.0f * (static_cast<float>(x) / static_cast<float>(w)) - 1.0f;
-         const float yy = 2.0f * (static_cast<float>(y) / static_cast<float>(h)) - 1.0f;
-
-         terrain_vertices[y * w + x] = 0.2f * xx * xx + 0.2f * yy * yy;
-         terrain_vertices[y * w + x] += 0.12f * (xx - 0.5f) * (xx - 0.5f) + 0.12f * (yy + 0.2f) * (yy + 0.2f);
-         // terrain_vertices[y * w + x] = static_cast<float>(rand() % 10) / 60.0f;
-      }
-   }
-
-   auto tex = GAPI_CHECK(device.create_texture(GAPI_FORMAT(R, Float32), graphics_api::Resolution{w, h}));
-   GAPI_CHECK_STATUS(tex.write(device, reinterpret_cast<const uint8_t*>(terrain_vertices.data())));
-
+   auto tex = GAPI_CHECK(device.create_texture(format, graphics_api::Resolution{static_cast<u32>(size.x), static_cast<u32>(size.y)}));
    tex.sampler_properties().address_u = graphics_api::TextureAddressMode::Clamp;
    tex.sampler_properties().address_v = graphics_api::TextureAddressMode::Clamp;
    tex.sampler_properties().address_w = graphics_api::TextureAddressMode::Clamp;
    return tex;
 }
 
-graphics_api::Buffer generate_terrain_vertices(graphics_api::Device& device)
-{
-   static constexpr u32 w = 8;
-   static constexpr u32 h = 8;
-   static constexpr u32 vertices_count = 4 * w * h;
-   std::vector<TerrainVertex> vertices(vertices_count);
-   constexpr float SIZE = 120.0;
-
-
-   for (u32 y = 0; y < h; ++y) {
-      for (u32 x = 0; x < w; ++x) {
-         const float uv_left = static_cast<float>(x) / static_cast<float>(w);
-         const float uv_right = static_cast<float>(x + 1) / static_cast<float>(w);
-         const float uv_bottom = static_cast<float>(y) / static_cast<float>(h);
-         const float uv_top = static_cast<float>(y + 1) / static_cast<float>(h);
-
-         const float pos_left = SIZE * (2.0f * uv_left - 1.0f);
-         const float pos_right = SIZE * (2.0f * uv_right - 1.0f);
-         const float pos_bottom = SIZE * (2.0f * uv_bottom - 1.0f);
-         const float pos_top = SIZE * (2.0f * uv_top - 1.0f);
-
-         const auto index = x + y * w;
-         vertices[4 * index + 0] = {Vector3{pos_left, pos_bottom, 0.0f}, Vector2{uv_left, uv_bottom}};
-         vertices[4 * index + 1] = {Vector3{pos_left, pos_top, 0.0f}, Vector2{uv_left, uv_top}};
-         vertices[4 * index + 2] = {Vector3{pos_right, pos_top, 0.0f}, Vector2{uv_right, uv_top}};
-         vertices[4 * index + 3] = {Vector3{pos_right, pos_bottom, 0.0f}, Vector2{uv_right, uv_bottom}};
-      }
-   }
-
-   auto buff = GAPI_CHECK(device.create_buffer(graphics_api::BufferUsage::TransferDst | graphics_api::BufferUsage::VertexBuffer,
-                                               vertices.size() * sizeof(TerrainVertex)));
-   GAPI_CHECK_STATUS(buff.write_indirect(vertices.data(), vertices.size() * sizeof(TerrainVertex)));
-   return buff;
-}
-
-
 }// namespace
 
-GBufferStage::GBufferStage(graphics_api::Device& device, BindlessScene& bindless_scene) :
+GBufferStage::GBufferStage(graphics_api::Device& device, BindlessScene& bindless_scene, const OcclusionCulling& occlusion_culling) :
     m_device(device),
     m_mesh(create_skybox_mesh(device)),
-    m_terrain_texture(generate_terrain_bitmap(device, 1024, 1024)),
-    m_terrain_blend_texture(GAPI_CHECK(device.create_texture(GAPI_FORMAT(R, UNorm8), graphics_api::Resolution{1024, 1024}))),
-    m_terrain_vertices(generate_terrain_vertices(device)),
+    m_terrain_texture(create_terrain_texture(device, GAPI_FORMAT(R, Float32), bindless_scene.scene().terrain().window_size())),
+    m_terrain_blend_texture(create_terrain_texture(device, GAPI_FORMAT(R, UNorm8), bindless_scene.scene().terrain().window_size())),
+    m_terrain_uploader(device, m_terrain_texture),
+    m_terrain_blend_uploader(device, m_terrain_blend_texture),
+    m_terrain_vertices(GAPI_CHECK(device.create_buffer(graphics_api::BufferUsage::TransferDst | graphics_api::BufferUsage::VertexBuffer,
+                                                       bindless_scene.scene().terrain().max_patch_vertex_count() * sizeof(TerrainPatchVertex)))),
+    m_terrain_draw_call(
+       GAPI_CHECK(device.create_buffer(graphics_api::BufferUsage::TransferDst | graphics_api::BufferUsage::Indirect, sizeof(TerrainDrawCall)))),
+    m_terrain_draw_count(GAPI_CHECK(device.create_buffer(graphics_api::BufferUsage::TransferDst | graphics_api::BufferUsage::Indirect, sizeof(u32)))),
     m_bindless_scene(bindless_scene),
-    TG_CONNECT(m_bindless_scene.scene(), OnTerrainUpdated, on_terrain_updated)
+    m_occlusion_culling(occlusion_culling),
+    TG_CONNECT(m_bindless_scene.scene(), OnTerrainUpdated, on_terrain_updated),
+    TG_CONNECT(m_bindless_scene.scene(), OnTerrainTilesChanged, on_terrain_tiles_changed)
 {
-   this->on_terrain_updated(Vector2i{1024, 1024}, m_bindless_scene.scene().terrain(), m_bindless_scene.scene().terrain_blending());
+   constexpr u32 draw_count = 1;
+   GAPI_CHECK_STATUS(m_terrain_draw_count.write_indirect(&draw_count, sizeof(u32)));
+
+   const auto& terrain = m_bindless_scene.scene().terrain();
+   const std::array full_region{DirtyRegion{Vector2i{0, 0}, terrain.window_size()}};
+   m_terrain_uploader.upload({reinterpret_cast<const u8*>(terrain.height().data()), terrain.height().size_bytes()}, full_region);
+   m_terrain_blend_uploader.upload(terrain.blending(), full_region);
+   this->on_terrain_tiles_changed(terrain);
 }
 
 void GBufferStage::build_stage(render_core::BuildContext& ctx, const Config& /*config*/) const
@@ -190,13 +163,29 @@ void GBufferStage::build_terrain(render_core::BuildContext& ctx) const
    ctx.bind_vertex_buffer(&m_terrain_vertices);
    ctx.set_tesselation_control_points(4);
 
-   ctx.draw_primitives(8 * 8 * 4, 0, 1, 0);
+   ctx.draw_indirect_with_count(&m_terrain_draw_call, &m_terrain_draw_count, 1, sizeof(TerrainDrawCall));
 }
 
-void GBufferStage::on_terrain_updated(const Vector2i /*size*/, const std::vector<float>& height, const std::vector<u8>& blending) const
+void GBufferStage::on_terrain_updated(const TiledTerrain& terrain)
 {
-   GAPI_CHECK_STATUS(m_terrain_texture.write(m_device, reinterpret_cast<const uint8_t*>(height.data())));
-   GAPI_CHECK_STATUS(m_terrain_blend_texture.write(m_device, blending.data()));
+   m_terrain_uploader.upload({reinterpret_cast<const u8*>(terrain.height().data()), terrain.height().size_bytes()}, terrain.height_changes());
+   m_terrain_blend_uploader.upload(terrain.blending(), terrain.blending_changes());
+}
+
+void GBufferStage::on_terrain_tiles_changed(const TiledTerrain& terrain)
+{
+   const auto vertices = terrain.build_patches();
+   if (!vertices.empty()) {
+      GAPI_CHECK_STATUS(m_terrain_vertices.write_indirect(vertices.data(), vertices.size() * sizeof(TerrainPatchVertex)));
+   }
+
+   const TerrainDrawCall draw_call{
+      .vertex_count = static_cast<u32>(vertices.size()),
+      .instance_count = 1,
+      .first_vertex = 0,
+      .first_instance = 0,
+   };
+   GAPI_CHECK_STATUS(m_terrain_draw_call.write_indirect(&draw_call, sizeof(TerrainDrawCall)));
 }
 
 void GBufferStage::draw_objects_with_render_info(render_core::BuildContext& ctx,
@@ -224,8 +213,8 @@ void GBufferStage::draw_objects_with_render_info(render_core::BuildContext& ctx,
 
    ctx.set_is_blending_enabled(false);
 
-   ctx.draw_indexed_indirect_with_count(render_core::External(info.draw_call_buffer), "occlusion_culling.count_buffer"_external, 80,
-                                        sizeof(DrawCall), sizeof(u32) * info.index);
+   ctx.draw_indexed_indirect_with_count(render_core::External(info.draw_call_buffer), "occlusion_culling.count_buffer"_external,
+                                        m_occlusion_culling.object_capacity(), sizeof(DrawCall), sizeof(u32) * info.index);
 }
 
 }// namespace triglav::renderer::stage
@@ -1,8 +1,10 @@
 #include "stage/PostProcessStage.hpp"
 
+#include "IRenderSurface.hpp"
 #include "UpdateUserInterfaceJob.hpp"
 
 #include "triglav/render_core/BuildContext.hpp"
+#include "triglav/render_core/JobGraph.hpp"
 
 #include <Config.hpp>
 
@@ -15,43 +17,116 @@ struct PostProcessingPushConstants
 };
 
 using namespace name_literals;
+using namespace render_core::literals;
 
-PostProcessStage::PostProcessStage(UpdateUserInterfaceJob* update_user_interface_job, Name output_render_target) :
+namespace {
+
+constexpr auto g_fxaa_flag = make_name_id("post_process.fxaa");
+constexpr auto g_bloom_flag = make_name_id("post_process.bloom");
+constexpr auto g_ui_hidden_flag = make_name_id("post_process.ui_hidden");
+
+void set_flag(render_core::JobGraph& graph, const Name job, const Name flag, const bool is_enabled)
+{
+   if (is_enabled) {
+      graph.enable_flag(job, flag);
+   } else {
+      graph.disable_flag(job, flag);
+   }
+}
+
+}// namespace
+
+PostProcessStage::PostProcessStage(UpdateUserInterfaceJob* update_user_interface_job, const Name output_render_target) :
     m_update_user_interface_job(update_user_interface_job),
     m_output_render_target(output_render_target)
 {
 }
 
+PostProcessStage::PostProcessStage(UpdateUserInterfaceJob* update_user_interface_job, const IRenderSurface& render_surface) :
+    m_update_user_interface_job(update_user_interface_job),
+    m_render_surface(&render_surface),
+    m_output_render_target("core.color_out"_name)
+{
+}
+
 void PostProcessStage::build_stage(render_core::BuildContext& ctx, const Config& config) const
 {
-   ctx.declare_render_target(m_output_render_target, GAPI_FORMAT(BGRA, sRGB));
+   if (m_render_surface != nullptr) {
+      m_render_surface->declare_output_target(ctx);
+      ctx.declare_flag(g_fxaa_flag);
+      ctx.declare_flag(g_bloom_flag);
+      ctx.declare_flag(g_ui_hidden_flag);
+   } else {
+      ctx.declare_render_target(m_output_render_target, GAPI_FORMAT(BGRA, sRGB));
+   }
    // ctx.declare_depth_target("ui.depth"_name, GAPI_FORMAT(D, UNorm16));
 
    // ctx.begin_render_pass("post_processing"_name, m_output_render_target, "ui.depth"_name);
    ctx.begin_render_pass("post_processing"_name, m_output_render_target);
 
+   if (m_render_surface != nullptr) {
+      // Each combination of the flags gets its own draw, so toggling them doesn't require recording the job again.
+      for (const bool enable_fxaa : {false, true}) {
+         for (const bool bloom_enabled : {false, true}) {
+            enable_fxaa ? ctx.if_enabled(g_fxaa_flag) : ctx.if_disabled(g_fxaa_flag);
+            bloom_enabled ? ctx.if_enabled(g_bloom_flag) : ctx.if_disabled(g_bloom_flag);
+            this->draw_post_processing(ctx, enable_fxaa, bloom_enabled);
+            ctx.end_if();
+            ctx.end_if();
+         }
+      }
+
+      if (m_update_user_interface_job != nullptr) {
+         ctx.if_disabled(g_ui_hidden_flag);
+         m_update_user_interface_job->render_ui(ctx);
+         ctx.end_if();
+      }
+   } else {
+      this->draw_post_processing(ctx, config.antialiasing == AntialiasingMethod::FastApproximate, config.is_bloom_enabled);
+
+      if (m_update_user_interface_job != nullptr && !config.is_uihidden) {
+         m_update_user_interface_job->render_ui(ctx);
+      }
+   }
+
+   ctx.end_render_pass();
+
+   if (m_render_surface != nullptr) {
+      m_render_surface->export_output_target(ctx);
+   } else {
+      ctx.export_texture(m_output_render_target, graphics_api::PipelineStage::Transfer, graphics_api::TextureState::TransferSrc,
+                         graphics_api::TextureUsage::TransferSrc);
+   }
+}
+
+void PostProcessStage::draw_post_processing(render_core::BuildContext& ctx, const bool enable_fxaa, const bool bloom_enabled) const
+{
    ctx.bind_fragment_shader("shader/pass/post_processing.fshader"_rc);
 
    ctx.push_constant(PostProcessingPushConstants{
-      .enable_fxaa = config.antialiasing == AntialiasingMethod::FastApproximate,
-      .bloom_enabled = config.is_bloom_enabled,
+      .enable_fxaa = enable_fxaa,
+      .bloom_enabled = bloom_enabled,
    });
 
-   ctx.bind_samplable_texture(0, "shading.color"_name);
-   ctx.bind_samplable_texture(1, "shading.blurred_bloom"_name);
+   // In a dedicated job the shading results come from the rendering job.
+   if (m_render_surface != nullptr) {
+      ctx.bind_samplable_texture(0, "shading.color"_external);
+      ctx.bind_samplable_texture(1, "shading.blurred_bloom"_external);
+   } else {
+      ctx.bind_samplable_texture(0, "shading.color"_name);
+      ctx.bind_samplable_texture(1, "shading.blurred_bloom"_name);
+   }
 
    ctx.set_is_blending_enabled(false);
 
    ctx.draw_full_screen_quad();
+}
 
-   if (m_update_user_interface_job != nullptr && !config.is_uihidden) {
-      m_update_user_interface_job->render_ui(ctx);
-   }
-
-   ctx.end_render_pass();
-
-   ctx.export_texture(m_output_render_target, graphics_api::PipelineStage::Transfer, graphics_api::TextureState::TransferSrc,
-                      graphics_api::TextureUsage::TransferSrc);
+void PostProcessStage::apply_config_flags(render_core::JobGraph& graph, const Name job, const Config& config)
+{
+   set_flag(graph, job, g_fxaa_flag, config.antialiasing == AntialiasingMethod::FastApproximate);
+   set_flag(graph, job, g_bloom_flag, config.is_bloom_enabled);
+   set_flag(graph, job, g_ui_hidden_flag, config.is_uihidden);
 }
 
 }// namespace triglav::renderer::stage
\ No newline at end of file
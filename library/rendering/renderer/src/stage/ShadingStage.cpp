@@ -89,6 +89,11 @@ void ShadingStage::build_stage(render_core::BuildContext& ctx, const Config& con
    ctx.end_render_pass();
 
    blur_texture(ctx, "shading.bloom"_name, "shading.blurred_bloom"_name, GAPI_FORMAT(RGBA, Float16));
+
+   ctx.export_texture("shading.color"_name, graphics_api::PipelineStage::FragmentShader, graphics_api::TextureState::ShaderRead,
+                      graphics_api::TextureUsage::Sampled);
+   ctx.export_texture("shading.blurred_bloom"_name, graphics_api::PipelineStage::FragmentShader, graphics_api::TextureState::ShaderRead,
+                      graphics_api::TextureUsage::Sampled);
 }
 
 void ShadingStage::prepare_particles(render_core::BuildContext& ctx) const
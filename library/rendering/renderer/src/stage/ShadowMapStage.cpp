@@ -1,8 +1,13 @@
 #include "stage/ShadowMapStage.hpp"
 
 #include "BindlessScene.hpp"
+#include "OcclusionCulling.hpp"
 #include "Scene.hpp"
 
+#include "RenderingJob.hpp"
+
+#include "triglav/Ranges.hpp"
+#include "triglav/graphics_api/Device.hpp"
 #include "triglav/render_core/BuildContext.hpp"
 #include "triglav/render_core/JobGraph.hpp"
 
@@ -24,53 +29,238 @@ constexpr graphics_api::SamplerProperties g_shadow_map_props{
 };
 
 constexpr Vector2i g_shadow_map_size{4096, 4096};
+constexpr auto g_update_static_casters_flag = make_name_id("shadow_map.update_static_casters");
+
+// Static casters are drawn only when the cache is invalidated, the job's textures don't retain
+// their contents between frames so the depth is cached in a texture owned by the stage.
+struct ShadowCascadeInfo
+{
+   Name pass;
+   Name target;
+   Name static_pass;
+   Name view_properties;
+   Name count_buffer;
+   std::array<Name, render_objects::VERTEX_LAYOUT_INFOS.size()> draw_call_buffers;
+};
+
+namespace {
 
-ShadowMapStage::ShadowMapStage(Scene& scene, BindlessScene& bindless_scene, UpdateViewParamsJob& update_view_params_job) :
+constexpr std::array<ShadowCascadeInfo, SHADOW_MAP_CASCADE_COUNT> g_cascades{
+   ShadowCascadeInfo{
+      .pass = make_name_id("shadow_map.pass.cascade0"),
+      .target = make_name_id("shadow_map.cascade0"),
+      .static_pass = make_name_id("shadow_map.pass.static_casters.cascade0"),
+      .view_properties = make_name_id("shadow_map.view_properties.cascade0"),
+      .count_buffer = make_name_id("shadow_map.culling.count_buffer.cascade0"),
+      .draw_call_buffers =
+         {
+            make_name_id("shadow_map.culling.cascade0.vl0"),
+            make_name_id("shadow_map.culling.cascade0.vl1"),
+            make_name_id("shadow_map.culling.cascade0.vl2"),
+            make_name_id("shadow_map.culling.cascade0.vl3"),
+         },
+   },
+   ShadowCascadeInfo{
+      .pass = make_name_id("shadow_map.pass.cascade1"),
+      .target = make_name_id("shadow_map.cascade1"),
+      .static_pass = make_name_id("shadow_map.pass.static_casters.cascade1"),
+      .view_properties = make_name_id("shadow_map.view_properties.cascade1"),
+      .count_buffer = make_name_id("shadow_map.culling.count_buffer.cascade1"),
+      .draw_call_buffers =
+         {
+            make_name_id("shadow_map.culling.cascade1.vl0"),
+            make_name_id("shadow_map.culling.cascade1.vl1"),
+            make_name_id("shadow_map.culling.cascade1.vl2"),
+            make_name_id("shadow_map.culling.cascade1.vl3"),
+         },
+   },
+   ShadowCascadeInfo{
+      .pass = make_name_id("shadow_map.pass.cascade2"),
+      .target = make_name_id("shadow_map.cascade2"),
+      .static_pass = make_name_id("shadow_map.pass.static_casters.cascade2"),
+      .view_properties = make_name_id("shadow_map.view_properties.cascade2"),
+      .count_buffer = make_name_id("shadow_map.culling.count_buffer.cascade2"),
+      .draw_call_buffers =
+         {
+            make_name_id("shadow_map.culling.cascade2.vl0"),
+            make_name_id("shadow_map.culling.cascade2.vl1"),
+            make_name_id("shadow_map.culling.cascade2.vl2"),
+            make_name_id("shadow_map.culling.cascade2.vl3"),
+         },
+   },
+};
+
+constexpr ShadowMapCounters g_zero_counters{};
+
+// Skeletal meshes are animated every frame, so they're never cached.
+bool is_dynamic_layout(const render_objects::MaterialVertexLayoutInfo& layout_info)
+{
+   return (layout_info.components & geometry::VertexComponent::Skeleton) != 0;
+}
+
+graphics_api::Texture create_static_cache(const graphics_api::Device& device)
+{
+   const gapi::Resolution resolution{static_cast<u32>(g_shadow_map_size.x), static_cast<u32>(g_shadow_map_size.y)};
+   return GAPI_CHECK(device.create_texture(GAPI_FORMAT(D, Float32), resolution,
+                                           gapi::TextureUsage::DepthStencilAttachment | gapi::TextureUsage::TransferSrc |
+                                              gapi::TextureUsage::TransferDst));
+}
+
+}// namespace
+
+ShadowMapStage::ShadowMapStage(graphics_api::Device& device, Scene& scene, BindlessScene& bindless_scene,
+                               const OcclusionCulling& occlusion_culling, UpdateViewParamsJob& update_view_params_job) :
     m_scene(scene),
     m_bindless_scene(bindless_scene),
+    m_occlusion_culling(occlusion_culling),
+    m_static_caches{create_static_cache(device), create_static_cache(device), create_static_cache(device)},
     TG_CONNECT(update_view_params_job, OnResourceDefinition, on_resource_definition),
     TG_CONNECT(update_view_params_job, OnViewPropertiesChanged, on_view_properties_changed),
     TG_CONNECT(update_view_params_job, OnViewPropertiesNotChanged, on_view_properties_not_changed),
     TG_CONNECT(update_view_params_job, OnFinalize, on_finalize),
-    TG_CONNECT(update_view_params_job, OnPrepareFrame, on_prepare_frame)
+    TG_CONNECT(update_view_params_job, OnPrepareFrame, on_prepare_frame),
+    TG_CONNECT(scene, OnShadowMapChanged, on_shadow_map_changed),
+    TG_CONNECT(scene, OnObjectAddedToScene, on_object_added_to_scene),
+    TG_CONNECT(scene, OnObjectChangedTransform, on_object_changed_transform),
+    TG_CONNECT(scene, OnObjectRemoved, on_object_removed)
 {
 }
 
 void ShadowMapStage::build_stage(render_core::BuildContext& ctx, const Config& /*config*/) const
 {
-   ctx.declare_sized_depth_target("shadow_map.cascade0"_name, g_shadow_map_size, GAPI_FORMAT(D, Float32));
-   ctx.declare_sized_depth_target("shadow_map.cascade1"_name, g_shadow_map_size, GAPI_FORMAT(D, Float32));
-   ctx.declare_sized_depth_target("shadow_map.cascade2"_name, g_shadow_map_size, GAPI_FORMAT(D, Float32));
+   // The job's targets are recreated, so the cache is redrawn to restore them from it.
+   this->invalidate_static_casters();
 
-   ctx.set_sampler_properties("shadow_map.cascade0"_name, g_shadow_map_props);
-   ctx.set_sampler_properties("shadow_map.cascade1"_name, g_shadow_map_props);
-   ctx.set_sampler_properties("shadow_map.cascade2"_name, g_shadow_map_props);
+   ctx.declare_flag(g_update_static_casters_flag);
+   ctx.declare_buffer("shadow_map.counters"_name, sizeof(ShadowMapCounters));
+   ctx.declare_staging_buffer("shadow_map.counters.staging"_name, sizeof(ShadowMapCounters));
 
-   this->render_cascade(ctx, "shadow_map.pass.cascade0"_name, "shadow_map.cascade0"_name, "shadow_map.view_properties.cascade0"_external);
-   this->render_cascade(ctx, "shadow_map.pass.cascade1"_name, "shadow_map.cascade1"_name, "shadow_map.view_properties.cascade1"_external);
-   this->render_cascade(ctx, "shadow_map.pass.cascade2"_name, "shadow_map.cascade2"_name, "shadow_map.view_properties.cascade2"_external);
+   for (const auto& cascade : g_cascades) {
+      ctx.declare_sized_depth_target(cascade.target, g_shadow_map_size, GAPI_FORMAT(D, Float32));
+      ctx.set_sampler_properties(cascade.target, g_shadow_map_props);
+
+      ctx.declare_buffer(cascade.count_buffer, render_objects::VERTEX_LAYOUT_INFOS.size() * sizeof(u32));
+      for (const Name draw_call_buffer : cascade.draw_call_buffers) {
+         ctx.declare_buffer(draw_call_buffer, sizeof(DrawCall) * m_occlusion_culling.object_capacity());
+      }
+   }
+
+   {
+      TG_DEBUG_LABEL(ctx, "Cull shadow casters", {0.8f, 0.2f, 0.2f, 1.0f})
+      ctx.fill_buffer("shadow_map.counters"_name, ShadowMapCounters{});
+      for (const u32 cascade_index : Range(0u, SHADOW_MAP_CASCADE_COUNT)) {
+         this->cull_cascade(ctx, cascade_index);
+      }
+   }
+
+   ctx.if_enabled(g_update_static_casters_flag);
+   {
+      for (const u32 cascade_index : Range(0u, SHADOW_MAP_CASCADE_COUNT)) {
+         this->render_static_casters(ctx, cascade_index);
+      }
+      ctx.end_if();
+   }
+
+   ctx.if_disabled(g_update_static_casters_flag);
+   {
+      for (const u32 cascade_index : Range(0u, SHADOW_MAP_CASCADE_COUNT)) {
+         ctx.copy_texture(&m_static_caches[cascade_index], g_cascades[cascade_index].target);
+      }
+      ctx.end_if();
+   }
+
+   // Dynamic casters are drawn on top of the depth of the static ones.
+   for (const auto& cascade : g_cascades) {
+      this->render_cascade(ctx, cascade);
+   }
+
+   ctx.copy_buffer("shadow_map.counters"_name, "shadow_map.counters.staging"_name);
+}
+
+void ShadowMapStage::cull_cascade(render_core::BuildContext& ctx, const u32 cascade_index) const
+{
+   const auto& cascade = g_cascades[cascade_index];
+
+   ctx.fill_buffer(cascade.count_buffer, std::array<u32, render_objects::VERTEX_LAYOUT_INFOS.size()>{});
+
+   ctx.bind_compute_shader("shader/bindless_geometry/shadow_culling.cshader"_rc);
+
+   ctx.bind_storage_buffer(0, &m_bindless_scene.scene_object_buffer());
+   ctx.bind_uniform_buffer(1, &m_bindless_scene.count_buffer());
+   ctx.bind_storage_buffer(2, &m_bindless_scene.transform_matrix_buffer());
+   ctx.bind_uniform_buffer(3, render_core::External{cascade.view_properties});
+   ctx.bind_storage_buffer(4, cascade.count_buffer);
+
+   u32 descriptor_index = 5;
+   for (const Name draw_call_buffer : cascade.draw_call_buffers) {
+      ctx.bind_storage_buffer(descriptor_index, draw_call_buffer);
+      ++descriptor_index;
+   }
+
+   ctx.bind_storage_buffer(9, "shadow_map.counters"_name);
+   ctx.push_constant(cascade_index);
+
+   ctx.dispatch({std::max(divide_rounded_up(m_bindless_scene.scene_object_count(), 256), 1u), 1, 1});
 }
 
-void ShadowMapStage::render_cascade(render_core::BuildContext& ctx, const Name pass_name, const Name target_name,
-                                    const render_core::BufferRef view_props) const
+void ShadowMapStage::render_static_casters(render_core::BuildContext& ctx, const u32 cascade_index) const
 {
-   render_core::RenderPassScope rt_scope(ctx, pass_name, target_name);
+   const auto& cascade = g_cascades[cascade_index];
+   const auto* static_cache = &m_static_caches[cascade_index];
+
+   {
+      render_core::RenderPassScope rt_scope(ctx, cascade.static_pass, cascade.target);
+
+      for (const auto& layout_info : render_objects::VERTEX_LAYOUT_INFOS) {
+         if (!is_dynamic_layout(layout_info)) {
+            this->render_geometry(ctx, cascade, layout_info);
+         }
+      }
+   }
+
+   // The stage's own textures aren't tracked by the job, the cache is kept in the transfer source state between updates.
+   render_core::TextureBarrier write_barrier;
+   write_barrier.texture_ref = static_cache;
+   write_barrier.src_stage_flags = gapi::PipelineStage::Transfer;
+   write_barrier.dst_stage_flags = gapi::PipelineStage::Transfer;
+   write_barrier.src_state = gapi::TextureState::Undefined;
+   write_barrier.dst_state = gapi::TextureState::TransferDst;
+   ctx.texture_barrier(write_barrier);
+
+   ctx.copy_texture(cascade.target, static_cache);
+
+   render_core::TextureBarrier read_barrier;
+   read_barrier.texture_ref = static_cache;
+   read_barrier.src_stage_flags = gapi::PipelineStage::Transfer;
+   read_barrier.dst_stage_flags = gapi::PipelineStage::Transfer;
+   read_barrier.src_state = gapi::TextureState::TransferDst;
+   read_barrier.dst_state = gapi::TextureState::TransferSrc;
+   ctx.texture_barrier(read_barrier);
+}
+
+void ShadowMapStage::render_cascade(render_core::BuildContext& ctx, const ShadowCascadeInfo& cascade) const
+{
+   render_core::RenderPassScope rt_scope(ctx, cascade.pass, cascade.target);
 
    for (const auto& layout_info : render_objects::VERTEX_LAYOUT_INFOS) {
-      this->render_geometry(ctx, view_props, layout_info);
+      if (is_dynamic_layout(layout_info)) {
+         this->render_geometry(ctx, cascade, layout_info);
+      }
    }
 }
 
-void ShadowMapStage::render_geometry(render_core::BuildContext& ctx, const render_core::BufferRef view_props,
+void ShadowMapStage::render_geometry(render_core::BuildContext& ctx, const ShadowCascadeInfo& cascade,
                                      const render_objects::MaterialVertexLayoutInfo& layout_info) const
 {
+   const Name draw_call_buffer = cascade.draw_call_buffers[layout_info.index];
+
    ctx.bind_vertex_shader(layout_info.vertex_shader_shadow_map);
 
    const auto layout = render_core::vertex_layout_from_components_for_depth_only(layout_info.components);
    ctx.bind_vertex_layout(layout);
 
-   ctx.bind_uniform_buffer(0, view_props);
-   ctx.bind_storage_buffer(1, render_core::External{layout_info.passthrough_buffer});
+   ctx.bind_uniform_buffer(0, render_core::External{cascade.view_properties});
+   ctx.bind_storage_buffer(1, draw_call_buffer);
    if (layout_info.components & geometry::VertexComponent::Skeleton) {
       ctx.bind_storage_buffer(2, &m_bindless_scene.transform_matrix_buffer());
    }
@@ -80,11 +270,40 @@ void ShadowMapStage::render_geometry(render_core::BuildContext& ctx, const rende
    ctx.bind_vertex_buffer(&m_bindless_scene.combined_vertex_buffer());
    ctx.bind_index_buffer(&m_bindless_scene.combined_index_buffer());
 
-   ctx.draw_indexed_indirect_with_count(render_core::External{layout_info.passthrough_buffer},
-                                        "occlusion_culling.passthrough.count_buffer"_external, 128, sizeof(DrawCall),
+   ctx.draw_indexed_indirect_with_count(draw_call_buffer, cascade.count_buffer, m_occlusion_culling.object_capacity(), sizeof(DrawCall),
                                         layout_info.index * sizeof(u32));
 }
 
+void ShadowMapStage::prepare_frame(render_core::JobGraph& graph)
+{
+   if (!m_is_static_update_pending) {
+      graph.disable_flag(RenderingJob::JobName, g_update_static_casters_flag);
+      return;
+   }
+
+   graph.enable_flag(RenderingJob::JobName, g_update_static_casters_flag);
+   m_is_static_update_pending = false;
+}
+
+void ShadowMapStage::invalidate_static_casters() const
+{
+   m_is_static_update_pending = true;
+}
+
+ShadowMapCounters ShadowMapStage::read_counters(render_core::JobGraph& graph, const u32 frame_index)
+{
+   const auto mapped_counters = GAPI_CHECK(graph.resources().buffer("shadow_map.counters.staging"_name, frame_index).map_memory());
+   return mapped_counters.cast<ShadowMapCounters>();
+}
+
+void ShadowMapStage::reset_counters(render_core::JobGraph& graph)
+{
+   for (const u32 frame_index : Range(0, render_core::FRAMES_IN_FLIGHT_COUNT)) {
+      auto& staging_counters = graph.resources().buffer("shadow_map.counters.staging"_name, frame_index);
+      GAPI_CHECK(staging_counters.map_memory()).write(&g_zero_counters, sizeof(ShadowMapCounters));
+   }
+}
+
 void ShadowMapStage::on_resource_definition(render_core::BuildContext& ctx) const
 {
    ctx.declare_buffer("shadow_map.matrices"_name, 3 * sizeof(Matrix4x4));
@@ -145,4 +364,24 @@ void ShadowMapStage::on_prepare_frame(render_core::JobGraph& graph, const u32 fr
    mapped_mem_view_props2.cast<Matrix4x4>() = m_scene.shadow_map_camera(2).view_projection_matrix();
 }
 
+void ShadowMapStage::on_shadow_map_changed(u32 /*index*/, const OrthoCamera& /*camera*/) const
+{
+   this->invalidate_static_casters();
+}
+
+void ShadowMapStage::on_object_added_to_scene(ObjectID /*object_id*/, const SceneObject& /*object*/) const
+{
+   this->invalidate_static_casters();
+}
+
+void ShadowMapStage::on_object_changed_transform(ObjectID /*object_id*/, const Transform3D& /*transform*/) const
+{
+   this->invalidate_static_casters();
+}
+
+void ShadowMapStage::on_object_removed(ObjectID /*object_id*/) const
+{
+   this->invalidate_static_casters();
+}
+
 }// namespace triglav::renderer::stage
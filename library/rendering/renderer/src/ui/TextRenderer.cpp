@@ -11,7 +11,6 @@ constexpr u32 g_max_text_update_count = 256;
 constexpr u32 g_max_character_count = 4096;
 constexpr u32 g_max_text_draw_calls = 512;
 constexpr u32 g_max_text_vertices = 8192;
-constexpr u32 g_max_combined_glyph_buffer_size = sizeof(render_core::GlyphInfo) * 286 * 32;
 constexpr u32 g_vertex_count_per_char = 6;
 
 using namespace name_literals;
@@ -23,16 +22,17 @@ struct TextUpdateInfo
    Vector4 color;
    Vector4 crop;
    Vector2 position;
-   u32 atlas_id;
 
    u32 character_offset;
    u32 character_count;
-   u32 glyph_buffer_offset;
 
    u32 dst_draw_call;
    u32 dst_vertex_offset;
    u32 dst_vertex_count;
 
+   float glyph_scale;
+   u32 render_mode;
+
    u32 padding[3];
 };
 
@@ -48,7 +48,7 @@ struct TextDrawCall
    Vector4 color;
    Vector4 crop;
    Vector2 position;
-   u32 atlas_index;
+   u32 render_mode;
 
    u32 padding;
 };
@@ -59,6 +59,8 @@ struct TextVertex
 {
    Vector2 position;
    Vector2 uv;
+   float atlas_page;
+   float padding;
 };
 
 TextRenderer::TextRenderer(graphics_api::Device& device, render_core::GlyphCache& glyph_cache, ui_core::Viewport& viewport,
@@ -72,32 +74,36 @@ TextRenderer::TextRenderer(graphics_api::Device& device, render_core::GlyphCache
     m_vertex_buffer(GAPI_CHECK(device.create_buffer(graphics_api::BufferUsage::VertexBuffer | graphics_api::BufferUsage::StorageBuffer |
                                                        graphics_api::BufferUsage::TransferDst,
                                                     sizeof(TextVertex) * g_max_text_vertices))),
-    m_combined_glyph_buffer(GAPI_CHECK(device.create_buffer(
-       graphics_api::BufferUsage::StorageBuffer | graphics_api::BufferUsage::TransferDst, g_max_combined_glyph_buffer_size))),
     m_vertex_allocator{memory::HeapAllocator{g_max_text_vertices}},
     TG_CONNECT(viewport, OnAddedText, on_added_text),
     TG_CONNECT(viewport, OnUpdatedText, on_updated_text),
     TG_CONNECT(viewport, OnRemovedText, on_removed_text)
 {
+   // All atlas pages are bound upfront, so new fonts don't require rebuilding the render jobs.
+   for (const auto page : Range(0u, render_core::DynamicGlyphAtlas::page_count)) {
+      m_atlases.emplace_back(&m_glyph_cache.dynamic_atlas().page_texture(page));
+   }
 }
 
 void TextRenderer::on_added_text(const TextId text_id, const ui_core::Text& text)
 {
    std::unique_lock lk{m_update_mtx};
 
-   const auto& typeface_info = this->get_typeface_info({text.typeface_name, text.font_size});
-   const auto vertex_section = this->allocate_vertex_section(text_id, static_cast<u32>(g_vertex_count_per_char * text.content.size()));
+   const auto& atlas = m_glyph_cache.find_glyph_atlas({text.typeface_name, text.font_size});
 
-   m_frame_updates.add_or_update(text_id, TextInfo{text, typeface_info.glyph_buffer_offset, text.color, text.crop, text.position,
-                                                   typeface_info.atlas_id, static_cast<u32>(vertex_section.offset),
-                                                   static_cast<u32>(vertex_section.size)});
+   // The text is submitted once all of its glyphs are present in the atlas,
+   // until then the previous version of the text stays on the screen.
+   m_pending_texts.insert_or_assign(text_id, TextInfo{text_id, text, &atlas, text.color, text.crop, text.position, 0, 0});
 }
 
 void TextRenderer::on_removed_text(const TextId text_id)
 {
    std::unique_lock lk{m_update_mtx};
-   m_frame_updates.remove(text_id);
-   this->free_vertex_section(text_id);
+   m_pending_texts.erase(text_id);
+   if (m_displayed_texts.erase(text_id) != 0) {
+      m_frame_updates.remove(text_id);
+      this->free_vertex_section(text_id);
+   }
 }
 
 void TextRenderer::on_updated_text(const TextId text_id, const ui_core::Text& text)
@@ -109,6 +115,9 @@ void TextRenderer::prepare_frame(render_core::JobGraph& graph, const u32 frame_i
 {
    std::unique_lock lk{m_update_mtx};
 
+   auto& glyph_atlas = m_glyph_cache.dynamic_atlas();
+   this->update_glyph_residency(glyph_atlas);
+
    const auto text_update_mem =
       GAPI_CHECK(graph.resources().buffer("user_interface.text_update_buffer.staging"_name, frame_index).map_memory());
    m_update_infos = static_cast<TextUpdateInfo*>(*text_update_mem);
@@ -140,6 +149,9 @@ void TextRenderer::prepare_frame(render_core::JobGraph& graph, const u32 frame_i
 
    m_frame_updates.write_to_buffers(*this);
 
+   // Glyphs used by this frame need to be uploaded before it gets submitted.
+   glyph_atlas.flush_uploads();
+
    text_draw_call_count = m_frame_updates.top_index();
    text_removal_count = m_top_move_index;
    text_dispatch = {m_top_update_info, 1, 1};
@@ -168,7 +180,7 @@ void TextRenderer::build_data_preparation(render_core::BuildContext& ctx) const
    // input
    ctx.bind_storage_buffer(0, "user_interface.text_update_buffer"_name);
    ctx.bind_storage_buffer(1, "user_interface.character_buffer"_name);
-   ctx.bind_storage_buffer(2, &this->m_combined_glyph_buffer);
+   ctx.bind_storage_buffer(2, &m_glyph_cache.dynamic_atlas().glyph_buffer());
 
    // output
    ctx.bind_storage_buffer(3, &m_draw_calls);
@@ -204,6 +216,7 @@ void TextRenderer::build_render_ui(render_core::BuildContext& ctx)
    render_core::VertexLayout layout(sizeof(TextVertex));
    layout.add("position"_name, GAPI_FORMAT(RG, Float32), offsetof(TextVertex, position));
    layout.add("uv"_name, GAPI_FORMAT(RG, Float32), offsetof(TextVertex, uv));
+   layout.add("atlas_page"_name, GAPI_FORMAT(R, Float32), offsetof(TextVertex, atlas_page));
    ctx.bind_vertex_layout(layout);
 
    ctx.bind_vertex_buffer(&m_vertex_buffer);
@@ -213,20 +226,26 @@ void TextRenderer::build_render_ui(render_core::BuildContext& ctx)
 
 void TextRenderer::set_object(const u32 index, const TextInfo& info)
 {
-   const auto char_count = font::Charset::European.encode_string_to(info.text.content.view(), m_char_buffer + m_char_offset);
+   const auto encoded = info.atlas->encode_text(info.text.content.view(), m_char_buffer + m_char_offset);
+   if (not encoded.is_resident) {
+      // Some glyphs got evicted in the meantime, resubmit the text once they are back.
+      m_pending_texts.try_emplace(info.text_id, info);
+   }
+
+   const auto char_count = encoded.glyph_count;
    assert(m_top_update_info < g_max_text_update_count);
    assert(index < g_max_text_draw_calls);
    m_update_infos[m_top_update_info++] = TextUpdateInfo{
       .color = info.color,
       .crop = info.crop,
       .position = info.position,
-      .atlas_id = info.atlas_id,
       .character_offset = m_char_offset,
       .character_count = char_count,
-      .glyph_buffer_offset = info.glyph_buffer_offset,
       .dst_draw_call = index,
       .dst_vertex_offset = info.dst_vertex_offset,
       .dst_vertex_count = info.dst_vertex_count,
+      .glyph_scale = info.atlas->glyph_scale(),
+      .render_mode = static_cast<u32>(info.atlas->render_mode()),
    };
    m_char_offset += char_count;
    assert(m_char_offset < g_max_character_count);
@@ -240,35 +259,47 @@ void TextRenderer::move_object(const u32 src, const u32 dst)
    m_move_buffer[m_top_move_index++] = {src, dst};
 }
 
-const TypefaceInfo& TextRenderer::get_typeface_info(const render_core::GlyphProperties& glyph_props)
+void TextRenderer::submit_text(TextInfo info, const u32 page_mask)
 {
-   if (const auto it = m_typeface_infos.find(glyph_props.hash()); it != m_typeface_infos.end()) {
-      return it->second;
-   }
+   const auto vertex_section =
+      this->allocate_vertex_section(info.text_id, static_cast<u32>(g_vertex_count_per_char * info.text.content.size()));
+   info.dst_vertex_offset = static_cast<u32>(vertex_section.offset);
+   info.dst_vertex_count = static_cast<u32>(vertex_section.size);
 
-   m_renderer.recreate_render_jobs();
-
-   auto& glyph_atlas = m_glyph_cache.find_glyph_atlas(glyph_props);
-
-   const auto atlas_id = static_cast<u32>(m_atlases.size());
-   m_atlases.emplace_back(&glyph_atlas.texture());
-
-   const auto transfer_cmd_list = GAPI_CHECK(m_device.create_command_list(graphics_api::WorkType::Transfer));
-
-   GAPI_CHECK_STATUS(transfer_cmd_list.begin(graphics_api::SubmitType::OneTime));
-   transfer_cmd_list.copy_buffer(glyph_atlas.storage_buffer(), m_combined_glyph_buffer, 0, m_glyph_offset,
-                                 static_cast<u32>(glyph_atlas.storage_buffer().size()));
-   GAPI_CHECK_STATUS(transfer_cmd_list.finish());
+   m_displayed_texts.insert_or_assign(info.text_id, DisplayedText{info, page_mask});
+   m_frame_updates.add_or_update(info.text_id, std::move(info));
+}
 
-   GAPI_CHECK_STATUS(m_device.submit_command_list_one_time(transfer_cmd_list));
+void TextRenderer::update_glyph_residency(render_core::DynamicGlyphAtlas& atlas)
+{
+   // Texts using evicted atlas pages need to wait for their glyphs to be rasterized again.
+   const auto eviction_generation = atlas.eviction_generation();
+   const auto evicted_pages = atlas.evicted_pages_since(m_eviction_generation);
+   m_eviction_generation = eviction_generation;
+
+   u32 used_pages{};
+   for (const auto& [text_id, displayed_text] : m_displayed_texts) {
+      if (displayed_text.page_mask & evicted_pages) {
+         m_pending_texts.try_emplace(text_id, displayed_text.info);
+      } else {
+         used_pages |= displayed_text.page_mask;
+      }
+   }
+   atlas.touch_pages(used_pages);
 
-   auto [new_it, ok] = m_typeface_infos.emplace(glyph_props.hash(),
-                                                TypefaceInfo{atlas_id, static_cast<u32>(m_glyph_offset / sizeof(render_core::GlyphInfo))});
-   assert(ok);
+   for (auto it = m_pending_texts.begin(); it != m_pending_texts.end();) {
+      const auto& info = it->second;
+      m_encode_buffer.resize(info.text.content.size());
 
-   m_glyph_offset += static_cast<u32>(glyph_atlas.storage_buffer().size());
+      const auto encoded = info.atlas->encode_text(info.text.content.view(), m_encode_buffer.data());
+      if (not encoded.is_resident) {
+         ++it;
+         continue;
+      }
 
-   return new_it->second;
+      this->submit_text(info, encoded.page_mask);
+      it = m_pending_texts.erase(it);
+   }
 }
 
 memory::Area TextRenderer::allocate_vertex_section(const TextId text_id, const u32 vertex_count)
@@ -0,0 +1,126 @@
+#include "triglav/testing_core/GTest.hpp"
+
+#include "triglav/renderer/CullingReference.hpp"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+using triglav::Matrix4x4;
+using triglav::u32;
+using triglav::Vector2u;
+using triglav::Vector3;
+using triglav::geometry::BoundingBox;
+using triglav::renderer::cull_objects;
+using triglav::renderer::CullingObject;
+using triglav::renderer::DepthRange;
+using triglav::renderer::HierarchicalDepth;
+using triglav::renderer::retest_rejected_objects;
+
+namespace {
+
+constexpr DepthRange g_depth_range{0.1f, 100.0f};
+constexpr Vector2u g_depth_size{64, 64};
+constexpr float g_wall_distance = 10.0f;
+
+// Inverse of to_linear_depth.
+float to_depth(const float linear_depth)
+{
+   const auto [near_plane, far_plane] = g_depth_range;
+   return (far_plane + near_plane - 2.0f * near_plane * far_plane / linear_depth) / (far_plane - near_plane);
+}
+
+Matrix4x4 view_projection()
+{
+   const auto projection = glm::perspective(glm::radians(90.0f), 1.0f, g_depth_range.near_plane, g_depth_range.far_plane);
+   const auto view = glm::lookAt(Vector3{0, 0, 0}, Vector3{0, 0, -1}, Vector3{0, 1, 0});
+   return projection * view;
+}
+
+// Fills the columns in range [0, wall_width) with a wall, the rest is empty.
+HierarchicalDepth make_depth(const u32 wall_width)
+{
+   std::vector<float> depth(g_depth_size.x * g_depth_size.y);
+   for (u32 y = 0; y < g_depth_size.y; ++y) {
+      for (u32 x = 0; x < g_depth_size.x; ++x) {
+         depth[y * g_depth_size.x + x] = x < wall_width ? to_depth(g_wall_distance) : 1.0f;
+      }
+   }
+   return {g_depth_size, std::move(depth)};
+}
+
+CullingObject make_object(const Vector3 position)
+{
+   return {
+      .bounding_box = BoundingBox{{-1, -1, -1}, {1, 1, 1}},
+      .transform = glm::translate(Matrix4x4{1}, position),
+   };
+}
+
+}// namespace
+
+TEST(CullingTest, ObjectInFrontOfWallIsVisible)
+{
+   const std::array objects{make_object({0, 0, -5})};
+   const auto result = cull_objects(objects, view_projection(), g_depth_range, make_depth(g_depth_size.x));
+
+   ASSERT_EQ(result.visible.size(), 1);
+   ASSERT_TRUE(result.rejected.empty());
+   ASSERT_EQ(result.culled_count, 0);
+}
+
+TEST(CullingTest, ObjectBehindWallIsRejected)
+{
+   const std::array objects{make_object({0, 0, -20}), make_object({3, 2, -30})};
+   const auto result = cull_objects(objects, view_projection(), g_depth_range, make_depth(g_depth_size.x));
+
+   ASSERT_TRUE(result.visible.empty());
+   ASSERT_EQ(result.rejected, (std::vector<u32>{0, 1}));
+   ASSERT_EQ(result.culled_count, 0);
+}
+
+TEST(CullingTest, ObjectOutsideOfFrustumIsCulled)
+{
+   const std::array objects{make_object({50, 0, -5}), make_object({0, 0, -150}), make_object({0, 0, -5})};
+   const auto result = cull_objects(objects, view_projection(), g_depth_range, make_depth(0));
+
+   ASSERT_EQ(result.visible, (std::vector<u32>{2}));
+   ASSERT_TRUE(result.rejected.empty());
+   ASSERT_EQ(result.culled_count, 2);
+}
+
+TEST(CullingTest, PartiallyOccludedObjectIsVisible)
+{
+   const std::array objects{make_object({0, 0, -20})};
+   const auto result = cull_objects(objects, view_projection(), g_depth_range, make_depth(g_depth_size.x / 2));
+
+   ASSERT_EQ(result.visible.size(), 1);
+   ASSERT_TRUE(result.rejected.empty());
+}
+
+TEST(CullingTest, SecondPhaseRecoversStaleRejects)
+{
+   const std::array objects{make_object({0, 0, -20}), make_object({-10, 0, -20})};
+
+   // The wall was visible in the last frame, in the current frame it only covers the left half.
+   auto result = cull_objects(objects, view_projection(), g_depth_range, make_depth(g_depth_size.x));
+   ASSERT_EQ(result.rejected.size(), 2);
+
+   retest_rejected_objects(result, objects, view_projection(), g_depth_range, make_depth(g_depth_size.x / 2));
+
+   ASSERT_EQ(result.visible, (std::vector<u32>{0}));
+   ASSERT_TRUE(result.rejected.empty());
+   ASSERT_EQ(result.culled_count, 1);
+}
+
+TEST(CullingTest, HierarchicalDepthKeepsFarthestSample)
+{
+   std::vector<float> depth(5 * 4, 0.1f);
+   depth[2 * 5 + 3] = 0.9f;
+
+   const HierarchicalDepth hi_z({5, 4}, std::move(depth));
+
+   ASSERT_EQ(hi_z.mip_count(), 3);
+   ASSERT_EQ(hi_z.mip_size(1), (Vector2u{2, 2}));
+   ASSERT_FLOAT_EQ(hi_z.load({1, 1}, 1), 0.9f);
+   ASSERT_FLOAT_EQ(hi_z.load({0, 0}, 1), 0.1f);
+   ASSERT_FLOAT_EQ(hi_z.load({0, 0}, 2), 0.9f);
+}
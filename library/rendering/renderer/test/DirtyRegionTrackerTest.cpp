@@ -0,0 +1,87 @@
+#include "triglav/testing_core/GTest.hpp"
+
+#include "triglav/renderer/DirtyRegionTracker.hpp"
+#include "triglav/renderer/TerrainBrush.hpp"
+
+#include <vector>
+
+using triglav::MemorySize;
+using triglav::Vector2i;
+using triglav::renderer::DirtyRegion;
+using triglav::renderer::DirtyRegionTracker;
+using triglav::renderer::shift_terrain;
+
+TEST(DirtyRegionTrackerTest, OverlappingRegionsAreMerged)
+{
+   DirtyRegionTracker tracker(Vector2i{64, 64});
+   tracker.mark({{0, 0}, {10, 10}});
+   tracker.mark({{5, 5}, {20, 12}});
+
+   ASSERT_EQ(tracker.regions().size(), 1);
+   ASSERT_EQ(tracker.regions()[0].min, (Vector2i{0, 0}));
+   ASSERT_EQ(tracker.regions()[0].max, (Vector2i{20, 12}));
+}
+
+TEST(DirtyRegionTrackerTest, AdjacentRegionsAreMerged)
+{
+   DirtyRegionTracker tracker(Vector2i{64, 64});
+   tracker.mark({{0, 0}, {10, 10}});
+   tracker.mark({{10, 0}, {20, 10}});
+
+   ASSERT_EQ(tracker.regions().size(), 1);
+   ASSERT_EQ(tracker.area(), 200);
+}
+
+TEST(DirtyRegionTrackerTest, DisjointRegionsAreKept)
+{
+   DirtyRegionTracker tracker(Vector2i{64, 64});
+   tracker.mark({{0, 0}, {4, 4}});
+   tracker.mark({{30, 30}, {34, 34}});
+
+   ASSERT_EQ(tracker.regions().size(), 2);
+   ASSERT_EQ(tracker.area(), 32);
+}
+
+TEST(DirtyRegionTrackerTest, RegionsAreClampedToSize)
+{
+   DirtyRegionTracker tracker(Vector2i{64, 64});
+   tracker.mark({{-10, 60}, {5, 80}});
+   tracker.mark({{70, 70}, {80, 80}});
+
+   ASSERT_EQ(tracker.regions().size(), 1);
+   ASSERT_EQ(tracker.regions()[0].min, (Vector2i{0, 60}));
+   ASSERT_EQ(tracker.regions()[0].max, (Vector2i{5, 64}));
+}
+
+TEST(DirtyRegionTrackerTest, RegionCountIsLimited)
+{
+   DirtyRegionTracker tracker(Vector2i{256, 256}, 4);
+   for (int i = 0; i < 16; ++i) {
+      tracker.mark({{i * 16, i * 16}, {i * 16 + 2, i * 16 + 2}});
+   }
+
+   ASSERT_LE(tracker.regions().size(), 4);
+
+   // Every marked texel is still covered.
+   for (int i = 0; i < 16; ++i) {
+      const Vector2i texel{i * 16, i * 16};
+      bool is_covered = false;
+      for (const auto& region : tracker.regions()) {
+         is_covered |= texel.x >= region.min.x && texel.x < region.max.x && texel.y >= region.min.y && texel.y < region.max.y;
+      }
+      ASSERT_TRUE(is_covered);
+   }
+}
+
+TEST(DirtyRegionTrackerTest, BrushNearEdgeStaysInBounds)
+{
+   constexpr Vector2i size{32, 32};
+   std::vector<float> height(static_cast<MemorySize>(size.x) * size.y);
+
+   const auto region = shift_terrain(height, size, {{31, 31}, 8.0f}, 1.0f);
+
+   ASSERT_EQ(region.min, (Vector2i{23, 23}));
+   ASSERT_EQ(region.max, (Vector2i{32, 32}));
+   ASSERT_GT(height[31 * size.x + 31], 0.0f);
+   ASSERT_EQ(height[0], 0.0f);
+}
@@ -270,6 +270,82 @@ TEST(DrawCallTest, Passthrough)
    });
 }
 
+TEST(DrawCallTest, ShadowCulling)
+{
+   RenderTestState state;
+
+   // Orthographic light space spanning x in [2, 8], y in [-8, -2] and z in [5, 15], only the first two objects are inside.
+   Matrix4x4 view_proj{1.0f};
+   view_proj[0][0] = 1.0f / 3.0f;
+   view_proj[1][1] = 1.0f / 3.0f;
+   view_proj[2][2] = 0.1f;
+   view_proj[3] = Vector4{-5.0f / 3.0f, 5.0f / 3.0f, -0.5f, 1.0f};
+
+   state.bctx.declare_staging_buffer("scene_upload"_name, 16 * sizeof(BindlessSceneObject));
+   state.bctx.declare_staging_buffer("matrices_upload"_name, 16 * sizeof(Matrix4x4));
+   state.bctx.declare_staging_buffer("count_buffer_stage"_name, triglav::render_objects::VERTEX_LAYOUT_INFOS.size() * sizeof(u32));
+   state.bctx.declare_staging_buffer("counters_stage"_name, 6 * sizeof(u32));
+
+   state.bctx.declare_buffer("scene_meshes"_name, 16 * sizeof(BindlessSceneObject));
+   state.bctx.declare_buffer("matrices"_name, 16 * sizeof(Matrix4x4));
+   state.bctx.declare_buffer("draw_calls_base"_name, 16 * sizeof(DrawCall));
+   state.bctx.declare_buffer("draw_calls_normal_map"_name, 16 * sizeof(DrawCall));
+   state.bctx.declare_buffer("draw_calls_skeletal"_name, 16 * sizeof(DrawCall));
+   state.bctx.declare_buffer("draw_calls_skeletal_normal_map"_name, 16 * sizeof(DrawCall));
+   state.bctx.init_buffer("count_buffer"_name, std::array<u32, triglav::render_objects::VERTEX_LAYOUT_INFOS.size()>{});
+   state.bctx.init_buffer("counters"_name, std::array<u32, 6>{});
+   state.bctx.init_buffer("mesh_count"_name, SCENE_MESH_COUNT);
+   state.bctx.init_buffer("shadow_map_props"_name, view_proj);
+
+   state.bctx.copy_buffer("scene_upload"_name, "scene_meshes"_name);
+   state.bctx.copy_buffer("matrices_upload"_name, "matrices"_name);
+
+   state.bctx.bind_compute_shader("shader/bindless_geometry/shadow_culling.cshader"_rc);
+
+   state.bctx.bind_storage_buffer(0, "scene_meshes"_name);
+   state.bctx.bind_uniform_buffer(1, "mesh_count"_name);
+   state.bctx.bind_storage_buffer(2, "matrices"_name);
+   state.bctx.bind_uniform_buffer(3, "shadow_map_props"_name);
+   state.bctx.bind_storage_buffer(4, "count_buffer"_name);
+   state.bctx.bind_storage_buffer(5, "draw_calls_base"_name);
+   state.bctx.bind_storage_buffer(6, "draw_calls_normal_map"_name);
+   state.bctx.bind_storage_buffer(7, "draw_calls_skeletal"_name);
+   state.bctx.bind_storage_buffer(8, "draw_calls_skeletal_normal_map"_name);
+   state.bctx.bind_storage_buffer(9, "counters"_name);
+   state.bctx.push_constant(1u);
+
+   state.bctx.dispatch({1, 1, 1});
+
+   state.bctx.copy_buffer("count_buffer"_name, "count_buffer_stage"_name);
+   state.bctx.copy_buffer("counters"_name, "counters_stage"_name);
+
+   state.build();
+
+   state.map_buffer("matrices_upload"_name,
+                    [](void* buffer) { std::memcpy(buffer, SCENE_MATRICES.data(), sizeof(Matrix4x4) * SCENE_MATRICES.size()); });
+   state.map_buffer("scene_upload"_name,
+                    [](void* buffer) { std::memcpy(buffer, SCENE_OBJECTS.data(), sizeof(BindlessSceneObject) * SCENE_OBJECTS.size()); });
+
+   state.execute_and_await();
+
+   state.map_buffer("count_buffer_stage"_name, [](void* count_buffer) {
+      const auto& arr = *static_cast<std::array<u32, triglav::render_objects::VERTEX_LAYOUT_INFOS.size()>*>(count_buffer);
+      ASSERT_EQ(arr[0], 2u);
+      ASSERT_EQ(arr[1], 0u);
+      ASSERT_EQ(arr[2], 0u);
+      ASSERT_EQ(arr[3], 0u);
+   });
+
+   // The counters of the second cascade were written.
+   state.map_buffer("counters_stage"_name, [](void* counters) {
+      const auto& arr = *static_cast<std::array<u32, 6>*>(counters);
+      ASSERT_EQ(arr[0], 0u);
+      ASSERT_EQ(arr[1], 0u);
+      ASSERT_EQ(arr[2], 2u);
+      ASSERT_EQ(arr[3], 1u);
+   });
+}
+
 struct ChannelState
 {
    float start_time;
@@ -0,0 +1,139 @@
+#include "triglav/testing_core/GTest.hpp"
+
+#include "triglav/renderer/TerrainBrush.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using triglav::i32;
+using triglav::MemorySize;
+using triglav::u8;
+using triglav::Vector2;
+using triglav::Vector2i;
+using triglav::renderer::brush_region;
+using triglav::renderer::DirtyRegion;
+using triglav::renderer::TerrainBrush;
+
+namespace {
+
+constexpr Vector2i g_size{300, 200};
+
+// Scalar kernels the brushes were originally implemented with, the optimized ones must match them exactly.
+namespace reference {
+
+template<typename TFunc>
+DirtyRegion for_each_brush_texel(const Vector2i size, const TerrainBrush& brush, TFunc func)
+{
+   const auto region = brush_region(size, brush);
+   for (i32 y = region.min.y; y < region.max.y; ++y) {
+      for (i32 x = region.min.x; x < region.max.x; ++x) {
+         const Vector2 offset = Vector2{x - brush.center.x, y - brush.center.y} / brush.radius;
+         const float dist = glm::length(offset);
+         if (dist > 1.0f)
+            continue;
+
+         func(static_cast<MemorySize>(y) * size.x + x, dist);
+      }
+   }
+   return region;
+}
+
+void shift_terrain(std::vector<float>& height, const TerrainBrush& brush, const float amount)
+{
+   for_each_brush_texel(g_size, brush, [&](const MemorySize index, const float dist) {
+      const float shape = std::sin(dist * dist * triglav::MATH_PI * 0.5f);
+      height[index] += amount * (1.0f - shape);
+   });
+}
+
+void level_terrain(std::vector<float>& height, const TerrainBrush& brush, const float level, const float strength)
+{
+   for_each_brush_texel(g_size, brush, [&](const MemorySize index, const float dist) {
+      const float shape = std::cos(dist * triglav::MATH_PI * 0.5f);
+      height[index] = std::lerp(height[index], level, shape * strength);
+   });
+}
+
+void paint_terrain(std::vector<u8>& blending, const TerrainBrush& brush, const float strength)
+{
+   for_each_brush_texel(g_size, brush, [&](const MemorySize index, const float dist) {
+      const float shape = std::sin(dist * triglav::MATH_PI * 0.5f);
+      const auto value = static_cast<float>(blending[index]) / 255.0f + strength * (1.0f - shape);
+      blending[index] = static_cast<u8>(std::clamp(value, 0.0f, 1.0f) * 255.0f);
+   });
+}
+
+}// namespace reference
+
+// Small brushes run on the calling thread, large ones are split across the thread pool.
+std::vector<TerrainBrush> test_brushes()
+{
+   return {
+      {{150, 100}, 5.0f}, {{150, 100}, 40.0f}, {{150, 100}, 95.5f}, {{0, 0}, 30.0f},     {{299, 199}, 70.0f},
+      {{-20, 50}, 35.0f}, {{150, 230}, 45.0f}, {{10, 190}, 12.3f},  {{150, 100}, 400.0f}, {{-500, -500}, 10.0f},
+   };
+}
+
+std::vector<float> random_height(const unsigned seed)
+{
+   std::mt19937 rng(seed);
+   std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+   std::vector<float> result(static_cast<MemorySize>(g_size.x) * g_size.y);
+   std::ranges::generate(result, [&] { return dist(rng); });
+   return result;
+}
+
+}// namespace
+
+TEST(TerrainBrushTest, ShiftMatchesReference)
+{
+   auto expected = random_height(1);
+   auto actual = expected;
+
+   for (const auto& brush : test_brushes()) {
+      reference::shift_terrain(expected, brush, 0.37f);
+      triglav::renderer::shift_terrain(actual, g_size, brush, 0.37f);
+      ASSERT_EQ(actual, expected);
+   }
+}
+
+TEST(TerrainBrushTest, LevelMatchesReference)
+{
+   auto expected = random_height(2);
+   auto actual = expected;
+
+   for (const auto& brush : test_brushes()) {
+      reference::level_terrain(expected, brush, 0.25f, 0.6f);
+      triglav::renderer::level_terrain(actual, g_size, brush, 0.25f, 0.6f);
+      ASSERT_EQ(actual, expected);
+   }
+}
+
+TEST(TerrainBrushTest, SmoothMatchesReference)
+{
+   auto expected = random_height(3);
+   auto actual = expected;
+
+   for (const auto& brush : test_brushes()) {
+      const auto average = triglav::renderer::sample_terrain_average(expected, g_size, brush);
+      reference::level_terrain(expected, brush, average, 0.3f);
+      triglav::renderer::smooth_terrain(actual, g_size, brush, 0.3f);
+      ASSERT_EQ(actual, expected);
+   }
+}
+
+TEST(TerrainBrushTest, PaintMatchesReference)
+{
+   std::vector<u8> expected(static_cast<MemorySize>(g_size.x) * g_size.y);
+   std::mt19937 rng(4);
+   std::ranges::generate(expected, [&] { return static_cast<u8>(rng()); });
+   auto actual = expected;
+
+   for (const auto& brush : test_brushes()) {
+      reference::paint_terrain(expected, brush, 0.2f);
+      triglav::renderer::paint_terrain(actual, g_size, brush, 0.2f);
+      ASSERT_EQ(actual, expected);
+   }
+}
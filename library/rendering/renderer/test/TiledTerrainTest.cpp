@@ -0,0 +1,183 @@
+#include "triglav/testing_core/GTest.hpp"
+
+#include "triglav/renderer/Camera.hpp"
+#include "triglav/renderer/TiledTerrain.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <numbers>
+#include <set>
+
+using triglav::i32;
+using triglav::Vector2;
+using triglav::Vector2i;
+using triglav::Vector3;
+using triglav::geometry::Ray;
+using triglav::renderer::Camera;
+using triglav::renderer::DirtyRegion;
+using triglav::renderer::TerrainPatchVertex;
+using triglav::renderer::TiledTerrain;
+
+namespace {
+
+Camera make_camera(const Vector3 position)
+{
+   Camera camera;
+   camera.set_viewport_size(800, 600);
+   camera.set_position(position);
+   return camera;
+}
+
+// Points produced by tessellating the edge, as the hull shader would with integer partitioning.
+// The factor only depends on the anchor so that any function of it must keep the edges matching.
+void tessellate_edge(const TerrainPatchVertex& from, const TerrainPatchVertex& to, std::set<std::pair<i32, i32>>& out_points)
+{
+   const auto level = 1 + static_cast<i32>(std::abs(from.edge.x * 7.0f + from.edge.y * 13.0f)) % 3;
+   const auto factor = level * static_cast<i32>(from.edge.z);
+   for (i32 i = 0; i <= factor; ++i) {
+      const auto point = Vector2{from.position} + (Vector2{to.position} - Vector2{from.position}) * (static_cast<float>(i) / factor);
+      out_points.emplace(static_cast<i32>(std::round(point.x * 100.0f)), static_cast<i32>(std::round(point.y * 100.0f)));
+   }
+}
+
+}// namespace
+
+TEST(TiledTerrainTest, WindowFollowsCamera)
+{
+   TiledTerrain terrain;
+   const auto resolution = terrain.properties().tile_resolution;
+
+   auto camera = make_camera({0, 0, 10});
+   terrain.update(camera);
+   ASSERT_EQ(terrain.window_origin(), (Vector2i{-2 * resolution, -2 * resolution}));
+   ASSERT_TRUE(std::ranges::all_of(terrain.tiles(), [](const auto& tile) { return tile.is_loaded; }));
+   terrain.clear_changes();
+
+   // Moving within the central tiles keeps the window.
+   camera.set_position({-50, 50, 10});
+   terrain.update(camera);
+   ASSERT_EQ(terrain.window_origin(), (Vector2i{-2 * resolution, -2 * resolution}));
+   ASSERT_TRUE(terrain.height_changes().empty());
+
+   camera.set_position({130, 10, 10});
+   terrain.update(camera);
+   ASSERT_EQ(terrain.window_origin(), (Vector2i{0, -2 * resolution}));
+   ASSERT_TRUE(terrain.has_tile_changes());
+   ASSERT_EQ(terrain.height_changes().size(), 1);
+   ASSERT_EQ(terrain.tiles().front().coord, (Vector2i{0, -2}));
+}
+
+TEST(TiledTerrainTest, EditsMoveWithTheWindow)
+{
+   TiledTerrain terrain;
+   const auto resolution = terrain.properties().tile_resolution;
+
+   auto camera = make_camera({0, 0, 10});
+   terrain.update(camera);
+
+   const Vector2i texel{10, 20};
+   const auto window_texel = texel - terrain.window_origin();
+   terrain.height()[window_texel.y * terrain.window_size().x + window_texel.x] = 0.5f;
+   terrain.mark_height_dirty(DirtyRegion{window_texel, window_texel + Vector2i{1, 1}});
+
+   camera.set_position({70, 10, 10});
+   terrain.update(camera);
+   ASSERT_EQ(terrain.window_origin(), (Vector2i{-resolution, -2 * resolution}));
+   ASSERT_FLOAT_EQ(terrain.sample_height(texel).value_or(0.0f), 0.5f);
+   ASSERT_FALSE(terrain.sample_height(Vector2i{-2 * resolution, 0}).has_value());
+}
+
+TEST(TiledTerrainTest, EditsOfUnloadedTilesSurviveLoading)
+{
+   TiledTerrain terrain;
+
+   // No tile is streamed in before the first update.
+   const Vector2i texel{10, 20};
+   const auto window_texel = texel - terrain.window_origin();
+   terrain.height()[window_texel.y * terrain.window_size().x + window_texel.x] = 0.5f;
+   terrain.mark_height_dirty(DirtyRegion{window_texel, window_texel + Vector2i{1, 1}});
+   ASSERT_FALSE(terrain.sample_height(texel).has_value());
+
+   terrain.update(make_camera({0, 0, 10}));
+   ASSERT_FLOAT_EQ(terrain.sample_height(texel).value_or(0.0f), 0.5f);
+   ASSERT_FLOAT_EQ(terrain.sample_height(texel + Vector2i{1, 0}).value_or(1.0f), 0.0f);
+
+   const auto modified_count = std::ranges::count_if(terrain.tiles(), [](const auto& tile) { return tile.is_modified; });
+   ASSERT_EQ(modified_count, 1);
+}
+
+TEST(TiledTerrainTest, PatchEdgesMatchBetweenTiles)
+{
+   TiledTerrain terrain;
+   const auto tile_size = terrain.properties().tile_world_size;
+
+   // Looks down from above so that the whole window is visible.
+   auto camera = make_camera({-40, -40, 400});
+   camera.rotate(-0.5f * std::numbers::pi_v<float>, 0.0f);
+   terrain.update(camera);
+   ASSERT_TRUE(std::ranges::all_of(terrain.tiles(), [](const auto& tile) { return tile.is_visible; }));
+
+   std::set<triglav::u32> lods;
+   for (const auto& tile : terrain.tiles()) {
+      lods.emplace(tile.lod);
+   }
+   ASSERT_GT(lods.size(), 1);
+
+   const auto vertices = terrain.build_patches();
+   ASSERT_EQ(vertices.size() % 4, 0);
+   ASSERT_LE(vertices.size(), terrain.max_patch_vertex_count());
+
+   std::map<std::pair<i32, i32>, std::set<std::pair<i32, i32>>> tile_points;
+   for (std::size_t patch = 0; patch < vertices.size(); patch += 4) {
+      const auto center = 0.25f * Vector2{vertices[patch].position + vertices[patch + 1].position + vertices[patch + 2].position +
+                                          vertices[patch + 3].position};
+      auto& points = tile_points[{static_cast<i32>(std::floor(center.x / tile_size)), static_cast<i32>(std::floor(center.y / tile_size))}];
+      for (std::size_t i = 0; i < 4; ++i) {
+         tessellate_edge(vertices[patch + i], vertices[patch + (i + 1) % 4], points);
+      }
+   }
+
+   // Every point a tile produces on the border of a neighbour must be produced by the neighbour as well.
+   for (const auto& [coord, points] : tile_points) {
+      for (const auto& [neighbour_coord, neighbour_points] : tile_points) {
+         if (std::abs(coord.first - neighbour_coord.first) + std::abs(coord.second - neighbour_coord.second) != 1)
+            continue;
+
+         const auto min_x = static_cast<i32>(std::round(neighbour_coord.first * tile_size * 100.0f));
+         const auto min_y = static_cast<i32>(std::round(neighbour_coord.second * tile_size * 100.0f));
+         const auto max_x = static_cast<i32>(std::round((neighbour_coord.first + 1) * tile_size * 100.0f));
+         const auto max_y = static_cast<i32>(std::round((neighbour_coord.second + 1) * tile_size * 100.0f));
+         for (const auto& point : points) {
+            if (point.first >= min_x && point.first <= max_x && point.second >= min_y && point.second <= max_y) {
+               ASSERT_TRUE(neighbour_points.contains(point));
+            }
+         }
+      }
+   }
+}
+
+TEST(TiledTerrainTest, RayHitsRaisedTerrain)
+{
+   TiledTerrain terrain;
+   terrain.update(make_camera({0, 0, 10}));
+
+   const auto size = terrain.window_size();
+   const auto origin = terrain.window_origin();
+   for (i32 y = 0; y < 16; ++y) {
+      for (i32 x = 0; x < 16; ++x) {
+         terrain.height()[(y - origin.y) * size.x + (x - origin.x)] = 0.5f;
+      }
+   }
+   terrain.mark_height_dirty(DirtyRegion{-origin, -origin + Vector2i{16, 16}});
+   terrain.update(make_camera({0, 0, 10}));
+
+   const auto raised_texel = Vector3{8, 8, 0} * terrain.texel_world_size();
+   const auto hit = terrain.trace_ray(Ray{raised_texel + Vector3{0, 0, 50}, Vector3{0, 0, -1}, 100.0f});
+   ASSERT_TRUE(hit.has_value());
+   ASSERT_NEAR(hit->z, 0.5f * terrain.properties().height_scale, 0.1f);
+
+   const auto flat_hit = terrain.trace_ray(Ray{Vector3{-20, -20, 50}, Vector3{0, 0, -1}, 100.0f});
+   ASSERT_TRUE(flat_hit.has_value());
+   ASSERT_NEAR(flat_hit->z, 0.0f, 0.1f);
+}
@@ -0,0 +1,287 @@
+#include "triglav/Format.hpp"
+#include "triglav/desktop/Entrypoint.hpp"
+#include "triglav/desktop/IDisplay.hpp"
+#include "triglav/desktop_ui/DesktopUI.hpp"
+#include "triglav/desktop_ui/MenuList.hpp"
+#include "triglav/desktop_ui/PopupManager.hpp"
+#include "triglav/desktop_ui/TreeView.hpp"
+#include "triglav/font/FontManager.hpp"
+#include "triglav/graphics_api/Instance.hpp"
+#include "triglav/io/CommandLine.hpp"
+#include "triglav/project/Name.hpp"
+#include "triglav/project/PathManager.hpp"
+#include "triglav/render_core/GlyphCache.hpp"
+#include "triglav/resource/ResourceManager.hpp"
+#include "triglav/threading/ThreadPool.hpp"
+#include "triglav/ui_core/Viewport.hpp"
+#include "triglav/ui_core/widget/EmptySpace.hpp"
+#include "triglav/ui_core/widget/GridLayout.hpp"
+#include "triglav/ui_core/widget/HorizontalLayout.hpp"
+#include "triglav/ui_core/widget/Image.hpp"
+#include "triglav/ui_core/widget/Padding.hpp"
+#include "triglav/ui_core/widget/RectBox.hpp"
+#include "triglav/ui_core/widget/ScrollBox.hpp"
+#include "triglav/ui_core/widget/TextBox.hpp"
+#include "triglav/ui_core/widget/VerticalLayout.hpp"
+
+#include <chrono>
+#include <print>
+#include <random>
+
+TG_PROJECT_NAME(triglav_desktop_ui_benchmark)
+
+using triglav::desktop::IDisplay;
+using triglav::desktop::InputArgs;
+using triglav::desktop::WindowAttribute;
+using triglav::desktop_ui::DesktopContext;
+using triglav::desktop_ui::MenuController;
+using triglav::desktop_ui::MenuList;
+using triglav::desktop_ui::PopupManager;
+using triglav::desktop_ui::ThemeProperties;
+using triglav::desktop_ui::TREE_ROOT;
+using triglav::desktop_ui::TreeController;
+using triglav::desktop_ui::TreeView;
+using triglav::io::CommandLine;
+using triglav::project::PathManager;
+using triglav::render_core::GlyphCache;
+using triglav::resource::ResourceManager;
+using triglav::ui_core::Event;
+
+using namespace triglav::name_literals;
+using namespace triglav::string_literals;
+
+TG_DEFINE_AWAITER(ResourceLoadedAwaiter, ResourceManager, OnLoadedAssets)
+
+namespace {
+
+constexpr auto g_default_item_count = 4000;
+constexpr auto g_default_iteration_count = 50;
+constexpr auto g_items_per_folder = 40;
+constexpr auto g_panel_section_count = 64;
+constexpr auto g_mouse_event_count = 10000;
+constexpr triglav::Vector4 g_window_rect{0, 0, 1920, 1080};
+
+class ScopedTimer
+{
+ public:
+   explicit ScopedTimer(std::chrono::nanoseconds& out) :
+       m_out(out),
+       m_start(std::chrono::steady_clock::now())
+   {
+   }
+
+   ~ScopedTimer()
+   {
+      m_out += std::chrono::steady_clock::now() - m_start;
+   }
+
+ private:
+   std::chrono::nanoseconds& m_out;
+   std::chrono::steady_clock::time_point m_start;
+};
+
+void report(const std::string_view name, const std::chrono::nanoseconds cold, const std::chrono::nanoseconds warm_total,
+            const int iterations)
+{
+   const auto to_us = [](const std::chrono::nanoseconds value) { return std::chrono::duration<double, std::micro>(value).count(); };
+   std::println("{:<12} cold: {:>10.1f} us, warm avg: {:>10.1f} us ({} iterations)", name, to_us(cold), to_us(warm_total / iterations),
+                iterations);
+}
+
+// Every widget is constructed anew so its own measure cache is cold, the glyph caches stay warm after the first run.
+template<typename TWidget, typename TState>
+void run_layout_benchmark(const std::string_view name, DesktopContext& context, const TState& state, const int iterations)
+{
+   std::chrono::nanoseconds cold{};
+   {
+      TWidget widget(context, state, nullptr);
+      ScopedTimer timer(cold);
+      [[maybe_unused]] const auto size = widget.desired_size({1920, 1080});
+   }
+
+   std::chrono::nanoseconds warm{};
+   for (int i = 0; i < iterations; ++i) {
+      TWidget widget(context, state, nullptr);
+      ScopedTimer timer(warm);
+      [[maybe_unused]] const auto size = widget.desired_size({1920, 1080});
+   }
+
+   report(name, cold, warm, iterations);
+}
+
+// Mirrors the structure of the level editor's side panel: a list of section headers and transform grids.
+void build_side_panel(triglav::ui_core::VerticalLayout& layout, const DesktopContext& context)
+{
+   for (int section = 0; section < g_panel_section_count; ++section) {
+      auto& header = layout.create_child<triglav::ui_core::VerticalLayout>({
+         .padding = {},
+         .separation = 8.0f,
+      });
+
+      auto& title = header.create_child<triglav::ui_core::HorizontalLayout>({
+         .padding = {},
+         .separation = 8.0f,
+      });
+      title.create_child<triglav::ui_core::Image>({
+         .texture = "engine/texture/ui_atlas.tex"_rc,
+         .max_size = triglav::Vector2{18, 18},
+         .region = triglav::Vector4{0, 0, 64, 64},
+      });
+      title.create_child<triglav::ui_core::TextBox>({
+         .font_size = 13,
+         .typeface = context.properties().base_typeface,
+         .content = triglav::format("Section {}", section),
+         .color = context.properties().foreground_color,
+         .horizontal_alignment = triglav::ui_core::HorizontalAlignment::Left,
+         .vertical_alignment = triglav::ui_core::VerticalAlignment::Center,
+      });
+      header.create_child<triglav::ui_core::EmptySpace>({
+         .size = {10.0f, 5.0f},
+      });
+
+      auto& grid = layout.create_child<triglav::ui_core::GridLayout>({
+         .column_ratios = {0.3f, 0.233f, 0.233f, 0.233f},
+         .row_ratios = {0.333f, 0.333f, 0.333f},
+         .horizontal_spacing = 5.0f,
+         .vertical_spacing = 5.0f,
+      });
+      for (int cell = 0; cell < 12; ++cell) {
+         grid.create_child<triglav::ui_core::TextBox>({
+            .font_size = context.properties().base_font_size,
+            .typeface = context.properties().base_typeface,
+            .content = cell % 4 == 0 ? "Translate" : "0.000",
+            .color = context.properties().foreground_color,
+            .horizontal_alignment = triglav::ui_core::HorizontalAlignment::Left,
+            .vertical_alignment = triglav::ui_core::VerticalAlignment::Center,
+         });
+      }
+   }
+}
+
+// Mirrors the structure of the editor's project explorer.
+void build_project_explorer(triglav::ui_core::VerticalLayout& layout, const DesktopContext& context, TreeView::State tree_state)
+{
+   layout.create_child<triglav::ui_core::Padding>({10, 10, 10, 10})
+      .create_content<triglav::ui_core::TextBox>({
+         .font_size = 13,
+         .typeface = context.properties().base_typeface,
+         .content = "PROJECT EXPLORER",
+         .color = {0.3, 0.3, 0.3, 1.0},
+         .horizontal_alignment = triglav::ui_core::HorizontalAlignment::Left,
+         .vertical_alignment = triglav::ui_core::VerticalAlignment::Top,
+      });
+
+   auto& scroll_rect = layout.create_child<triglav::ui_core::RectBox>({
+      .color = context.properties().background_color_darker,
+      .border_radius = {4, 4, 4, 4},
+      .border_color = triglav::palette::NO_COLOR,
+      .border_width = 0.0f,
+   });
+   scroll_rect.create_content<triglav::ui_core::ScrollBox>({}).create_content<TreeView>(std::move(tree_state));
+}
+
+// Dispatches mouse moves at random positions over the root widget, the way the window forwards them.
+void run_event_benchmark(const std::string_view name, triglav::ui_core::IWidget& root)
+{
+   root.add_to_viewport(g_window_rect, g_window_rect);
+
+   std::mt19937 generator{42};
+   std::uniform_real_distribution<float> x_distribution{0.0f, g_window_rect.z};
+   std::uniform_real_distribution<float> y_distribution{0.0f, g_window_rect.w};
+
+   std::chrono::nanoseconds total{};
+   for (int i = 0; i < g_mouse_event_count; ++i) {
+      Event event{};
+      event.event_type = Event::Type::MouseMoved;
+      event.widget_size = triglav::rect_size(g_window_rect);
+      event.mouse_position = {x_distribution(generator), y_distribution(generator)};
+      event.global_mouse_position = event.mouse_position;
+
+      ScopedTimer timer(total);
+      root.on_event(event);
+   }
+
+   const auto average_us = std::chrono::duration<double, std::micro>(total).count() / g_mouse_event_count;
+   std::println("{:<12} avg: {:>10.3f} us ({} events)", name, average_us, g_mouse_event_count);
+   root.remove_from_viewport();
+}
+
+}// namespace
+
+int triglav_main(InputArgs& args, IDisplay& display)
+{
+   CommandLine::the().parse(args.arg_count, args.args);
+
+   triglav::threading::ThreadPool::the().initialize(4);
+
+   const auto instance = GAPI_CHECK(triglav::graphics_api::Instance::create_instance(&display));
+   const auto device = GAPI_CHECK(instance.create_device(nullptr, triglav::graphics_api::DevicePickStrategy::PreferDedicated,
+                                                         triglav::graphics_api::DeviceFeature::None));
+
+   triglav::font::FontManger font_manager;
+   ResourceManager resource_manager(*device, font_manager);
+
+   ResourceLoadedAwaiter resource_awaiter(resource_manager);
+   resource_manager.load_asset_list(PathManager::the().translate_path("engine/index.yaml"_rc));
+   resource_awaiter.await();
+
+   GlyphCache glyph_cache(*device, resource_manager);
+   PopupManager popup_manager(instance, *device, glyph_cache, resource_manager);
+   triglav::ui_core::Viewport viewport({1920, 1080});
+   triglav::ui_core::Context core_context(viewport, glyph_cache, resource_manager);
+
+   const auto surface = display.create_surface("Desktop UI Benchmark"_strv, {32, 32}, WindowAttribute::Default);
+   DesktopContext context(core_context, ThemeProperties::get_default(), *surface, popup_manager);
+
+   const auto item_count = CommandLine::the().arg_int("itemCount"_name).value_or(g_default_item_count);
+   const auto iterations = CommandLine::the().arg_int("iterations"_name).value_or(g_default_iteration_count);
+
+   TreeController tree_controller;
+   TreeView::State tree_state{.controller = &tree_controller};
+   for (int folder = 0; folder < item_count / g_items_per_folder; ++folder) {
+      const auto folder_id = tree_controller.add_item(TREE_ROOT, {
+                                                                    .icon_name = "engine/texture/ui_atlas.tex"_rc,
+                                                                    .icon_region = {0, 0, 64, 64},
+                                                                    .label = triglav::format("folder_{}", folder),
+                                                                    .has_children = true,
+                                                                 });
+      tree_state.extended_items.insert(folder_id);
+      for (int item = 0; item < g_items_per_folder; ++item) {
+         tree_controller.add_item(folder_id, {
+                                                .icon_name = "engine/texture/ui_atlas.tex"_rc,
+                                                .icon_region = {0, 0, 64, 64},
+                                                .label = triglav::format("mesh/level_{}/object_{}.mesh", folder, item),
+                                                .has_children = false,
+                                             });
+      }
+   }
+
+   MenuController menu_controller;
+   for (int item = 0; item < item_count; ++item) {
+      if (item % 16 == 15) {
+         menu_controller.add_seperator();
+         continue;
+      }
+      const auto label = triglav::format("Recent File {}.level", item);
+      menu_controller.add_item(triglav::make_name_id(label.to_std_view()), label.view());
+   }
+
+   std::println("Laying out {} items", item_count);
+   run_layout_benchmark<TreeView>("TreeView", context, tree_state, iterations);
+   const MenuList::State menu_state{
+      .controller = &menu_controller,
+      .list_name = "root"_name,
+      .screen_offset = {},
+   };
+   run_layout_benchmark<MenuList>("MenuList", context, menu_state, iterations);
+
+   triglav::ui_core::HorizontalLayout panels(context, {.padding = {}, .separation = 4.0f}, nullptr);
+   build_side_panel(panels.create_child<triglav::ui_core::VerticalLayout>({.padding = {4, 4, 4, 4}, .separation = 4.0f}), context);
+   build_project_explorer(panels.create_child<triglav::ui_core::VerticalLayout>({.padding = {4, 4, 4, 4}, .separation = 4.0f}), context,
+                          tree_state);
+   run_event_benchmark("MouseMoved", panels);
+
+   triglav::threading::ThreadPool::the().quit();
+
+   return 0;
+}
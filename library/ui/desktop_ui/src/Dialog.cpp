@@ -58,10 +58,11 @@ void Dialog::initialize()
 
    m_job_graph.add_dependency_to_previous_frame("update_ui"_name, "update_ui"_name);
 
-   renderer::RenderSurface::add_present_jobs(m_job_graph, "render_dialog"_name);
+   m_render_surface.add_present_jobs(m_job_graph, "render_dialog"_name);
 
    m_job_graph.add_dependency("render_dialog"_name, "update_ui"_name);
 
+   m_job_graph.set_submission_mode(render_core::SubmissionMode::Batched);
    m_job_graph.build_jobs("render_dialog"_name);
 
    m_render_surface.recreate_present_jobs();
@@ -76,10 +77,9 @@ void Dialog::uninitialize() const
 
 void Dialog::build_rendering_job(render_core::BuildContext& ctx)
 {
-   ctx.declare_render_target("core.color_out"_name, GAPI_FORMAT(BGRA, sRGB));
+   m_render_surface.declare_output_target(ctx);
    m_widget_renderer.create_render_job(ctx, "core.color_out"_name);
-   ctx.export_texture("core.color_out"_name, graphics_api::PipelineStage::Transfer, graphics_api::TextureState::TransferSrc,
-                      graphics_api::TextureUsage::TransferSrc);
+   m_render_surface.export_output_target(ctx);
 }
 
 void Dialog::update()
@@ -101,7 +101,8 @@ void Dialog::update()
 
    m_widget_renderer.prepare_resources(m_job_graph, m_frame_index);
 
-   m_job_graph.execute("render_dialog"_name, m_frame_index, nullptr);
+   m_render_surface.acquire_image(m_job_graph, m_frame_index);
+   m_job_graph.execute("render_dialog"_name, m_frame_index, m_render_surface.job_fence(m_frame_index));
 
    m_render_surface.present(m_job_graph, m_frame_index);
 
@@ -117,6 +118,9 @@ void Dialog::on_resize(const Vector2i size)
 {
    m_device.await_all();
 
+   // The swapchain images are recreated first as the rendering job may render to them directly.
+   m_render_surface.recreate_swapchain(size);
+
    m_job_graph.set_screen_size(size);
    m_widget_renderer.ui_viewport().set_dimensions(size);
 
@@ -128,7 +132,6 @@ void Dialog::on_resize(const Vector2i size)
    this->build_rendering_job(render_ctx);
    m_job_graph.rebuild_job("render_dialog"_name);
 
-   m_render_surface.recreate_swapchain(size);
    m_widget_renderer.add_widget_to_viewport(size);
 };
 
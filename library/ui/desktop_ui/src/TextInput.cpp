@@ -1,6 +1,7 @@
 #include "TextInput.hpp"
 
 #include "triglav/desktop/ISurface.hpp"
+#include "triglav/font/Charset.hpp"
 #include "triglav/render_core/GlyphCache.hpp"
 #include "triglav/threading/Scheduler.hpp"
 #include "triglav/ui_core/Context.hpp"
@@ -6,6 +6,7 @@
 #include "triglav/desktop/Desktop.hpp"
 
 #include <memory>
+#include <optional>
 #include <type_traits>
 #include <variant>
 #include <vector>
@@ -210,6 +211,7 @@ class LayoutWidget : public BaseWidget
    LayoutWidget(Context& context, IWidget* parent);
 
    IWidget& add_child(IWidgetPtr&& widget);
+   void on_child_state_changed(IWidget& widget) override;
 
    template<typename TChild, typename... TArgs>
    TChild& emplace_child(TArgs&&... args)
@@ -224,8 +226,30 @@ class LayoutWidget : public BaseWidget
    }
 
  protected:
+   // Placement of a child along the layout's main axis, relative to the layout.
+   struct ChildSlot
+   {
+      float begin;
+      float end;
+      Vector2 size;
+   };
+
+   // Returns the desired size measured previously for the same available size.
+   [[nodiscard]] std::optional<Vector2> cached_desired_size(Vector2 available_size) const;
+   void store_desired_size(Vector2 available_size, Vector2 desired_size) const;
+   void invalidate_layout();
+
+   // Binary search of the child slot containing the position.
+   [[nodiscard]] std::optional<MemorySize> find_child_slot(float position) const;
+
    Context& m_context;
    std::vector<IWidgetPtr> m_children;
+   std::vector<ChildSlot> m_child_slots;
+   std::optional<Vector2> m_child_slots_size;
+
+ private:
+   mutable std::optional<Vector2> m_cached_desired_size;
+   mutable Vector2 m_cached_available_size{};
 };
 
 class ProxyWidget : public ContainerWidget
@@ -30,10 +30,19 @@ class GridLayout final : public LayoutWidget
    void on_event(const Event& event) override;
 
  private:
+   struct Span
+   {
+      float begin;
+      float end;
+   };
+
    std::optional<MemorySize> find_active_child() const;
+   void update_spans();
 
    State m_state;
    Vector4 m_dimensions;
+   std::vector<Span> m_column_spans;
+   std::vector<Span> m_row_spans;
    u32 m_last_row = 0;
    u32 m_last_col = 0;
 };
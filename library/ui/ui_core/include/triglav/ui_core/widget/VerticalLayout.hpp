@@ -24,10 +24,10 @@ class VerticalLayout : public LayoutWidget
    [[nodiscard]] Vector2 desired_size(Vector2 available_size) const override;
    void add_to_viewport(Vector4 dimensions, Vector4 cropping_mask) override;
    void remove_from_viewport() override;
-   void on_child_state_changed(IWidget& widget) override;
    void on_event(const Event& event) override;
 
  private:
+   void update_child_slots(Vector2 size);
    void handle_mouse_leave(const Event& event, IWidget* widget);
 
    State m_state;
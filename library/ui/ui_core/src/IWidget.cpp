@@ -1,5 +1,7 @@
 #include "IWidget.hpp"
 
+#include <algorithm>
+
 namespace triglav::ui_core {
 
 BaseWidget::BaseWidget(IWidget* parent) :
@@ -40,9 +42,53 @@ LayoutWidget::LayoutWidget(Context& context, IWidget* parent) :
 
 IWidget& LayoutWidget::add_child(IWidgetPtr&& widget)
 {
+   this->invalidate_layout();
    return *m_children.emplace_back(std::move(widget));
 }
 
+void LayoutWidget::on_child_state_changed(IWidget& widget)
+{
+   this->invalidate_layout();
+   if (m_parent != nullptr) {
+      m_parent->on_child_state_changed(widget);
+   }
+}
+
+std::optional<Vector2> LayoutWidget::cached_desired_size(const Vector2 available_size) const
+{
+   if (m_cached_desired_size.has_value() && m_cached_available_size == available_size) {
+      return m_cached_desired_size;
+   }
+   return std::nullopt;
+}
+
+void LayoutWidget::store_desired_size(const Vector2 available_size, const Vector2 desired_size) const
+{
+   m_cached_available_size = available_size;
+   m_cached_desired_size.emplace(desired_size);
+}
+
+void LayoutWidget::invalidate_layout()
+{
+   m_cached_desired_size.reset();
+   m_child_slots_size.reset();
+   m_child_slots.clear();
+}
+
+std::optional<MemorySize> LayoutWidget::find_child_slot(const float position) const
+{
+   const auto it = std::ranges::upper_bound(m_child_slots, position, {}, &ChildSlot::begin);
+   if (it == m_child_slots.begin()) {
+      return std::nullopt;
+   }
+
+   const auto slot = std::prev(it);
+   if (position >= slot->end) {
+      return std::nullopt;
+   }
+   return std::distance(m_child_slots.begin(), slot);
+}
+
 ProxyWidget::ProxyWidget(Context& context, IWidget* parent) :
     ContainerWidget(context, parent)
 {
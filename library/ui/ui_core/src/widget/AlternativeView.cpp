@@ -57,6 +57,10 @@ void AlternativeView::set_visible_widget(const u32 index)
    if (m_is_added_to_viewport) {
       this->add_to_viewport(m_dimensions, m_cropping_mask);
    }
+
+   if (m_parent != nullptr) {
+      m_parent->on_child_state_changed(*this);
+   }
 }
 
 }// namespace triglav::ui_core
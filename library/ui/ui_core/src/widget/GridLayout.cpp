@@ -2,8 +2,40 @@
 
 #include "Context.hpp"
 
+#include <algorithm>
+
 namespace triglav::ui_core {
 
+namespace {
+
+template<typename TSpan>
+std::vector<TSpan> calculate_spans(const std::vector<float>& ratios, const float base_size, const float spacing)
+{
+   std::vector<TSpan> result;
+   result.reserve(ratios.size());
+
+   float offset = 0.0f;
+   for (const auto ratio : ratios) {
+      const float size = ratio * base_size;
+      result.push_back({offset, offset + size});
+      offset += size + spacing;
+   }
+   return result;
+}
+
+// Returns the number of spans if the position is outside all of them.
+template<typename TSpan>
+u32 find_span(const std::vector<TSpan>& spans, const float position)
+{
+   const auto it = std::ranges::upper_bound(spans, position, {}, &TSpan::begin);
+   if (it == spans.begin() || position >= std::prev(it)->end) {
+      return static_cast<u32>(spans.size());
+   }
+   return static_cast<u32>(std::distance(spans.begin(), it) - 1);
+}
+
+}// namespace
+
 GridLayout::GridLayout(Context& context, State state, IWidget* parent) :
     LayoutWidget(context, parent),
     m_state(std::move(state))
@@ -12,6 +44,10 @@ GridLayout::GridLayout(Context& context, State state, IWidget* parent) :
 
 Vector2 GridLayout::desired_size(const Vector2 available_size) const
 {
+   if (const auto cached_size = this->cached_desired_size(available_size); cached_size.has_value()) {
+      return *cached_size;
+   }
+
    const auto row_count = m_state.row_ratios.size();
    const auto column_count = m_state.column_ratios.size();
    assert(m_children.size() == row_count * column_count);
@@ -34,12 +70,15 @@ Vector2 GridLayout::desired_size(const Vector2 available_size) const
       result.y += max_height + m_state.vertical_spacing;
    }
 
-   return result - Vector2{m_state.horizontal_spacing, m_state.vertical_spacing};
+   result -= Vector2{m_state.horizontal_spacing, m_state.vertical_spacing};
+   this->store_desired_size(available_size, result);
+   return result;
 }
 
 void GridLayout::add_to_viewport(const Vector4 dimensions, const Vector4 cropping_mask)
 {
    m_dimensions = dimensions;
+   this->update_spans();
 
    const auto row_count = m_state.row_ratios.size();
    const auto column_count = m_state.column_ratios.size();
@@ -83,32 +122,12 @@ void GridLayout::on_event(const Event& event)
       return;
    }
 
-   const auto row_count = m_state.row_ratios.size();
    const auto column_count = m_state.column_ratios.size();
 
-   const Vector2 base_size = rect_size(m_dimensions) - Vector2{static_cast<float>(column_count - 1) * m_state.horizontal_spacing,
-                                                               static_cast<float>(row_count - 1) * m_state.vertical_spacing};
-
-   u32 row = 0, col = 0;
-   float x_offset = 0.0f;
-   for (const auto& ratio : m_state.column_ratios) {
-      const float width = ratio * base_size.x;
-      if (event.mouse_position.x >= x_offset && event.mouse_position.x < (x_offset + width)) {
-         break;
-      }
-      x_offset += width + m_state.horizontal_spacing;
-      ++col;
-   }
-
-   float y_offset = 0.0f;
-   for (const auto& ratio : m_state.row_ratios) {
-      const float height = ratio * base_size.y;
-      if (event.mouse_position.y >= y_offset && event.mouse_position.y < (y_offset + height)) {
-         break;
-      }
-      y_offset += height + m_state.vertical_spacing;
-      ++row;
-   }
+   const u32 col = find_span(m_column_spans, event.mouse_position.x);
+   const u32 row = find_span(m_row_spans, event.mouse_position.y);
+   const float x_offset = col < m_column_spans.size() ? m_column_spans[col].begin : 0.0f;
+   const float y_offset = row < m_row_spans.size() ? m_row_spans[row].begin : 0.0f;
 
    if (m_last_col != col || m_last_row != row) {
       Event leave_event{};
@@ -146,6 +165,18 @@ void GridLayout::on_event(const Event& event)
    }
 }
 
+void GridLayout::update_spans()
+{
+   const auto row_count = m_state.row_ratios.size();
+   const auto column_count = m_state.column_ratios.size();
+
+   const Vector2 base_size = rect_size(m_dimensions) - Vector2{static_cast<float>(column_count - 1) * m_state.horizontal_spacing,
+                                                               static_cast<float>(row_count - 1) * m_state.vertical_spacing};
+
+   m_column_spans = calculate_spans<Span>(m_state.column_ratios, base_size.x, m_state.horizontal_spacing);
+   m_row_spans = calculate_spans<Span>(m_state.row_ratios, base_size.y, m_state.vertical_spacing);
+}
+
 std::optional<MemorySize> GridLayout::find_active_child() const
 {
    MemorySize index = 0;
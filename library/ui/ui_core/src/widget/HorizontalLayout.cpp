@@ -10,9 +10,14 @@ HorizontalLayout::HorizontalLayout(Context& context, State state, IWidget* paren
 
 Vector2 HorizontalLayout::desired_size(const Vector2 available_size) const
 {
+   if (const auto cached_size = this->cached_desired_size(available_size); cached_size.has_value()) {
+      return *cached_size;
+   }
+
    const Vector2 min_size{m_state.padding.x + m_state.padding.z, m_state.padding.y + m_state.padding.w};
 
    if (m_children.empty()) {
+      this->store_desired_size(available_size, min_size);
       return min_size;
    }
 
@@ -35,6 +40,7 @@ Vector2 HorizontalLayout::desired_size(const Vector2 available_size) const
       inner_size.x -= child_desired_size.x;
    }
 
+   this->store_desired_size(available_size, min_size + result);
    return min_size + result;
 }
 
@@ -57,18 +63,13 @@ float initial_position(const HorizontalAlignment alignment, const float containe
 
 void HorizontalLayout::add_to_viewport(const Vector4 dimensions, const Vector4 cropping_mask)
 {
-   const Vector4 inner_dimensions{dimensions.x + m_state.padding.x, dimensions.y + m_state.padding.y,
-                                  dimensions.z - m_state.padding.x - m_state.padding.z,
-                                  dimensions.w - m_state.padding.y - m_state.padding.w};
+   this->update_child_slots(rect_size(dimensions));
 
-   const auto content_size = this->desired_size(dimensions);
-   float width = inner_dimensions.z;
-   float x = initial_position(m_state.gravity, width, content_size.x);
-   for (const auto& child : m_children) {
-      const auto size = child->desired_size({width, dimensions.w});
-      child->add_to_viewport({inner_dimensions.x + x, inner_dimensions.y, size.x, inner_dimensions.w}, cropping_mask);
-      x += size.x + m_state.separation;
-      width -= size.x + m_state.separation;
+   const float inner_height = dimensions.w - m_state.padding.y - m_state.padding.w;
+   for (MemorySize i = 0; i < m_children.size(); ++i) {
+      const auto& slot = m_child_slots[i];
+      m_children[i]->add_to_viewport({dimensions.x + slot.begin, dimensions.y + m_state.padding.y, slot.size.x, inner_height},
+                                     cropping_mask);
    }
 }
 
@@ -79,13 +80,6 @@ void HorizontalLayout::remove_from_viewport()
    }
 }
 
-void HorizontalLayout::on_child_state_changed(IWidget& widget)
-{
-   if (m_parent != nullptr) {
-      m_parent->on_child_state_changed(widget);
-   }
-}
-
 void HorizontalLayout::on_event(const Event& event)
 {
    if (event.event_type == Event::Type::MouseLeft) {
@@ -95,25 +89,21 @@ void HorizontalLayout::on_event(const Event& event)
       return;
    }
 
-   float width = event.widget_size.x;
-   float x{m_state.padding.x};
+   this->update_child_slots(event.widget_size);
 
-   for (const auto& child : m_children) {
-      const auto size = child->desired_size({width, event.widget_size.y});
-      if (event.mouse_position.x >= x && event.mouse_position.x < (x + size.x)) {
-         Event sub_event{event};
-         sub_event.widget_size = size;
-         sub_event.mouse_position -= Vector2{x, m_state.padding.y};
-         child->on_event(sub_event);
-
-         if (event.event_type == Event::Type::MouseMoved) {
-            this->handle_mouse_leave(sub_event, child.get());
-         }
-         return;
-      }
+   if (const auto index = this->find_child_slot(event.mouse_position.x); index.has_value()) {
+      const auto& slot = m_child_slots[*index];
+      auto& child = *m_children[*index];
 
-      x += size.x + m_state.separation;
-      width -= size.x + m_state.separation;
+      Event sub_event{event};
+      sub_event.widget_size = slot.size;
+      sub_event.mouse_position -= Vector2{slot.begin, m_state.padding.y};
+      child.on_event(sub_event);
+
+      if (event.event_type == Event::Type::MouseMoved) {
+         this->handle_mouse_leave(sub_event, &child);
+      }
+      return;
    }
 
    if (event.event_type == Event::Type::MouseMoved && m_last_active_widget != nullptr) {
@@ -124,6 +114,28 @@ void HorizontalLayout::on_event(const Event& event)
    }
 }
 
+void HorizontalLayout::update_child_slots(const Vector2 size)
+{
+   if (m_child_slots_size.has_value() && *m_child_slots_size == size) {
+      return;
+   }
+
+   m_child_slots.clear();
+   m_child_slots.reserve(m_children.size());
+
+   const auto content_size = this->desired_size(size);
+   float width = size.x - m_state.padding.x - m_state.padding.z;
+   float x = m_state.padding.x + initial_position(m_state.gravity, width, content_size.x);
+   for (const auto& child : m_children) {
+      const auto child_size = child->desired_size({width, size.y});
+      m_child_slots.push_back({x, x + child_size.x, child_size});
+      x += child_size.x + m_state.separation;
+      width -= child_size.x + m_state.separation;
+   }
+
+   m_child_slots_size.emplace(size);
+}
+
 void HorizontalLayout::handle_mouse_leave(const Event& event, IWidget* widget)
 {
    // FIXME: Leave events have invalid position
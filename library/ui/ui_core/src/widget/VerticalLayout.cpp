@@ -10,9 +10,14 @@ VerticalLayout::VerticalLayout(Context& context, State state, IWidget* parent) :
 
 Vector2 VerticalLayout::desired_size(const Vector2 available_size) const
 {
+   if (const auto cached_size = this->cached_desired_size(available_size); cached_size.has_value()) {
+      return *cached_size;
+   }
+
    const Vector2 min_size{m_state.padding.x + m_state.padding.z, m_state.padding.y + m_state.padding.w};
 
    if (m_children.empty()) {
+      this->store_desired_size(available_size, min_size);
       return min_size;
    }
 
@@ -35,22 +40,19 @@ Vector2 VerticalLayout::desired_size(const Vector2 available_size) const
       inner_size.y -= child_desired_size.y;
    }
 
+   this->store_desired_size(available_size, min_size + result);
    return min_size + result;
 }
 
 void VerticalLayout::add_to_viewport(const Vector4 dimensions, const Vector4 cropping_mask)
 {
-   const Vector4 inner_dimensions{dimensions.x + m_state.padding.x, dimensions.y + m_state.padding.y,
-                                  dimensions.z - m_state.padding.x - m_state.padding.z,
-                                  dimensions.w - m_state.padding.y - m_state.padding.w};
+   this->update_child_slots(rect_size(dimensions));
 
-   float height = inner_dimensions.w;
-   float y{0.0f};
-   for (const auto& child : m_children) {
-      const auto size = child->desired_size({dimensions.z, height});
-      child->add_to_viewport({inner_dimensions.x, inner_dimensions.y + y, inner_dimensions.z, size.y}, cropping_mask);
-      y += size.y + m_state.separation;
-      height -= size.y + m_state.separation;
+   const float inner_width = dimensions.z - m_state.padding.x - m_state.padding.z;
+   for (MemorySize i = 0; i < m_children.size(); ++i) {
+      const auto& slot = m_child_slots[i];
+      m_children[i]->add_to_viewport({dimensions.x + m_state.padding.x, dimensions.y + slot.begin, inner_width, slot.size.y},
+                                     cropping_mask);
    }
 }
 
@@ -61,13 +63,6 @@ void VerticalLayout::remove_from_viewport()
    }
 }
 
-void VerticalLayout::on_child_state_changed(IWidget& widget)
-{
-   if (m_parent != nullptr) {
-      m_parent->on_child_state_changed(widget);
-   }
-}
-
 void VerticalLayout::on_event(const Event& event)
 {
    if (event.event_type == Event::Type::MouseLeft) {
@@ -77,25 +72,21 @@ void VerticalLayout::on_event(const Event& event)
       return;
    }
 
-   float height = event.widget_size.y;
-   float y{m_state.padding.y};
+   this->update_child_slots(event.widget_size);
 
-   for (const auto& child : m_children) {
-      const auto size = child->desired_size({event.widget_size.x, height});
-      if (event.mouse_position.y >= y && event.mouse_position.y < (y + size.y)) {
-         Event sub_event{event};
-         sub_event.widget_size = size;
-         sub_event.mouse_position -= Vector2{m_state.padding.x, y};
-         child->on_event(sub_event);
-
-         if (event.event_type == Event::Type::MouseMoved) {
-            this->handle_mouse_leave(sub_event, child.get());
-         }
-         return;
-      }
+   if (const auto index = this->find_child_slot(event.mouse_position.y); index.has_value()) {
+      const auto& slot = m_child_slots[*index];
+      auto& child = *m_children[*index];
+
+      Event sub_event{event};
+      sub_event.widget_size = slot.size;
+      sub_event.mouse_position -= Vector2{m_state.padding.x, slot.begin};
+      child.on_event(sub_event);
 
-      y += size.y + m_state.separation;
-      height -= size.y + m_state.separation;
+      if (event.event_type == Event::Type::MouseMoved) {
+         this->handle_mouse_leave(sub_event, &child);
+      }
+      return;
    }
 
    if (event.event_type == Event::Type::MouseMoved && m_last_active_widget != nullptr) {
@@ -107,6 +98,27 @@ void VerticalLayout::on_event(const Event& event)
    }
 }
 
+void VerticalLayout::update_child_slots(const Vector2 size)
+{
+   if (m_child_slots_size.has_value() && *m_child_slots_size == size) {
+      return;
+   }
+
+   m_child_slots.clear();
+   m_child_slots.reserve(m_children.size());
+
+   float height = size.y - m_state.padding.y - m_state.padding.w;
+   float y{m_state.padding.y};
+   for (const auto& child : m_children) {
+      const auto child_size = child->desired_size({size.x, height});
+      m_child_slots.push_back({y, y + child_size.y, child_size});
+      y += child_size.y + m_state.separation;
+      height -= child_size.y + m_state.separation;
+   }
+
+   m_child_slots_size.emplace(size);
+}
+
 void VerticalLayout::handle_mouse_leave(const Event& event, IWidget* widget)
 {
    // FIXME: Leave events have invalid position
@@ -58,7 +58,7 @@ void RootWindow::initialize()
    m_job_graph.add_dependency("render_dialog"_name, "render_viewport"_name);
    m_job_graph.add_dependency("render_dialog"_name, "update_ui"_name);
 
-   renderer::RenderSurface::add_present_jobs(m_job_graph, "render_dialog"_name);
+   m_render_surface.add_present_jobs(m_job_graph, "render_dialog"_name);
 
    m_job_graph.build_jobs("render_dialog"_name);
 
@@ -74,14 +74,13 @@ void RootWindow::uninitialize() const
 
 void RootWindow::build_rendering_job(render_core::BuildContext& ctx)
 {
-   ctx.declare_render_target("core.color_out"_name, GAPI_FORMAT(BGRA, sRGB));
+   m_render_surface.declare_output_target(ctx);
    m_widget_renderer.create_render_job(ctx, "core.color_out"_name);
 
    ctx.copy_texture_region("render_viewport.out"_external, {0, 0}, "core.color_out"_name,
                            rect_position(this->render_overlay().dimensions()), rect_size(this->render_overlay().dimensions()));
 
-   ctx.export_texture("core.color_out"_name, graphics_api::PipelineStage::Transfer, graphics_api::TextureState::TransferSrc,
-                      graphics_api::TextureUsage::TransferSrc);
+   m_render_surface.export_output_target(ctx);
 }
 
 void RootWindow::update()
@@ -100,6 +99,9 @@ void RootWindow::update()
    if (m_should_update_viewport) {
       m_device.await_all();
 
+      // Nothing is in flight, resources released by a closed editor can be evicted.
+      m_resource_manager.evict_to_budget();
+
       auto& update_viewport_ctx = m_job_graph.replace_job(renderer::UpdateViewParamsJob::JobName);
       this->render_overlay().build_update_job(update_viewport_ctx);
       m_job_graph.rebuild_job(renderer::UpdateViewParamsJob::JobName);
@@ -125,7 +127,8 @@ void RootWindow::update()
 
    m_widget_renderer.prepare_resources(m_job_graph, m_frame_index);
 
-   m_job_graph.execute("render_dialog"_name, m_frame_index, nullptr);
+   m_render_surface.acquire_image(m_job_graph, m_frame_index);
+   m_job_graph.execute("render_dialog"_name, m_frame_index, m_render_surface.job_fence(m_frame_index));
 
    m_render_surface.present(m_job_graph, m_frame_index);
 
@@ -141,6 +144,9 @@ void RootWindow::on_resize(const Vector2i size)
 {
    m_device.await_all();
 
+   // The swapchain images are recreated first as the rendering job may render to them directly.
+   m_render_surface.recreate_swapchain(size);
+
    m_job_graph.set_screen_size(size);
    m_widget_renderer.ui_viewport().set_dimensions(size);
 
@@ -158,8 +164,6 @@ void RootWindow::on_resize(const Vector2i size)
    auto& render_ctx = m_job_graph.replace_job("render_dialog"_name);
    this->build_rendering_job(render_ctx);
    m_job_graph.rebuild_job("render_dialog"_name);
-
-   m_render_surface.recreate_swapchain(size);
 }
 
 void RootWindow::on_loaded_assets()
@@ -49,6 +49,12 @@ renderer::Config get_default_config()
    return result;
 }
 
+// Terrain tiles are stored next to the level file.
+io::Path level_terrain_directory(const ResourceName asset_name)
+{
+   return io::Path{std::format("{}.terrain", project::PathManager::the().translate_path(asset_name).string())};
+}
+
 }// namespace
 
 
@@ -463,13 +469,15 @@ LevelEditor::LevelEditor(ui_core::Context& context, const State state, ui_core::
    m_viewport = &left_layout.emplace_child<LevelViewport>(context, &left_layout, *m_state.root_window, *this);
 
    m_scene.load_level(m_state.asset_name);
+   m_scene.set_terrain_directory(level_terrain_directory(m_state.asset_name));
    m_bindless_scene.write_objects_to_buffer();
    m_scene.update_shadow_maps();
 
-   m_rendering_job.emplace_stage<renderer::stage::GBufferStage>(m_state.root_window->device(), m_bindless_scene);
+   m_rendering_job.emplace_stage<renderer::stage::GBufferStage>(m_state.root_window->device(), m_bindless_scene, m_occlusion_culling);
    m_decal_rendering_stage = &m_rendering_job.emplace_stage<DecalRenderingStage>(m_state.root_window->device());
    m_rendering_job.emplace_stage<renderer::stage::AmbientOcclusionStage>(m_state.root_window->device());
-   m_rendering_job.emplace_stage<renderer::stage::ShadowMapStage>(m_scene, m_bindless_scene, m_update_view_params_job);
+   m_rendering_job.emplace_stage<renderer::stage::ShadowMapStage>(m_scene, m_bindless_scene, m_occlusion_culling,
+                                                                  m_update_view_params_job);
    m_rendering_job.emplace_stage<renderer::stage::ShadingStage>();
    m_rendering_job.emplace_stage<renderer::stage::PostProcessStage>(nullptr, "post_process.out"_name);
 
@@ -484,6 +492,9 @@ LevelEditor::LevelEditor(ui_core::Context& context, const State state, ui_core::
 void LevelEditor::tick(const float delta_time)
 {
    m_bindless_scene.write_objects_to_buffer();
+   if (m_occlusion_culling.needs_rebuild()) {
+      m_state.root_window->recreate_render_jobs();
+   }
    if (m_viewport != nullptr) {
       m_viewport->tick(delta_time);
    }
@@ -653,11 +664,12 @@ void LevelEditor::on_event(const ui_core::Event& event)
    ProxyWidget::on_event(event);
 }
 
-void LevelEditor::save_level() const
+void LevelEditor::save_level()
 {
    const auto level = m_scene.to_level();
    const auto level_path = project::PathManager::the().translate_path(m_state.asset_name);
    assert(level.save_to_file(level_path));
+   m_scene.terrain().save_modified_tiles();
 }
 
 void LevelEditor::remove_selected_item()
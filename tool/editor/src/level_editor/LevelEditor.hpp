@@ -89,7 +89,7 @@ class LevelEditor final : public desktop_ui::DesktopProxyWidget, public desktop_
    void set_selected_object(renderer::ObjectID id);
    HistoryManager& history_manager();
    void on_event(const ui_core::Event& event) override;
-   void save_level() const;
+   void save_level();
    void remove_selected_item();
    void on_command(Command command) override;
    [[nodiscard]] bool accepts_key_chords() const override;
@@ -140,6 +140,9 @@ void RenderViewport::update(render_core::JobGraph& graph, const u32 frame_index,
 {
    m_level_editor.m_update_view_params_job.prepare_frame(graph, frame_index, delta_time);
 
+   // Terrain edits made since the last frame are uploaded together.
+   m_level_editor.scene().update_terrain();
+
    if (m_updates < render_core::FRAMES_IN_FLIGHT_COUNT) {
       const auto& limits = m_level_editor.m_state.root_window->device().limits();
       const auto color_align = align_size(sizeof(Vector4), limits.min_uniform_buffer_alignment);
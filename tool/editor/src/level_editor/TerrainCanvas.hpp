@@ -7,7 +7,8 @@
 
 namespace triglav::renderer {
 class Scene;
-}
+struct TerrainBrush;
+}// namespace triglav::renderer
 
 namespace triglav::editor {
 
@@ -22,6 +23,7 @@ class TerrainCanvas
    void smooth(float strength, Vector2i coord) const;
    void paint(float strength, Vector2i coord) const;
 
+   // Coordinates are terrain texels.
    [[nodiscard]] float sample(Vector2i coord) const;
    [[nodiscard]] std::optional<Vector3> trace_ray(const geometry::Ray& ray) const;
    [[nodiscard]] Vector2i world_pos_to_coord(Vector3 pos) const;
@@ -30,13 +32,10 @@ class TerrainCanvas
    [[nodiscard]] float brush_size() const;
 
  private:
-   float sample_average(Vector2i coord) const;
+   [[nodiscard]] renderer::TerrainBrush brush_at(Vector2i coord) const;
 
    renderer::Scene& m_scene;
    float m_brush_size = 40.0f;
-   i32 m_height_map_resolution = 1024;
-   float m_world_size = 240.0f;
-   float m_height_scale = 30.0f;
 };
 
 }// namespace triglav::editor
\ No newline at end of file
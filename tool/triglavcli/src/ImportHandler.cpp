@@ -10,6 +10,7 @@
 #include "triglav/project/PathManager.hpp"
 #include "triglav/project/ProjectManager.hpp"
 
+#include <algorithm>
 #include <format>
 #include <iostream>
 
@@ -82,6 +83,7 @@ ExitStatus handle_level_from_glb(const CmdArgs_import& args)
       .src_path = io::Path{args.positional_args[0]},
       .dst_path = project::PathManager::the().translate_path(name_from_path(sub_path)),
       .should_override = args.should_override,
+      .thread_count = static_cast<u32>(std::max(args.thread_count, 0)),
    };
    if (!import_level(import_props)) {
       return EXIT_FAILURE;
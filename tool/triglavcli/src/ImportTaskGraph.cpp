@@ -0,0 +1,201 @@
+#include "ImportTaskGraph.hpp"
+
+#include "triglav/Ranges.hpp"
+#include "triglav/threading/ThreadPool.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <exception>
+#include <print>
+
+namespace triglav::tool::cli {
+
+namespace {
+
+using Milliseconds = std::chrono::duration<double, std::milli>;
+
+std::string_view category_to_string(const ImportTaskCategory category)
+{
+   switch (category) {
+   case ImportTaskCategory::Read:
+      return "read";
+   case ImportTaskCategory::Texture:
+      return "texture";
+   case ImportTaskCategory::Material:
+      return "material";
+   case ImportTaskCategory::Mesh:
+      return "mesh";
+   case ImportTaskCategory::Animation:
+      return "animation";
+   case ImportTaskCategory::Other:
+      return "other";
+   }
+   return "unknown";
+}
+
+}// namespace
+
+ImportTaskID ImportTaskGraph::add_task(std::string name, const ImportTaskCategory category, Task&& task,
+                                       const std::span<const ImportTaskID> dependencies)
+{
+   const auto task_id = static_cast<ImportTaskID>(m_tasks.size());
+   for (const auto dep_id : dependencies) {
+      assert(dep_id < task_id);
+      m_tasks[dep_id].dependents.emplace_back(task_id);
+   }
+
+   m_tasks.emplace_back(TaskInfo{
+      .name = std::move(name),
+      .category = category,
+      .task = std::move(task),
+      .dependents = {},
+      .dependency_count = static_cast<u32>(dependencies.size()),
+   });
+   return task_id;
+}
+
+bool ImportTaskGraph::execute()
+{
+   const auto start_time = std::chrono::steady_clock::now();
+
+   std::vector<ImportTaskID> ready_tasks;
+   {
+      std::unique_lock lk{m_mutex};
+      m_finished_count = 0;
+      for (const auto task_id : Range(0u, static_cast<u32>(m_tasks.size()))) {
+         auto& task = m_tasks[task_id];
+         task.remaining_dependencies = task.dependency_count;
+         task.has_failed_dependency = false;
+         task.state = TaskState::Pending;
+         if (task.dependency_count == 0) {
+            ready_tasks.emplace_back(task_id);
+         }
+      }
+   }
+
+   for (const auto task_id : ready_tasks) {
+      this->issue_task(task_id);
+   }
+
+   std::unique_lock lk{m_mutex};
+   m_all_finished_cv.wait(lk, [this] { return m_finished_count == m_tasks.size(); });
+
+   m_wall_time = std::chrono::steady_clock::now() - start_time;
+
+   return std::ranges::all_of(m_tasks, [](const TaskInfo& task) { return task.state == TaskState::Succeeded; });
+}
+
+void ImportTaskGraph::issue_task(const ImportTaskID task_id)
+{
+   threading::ThreadPool::the().issue_job([this, task_id] {
+      auto& task = m_tasks[task_id];
+
+      const auto start_time = std::chrono::steady_clock::now();
+      bool succeeded = false;
+      try {
+         succeeded = task.task();
+      } catch (const std::exception& e) {
+         std::print(stderr, "triglav-cli: Import task {} failed: {}\n", task.name, e.what());
+      }
+      task.duration = std::chrono::steady_clock::now() - start_time;
+
+      this->on_task_finished(task_id, succeeded ? TaskState::Succeeded : TaskState::Failed);
+   });
+}
+
+void ImportTaskGraph::on_task_finished(const ImportTaskID task_id, const TaskState state)
+{
+   std::vector<ImportTaskID> ready_tasks;
+   std::vector<std::pair<ImportTaskID, TaskState>> finished_tasks{{task_id, state}};
+
+   {
+      std::unique_lock lk{m_mutex};
+
+      // Tasks with failed dependencies are finished immediately, without running them.
+      while (!finished_tasks.empty()) {
+         const auto [finished_id, finished_state] = finished_tasks.back();
+         finished_tasks.pop_back();
+
+         auto& finished_task = m_tasks[finished_id];
+         finished_task.state = finished_state;
+         ++m_finished_count;
+
+         for (const auto dependent_id : finished_task.dependents) {
+            auto& dependent = m_tasks[dependent_id];
+            if (finished_state != TaskState::Succeeded) {
+               dependent.has_failed_dependency = true;
+            }
+
+            assert(dependent.remaining_dependencies > 0);
+            if (--dependent.remaining_dependencies != 0)
+               continue;
+
+            if (dependent.has_failed_dependency) {
+               finished_tasks.emplace_back(dependent_id, TaskState::Skipped);
+            } else {
+               ready_tasks.emplace_back(dependent_id);
+            }
+         }
+      }
+
+      // Notify while holding the lock, the graph may be destroyed as soon as `execute` returns.
+      if (m_finished_count == m_tasks.size()) {
+         m_all_finished_cv.notify_one();
+      }
+   }
+
+   for (const auto ready_id : ready_tasks) {
+      this->issue_task(ready_id);
+   }
+}
+
+void ImportTaskGraph::print_summary() const
+{
+   std::vector<const TaskInfo*> sorted_tasks;
+   sorted_tasks.reserve(m_tasks.size());
+   for (const auto& task : m_tasks) {
+      sorted_tasks.emplace_back(&task);
+   }
+   std::ranges::sort(sorted_tasks, [](const TaskInfo* lhs, const TaskInfo* rhs) { return lhs->duration > rhs->duration; });
+
+   std::print(stderr, "triglav-cli: Import summary ({} tasks, {} threads):\n", m_tasks.size(), threading::ThreadPool::the().thread_count());
+   for (const auto* task : sorted_tasks) {
+      std::string_view status;
+      switch (task->state) {
+      case TaskState::Succeeded:
+         status = "ok";
+         break;
+      case TaskState::Failed:
+         status = "failed";
+         break;
+      case TaskState::Skipped:
+         status = "skipped";
+         break;
+      case TaskState::Pending:
+         status = "pending";
+         break;
+      }
+      std::print(stderr, "  {:>10.2f} ms  {:<9} {:<8} {}\n", Milliseconds(task->duration).count(), category_to_string(task->category), status,
+                 task->name);
+   }
+
+   std::array<std::chrono::nanoseconds, 6> category_totals{};
+   for (const auto& task : m_tasks) {
+      category_totals[static_cast<u32>(task.category)] += task.duration;
+   }
+
+   std::chrono::nanoseconds cpu_time{};
+   for (const auto category_id : Range(0u, static_cast<u32>(category_totals.size()))) {
+      const auto total = category_totals[category_id];
+      if (total.count() == 0)
+         continue;
+      std::print(stderr, "  total {:<9} {:>10.2f} ms\n", category_to_string(static_cast<ImportTaskCategory>(category_id)),
+                 Milliseconds(total).count());
+      cpu_time += total;
+   }
+
+   std::print(stderr, "  wall time {:.2f} ms, task time {:.2f} ms\n", Milliseconds(m_wall_time).count(), Milliseconds(cpu_time).count());
+}
+
+}// namespace triglav::tool::cli
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "triglav/Int.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace triglav::tool::cli {
+
+using ImportTaskID = u32;
+
+enum class ImportTaskCategory
+{
+   Read,
+   Texture,
+   Material,
+   Mesh,
+   Animation,
+   Other,
+};
+
+// Runs import tasks on the global thread pool, a task is issued once all of its dependencies finished.
+// If a task fails, all tasks depending on it are skipped.
+class ImportTaskGraph
+{
+ public:
+   using Task = std::function<bool()>;
+
+   ImportTaskID add_task(std::string name, ImportTaskCategory category, Task&& task, std::span<const ImportTaskID> dependencies = {});
+
+   [[nodiscard]] bool execute();
+   void print_summary() const;
+
+ private:
+   enum class TaskState
+   {
+      Pending,
+      Succeeded,
+      Failed,
+      Skipped,
+   };
+
+   struct TaskInfo
+   {
+      std::string name;
+      ImportTaskCategory category;
+      Task task;
+      std::vector<ImportTaskID> dependents;
+      u32 dependency_count{};
+      u32 remaining_dependencies{};
+      bool has_failed_dependency{};
+      TaskState state{TaskState::Pending};
+      std::chrono::nanoseconds duration{};
+   };
+
+   void issue_task(ImportTaskID task_id);
+   void on_task_finished(ImportTaskID task_id, TaskState state);
+
+   std::vector<TaskInfo> m_tasks;
+   std::mutex m_mutex;
+   std::condition_variable m_all_finished_cv;
+   u32 m_finished_count{};
+   std::chrono::nanoseconds m_wall_time{};
+};
+
+}// namespace triglav::tool::cli
@@ -0,0 +1,32 @@
+#include "Commands.hpp"
+#include "triglav/io/Path.hpp"
+#include "triglav/world/Level.hpp"
+
+#include <iostream>
+#include <print>
+
+namespace triglav::tool::cli {
+
+ExitStatus handle_level_convert(const CmdArgs_level_convert& args)
+{
+   if (args.positional_args.size() < 2) {
+      std::println(std::cerr, "triglav-cli: not enough arguments");
+      return EXIT_FAILURE;
+   }
+
+   const auto level = world::Level::load_from_file(io::Path(args.positional_args[0]));
+   if (!level.has_value()) {
+      std::println(std::cerr, "triglav-cli: failed to load level \"{}\"", args.positional_args[0]);
+      return EXIT_FAILURE;
+   }
+
+   const auto format = args.to_yaml ? world::LevelFormat::Yaml : world::LevelFormat::Binary;
+   if (!level->save_to_file(io::Path(args.positional_args[1]), format)) {
+      std::println(std::cerr, "triglav-cli: failed to save level \"{}\"", args.positional_args[1]);
+      return EXIT_FAILURE;
+   }
+
+   return EXIT_SUCCESS;
+}
+
+}// namespace triglav::tool::cli
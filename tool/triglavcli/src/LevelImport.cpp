@@ -1,22 +1,28 @@
 #include "LevelImport.hpp"
 
+#include "ImportTaskGraph.hpp"
 #include "MeshImport.hpp"
 #include "TextureImport.hpp"
+#include "triglav/Ranges.hpp"
 #include "triglav/ResourcePathMap.hpp"
 
 #include "triglav/gltf/Glb.hpp"
 #include "triglav/gltf/MeshLoad.hpp"
+#include "triglav/io/MemoryStream.hpp"
 #include "triglav/json_util/Serialize.hpp"
 #include "triglav/project/PathManager.hpp"
 #include "triglav/project/ProjectManager.hpp"
 #include "triglav/render_objects/Armature.hpp"
 #include "triglav/render_objects/Material.hpp"
+#include "triglav/threading/ThreadPool.hpp"
 #include "triglav/world/Level.hpp"
 
+#include <algorithm>
 #include <print>
 #include <queue>
 #include <ryml.hpp>
 #include <set>
+#include <thread>
 #include <utility>
 
 namespace c4 {
@@ -107,6 +113,14 @@ asset::AnimationChannelType channel_type_from_path(const std::string_view path)
    return {};
 }
 
+u64 hash_bytes(const std::span<const u8> data, u64 crc = 0)
+{
+   for (const u8 byte : data) {
+      crc = detail::CRC64_LOOKUP[byte ^ (crc & 0xFF)] ^ (crc >> 8);
+   }
+   return crc;
+}
+
 Transform3D transform_from_node(const gltf::Node& node)
 {
    auto transform = Transform3D::identity();
@@ -143,31 +157,115 @@ class LevelImporter
       u32 bone_id{};
    };
 
+   using TextureKey = std::pair<u32, std::optional<TextureChannel>>;
+
+   struct ImageSource
+   {
+      std::vector<u8> data;
+      u64 content_hash{};
+      std::optional<ImportTaskID> read_task;
+   };
+
+   struct TextureImport
+   {
+      u32 image_id{};
+      u32 sampler_id{};
+      asset::TexturePurpose purpose{};
+      io::Path dst_path;
+      TextureName rc_name;
+      std::optional<TextureKey> duplicate_of;
+   };
+
+   struct MeshImport
+   {
+      io::Path dst_path;
+      MeshName rc_name;
+      u64 content_hash{};
+      ImportTaskID hash_task{};
+      std::optional<u32> duplicate_of;
+   };
+
+   struct MeshNode
+   {
+      std::string name;
+      Transform3D transform;
+      u32 mesh_id{};
+      std::optional<ArmatureName> armature_name;
+   };
+
    LevelImporter(LevelImportProps props, gltf::GlbResource&& glb_resource, const io::Path& glb_src_path) :
        m_props(std::move(props)),
        m_glb_file(std::move(glb_resource)),
-       m_glb_source_path(glb_src_path)
+       m_glb_source_path(glb_src_path),
+       m_images(m_glb_file.document->images.size())
    {
    }
 
-   std::optional<TextureName> import_texture(const u32 texture_id, const asset::TexturePurpose purpose,
-                                             const std::optional<TextureChannel> extract_channel = {})
+   // Reserves a unique destination path, assets with clashing names get a numeric suffix.
+   std::pair<io::Path, ResourceName> reserve_import_path(const ResourceType type, std::string name_str)
+   {
+      for (char& ch : name_str) {
+         ch = static_cast<char>(std::tolower(ch));
+      }
+
+      auto result = project::PathManager::the().import_path(type, name_str);
+      for (u32 suffix = 1; m_reserved_paths.contains(result.second); ++suffix) {
+         result = project::PathManager::the().import_path(type, std::format("{}.{}", name_str, suffix));
+      }
+      m_reserved_paths.emplace(result.second);
+      return result;
+   }
+
+   [[nodiscard]] bool request_image(const u32 image_id)
+   {
+      auto& image = m_images.at(image_id);
+      if (image.read_task.has_value()) {
+         return true;
+      }
+
+      const auto& src_image = m_glb_file.document->images.at(image_id);
+      if (src_image.uri.has_value()) {
+         auto path = m_glb_source_path.parent().sub(src_image.uri.value());
+         image.read_task = m_task_graph.add_task(std::string{path.string()}, ImportTaskCategory::Read, [&image, path] {
+            const auto file_data = io::read_whole_file(path);
+            if (file_data.empty()) {
+               std::print(stderr, "triglav-cli: Failed to read image {}\n", path.string());
+               return false;
+            }
+            image.data.assign(file_data.begin(), file_data.end());
+            image.content_hash = hash_bytes(image.data);
+            return true;
+         });
+      } else if (src_image.buffer_view.has_value()) {
+         image.read_task = m_task_graph.add_task(
+            std::format("image{}", image_id), ImportTaskCategory::Read, [this, &image, buffer_view = *src_image.buffer_view] {
+               auto data = m_glb_file.buffer_manager.read_buffer_view_data(buffer_view);
+               if (!data.has_value()) {
+                  return false;
+               }
+               image.data = std::move(*data);
+               image.content_hash = hash_bytes(image.data);
+               return true;
+            });
+      } else {
+         return false;
+      }
+
+      return true;
+   }
+
+   std::optional<TextureName> plan_texture(const u32 texture_id, const asset::TexturePurpose purpose,
+                                           const std::optional<TextureChannel> extract_channel = {})
    {
       const auto tex_iden = std::make_pair(texture_id, extract_channel);
-      if (m_imported_textures.contains(tex_iden)) {
-         return m_imported_textures.at(tex_iden);
+      if (const auto it = m_textures.find(tex_iden); it != m_textures.end()) {
+         return it->second.rc_name;
       }
 
       const auto& src_texture = m_glb_file.document->textures.at(texture_id);
 
-      const auto& src_image = m_glb_file.document->images.at(src_texture.source);
-      const auto& src_sampler = m_glb_file.document->samplers.at(src_texture.sampler);
-
       auto texture_name_str =
          src_texture.name.empty() ? std::format("{}.tex{}", strip_extension(m_props.src_path.basename()), texture_id) : src_texture.name;
-      for (char& ch : texture_name_str) {
-         ch = static_cast<char>(std::tolower(ch));
-      }
       if (extract_channel.has_value()) {
          switch (*extract_channel) {
          case TextureChannel::Red:
@@ -185,40 +283,35 @@ class LevelImporter
          }
       }
 
-      const auto [dst_path, rc_name] = project::PathManager::the().import_path(ResourceType::Texture, texture_name_str);
-
-      TextureImportProps import_props{
-         .src_path = "."_path,
-         .dst_path = dst_path,
-         .purpose = purpose,
-         .sampler_properties = to_sampler_properties(src_sampler),
-         .should_compress = true,
-         .has_mip_maps = true,
-         .should_override = m_props.should_override,
-         .extract_channel = extract_channel,
-      };
-
-      if (src_image.uri.has_value()) {
-         import_props.src_path = m_glb_source_path.parent().sub(src_image.uri.value());
-         if (!cli::import_texture(import_props)) {
-            return std::nullopt;
-         }
-      } else if (src_image.buffer_view.has_value()) {
-         auto stream = m_glb_file.buffer_manager.buffer_view_to_stream(*src_image.buffer_view);
-         if (!cli::import_texture_from_stream(import_props, stream)) {
-            return std::nullopt;
-         }
-      } else {
+      if (!this->request_image(src_texture.source)) {
          std::print(stderr, "triglav-cli: Failed to import texture {}, no URI or buffer view provided\n", texture_name_str);
          return std::nullopt;
       }
 
-      m_imported_textures.emplace(tex_iden, rc_name);
+      const auto [dst_path, rc_name] = this->reserve_import_path(ResourceType::Texture, texture_name_str);
+
+      m_textures.emplace(tex_iden, TextureImport{
+                                      .image_id = src_texture.source,
+                                      .sampler_id = src_texture.sampler,
+                                      .purpose = purpose,
+                                      .dst_path = dst_path,
+                                      .rc_name = rc_name,
+                                   });
 
       return rc_name;
    }
 
-   std::optional<MaterialName> import_material(const u32 material_id)
+   [[nodiscard]] TextureName texture_name(const TextureName name) const
+   {
+      // Resolve the name of the texture with the same content that actually gets imported.
+      const auto it = std::ranges::find_if(m_textures, [name](const auto& pair) { return pair.second.rc_name == name; });
+      if (it == m_textures.end() || !it->second.duplicate_of.has_value()) {
+         return name;
+      }
+      return m_textures.at(*it->second.duplicate_of).rc_name;
+   }
+
+   std::optional<MaterialName> plan_material(const u32 material_id)
    {
       if (m_imported_materials.contains(material_id)) {
          return m_imported_materials.at(material_id);
@@ -228,109 +321,116 @@ class LevelImporter
       if (!src_material.pbr_metallic_roughness.base_color_texture.has_value()) {
          std::println(stderr, "triglav-cli: Failed to import GLTF material, material: {} has no texture assigned, defaulting to stone.mat",
                       material_id);
-         return {"material/stone.mat"_rc};
+         // Record the fallback, so the mesh hash and content checks can look it up like any other material.
+         const MaterialName fallback{"material/stone.mat"_rc};
+         m_imported_materials.emplace(material_id, fallback);
+         return fallback;
       }
 
-      auto albedo_tex = this->import_texture(src_material.pbr_metallic_roughness.base_color_texture->index, asset::TexturePurpose::Albedo);
+      auto albedo_tex = this->plan_texture(src_material.pbr_metallic_roughness.base_color_texture->index, asset::TexturePurpose::Albedo);
       if (!albedo_tex.has_value()) {
          return std::nullopt;
       }
 
-      render_objects::Material dst_material{};
+      // Texture names are resolved once the texture content is deduplicated.
+      std::function<render_objects::Material()> build_material;
       if (src_material.normal_texture.has_value()) {
-         auto normal_tex = this->import_texture(src_material.normal_texture->index, asset::TexturePurpose::NormalMap);
+         auto normal_tex = this->plan_texture(src_material.normal_texture->index, asset::TexturePurpose::NormalMap);
          if (!normal_tex.has_value()) {
             return std::nullopt;
          }
 
          if (src_material.pbr_metallic_roughness.metallic_roughness_texture.has_value()) {
-            auto metallic_tex = this->import_texture(src_material.pbr_metallic_roughness.metallic_roughness_texture->index,
-                                                     asset::TexturePurpose::Metallic, TextureChannel::Blue);
+            auto metallic_tex = this->plan_texture(src_material.pbr_metallic_roughness.metallic_roughness_texture->index,
+                                                   asset::TexturePurpose::Metallic, TextureChannel::Blue);
             if (!metallic_tex.has_value()) {
                return std::nullopt;
             }
 
-            auto roughness_tex = this->import_texture(src_material.pbr_metallic_roughness.metallic_roughness_texture->index,
-                                                      asset::TexturePurpose::Roughness, TextureChannel::Green);
+            auto roughness_tex = this->plan_texture(src_material.pbr_metallic_roughness.metallic_roughness_texture->index,
+                                                    asset::TexturePurpose::Roughness, TextureChannel::Green);
             if (!roughness_tex.has_value()) {
                return std::nullopt;
             }
 
-            render_objects::MTProperties_FullPBR properties{
-               .texture = *albedo_tex,
-               .normal = *normal_tex,
-               .roughness = *roughness_tex,
-               .metallic = *metallic_tex,
+            build_material = [this, albedo = *albedo_tex, normal = *normal_tex, roughness = *roughness_tex, metallic = *metallic_tex] {
+               render_objects::Material dst_material{};
+               dst_material.material_template = render_objects::MaterialTemplate::FullPBR;
+               dst_material.properties = render_objects::MTProperties_FullPBR{
+                  .texture = this->texture_name(albedo),
+                  .normal = this->texture_name(normal),
+                  .roughness = this->texture_name(roughness),
+                  .metallic = this->texture_name(metallic),
+               };
+               return dst_material;
             };
-            dst_material.material_template = render_objects::MaterialTemplate::FullPBR;
-            dst_material.properties = properties;
-
          } else {
-            render_objects::MTProperties_NormalMap properties{
-               .albedo = *albedo_tex,
-               .normal = *normal_tex,
-               .roughness = src_material.pbr_metallic_roughness.roughness_factor,
-               .metallic = src_material.pbr_metallic_roughness.metallic_factor,
+            build_material = [this, albedo = *albedo_tex, normal = *normal_tex, &src_material] {
+               render_objects::Material dst_material{};
+               dst_material.material_template = render_objects::MaterialTemplate::NormalMap;
+               dst_material.properties = render_objects::MTProperties_NormalMap{
+                  .albedo = this->texture_name(albedo),
+                  .normal = this->texture_name(normal),
+                  .roughness = src_material.pbr_metallic_roughness.roughness_factor,
+                  .metallic = src_material.pbr_metallic_roughness.metallic_factor,
+               };
+               return dst_material;
             };
-            dst_material.material_template = render_objects::MaterialTemplate::NormalMap;
-            dst_material.properties = properties;
          }
       } else {
-         render_objects::MTProperties_Basic properties{
-            .albedo = *albedo_tex,
-            .roughness = src_material.pbr_metallic_roughness.roughness_factor,
-            .metallic = src_material.pbr_metallic_roughness.metallic_factor,
+         build_material = [this, albedo = *albedo_tex, &src_material] {
+            render_objects::Material dst_material{};
+            dst_material.material_template = render_objects::MaterialTemplate::Basic;
+            dst_material.properties = render_objects::MTProperties_Basic{
+               .albedo = this->texture_name(albedo),
+               .roughness = src_material.pbr_metallic_roughness.roughness_factor,
+               .metallic = src_material.pbr_metallic_roughness.metallic_factor,
+            };
+            return dst_material;
          };
-         dst_material.properties = properties;
-         dst_material.material_template = render_objects::MaterialTemplate::Basic;
-      }
-
-      auto material_name_str =
-         src_material.name.empty() ? std::format("{}.mat{}", strip_extension(m_props.src_path.basename()), material_id) : src_material.name;
-      for (char& ch : material_name_str) {
-         ch = static_cast<char>(std::tolower(ch));
       }
 
-      const auto [dst_path, rc_name] = project::PathManager::the().import_path(ResourceType::Material, material_name_str);
+      const auto [dst_path, rc_name] = this->reserve_import_path(
+         ResourceType::Material,
+         src_material.name.empty() ? std::format("{}.mat{}", strip_extension(m_props.src_path.basename()), material_id) : src_material.name);
       if (!m_props.should_override && dst_path.exists()) {
          std::print(stderr, "triglav-cli: Failed to import material to {}, file exists\n", dst_path.string());
          return std::nullopt;
       }
 
-      const auto file = io::open_file(dst_path, io::FileMode::Write | io::FileMode::Create);
-      if (!file.has_value()) {
-         return std::nullopt;
-      }
+      m_material_tasks.emplace_back(std::string{dst_path.string()}, [build_material, dst_path] {
+         const auto file = io::open_file(dst_path, io::FileMode::Write | io::FileMode::Create);
+         if (!file.has_value()) {
+            return false;
+         }
 
-      ryml::Tree tree;
-      ryml::NodeRef tree_ref{tree};
-      tree_ref |= ryml::MAP;
-      dst_material.serialize_yaml(tree_ref);
+         ryml::Tree tree;
+         ryml::NodeRef tree_ref{tree};
+         tree_ref |= ryml::MAP;
+         build_material().serialize_yaml(tree_ref);
 
-      const auto str = ryml::emitrs_yaml<std::string>(tree);
-      if (!(*file)->write({reinterpret_cast<const u8*>(str.data()), str.size()}).has_value()) {
-         return std::nullopt;
-      }
+         const auto str = ryml::emitrs_yaml<std::string>(tree);
+         if (!(*file)->write({reinterpret_cast<const u8*>(str.data()), str.size()}).has_value()) {
+            return false;
+         }
 
-      std::print(stderr, "triglav-cli: Imported material to {}\n", dst_path.string());
+         std::print(stderr, "triglav-cli: Imported material to {}\n", dst_path.string());
+         return true;
+      });
 
       m_imported_materials.emplace(material_id, rc_name.name());
 
       return rc_name;
    }
 
-   [[nodiscard]] std::optional<MeshName> import_mesh(const std::optional<std::string>& name, const u32 mesh_id)
+   [[nodiscard]] std::optional<MeshName> plan_mesh(const std::optional<std::string>& name, const u32 mesh_id)
    {
-      if (m_imported_meshes.contains(mesh_id)) {
-         return m_imported_meshes.at(mesh_id);
+      if (const auto it = m_meshes.find(mesh_id); it != m_meshes.end()) {
+         return it->second.rc_name;
       }
 
-      auto mesh_name_str = name.value_or(std::format("{}.mesh{}", strip_extension(m_props.src_path.basename()), mesh_id));
-      for (char& ch : mesh_name_str) {
-         ch = static_cast<char>(std::tolower(ch));
-      }
-
-      const auto [dst_path, rc_name] = project::PathManager::the().import_path(ResourceType::Mesh, mesh_name_str);
+      const auto [dst_path, rc_name] =
+         this->reserve_import_path(ResourceType::Mesh, name.value_or(std::format("{}.mesh{}", strip_extension(m_props.src_path.basename()), mesh_id)));
       if (!m_props.should_override && dst_path.exists()) {
          std::print(stderr, "triglav-cli: Failed to import mesh to {}, file exists\n", dst_path.string());
          return std::nullopt;
@@ -340,20 +440,49 @@ class LevelImporter
       for (const auto& prim : mesh.primitives) {
          if (!prim.material.has_value())
             continue;
-         if (!this->import_material(*prim.material).has_value())
+         if (!this->plan_material(*prim.material).has_value())
             return std::nullopt;
       }
 
-      auto gltf_mesh = gltf::mesh_from_document(*m_glb_file.document, mesh_id, m_glb_file.buffer_manager, m_imported_materials);
-      write_mesh_to_file(gltf_mesh, dst_path);
-      m_imported_meshes.emplace(mesh_id, rc_name);
+      auto& mesh_import = m_meshes[mesh_id];
+      mesh_import.dst_path = dst_path;
+      mesh_import.rc_name = rc_name;
+      mesh_import.hash_task = m_task_graph.add_task(std::format("mesh{}", mesh_id), ImportTaskCategory::Read, [this, &mesh_import, &mesh] {
+         // Hash the primitive data as stored in the buffers, identical meshes end up with the same hash.
+         u64 hash = 0;
+         const auto hash_accessor = [&](const u32 accessor_id) {
+            const auto& accessor = m_glb_file.document->accessors.at(accessor_id);
+            const auto data = m_glb_file.buffer_manager.read_buffer_view_data(accessor.buffer_view, accessor.byte_offset);
+            if (!data.has_value()) {
+               return false;
+            }
+            const std::array header{static_cast<u32>(accessor.type), static_cast<u32>(accessor.component_type), accessor.count};
+            hash = hash_bytes({reinterpret_cast<const u8*>(header.data()), sizeof(header)}, hash);
+            hash = hash_bytes(*data, hash);
+            return true;
+         };
+
+         for (const auto& prim : mesh.primitives) {
+            for (const auto& [attribute_type, accessor_id] : prim.attributes) {
+               hash = hash_bytes({reinterpret_cast<const u8*>(&attribute_type), sizeof(attribute_type)}, hash);
+               if (!hash_accessor(accessor_id))
+                  return false;
+            }
+            if (prim.indices.has_value() && !hash_accessor(*prim.indices))
+               return false;
+
+            const auto material_name = prim.material.has_value() ? m_imported_materials.at(*prim.material).name() : Name{};
+            hash = hash_bytes({reinterpret_cast<const u8*>(&material_name), sizeof(material_name)}, hash);
+         }
 
-      std::print(stderr, "triglav-cli: Importing mesh to {}\n", dst_path.string());
+         mesh_import.content_hash = hash;
+         return true;
+      });
 
       return rc_name;
    }
 
-   [[nodiscard]] std::optional<AnimationName> import_animation(const u32 animation_id)
+   [[nodiscard]] bool import_animation(const u32 animation_id)
    {
       asset::Animation dst_animation{};
       auto& src_animation = m_glb_file.document->animations[animation_id];
@@ -382,12 +511,22 @@ class LevelImporter
          dst_channel.timestamps.resize(input_accessor.count);
          dst_channel.keyframes.resize(output_accessor.count);
 
-         auto input_stream = m_glb_file.buffer_manager.read_buffer_view(input_accessor.buffer_view);
+         const auto input_data = m_glb_file.buffer_manager.read_buffer_view_data(input_accessor.buffer_view, input_accessor.byte_offset);
+         if (!input_data.has_value()) {
+            return false;
+         }
+         io::MemoryStream input_memory_stream(*input_data);
+         io::Deserializer input_stream(input_memory_stream);
          for (MemorySize i = 0; i < input_accessor.count; ++i) {
             dst_channel.timestamps[i] = input_stream.read_float() * MILLISECOND_MULTIPLIER;
          }
 
-         auto output_stream = m_glb_file.buffer_manager.read_buffer_view(output_accessor.buffer_view);
+         const auto output_data = m_glb_file.buffer_manager.read_buffer_view_data(output_accessor.buffer_view, output_accessor.byte_offset);
+         if (!output_data.has_value()) {
+            return false;
+         }
+         io::MemoryStream output_memory_stream(*output_data);
+         io::Deserializer output_stream(output_memory_stream);
 
          switch (output_accessor.type) {
          case gltf::AccessorType::Vector3: {
@@ -408,28 +547,20 @@ class LevelImporter
          dst_animation.channels.emplace_back(std::move(dst_channel));
       }
 
-      auto animation_name_str = src_animation.name;
-      if (animation_name_str.empty()) {
-         animation_name_str = std::format("{}.anim{}", strip_extension(m_props.src_path.basename()), animation_id);
-      }
-      for (char& ch : animation_name_str) {
-         ch = static_cast<char>(std::tolower(ch));
-      }
-
-      const auto [dst_path, rc_name] = project::PathManager::the().import_path(ResourceType::Animation, animation_name_str);
+      const auto dst_path = m_animation_paths.at(animation_id);
 
       const auto dst_file = io::open_file(dst_path, io::FileMode::Write | io::FileMode::Create);
       if (!dst_file.has_value()) {
-         return std::nullopt;
+         return false;
       }
 
       if (!json_util::serialize(dst_animation.to_meta_ref(), **dst_file)) {
-         return std::nullopt;
+         return false;
       }
 
       std::print(stderr, "triglav-cli: Importing animation to {}\n", dst_path.string());
 
-      return rc_name;
+      return true;
    }
 
    [[nodiscard]] std::optional<ArmatureName> import_armature(const u32 skin_id, Transform3D root_transform)
@@ -491,11 +622,8 @@ class LevelImporter
       if (armature_name_str.empty()) {
          armature_name_str = std::format("{}.armature{}", strip_extension(m_props.src_path.basename()), skin_id);
       }
-      for (char& ch : armature_name_str) {
-         ch = static_cast<char>(std::tolower(ch));
-      }
 
-      const auto [dst_path, rc_name] = project::PathManager::the().import_path(ResourceType::Armature, armature_name_str);
+      const auto [dst_path, rc_name] = this->reserve_import_path(ResourceType::Armature, armature_name_str);
 
       const auto dst_file = io::open_file(dst_path, io::FileMode::Write | io::FileMode::Create);
       if (!dst_file.has_value()) {
@@ -510,6 +638,159 @@ class LevelImporter
       return rc_name;
    }
 
+   void deduplicate_content()
+   {
+      // Textures and meshes with the same hash are only merged if their content matches as well.
+      std::map<std::tuple<u64, u32, asset::TexturePurpose, std::optional<TextureChannel>>, std::vector<TextureKey>> unique_textures;
+      for (auto& [key, texture] : m_textures) {
+         const auto& image = m_images[texture.image_id];
+         auto& bucket = unique_textures[std::make_tuple(image.content_hash, texture.sampler_id, texture.purpose, key.second)];
+
+         const auto canonical_it = std::ranges::find_if(
+            bucket, [&](const TextureKey& canonical_key) { return m_images[m_textures.at(canonical_key).image_id].data == image.data; });
+         if (canonical_it == bucket.end()) {
+            bucket.emplace_back(key);
+            continue;
+         }
+
+         texture.duplicate_of = *canonical_it;
+         std::print(stderr, "triglav-cli: Texture {} has the same content as {}, skipping\n", texture.dst_path.string(),
+                    m_textures.at(*canonical_it).dst_path.string());
+      }
+
+      std::map<u64, std::vector<u32>> unique_meshes;
+      for (auto& [mesh_id, mesh] : m_meshes) {
+         auto& bucket = unique_meshes[mesh.content_hash];
+
+         const auto canonical_it =
+            std::ranges::find_if(bucket, [&](const u32 canonical_id) { return this->has_same_mesh_content(canonical_id, mesh_id); });
+         if (canonical_it == bucket.end()) {
+            bucket.emplace_back(mesh_id);
+            continue;
+         }
+
+         mesh.duplicate_of = *canonical_it;
+         std::print(stderr, "triglav-cli: Mesh {} has the same content as {}, skipping\n", mesh.dst_path.string(),
+                    m_meshes.at(*canonical_it).dst_path.string());
+      }
+   }
+
+   // Compares the primitive data the mesh content hash is calculated from.
+   [[nodiscard]] bool has_same_mesh_content(const u32 lhs_mesh_id, const u32 rhs_mesh_id) const
+   {
+      const auto& lhs_mesh = m_glb_file.document->meshes.at(lhs_mesh_id);
+      const auto& rhs_mesh = m_glb_file.document->meshes.at(rhs_mesh_id);
+      if (lhs_mesh.primitives.size() != rhs_mesh.primitives.size())
+         return false;
+
+      const auto has_same_accessor_content = [&](const u32 lhs_accessor_id, const u32 rhs_accessor_id) {
+         if (lhs_accessor_id == rhs_accessor_id)
+            return true;
+
+         const auto& lhs = m_glb_file.document->accessors.at(lhs_accessor_id);
+         const auto& rhs = m_glb_file.document->accessors.at(rhs_accessor_id);
+         if (lhs.type != rhs.type || lhs.component_type != rhs.component_type || lhs.count != rhs.count)
+            return false;
+
+         const auto lhs_data = m_glb_file.buffer_manager.read_buffer_view_data(lhs.buffer_view, lhs.byte_offset);
+         const auto rhs_data = m_glb_file.buffer_manager.read_buffer_view_data(rhs.buffer_view, rhs.byte_offset);
+         return lhs_data.has_value() && rhs_data.has_value() && *lhs_data == *rhs_data;
+      };
+
+      const auto material_name = [&](const gltf::Primitive& prim) {
+         return prim.material.has_value() ? m_imported_materials.at(*prim.material).name() : Name{};
+      };
+
+      for (MemorySize prim_id = 0; prim_id < lhs_mesh.primitives.size(); ++prim_id) {
+         const auto& lhs_prim = lhs_mesh.primitives[prim_id];
+         const auto& rhs_prim = rhs_mesh.primitives[prim_id];
+         if (lhs_prim.attributes.size() != rhs_prim.attributes.size() || lhs_prim.indices.has_value() != rhs_prim.indices.has_value())
+            return false;
+         if (material_name(lhs_prim) != material_name(rhs_prim))
+            return false;
+
+         for (auto lhs_it = lhs_prim.attributes.begin(), rhs_it = rhs_prim.attributes.begin(); lhs_it != lhs_prim.attributes.end();
+              ++lhs_it, ++rhs_it) {
+            if (lhs_it->first != rhs_it->first || !has_same_accessor_content(lhs_it->second, rhs_it->second))
+               return false;
+         }
+         if (lhs_prim.indices.has_value() && !has_same_accessor_content(*lhs_prim.indices, *rhs_prim.indices))
+            return false;
+      }
+
+      return true;
+   }
+
+   void build_task_graph()
+   {
+      std::vector<ImportTaskID> read_tasks;
+      for (const auto& image : m_images) {
+         if (image.read_task.has_value()) {
+            read_tasks.emplace_back(*image.read_task);
+         }
+      }
+      for (const auto& mesh : Values(m_meshes)) {
+         read_tasks.emplace_back(mesh.hash_task);
+      }
+
+      const std::array dedup_task{m_task_graph.add_task("deduplicate content", ImportTaskCategory::Other, [this] {
+         this->deduplicate_content();
+         return true;
+      }, read_tasks)};
+
+      for (auto& [key, texture] : m_textures) {
+         m_task_graph.add_task(std::string{texture.dst_path.string()}, ImportTaskCategory::Texture, [this, &texture = texture, channel = key.second] {
+            if (texture.duplicate_of.has_value()) {
+               return true;
+            }
+
+            const auto& src_sampler = m_glb_file.document->samplers.at(texture.sampler_id);
+            const TextureImportProps import_props{
+               .src_path = "."_path,
+               .dst_path = texture.dst_path,
+               .purpose = texture.purpose,
+               .sampler_properties = to_sampler_properties(src_sampler),
+               .should_compress = true,
+               .has_mip_maps = true,
+               .should_override = m_props.should_override,
+               .extract_channel = channel,
+            };
+
+            io::MemoryStream stream(m_images[texture.image_id].data);
+            return cli::import_texture_from_stream(import_props, stream);
+         }, dedup_task);
+      }
+
+      for (auto& [name, task] : m_material_tasks) {
+         m_task_graph.add_task(std::move(name), ImportTaskCategory::Material, std::move(task), dedup_task);
+      }
+
+      for (auto& [mesh_id, mesh] : m_meshes) {
+         m_task_graph.add_task(std::string{mesh.dst_path.string()}, ImportTaskCategory::Mesh, [this, mesh_id = mesh_id, &mesh = mesh] {
+            if (mesh.duplicate_of.has_value()) {
+               return true;
+            }
+
+            const auto gltf_mesh = gltf::mesh_from_document(*m_glb_file.document, mesh_id, m_glb_file.buffer_manager, m_imported_materials);
+            if (!write_mesh_to_file(gltf_mesh, mesh.dst_path)) {
+               return false;
+            }
+
+            std::print(stderr, "triglav-cli: Importing mesh to {}\n", mesh.dst_path.string());
+            return true;
+         }, dedup_task);
+      }
+
+      for (const auto& [animation_id, dst_path] : m_animation_paths) {
+         m_task_graph.add_task(std::string{dst_path.string()}, ImportTaskCategory::Animation, [this, animation_id = animation_id] {
+            if (!this->import_animation(animation_id)) {
+               std::print(stderr, "triglav-cli: Failed to import animation {}\n", animation_id);
+            }
+            return true;
+         });
+      }
+   }
+
    [[nodiscard]] bool import_scene()
    {
       if (!m_props.should_override && m_props.dst_path.exists()) {
@@ -519,7 +800,6 @@ class LevelImporter
 
       const auto& glb_scene = m_glb_file.document->scenes[m_glb_file.document->scene];
 
-      world::LevelNode root_node("root");
       std::queue<std::pair<u32, Transform3D>> nodes;
 
       for (const u32 node_id : glb_scene.nodes) {
@@ -527,7 +807,9 @@ class LevelImporter
       }
 
       std::set<u32> visited_nodes;
+      std::vector<MeshNode> mesh_nodes;
 
+      // Plan the import on the main thread, the assets are read and encoded afterwards by the task graph.
       while (!nodes.empty()) {
          auto [node_id, parent_transform] = nodes.front();
          nodes.pop();
@@ -554,31 +836,52 @@ class LevelImporter
                .type = NodeType::Mesh,
                .bone_id = ~0u,
             };
-            auto mesh_name = this->import_mesh(glb_node.name, *glb_node.mesh);
-            if (!mesh_name.has_value()) {
+            if (!this->plan_mesh(glb_node.name, *glb_node.mesh).has_value()) {
                return false;
             }
 
-            world::StaticMesh mesh;
-            mesh.name = glb_node.name.value_or(std::format("static_mesh{}", node_id));
-            mesh.transform = transform;
-            mesh.mesh_name = *mesh_name;
-            mesh.armature_name = armature_name;
-
-            root_node.add_static_mesh(std::move(mesh));
+            mesh_nodes.emplace_back(MeshNode{
+               .name = glb_node.name.value_or(std::format("static_mesh{}", node_id)),
+               .transform = transform,
+               .mesh_id = *glb_node.mesh,
+               .armature_name = armature_name,
+            });
          }
       }
 
-      world::Level level;
-      level.add_node("root"_name, std::move(root_node));
-
-      // import animations
       for (u32 animation_id = 0; animation_id < m_glb_file.document->animations.size(); ++animation_id) {
-         if (!this->import_animation(animation_id).has_value()) {
-            std::print(stderr, "triglav-cli: Failed to import animation {}\n", animation_id);
+         auto animation_name_str = m_glb_file.document->animations[animation_id].name;
+         if (animation_name_str.empty()) {
+            animation_name_str = std::format("{}.anim{}", strip_extension(m_props.src_path.basename()), animation_id);
          }
+         m_animation_paths.emplace(animation_id, this->reserve_import_path(ResourceType::Animation, animation_name_str).first);
       }
 
+      this->build_task_graph();
+      const auto tasks_succeeded = m_task_graph.execute();
+      m_task_graph.print_summary();
+
+      if (!tasks_succeeded) {
+         std::print(stderr, "triglav-cli: Failed to import level assets\n");
+         return false;
+      }
+
+      world::LevelNode root_node("root");
+      for (auto& mesh_node : mesh_nodes) {
+         const auto& mesh_import = m_meshes.at(mesh_node.mesh_id);
+
+         world::StaticMesh mesh;
+         mesh.name = std::move(mesh_node.name);
+         mesh.transform = mesh_node.transform;
+         mesh.mesh_name = mesh_import.duplicate_of.has_value() ? m_meshes.at(*mesh_import.duplicate_of).rc_name : mesh_import.rc_name;
+         mesh.armature_name = mesh_node.armature_name;
+
+         root_node.add_static_mesh(std::move(mesh));
+      }
+
+      world::Level level;
+      level.add_node("root"_name, std::move(root_node));
+
       if (!level.save_to_file(m_props.dst_path)) {
          std::print(stderr, "triglav-cli: Failed to save level file\n");
          return false;
@@ -591,10 +894,15 @@ class LevelImporter
    LevelImportProps m_props;
    gltf::GlbResource m_glb_file;
    io::Path m_glb_source_path;
-   std::map<u32, MeshName> m_imported_meshes;
+   ImportTaskGraph m_task_graph;
+   std::vector<ImageSource> m_images;
+   std::map<TextureKey, TextureImport> m_textures;
+   std::map<u32, MeshImport> m_meshes;
    std::map<u32, MaterialName> m_imported_materials;
    std::map<u32, ArmatureName> m_imported_armatures;
-   std::map<std::pair<u32, std::optional<TextureChannel>>, TextureName> m_imported_textures;
+   std::map<u32, io::Path> m_animation_paths;
+   std::vector<std::pair<std::string, ImportTaskGraph::Task>> m_material_tasks;
+   std::set<ResourceName> m_reserved_paths;
    std::map<u32, NodeInfo> m_node_infos;
 };
 
@@ -608,12 +916,16 @@ bool import_level(const LevelImportProps& props)
       return false;
    }
 
+   const auto thread_count = props.thread_count != 0 ? props.thread_count : std::max(1u, std::thread::hardware_concurrency());
+   threading::set_thread_id(threading::g_main_thread);
+   threading::ThreadPool::the().initialize(thread_count);
+
    LevelImporter importer(props, std::move(*glb_file), props.src_path);
-   if (!importer.import_scene()) {
-      return false;
-   }
+   const auto result = importer.import_scene();
+
+   threading::ThreadPool::the().quit();
 
-   return true;
+   return result;
 }
 
 }// namespace triglav::tool::cli
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "triglav/Int.hpp"
 #include "triglav/io/Path.hpp"
 
 namespace triglav::tool::cli {
@@ -9,6 +10,7 @@ struct LevelImportProps
    io::Path src_path;
    io::Path dst_path;
    bool should_override{};
+   u32 thread_count{};
 };
 
 [[nodiscard]] bool import_level(const LevelImportProps& props);
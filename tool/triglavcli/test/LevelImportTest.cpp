@@ -0,0 +1,121 @@
+#include "LevelImport.hpp"
+
+#include "triglav/gltf/Glb.hpp"
+#include "triglav/io/File.hpp"
+#include "triglav/project/PathManager.hpp"
+#include "triglav/testing_core/GTest.hpp"
+#include "triglav/world/Level.hpp"
+
+#include <array>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using triglav::ResourceType;
+using triglav::u16;
+using triglav::u32;
+using triglav::u8;
+using triglav::gltf::GlbChunkHeader;
+using triglav::gltf::GlbHeader;
+using triglav::io::FileMode;
+using triglav::io::open_file;
+using triglav::io::Path;
+using triglav::project::PathManager;
+using triglav::tool::cli::import_level;
+using triglav::world::Level;
+
+using namespace triglav::io::path_literals;
+using namespace triglav::name_literals;
+
+namespace {
+
+// Two nodes with identical meshes, both use a material without a base color texture.
+constexpr auto g_untextured_document = R"({
+   "asset": {"version": "2.0"},
+   "scene": 0,
+   "scenes": [{"nodes": [0, 1]}],
+   "nodes": [{"name": "plane_a", "mesh": 0}, {"name": "plane_b", "mesh": 1}],
+   "meshes": [
+      {"name": "plane_a", "primitives": [{"attributes": {"POSITION": 0, "NORMAL": 1, "TEXCOORD_0": 2}, "indices": 3, "mode": 4, "material": 0}]},
+      {"name": "plane_b", "primitives": [{"attributes": {"POSITION": 0, "NORMAL": 1, "TEXCOORD_0": 2}, "indices": 3, "mode": 4, "material": 0}]}
+   ],
+   "materials": [{"name": "untextured", "pbrMetallicRoughness": {"baseColorFactor": [1.0, 0.0, 0.0, 1.0], "metallicFactor": 0.0, "roughnessFactor": 1.0}}],
+   "accessors": [
+      {"bufferView": 0, "byteOffset": 0, "componentType": 5126, "count": 3, "type": "VEC3"},
+      {"bufferView": 1, "byteOffset": 0, "componentType": 5126, "count": 3, "type": "VEC3"},
+      {"bufferView": 2, "byteOffset": 0, "componentType": 5126, "count": 3, "type": "VEC2"},
+      {"bufferView": 3, "byteOffset": 0, "componentType": 5123, "count": 3, "type": "SCALAR"}
+   ],
+   "bufferViews": [
+      {"buffer": 0, "byteOffset": 0, "byteLength": 36},
+      {"buffer": 0, "byteOffset": 36, "byteLength": 36},
+      {"buffer": 0, "byteOffset": 72, "byteLength": 24},
+      {"buffer": 0, "byteOffset": 96, "byteLength": 6}
+   ],
+   "buffers": [{"byteLength": 104}]
+})";
+
+template<typename T>
+void append(std::vector<u8>& out, const T& value)
+{
+   const auto offset = out.size();
+   out.resize(offset + sizeof(T));
+   std::memcpy(out.data() + offset, &value, sizeof(T));
+}
+
+bool write_untextured_glb(const Path& path)
+{
+   std::vector<u8> binary;
+   for (const auto value : std::array{0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f}) {
+      append(binary, value);
+   }
+   for (const auto value : std::array{0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f}) {
+      append(binary, value);
+   }
+   for (const auto value : std::array{0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f}) {
+      append(binary, value);
+   }
+   for (const auto value : std::array<u16, 4>{0, 1, 2, 0}) {
+      append(binary, value);
+   }
+
+   // Chunks are aligned to 4 bytes, the JSON chunk is padded with spaces.
+   std::string json{g_untextured_document};
+   json.resize((json.size() + 3) & ~3ull, ' ');
+
+   std::vector<u8> glb;
+   append(glb, GlbHeader{
+                  .magic = 0x46546C67,
+                  .version = 2,
+                  .length = static_cast<u32>(sizeof(GlbHeader) + 2 * sizeof(GlbChunkHeader) + json.size() + binary.size()),
+               });
+   append(glb, GlbChunkHeader{.chunk_length = static_cast<u32>(json.size()), .chunk_type = 0x4E4F534A});
+   glb.insert(glb.end(), json.begin(), json.end());
+   append(glb, GlbChunkHeader{.chunk_length = static_cast<u32>(binary.size()), .chunk_type = 0x004E4942});
+   glb.insert(glb.end(), binary.begin(), binary.end());
+
+   const auto file = open_file(path, FileMode::Write | FileMode::Create);
+   if (!file.has_value())
+      return false;
+   return (*file)->write(glb).has_value();
+}
+
+}// namespace
+
+TEST(LevelImportTest, UntexturedMaterialFallsBackToStone)
+{
+   const auto src_path = "untextured.glb"_path;
+   ASSERT_TRUE(write_untextured_glb(src_path));
+
+   const auto dst_path = "untextured.level"_path;
+   ASSERT_TRUE(import_level({.src_path = src_path, .dst_path = dst_path, .should_override = true, .thread_count = 1}));
+
+   const auto level = Level::load_from_file(dst_path);
+   ASSERT_TRUE(level.has_value());
+
+   // The meshes only match if the fallback material is resolved the same way for both of them.
+   const auto& meshes = level->nodes().at("root"_name).static_meshes();
+   ASSERT_EQ(meshes.size(), 2);
+   EXPECT_EQ(meshes[0].mesh_name, meshes[1].mesh_name);
+   EXPECT_TRUE(PathManager::the().import_path(ResourceType::Mesh, "plane_a").first.exists());
+}
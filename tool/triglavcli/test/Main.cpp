@@ -0,0 +1,10 @@
+#include "triglav/project/Name.hpp"
+#include "triglav/testing_core/GTest.hpp"
+
+TG_PROJECT_NAME(triglav_cli_test)
+
+int main(int argc, char** argv)
+{
+   testing::InitGoogleTest(&argc, argv);
+   return RUN_ALL_TESTS();
+}